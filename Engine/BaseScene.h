@@ -8,6 +8,8 @@
 #include "ECS/systems/RenderingSystem.h"
 #include "ECS/systems/PauseManagerSystem.h"
 #include "ECS/systems/SliderSystem.h"
+#include "ECS/systems/UILayoutSystem.h"
+#include "ECS/systems/UIHitTestSystem.h"
 #include "ECS/systems/debug/DebugSystem.h"
 
 namespace FrostFireEngine
@@ -21,7 +23,9 @@ namespace FrostFireEngine
       world.AddSystem<ScriptSystem>(SystemPhase::Logic);
       world.AddSystem<PhysicsSystem>(SystemPhase::Physics);
       world.AddSystem<LightSystem>(SystemPhase::Logic, pDevice->GetD3DDevice());
+      world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, pDevice);
       world.AddSystem<RenderingSystem>(SystemPhase::Rendering, pDevice);
+      world.AddSystem<UIHitTestSystem>(SystemPhase::Logic, pDevice);
       world.AddSystem<ButtonSystem>(SystemPhase::Logic);
       world.AddSystem<SliderSystem>(SystemPhase::Logic);
       world.AddSystem<AudioSystem>(SystemPhase::Logic);
@@ -5,6 +5,7 @@
 #include "Engine/DispositifD3D11.h"
 #include "Engine/InputManager.h"
 #include "Engine/ECS/components/transform/TransformComponent.h"
+#include "Engine/ECS/systems/UIHitTestSystem.h"
 #include "rendering/UIRendererComponent.h"
 #include "transform/RectTransformComponent.h"
 
@@ -38,26 +39,25 @@ namespace FrostFireEngine
     {
     }
 
-    void Update()
+    void EnsureInitialized()
     {
-      if (!initialized_) {
-        Initialize();
-        initialized_ = true;
-      }
+      if (initialized_) return;
+      Initialize();
+      initialized_ = true;
+      UpdateVisuals();
+    }
+
+    // Appelé par ButtonSystem quand le curseur entre, sort, ou change d'état de clic au-dessus
+    // du bouton ; isInside vient du test de clic de UIHitTestSystem (bouton le plus haut)
+    void OnPointer(bool isInside, bool isMousePressed)
+    {
+      EnsureInitialized();
 
       // On vérifie ici le statut du component
       if (!IsEnabled() || !uiRendererComponent || !rectTransform_) {
         return;
       }
 
-      const auto* inputManager = &InputManager::GetInstance();
-
-      const float mouseX = static_cast<float>(inputManager->GetMouseX());
-      const float mouseY = static_cast<float>(inputManager->GetMouseY());
-
-      const bool isInside = IsPointInside(mouseX, mouseY);
-      const bool isMousePressed = inputManager->IsMouseButtonPressed(0);
-
       UpdateButtonState(isInside, isMousePressed);
       UpdateVisuals();
     }
@@ -70,6 +70,7 @@ namespace FrostFireEngine
     void SetEnabled(bool enabled) noexcept override
     {
       Component::SetEnabled(enabled);
+      UIHitTestSystem::InvalidateTargets();
       currentState_ = enabled ? State::Normal : State::Disabled;
       UpdateVisuals();
     }
@@ -81,40 +82,6 @@ namespace FrostFireEngine
     }
 
   private:
-    bool IsPointInside(float x, float y) const
-    {
-      if (!rectTransform_ || !uiRendererComponent || !transform) return false;
-
-      float contentWidth = uiRendererComponent->GetContentWidth();
-      float contentHeight = uiRendererComponent->GetContentHeight();
-
-      XMMATRIX uiMatrix = rectTransform_->GetUITransformMatrix(transform,
-                                                               contentWidth,
-                                                               contentHeight);
-      XMVECTOR tl = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-      XMVECTOR tr = XMVectorSet(1.0f, 0.0f, 0.0f, 1.0f);
-      XMVECTOR br = XMVectorSet(1.0f, 1.0f, 0.0f, 1.0f);
-      XMVECTOR bl = XMVectorSet(0.0f, 1.0f, 0.0f, 1.0f);
-
-      tl = XMVector4Transform(tl, uiMatrix);
-      tr = XMVector4Transform(tr, uiMatrix);
-      br = XMVector4Transform(br, uiMatrix);
-      bl = XMVector4Transform(bl, uiMatrix);
-
-      XMFLOAT4 ftl, ftr, fbr, fbl;
-      XMStoreFloat4(&ftl, tl);
-      XMStoreFloat4(&ftr, tr);
-      XMStoreFloat4(&fbr, br);
-      XMStoreFloat4(&fbl, bl);
-
-      float left = std::min({ftl.x, ftr.x, fbr.x, fbl.x});
-      float right = std::max({ftl.x, ftr.x, fbr.x, fbl.x});
-      float top = std::min({ftl.y, ftr.y, fbr.y, fbl.y});
-      float bottom = std::max({ftl.y, ftr.y, fbr.y, fbl.y});
-
-      return (x >= left && x <= right && y >= top && y <= bottom);
-    }
-
     void Initialize()
     {
       auto entity = World::GetInstance().GetEntity(owner);
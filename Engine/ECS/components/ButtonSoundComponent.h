@@ -6,6 +6,7 @@
 #include "InputManager.h"
 #include "TextureManager.h"
 #include "Engine/ECS/core/Component.h"
+#include "Engine/ECS/systems/UIHitTestSystem.h"
 #include "rendering/UIRendererComponent.h"
 #include "transform/RectTransformComponent.h"
 
@@ -47,26 +48,25 @@ namespace FrostFireEngine
     {
     }
 
-    void Update()
+    void EnsureInitialized()
     {
-      if (!initialized_) {
-        Initialize();
-        initialized_ = true;
-      }
+      if (initialized_) return;
+      Initialize();
+      initialized_ = true;
+      UpdateVisuals();
+    }
+
+    // Appelé par ButtonSystem quand le curseur entre, sort, ou change d'état de clic au-dessus
+    // du bouton ; isInside vient du test de clic de UIHitTestSystem (bouton le plus haut)
+    void OnPointer(bool isInside, bool isMousePressed)
+    {
+      EnsureInitialized();
 
       // On vérifie ici le statut du component
       if (!IsEnabled() || !uiRendererComponent || !rectTransform_) {
         return;
       }
 
-      const auto* inputManager = &InputManager::GetInstance();
-
-      const float mouseX = static_cast<float>(inputManager->GetMouseX());
-      const float mouseY = static_cast<float>(inputManager->GetMouseY());
-
-      const bool isInside = IsPointInside(mouseX, mouseY);
-      const bool isMousePressed = inputManager->IsMouseButtonPressed(0);
-
       UpdateButtonState(isInside, isMousePressed);
       UpdateVisuals();
     }
@@ -76,41 +76,14 @@ namespace FrostFireEngine
       onClick_ = callback;
     }
 
-  private:
-    bool IsPointInside(float x, float y) const
+    // Un bouton désactivé n'est plus une cible du test de clic
+    void SetEnabled(bool enabled) noexcept override
     {
-      if (!rectTransform_ || !uiRendererComponent || !transform) return false;
-
-      float contentWidth = uiRendererComponent->GetContentWidth();
-      float contentHeight = uiRendererComponent->GetContentHeight();
-
-      XMMATRIX uiMatrix = rectTransform_->GetUITransformMatrix(transform,
-                                                               contentWidth,
-                                                               contentHeight);
-      XMVECTOR tl = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-      XMVECTOR tr = XMVectorSet(1.0f, 0.0f, 0.0f, 1.0f);
-      XMVECTOR br = XMVectorSet(1.0f, 1.0f, 0.0f, 1.0f);
-      XMVECTOR bl = XMVectorSet(0.0f, 1.0f, 0.0f, 1.0f);
-
-      tl = XMVector4Transform(tl, uiMatrix);
-      tr = XMVector4Transform(tr, uiMatrix);
-      br = XMVector4Transform(br, uiMatrix);
-      bl = XMVector4Transform(bl, uiMatrix);
-
-      XMFLOAT4 ftl, ftr, fbr, fbl;
-      XMStoreFloat4(&ftl, tl);
-      XMStoreFloat4(&ftr, tr);
-      XMStoreFloat4(&fbr, br);
-      XMStoreFloat4(&fbl, bl);
-
-      float left = std::min({ftl.x, ftr.x, fbr.x, fbl.x});
-      float right = std::max({ftl.x, ftr.x, fbr.x, fbl.x});
-      float top = std::min({ftl.y, ftr.y, fbr.y, fbl.y});
-      float bottom = std::max({ftl.y, ftr.y, fbr.y, fbl.y});
-
-      return (x >= left && x <= right && y >= top && y <= bottom);
+      Component::SetEnabled(enabled);
+      UIHitTestSystem::InvalidateTargets();
     }
 
+  private:
     void Initialize()
     {
       auto entity = World::GetInstance().GetEntity(owner);
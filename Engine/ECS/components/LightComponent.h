@@ -1,6 +1,7 @@
 #pragma once
 #include "Engine/ECS/core/Component.h"
 #include <DirectXMath.h>
+#include <cstdint>
 
 namespace FrostFireEngine
 {
@@ -51,29 +52,41 @@ namespace FrostFireEngine
       return m_spotAngle;
     }
 
+    // Incrémenté par chaque setter, utilisé par LightSystem pour ne ré-encoder que les lumières modifiées
+    uint32_t GetVersion() const
+    {
+      return m_version;
+    }
+
     void SetType(LightType t)
     {
       m_type = t;
+      ++m_version;
     }
     void SetColor(const XMFLOAT3& c)
     {
       m_color = c;
+      ++m_version;
     }
     void SetIntensity(float i)
     {
       m_intensity = i;
+      ++m_version;
     }
     void SetDirection(const XMFLOAT3& d)
     {
       m_direction = d;
+      ++m_version;
     }
     void SetRange(float r)
     {
       m_range = r;
+      ++m_version;
     }
     void SetSpotAngle(float a)
     {
       m_spotAngle = a;
+      ++m_version;
     }
 
   private:
@@ -83,5 +96,6 @@ namespace FrostFireEngine
     XMFLOAT3  m_direction = {0, -1, 0};
     float     m_range = 100.0f;
     float     m_spotAngle = 45.0f; // en degrés
+    uint32_t  m_version = 0;
   };
 }
@@ -7,6 +7,7 @@
 #include "Engine/ECS/components/transform/TransformComponent.h"
 #include "Engine/ECS/components/rendering/UIRendererComponent.h"
 #include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "Engine/ECS/systems/UIHitTestSystem.h"
 #include <functional>
 #include "ButtonComponent.h"
 
@@ -64,6 +65,13 @@ namespace FrostFireEngine
 
     float GetValue() const { return value; }
 
+    // Un slider désactivé n'est plus une cible du test de clic
+    void SetEnabled(bool enabled) noexcept override
+    {
+      Component::SetEnabled(enabled);
+      UIHitTestSystem::InvalidateTargets();
+    }
+
 
     void UpdateCursorPosition(float newPosX)
     {
@@ -72,7 +80,9 @@ namespace FrostFireEngine
       if (newPosX > sliderWidth) newPosX = sliderWidth;
       rectTransformCursor->SetAnchorOffset({ newPosX, rectTransformCursor->GetAnchorOffset().y });
     }
-    void Update()
+    // Appelé par SliderSystem sur les transitions du curseur et pendant le glissement ;
+    // isInside vient du test de clic de UIHitTestSystem
+    void OnPointer(bool isInside, bool isMousePressed, float mouseX)
     {
       if (!initialized_)
       {
@@ -85,14 +95,6 @@ namespace FrostFireEngine
         return;
       }
 
-      const auto *inputManager = &InputManager::GetInstance();
-
-      const float mouseX = static_cast<float>(inputManager->GetMouseX());
-      const float mouseY = static_cast<float>(inputManager->GetMouseY());
-
-      const bool isInside = IsPointInside(mouseX, mouseY);
-      const bool isMousePressed = inputManager->IsMouseButtonPressed(0);
-
       UpdateButtonState(isInside, isMousePressed);
 
       if (isMousePressed && isInside)
@@ -133,40 +135,6 @@ namespace FrostFireEngine
     TransformComponent *transformSlidebar;
     TransformComponent *transformCursor;
 
-    bool IsPointInside(float x, float y) const
-    {
-      if (!rectTransformSlidebar || !uiRendererSlidebarComponent || !transformSlidebar) return false;
-
-      float contentWidth = uiRendererSlidebarComponent->GetContentWidth();
-      float contentHeight = uiRendererSlidebarComponent->GetContentHeight();
-
-      XMMATRIX uiMatrix = rectTransformSlidebar->GetUITransformMatrix(transformSlidebar,
-        contentWidth,
-        contentHeight);
-      XMVECTOR tl = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
-      XMVECTOR tr = XMVectorSet(1.0f, 0.0f, 0.0f, 1.0f);
-      XMVECTOR br = XMVectorSet(1.0f, 1.0f, 0.0f, 1.0f);
-      XMVECTOR bl = XMVectorSet(0.0f, 1.0f, 0.0f, 1.0f);
-
-      tl = XMVector4Transform(tl, uiMatrix);
-      tr = XMVector4Transform(tr, uiMatrix);
-      br = XMVector4Transform(br, uiMatrix);
-      bl = XMVector4Transform(bl, uiMatrix);
-
-      XMFLOAT4 ftl, ftr, fbr, fbl;
-      XMStoreFloat4(&ftl, tl);
-      XMStoreFloat4(&ftr, tr);
-      XMStoreFloat4(&fbr, br);
-      XMStoreFloat4(&fbl, bl);
-
-      float left = std::min({ ftl.x, ftr.x, fbr.x, fbl.x });
-      float right = std::max({ ftl.x, ftr.x, fbr.x, fbl.x });
-      float top = std::min({ ftl.y, ftr.y, fbr.y, fbl.y });
-      float bottom = std::max({ ftl.y, ftr.y, fbr.y, fbl.y });
-
-      return (x >= left && x <= right && y >= top && y <= bottom);
-    }
-
     void UpdateButtonState(bool isInside, bool isMousePressed)
     {
       auto newState = State::Normal;
@@ -2,6 +2,9 @@
 #include "Engine/ECS/core/World.h"
 #include "Engine/ECS/components/transform/TransformComponent.h"
 
+#undef min
+#undef max
+
 namespace FrostFireEngine
 {
   MeshComponent::MeshComponent() : m_currentLODIndex(0) {}
@@ -14,42 +17,75 @@ namespace FrostFireEngine
 
   std::shared_ptr<Mesh> MeshComponent::GetMesh() const
   {
-    if (HasLODs()) {
-      return m_lodLevels[m_currentLODIndex].mesh;
-    }
     return m_baseMesh;
   }
 
-  void MeshComponent::AddLODLevel(float distance, const std::shared_ptr<Mesh>& mesh)
+  std::shared_ptr<Mesh> MeshComponent::GetMeshForLOD(size_t lodIndex) const
   {
-    m_lodLevels.emplace_back(distance, mesh);
+    if (lodIndex == 0 || !HasLODs()) {
+      return m_baseMesh;
+    }
+    return m_lodLevels[std::min(lodIndex, m_lodLevels.size()) - 1].mesh;
+  }
+
+  void MeshComponent::AddLODLevel(float screenSize, const std::shared_ptr<Mesh>& mesh)
+  {
+    m_lodLevels.emplace_back(screenSize, mesh);
     std::ranges::sort(m_lodLevels,
                       [](const LODLevel& a, const LODLevel& b) {
-                        return a.distance > b.distance;
+                        return a.screenSize > b.screenSize;
                       });
   }
 
-  void MeshComponent::UpdateLOD(const XMFLOAT3& cameraPosition)
+  size_t MeshComponent::SelectLOD(float screenSize) const
+  {
+    size_t lod = 0;
+    while (lod < m_lodLevels.size() && screenSize < m_lodLevels[lod].screenSize) {
+      ++lod;
+    }
+    return lod;
+  }
+
+  void MeshComponent::UpdateLOD(float screenSize)
   {
     if (!HasLODs()) return;
 
-    auto entity = World::GetInstance().GetEntity(GetOwner());
-    auto transform = entity->GetComponent<TransformComponent>();
-    if (!transform) return;
+    // On ne passe à un niveau plus grossier qu'une fois le seuil franchi de h %,
+    // et inversement pour revenir à un niveau plus fin
+    const size_t coarser = SelectLOD(screenSize * (1.0f + m_lodHysteresis));
+    const size_t finer = SelectLOD(screenSize * (1.0f - m_lodHysteresis));
+
+    if (coarser > m_currentLODIndex) {
+      m_currentLODIndex = coarser;
+    }
+    else if (finer < m_currentLODIndex) {
+      m_currentLODIndex = finer;
+    }
+  }
+
+  float MeshComponent::ComputeScreenSize(const XMMATRIX& worldMatrix,
+                                         const XMMATRIX& viewMatrix,
+                                         const XMMATRIX& projectionMatrix) const
+  {
+    if (!m_baseMesh) return 0.0f;
 
-    XMVECTOR objectPos = XMLoadFloat3(&transform->GetPosition());
-    XMVECTOR camPos = XMLoadFloat3(&cameraPosition);
+    const auto& sphere = m_baseMesh->GetBounds().sphere;
+    const float scale = std::max({
+      XMVectorGetX(XMVector3Length(worldMatrix.r[0])),
+      XMVectorGetX(XMVector3Length(worldMatrix.r[1])),
+      XMVectorGetX(XMVector3Length(worldMatrix.r[2]))
+    });
+    const float radius = sphere.radius * scale;
 
-    float distanceSq = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(objectPos, camPos)));
+    const XMVECTOR centerWS = XMVector3TransformCoord(XMLoadFloat3(&sphere.center), worldMatrix);
+    const float    viewZ = XMVectorGetZ(XMVector3TransformCoord(centerWS, viewMatrix));
 
-    for (size_t i = 0; i < m_lodLevels.size(); ++i) {
-      if (distanceSq > (m_lodLevels[i].distance * m_lodLevels[i].distance)) {
-        m_currentLODIndex = i;
-        return;
-      }
-    }
+    // Caméra dans la sphère : plein écran
+    if (viewZ <= radius) return 1.0f;
 
-    m_currentLODIndex = m_lodLevels.size() - 1;
+    XMFLOAT4X4 proj;
+    XMStoreFloat4x4(&proj, projectionMatrix);
+    return radius * proj._22 / viewZ;
   }
 
   void MeshComponent::ClearLODLevels()
@@ -7,12 +7,14 @@
 
 namespace FrostFireEngine
 {
+  // Niveau de détail sélectionné tant que l'objet couvre au moins screenSize
+  // (fraction de la hauteur de l'écran occupée par sa sphère englobante)
   struct LODLevel {
-    float                 distance;
+    float                 screenSize;
     std::shared_ptr<Mesh> mesh;
 
-    LODLevel(float dist, const std::shared_ptr<Mesh>& m)
-      : distance(dist), mesh(m)
+    LODLevel(float size, const std::shared_ptr<Mesh>& m)
+      : screenSize(size), mesh(m)
     {
     }
   };
@@ -22,25 +24,59 @@ namespace FrostFireEngine
     MeshComponent();
     ~MeshComponent() override;
 
-    void                  SetMesh(const std::shared_ptr<Mesh>& mesh);
+    void SetMesh(const std::shared_ptr<Mesh>& mesh);
+
+    // Maillage de base (pleine résolution), utilisé par les colliders, l'octree et le cache
     std::shared_ptr<Mesh> GetMesh() const;
 
-    void AddLODLevel(float distance, const std::shared_ptr<Mesh>& mesh);
-    void UpdateLOD(const DirectX::XMFLOAT3& cameraPosition);
+    // Index 0 = maillage de base, index i = m_lodLevels[i - 1]
+    std::shared_ptr<Mesh> GetMeshForLOD(size_t lodIndex) const;
+
+    void AddLODLevel(float screenSize, const std::shared_ptr<Mesh>& mesh);
     void ClearLODLevels();
 
+    // Sélection par taille projetée, avec hystérésis pour éviter les oscillations
+    void UpdateLOD(float screenSize);
+
+    // Taille projetée de la sphère englobante du maillage de base
+    float ComputeScreenSize(const DirectX::XMMATRIX& worldMatrix,
+                            const DirectX::XMMATRIX& viewMatrix,
+                            const DirectX::XMMATRIX& projectionMatrix) const;
+
     bool HasLODs() const
     {
       return !m_lodLevels.empty();
     }
+    size_t GetLODCount() const
+    {
+      return m_lodLevels.size() + 1;
+    }
+    const std::vector<LODLevel>& GetLODLevels() const
+    {
+      return m_lodLevels;
+    }
     size_t GetCurrentLODIndex() const
     {
       return m_currentLODIndex;
     }
 
+    // Les ombres utilisent un niveau plus grossier que la vue principale
+    size_t GetShadowLODIndex() const
+    {
+      const size_t lod = m_currentLODIndex + m_shadowLODBias;
+      return lod < m_lodLevels.size() ? lod : m_lodLevels.size();
+    }
+
+    void SetLODHysteresis(float hysteresis) { m_lodHysteresis = hysteresis; }
+    void SetShadowLODBias(size_t bias) { m_shadowLODBias = bias; }
+
   private:
+    size_t SelectLOD(float screenSize) const;
+
     std::shared_ptr<Mesh> m_baseMesh;
     std::vector<LODLevel> m_lodLevels;
     size_t                m_currentLODIndex;
+    float                 m_lodHysteresis = 0.1f;
+    size_t                m_shadowLODBias = 1;
   };
 }
@@ -7,9 +7,11 @@
 #include <geometry/PxTriangleMeshGeometry.h>
 
 #include "RigidBodyComponent.h"
-#include "Engine/ECS/components/mesh/MeshComponent.h"
+#include "Engine/SceneCache.h"
+#include "Engine/Core/PhysicsResources.h"
 #include "Engine/ECS/components/transform/TransformComponent.h"
 #include "Engine/ECS/systems/PhysicsSystem.h"
+#include "Engine/Utils/ErrorLogger.h"
 
 
 namespace FrostFireEngine
@@ -63,6 +65,7 @@ namespace FrostFireEngine
       , shape(other.shape)
       , convexMesh(other.convexMesh)
       , triangleMesh(other.triangleMesh)
+      , cookedMesh(std::move(other.cookedMesh))
   {
     other.shape = nullptr;
     other.convexMesh = nullptr;
@@ -78,6 +81,7 @@ namespace FrostFireEngine
       shape = other.shape;
       convexMesh = other.convexMesh;
       triangleMesh = other.triangleMesh;
+      cookedMesh = std::move(other.cookedMesh);
 
       other.shape = nullptr;
       other.convexMesh = nullptr;
@@ -97,8 +101,6 @@ namespace FrostFireEngine
       scale = transform->GetScale();
     }
 
-    physx::PxPhysics* physics = PhysicsSystem::Get().GetPhysics();
-
     switch (colliderType) {
       case Type::Box:
         new(&geometry->box) physx::PxBoxGeometry(
@@ -130,91 +132,21 @@ namespace FrostFireEngine
       case Type::ConvexMesh:
       case Type::TriangleMesh:
         {
-          if (entityOwner) {
-            if (auto* meshComponent = entityOwner->GetComponent<MeshComponent>()) {
-              if (const auto mesh = meshComponent->GetMesh()) {
-                const std::vector<Vertex>&   vertices = mesh->GetVertices();
-                const std::vector<uint32_t>& indices = mesh->GetIndices();
-                std::vector<physx::PxVec3>   pxVertices(vertices.size());
-
-                for (size_t i = 0; i < vertices.size(); ++i) {
-                  pxVertices[i] = physx::PxVec3(
-                    vertices[i].GetPosition().x,
-                    vertices[i].GetPosition().y,
-                    vertices[i].GetPosition().z
-                  );
-                }
-
-                if (colliderType == Type::ConvexMesh) {
-                  physx::PxConvexMeshDesc convexDesc;
-                  convexDesc.points.count = static_cast<uint32_t>(pxVertices.size());
-                  convexDesc.points.stride = sizeof(physx::PxVec3);
-                  convexDesc.points.data = pxVertices.data();
-                  convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX |
-                  physx::PxConvexFlag::eDISABLE_MESH_VALIDATION |
-                  physx::PxConvexFlag::eQUANTIZE_INPUT |
-                  physx::PxConvexFlag::eSHIFT_VERTICES;
-
-                  physx::PxCookingParams cookingParams(physics->getTolerancesScale());
-                  cookingParams.planeTolerance = 0.0001f;
-                  cookingParams.meshPreprocessParams =
-                  physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
-                  cookingParams.gaussMapLimit = 32;
-                  cookingParams.areaTestEpsilon = 0.001f;
-                  cookingParams.convexMeshCookingType = physx::PxConvexMeshCookingType::eQUICKHULL;
-
-                  physx::PxDefaultMemoryOutputStream writeBuffer;
-                  if (!PxCookConvexMesh(cookingParams, convexDesc, writeBuffer)) {
-                    throw std::runtime_error("Failed to cook convex mesh.");
-                  }
-
-                  physx::PxDefaultMemoryInputData readBuffer(
-                    writeBuffer.getData(), writeBuffer.getSize());
-                  convexMesh = physics->createConvexMesh(readBuffer);
-
-                  new(&geometry->convexMesh) physx::PxConvexMeshGeometry(
-                    convexMesh,
-                    physx::PxMeshScale(physx::PxVec3(scale.x, scale.y, scale.z))
-                  );
-                }
-                else // Type::TriangleMesh
-                {
-                  physx::PxTriangleMeshDesc triangleDesc;
-                  triangleDesc.points.count = static_cast<uint32_t>(pxVertices.size());
-                  triangleDesc.points.stride = sizeof(physx::PxVec3);
-                  triangleDesc.points.data = pxVertices.data();
-                  triangleDesc.triangles.count = static_cast<uint32_t>(indices.size() / 3);
-                  triangleDesc.triangles.stride = 3 * sizeof(uint32_t);
-                  triangleDesc.triangles.data = indices.data();
-
-                  physx::PxCookingParams cookingParams(physics->getTolerancesScale());
-                  cookingParams.meshPreprocessParams =
-                  physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
-                  cookingParams.suppressTriangleMeshRemapTable = true;
-
-                  physx::PxDefaultMemoryOutputStream writeBuffer;
-                  if (!PxCookTriangleMesh(cookingParams, triangleDesc, writeBuffer)) {
-                    throw std::runtime_error("Failed to cook triangle mesh.");
-                  }
-
-                  physx::PxDefaultMemoryInputData readBuffer(
-                    writeBuffer.getData(), writeBuffer.getSize());
-                  triangleMesh = physics->createTriangleMesh(readBuffer);
-
-                  new(&geometry->triangleMesh) physx::PxTriangleMeshGeometry(
-                    triangleMesh,
-                    physx::PxMeshScale(physx::PxVec3(scale.x, scale.y, scale.z))
-                  );
-                }
-              }
-            }
+          // Le Mesh ne garde pas ses sommets côté CPU : le flux cuit vient de SetCookedMesh. Sans
+          // lui, rien n'est recuit ici ; le collider reste sans géométrie et la scène continue
+          if (!cookedMesh) {
+            ErrorLogger::Log(E_FAIL, "Mesh collider without a cooked collision mesh, ignored.");
+            break;
           }
+          CreateMeshGeometry(cookedMesh->data.data(), static_cast<uint32_t>(cookedMesh->data.size()), scale);
         }
         break;
     }
   }
   void ColliderComponent::UpdateScale(const XMFLOAT3& scale) const
   {
+    if (!HasGeometry()) return;
+
     switch (colliderType) {
       case Type::Box:
         geometry->box.halfExtents = physx::PxVec3(
@@ -261,6 +193,18 @@ namespace FrostFireEngine
     }
   }
 
+  bool ColliderComponent::HasGeometry() const
+  {
+    switch (colliderType) {
+      case Type::ConvexMesh:
+        return convexMesh != nullptr;
+      case Type::TriangleMesh:
+        return triangleMesh != nullptr;
+      default:
+        return true;
+    }
+  }
+
   const physx::PxGeometry& ColliderComponent::GetGeometry() const
   {
     switch (colliderType) {
@@ -315,36 +259,32 @@ namespace FrostFireEngine
       case Type::ConvexMesh:
       case Type::TriangleMesh:
         {
-          const auto entityOwner = World::GetInstance().GetEntity(owner);
-          if (entityOwner) {
-            if (const auto* meshComponent = entityOwner->GetComponent<MeshComponent>()) {
-              if (const auto mesh = meshComponent->GetMesh()) {
-                const std::vector<Vertex>&   vertices = mesh->GetVertices();
-                const std::vector<uint32_t>& indices = mesh->GetIndices();
-
-                uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
-                out.write(reinterpret_cast<const char*>(&vertexCount), sizeof(vertexCount));
-                out.write(reinterpret_cast<const char*>(vertices.data()),
-                          vertexCount * sizeof(Vertex));
-
-                uint32_t indexCount = static_cast<uint32_t>(indices.size());
-                out.write(reinterpret_cast<const char*>(&indexCount), sizeof(indexCount));
-                out.write(reinterpret_cast<const char*>(indices.data()),
-                          indexCount * sizeof(uint32_t));
-              }
-            }
+          // Le flux PhysX cuit est conservé : un chargement depuis le cache de scène ne cuit jamais
+          const std::shared_ptr<const CookedMesh>& cooked = cookedMesh;
+          const uint64_t hash = cooked ? cooked->hash : 0;
+          const uint32_t cookedSize = cooked ? static_cast<uint32_t>(cooked->data.size()) : 0;
+          out.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+          out.write(reinterpret_cast<const char*>(&cookedSize), sizeof(cookedSize));
+          if (cookedSize > 0) {
+            out.write(reinterpret_cast<const char*>(cooked->data.data()), cookedSize);
           }
         }
         break;
     }
   }
-  void ColliderComponent::Deserialize(std::istream& in)
+  void ColliderComponent::SharedMeshes::Clear()
+  {
+    for (const auto& [hash, mesh] : meshes) {
+      mesh->release();
+    }
+    meshes.clear();
+  }
+
+  void ColliderComponent::Deserialize(std::istream& in, SharedMeshes* shared)
   {
     in.read(reinterpret_cast<char*>(&colliderType), sizeof(colliderType));
     in.read(reinterpret_cast<char*>(&meshType), sizeof(meshType));
 
-    physx::PxPhysics* physics = PhysicsSystem::Get().GetPhysics();
-
     switch (colliderType) {
       case Type::Box:
         {
@@ -374,87 +314,157 @@ namespace FrostFireEngine
       case Type::ConvexMesh:
       case Type::TriangleMesh:
         {
-          uint32_t vertexCount = 0;
-          in.read(reinterpret_cast<char*>(&vertexCount), sizeof(vertexCount));
-          std::vector<Vertex> vertices(vertexCount);
-          in.read(reinterpret_cast<char*>(vertices.data()), vertexCount * sizeof(Vertex));
-
-          uint32_t indexCount = 0;
-          in.read(reinterpret_cast<char*>(&indexCount), sizeof(indexCount));
-          std::vector<uint32_t> indices(indexCount);
-          in.read(reinterpret_cast<char*>(indices.data()), indexCount * sizeof(uint32_t));
-
-          std::vector<physx::PxVec3> pxVertices(vertexCount);
-          for (size_t i = 0; i < vertices.size(); ++i) {
-            pxVertices[i] = physx::PxVec3(
-              vertices[i].GetPosition().x,
-              vertices[i].GetPosition().y,
-              vertices[i].GetPosition().z
-            );
-          }
-
-          if (colliderType == Type::ConvexMesh) {
-            physx::PxConvexMeshDesc convexDesc;
-            convexDesc.points.count = static_cast<uint32_t>(pxVertices.size());
-            convexDesc.points.stride = sizeof(physx::PxVec3);
-            convexDesc.points.data = pxVertices.data();
-            convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX |
-            physx::PxConvexFlag::eDISABLE_MESH_VALIDATION |
-            physx::PxConvexFlag::eQUANTIZE_INPUT |
-            physx::PxConvexFlag::eSHIFT_VERTICES;
-
-            physx::PxCookingParams cookingParams(physics->getTolerancesScale());
-            cookingParams.planeTolerance = 0.0001f;
-            cookingParams.meshPreprocessParams = physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
-            cookingParams.gaussMapLimit = 32;
-            cookingParams.areaTestEpsilon = 0.001f;
-            cookingParams.convexMeshCookingType = physx::PxConvexMeshCookingType::eQUICKHULL;
-
-            physx::PxDefaultMemoryOutputStream writeBuffer;
-            bool status = PxCookConvexMesh(cookingParams, convexDesc, writeBuffer);
-            if (!status) {
-              throw std::runtime_error("Failed to cook convex mesh during deserialization.");
+          uint64_t hash = 0;
+          uint32_t cookedSize = 0;
+          in.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+          in.read(reinterpret_cast<char*>(&cookedSize), sizeof(cookedSize));
+
+          // Même flux qu'un collider déjà lu : le maillage PhysX est partagé, sans recréation
+          if (shared && hash != 0) {
+            if (const auto it = shared->meshes.find(hash); it != shared->meshes.end()) {
+              in.ignore(cookedSize);
+              it->second->acquireReference();
+              SetMeshGeometry(it->second, XMFLOAT3(1.0f, 1.0f, 1.0f));
+              break;
             }
+          }
 
-            physx::PxDefaultMemoryInputData
-            readBuffer(writeBuffer.getData(), writeBuffer.getSize());
-            convexMesh = physics->createConvexMesh(readBuffer);
-            new(&geometry->convexMesh) physx::PxConvexMeshGeometry(convexMesh);
+          std::vector<uint8_t> cooked(cookedSize);
+          in.read(reinterpret_cast<char*>(cooked.data()), cookedSize);
+          if (!in || cookedSize == 0) {
+            throw std::runtime_error("Invalid cooked collision mesh during deserialization.");
           }
-          else // Type::TriangleMesh
-          {
-            physx::PxTriangleMeshDesc triangleDesc;
-            triangleDesc.points.count = static_cast<uint32_t>(pxVertices.size());
-            triangleDesc.points.stride = sizeof(physx::PxVec3);
-            triangleDesc.points.data = pxVertices.data();
-            triangleDesc.triangles.count = static_cast<uint32_t>(indices.size() / 3);
-            triangleDesc.triangles.stride = 3 * sizeof(uint32_t);
-            triangleDesc.triangles.data = indices.data();
-
-            float meshSize = CalculateMeshSize(pxVertices);
-            float weldTolerance = meshSize * 0.001f; // 0.1% of mesh size
-
-            physx::PxCookingParams cookingParams(physics->getTolerancesScale());
-            cookingParams.meshPreprocessParams = physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
-            cookingParams.suppressTriangleMeshRemapTable = true;
-            cookingParams.meshWeldTolerance = weldTolerance;
-
-            physx::PxDefaultMemoryOutputStream writeBuffer;
-            bool status = PxCookTriangleMesh(cookingParams, triangleDesc, writeBuffer);
-            if (!status) {
-              throw std::runtime_error("Failed to cook triangle mesh during deserialization.");
-            }
 
-            physx::PxDefaultMemoryInputData
-            readBuffer(writeBuffer.getData(), writeBuffer.getSize());
-            triangleMesh = physics->createTriangleMesh(readBuffer);
-            new(&geometry->triangleMesh) physx::PxTriangleMeshGeometry(triangleMesh);
+          CreateMeshGeometry(cooked.data(), cookedSize, XMFLOAT3(1.0f, 1.0f, 1.0f));
+          if (shared && hash != 0) {
+            physx::PxRefCounted* mesh = colliderType == Type::ConvexMesh
+                                          ? static_cast<physx::PxRefCounted*>(convexMesh)
+                                          : static_cast<physx::PxRefCounted*>(triangleMesh);
+            mesh->acquireReference();
+            shared->meshes.emplace(hash, mesh);
           }
         }
         break;
     }
   };
 
+  void ColliderComponent::CreateMeshGeometry(const uint8_t* data, uint32_t size, const XMFLOAT3& scale)
+  {
+    physx::PxPhysics*                physics = PhysicsSystem::Get().GetPhysics();
+    physx::PxDefaultMemoryInputData readBuffer(const_cast<physx::PxU8*>(data), size);
+
+    physx::PxRefCounted* mesh = nullptr;
+    if (colliderType == Type::ConvexMesh) {
+      mesh = physics->createConvexMesh(readBuffer);
+      if (!mesh) {
+        throw std::runtime_error("Failed to create convex mesh.");
+      }
+    }
+    else // Type::TriangleMesh
+    {
+      mesh = physics->createTriangleMesh(readBuffer);
+      if (!mesh) {
+        throw std::runtime_error("Failed to create triangle mesh.");
+      }
+    }
+    SetMeshGeometry(mesh, scale);
+  }
+
+  void ColliderComponent::SetMeshGeometry(physx::PxRefCounted* mesh, const XMFLOAT3& scale)
+  {
+    const physx::PxMeshScale meshScale(physx::PxVec3(scale.x, scale.y, scale.z));
+
+    if (colliderType == Type::ConvexMesh) {
+      convexMesh = static_cast<physx::PxConvexMesh*>(mesh);
+      new(&geometry->convexMesh) physx::PxConvexMeshGeometry(convexMesh, meshScale);
+    }
+    else // Type::TriangleMesh
+    {
+      triangleMesh = static_cast<physx::PxTriangleMesh*>(mesh);
+      new(&geometry->triangleMesh) physx::PxTriangleMeshGeometry(triangleMesh, meshScale);
+    }
+  }
+
+  uint64_t ColliderComponent::HashCollisionMesh(MeshType                  type,
+                                                std::span<const Vertex>   vertices,
+                                                std::span<const uint32_t> indices)
+  {
+    // Seules les positions (et les indices pour les triangle meshes) entrent dans la cuisson
+    uint64_t hash = HashBytes(&type, sizeof(type));
+    for (const auto& vertex : vertices) {
+      hash = HashBytes(&vertex.GetPosition(), sizeof(XMFLOAT3), hash);
+    }
+    if (type == MeshType::Triangle) {
+      hash = HashBytes(indices.data(), indices.size_bytes(), hash);
+    }
+    return hash;
+  }
+
+  std::shared_ptr<const ColliderComponent::CookedMesh> ColliderComponent::CookCollisionMesh(
+    MeshType                  type,
+    std::span<const Vertex>   vertices,
+    std::span<const uint32_t> indices)
+  {
+    std::vector<physx::PxVec3> pxVertices(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      pxVertices[i] = physx::PxVec3(
+        vertices[i].GetPosition().x,
+        vertices[i].GetPosition().y,
+        vertices[i].GetPosition().z
+      );
+    }
+
+    // PhysicsResources plutôt que PhysicsSystem::Get() : la cuisson tourne sur les threads de
+    // travail du chargement, qui ne doivent pas toucher au World
+    const physx::PxTolerancesScale& tolerances =
+      PhysicsResources::GetInstance().GetPhysics()->getTolerancesScale();
+
+    physx::PxDefaultMemoryOutputStream writeBuffer;
+
+    if (type == MeshType::Convex) {
+      physx::PxConvexMeshDesc convexDesc;
+      convexDesc.points.count = static_cast<uint32_t>(pxVertices.size());
+      convexDesc.points.stride = sizeof(physx::PxVec3);
+      convexDesc.points.data = pxVertices.data();
+      convexDesc.flags = physx::PxConvexFlag::eCOMPUTE_CONVEX |
+      physx::PxConvexFlag::eDISABLE_MESH_VALIDATION |
+      physx::PxConvexFlag::eQUANTIZE_INPUT |
+      physx::PxConvexFlag::eSHIFT_VERTICES;
+
+      physx::PxCookingParams cookingParams(tolerances);
+      cookingParams.planeTolerance = 0.0001f;
+      cookingParams.meshPreprocessParams = physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
+      cookingParams.gaussMapLimit = 32;
+      cookingParams.areaTestEpsilon = 0.001f;
+      cookingParams.convexMeshCookingType = physx::PxConvexMeshCookingType::eQUICKHULL;
+
+      if (!PxCookConvexMesh(cookingParams, convexDesc, writeBuffer)) return nullptr;
+    }
+    else // MeshType::Triangle
+    {
+      physx::PxTriangleMeshDesc triangleDesc;
+      triangleDesc.points.count = static_cast<uint32_t>(pxVertices.size());
+      triangleDesc.points.stride = sizeof(physx::PxVec3);
+      triangleDesc.points.data = pxVertices.data();
+      triangleDesc.triangles.count = static_cast<uint32_t>(indices.size() / 3);
+      triangleDesc.triangles.stride = 3 * sizeof(uint32_t);
+      triangleDesc.triangles.data = indices.data();
+
+      physx::PxCookingParams cookingParams(tolerances);
+      cookingParams.meshPreprocessParams = physx::PxMeshPreprocessingFlag::eWELD_VERTICES;
+      cookingParams.suppressTriangleMeshRemapTable = true;
+      cookingParams.meshWeldTolerance = CalculateMeshSize(pxVertices) * 0.001f; // 0.1% of mesh size
+
+      if (!PxCookTriangleMesh(cookingParams, triangleDesc, writeBuffer)) return nullptr;
+    }
+
+    auto cooked = std::make_shared<CookedMesh>();
+    cooked->type = type;
+    cooked->hash = HashCollisionMesh(type, vertices, indices);
+    cooked->data.assign(writeBuffer.getData(), writeBuffer.getData() + writeBuffer.getSize());
+    return cooked;
+  }
+
   float ColliderComponent::CalculateMeshSize(const std::vector<physx::PxVec3>& vertices)
   {
     if (vertices.empty()) return 1.0f;
@@ -3,9 +3,12 @@
 #include <DirectXMath.h>
 #include <memory>
 #include <iostream>
+#include <span>
+#include <unordered_map>
 #include <vector>
 #include <geometry/PxConvexMesh.h>
 #include <geometry/PxTriangleMesh.h>
+#include "Engine/Vertex.h"
 
 namespace physx
 {
@@ -13,6 +16,7 @@ namespace physx
   class PxGeometry;
   class PxTriangleMesh;
   class PxConvexMesh;
+  class PxRefCounted;
 }
 
 namespace FrostFireEngine
@@ -38,18 +42,49 @@ namespace FrostFireEngine
       Triangle
     };
 
+    // Flux binaire PhysX d'un maillage de collision cuit, identifié par le hachage de son contenu
+    struct CookedMesh {
+      MeshType             type = MeshType::Convex;
+      uint64_t             hash = 0;
+      std::vector<uint8_t> data;
+    };
+
     explicit ColliderComponent(Type type = Type::Box);
     ~ColliderComponent() override;
 
     ColliderComponent(const ColliderComponent&) = delete;
     ColliderComponent& operator=(const ColliderComponent&) = delete;
 
+    // Maillages PhysX créés pendant un chargement, partagés entre colliders par hachage du flux
+    // cuit. Une référence est gardée sur chacun jusqu'à Clear().
+    class SharedMeshes {
+    public:
+      SharedMeshes() = default;
+      ~SharedMeshes() { Clear(); }
+      SharedMeshes(const SharedMeshes&) = delete;
+      SharedMeshes& operator=(const SharedMeshes&) = delete;
+
+      void Clear();
+
+    private:
+      friend class ColliderComponent;
+      std::unordered_map<uint64_t, physx::PxRefCounted*> meshes;
+    };
+
     ColliderComponent(ColliderComponent&&) noexcept;
     ColliderComponent& operator=(ColliderComponent&&) noexcept;
 
+    // Les colliders de maillage exigent un flux fourni par SetCookedMesh (cf. CookCollisionMesh) ;
+    // sans lui, l'erreur est signalée et le collider reste sans géométrie (cf. HasGeometry)
     void Initialize(const DirectX::XMFLOAT3& size);
+    void SetCookedMesh(std::shared_ptr<const CookedMesh> cooked) { cookedMesh = std::move(cooked); }
+    void ReleaseCookedMesh() { cookedMesh.reset(); }
+    uint64_t GetCookedHash() const { return cookedMesh ? cookedMesh->hash : 0; }
     void UpdateScale(const DirectX::XMFLOAT3& scale) const;
 
+    // Faux pour un collider de maillage sans maillage PhysX : RigidBodyComponent l'ignore
+    bool HasGeometry() const;
+
     const physx::PxGeometry& GetGeometry() const;
     void SetShape(physx::PxShape* newShape);
     physx::PxShape* GetShape() const { return shape; }
@@ -58,10 +93,21 @@ namespace FrostFireEngine
     MeshType GetMeshType() const { return meshType; }
 
     void Serialize(std::ostream& out) const;
-    void Deserialize(std::istream& in);
+    // Avec shared, un flux dont le hachage a déjà été lu reprend le maillage PhysX déjà créé
+    void Deserialize(std::istream& in, SharedMeshes* shared = nullptr);
     static float CalculateMeshSize(const std::vector<physx::PxVec3>& vertices);
 
+    // Cuisson sans état, utilisable depuis les threads de travail du chargement ; nullptr en cas d'échec
+    static uint64_t HashCollisionMesh(MeshType type, std::span<const Vertex> vertices,
+                                      std::span<const uint32_t> indices);
+    static std::shared_ptr<const CookedMesh> CookCollisionMesh(MeshType type, std::span<const Vertex> vertices,
+                                                               std::span<const uint32_t> indices);
+
   private:
+    void CreateMeshGeometry(const uint8_t* data, uint32_t size, const DirectX::XMFLOAT3& scale);
+    // Prend possession d'une référence sur mesh, du type du collider
+    void SetMeshGeometry(physx::PxRefCounted* mesh, const DirectX::XMFLOAT3& scale);
+
     struct GeometryHolder;
     std::unique_ptr<GeometryHolder> geometry;
     Type colliderType;
@@ -69,5 +115,6 @@ namespace FrostFireEngine
     physx::PxShape* shape{ nullptr };
     physx::PxConvexMesh* convexMesh{ nullptr };
     physx::PxTriangleMesh* triangleMesh{ nullptr };
+    std::shared_ptr<const CookedMesh> cookedMesh;  // gardé pour l'écriture du cache de scène
   };
 }
@@ -105,7 +105,8 @@ namespace FrostFireEngine
     std::vector<std::pair<ColliderComponent*, TransformComponent*>>& colliderPairs)
   {
     // First check if this entity has both a collider and transform
-    if (auto* collider = entity->GetComponent<ColliderComponent>()) {
+    auto* collider = entity->GetComponent<ColliderComponent>();
+    if (collider && collider->HasGeometry()) {  // sans maillage PhysX (cuisson échouée), pas de forme
       if (auto* transform = entity->GetComponent<TransformComponent>()) {
         // Always add if it's a valid collider, regardless of whether it's on the root or child
         colliderPairs.emplace_back(collider, transform);
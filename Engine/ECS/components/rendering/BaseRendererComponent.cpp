@@ -31,6 +31,7 @@ BaseRendererComponent::BaseRendererComponent(BaseRendererComponent&& other) noex
     m_features(std::move(other.m_features)),
     m_technique(other.m_technique),
     m_ownedTechnique(std::move(other.m_ownedTechnique)),
+    m_featureMask(other.m_featureMask),
     m_matrixBuffer(other.m_matrixBuffer),
     m_visible(other.m_visible),
     m_opaque(other.m_opaque)
@@ -52,6 +53,7 @@ BaseRendererComponent& BaseRendererComponent::operator=(BaseRendererComponent&&
     m_features = std::move(other.m_features);
     m_technique = other.m_technique;
     m_ownedTechnique = std::move(other.m_ownedTechnique);
+    m_featureMask = other.m_featureMask;
     m_matrixBuffer = other.m_matrixBuffer;
     m_visible = other.m_visible;
     m_opaque = other.m_opaque;
@@ -64,6 +66,7 @@ BaseRendererComponent& BaseRendererComponent::operator=(BaseRendererComponent&&
 
 void BaseRendererComponent::AddFeature(std::unique_ptr<BaseShaderFeature> feature)
 {
+  m_featureMask |= ShaderVariantManager::GetFeatureBit(feature->GetId());
   m_features.push_back(std::move(feature));
 }
 
@@ -59,6 +59,12 @@ namespace FrostFireEngine
 
     std::vector<std::string> GetActiveFeatures() const;
 
+    // Masque des features, recalculé à chaque AddFeature plutôt qu'à chaque Draw
+    FeatureMask GetFeatureMask() const
+    {
+      return m_featureMask;
+    }
+
     virtual float GetDistanceFromCamera(const XMVECTOR& cameraPosition) const
     {
       if (const auto owner = World::GetInstance().GetEntity(GetOwner())) {
@@ -74,6 +80,17 @@ namespace FrostFireEngine
       return 0.0f;
     }
 
+    // Profondeur dans l'espace vue, clé du tri arrière vers avant des transparents
+    virtual float GetViewDepth(const XMMATRIX& viewMatrix) const
+    {
+      if (const auto owner = World::GetInstance().GetEntity(GetOwner())) {
+        if (const auto* transform = owner->GetComponent<TransformComponent>()) {
+          return XMVectorGetZ(XMVector3Transform(transform->GetWorldPosition(), viewMatrix));
+        }
+      }
+      return 0.0f;
+    }
+
 
     // Empêcher la copie
     BaseRendererComponent(const BaseRendererComponent&) = delete;
@@ -93,6 +110,7 @@ namespace FrostFireEngine
     std::vector<std::unique_ptr<BaseShaderFeature>> m_features;
     ShaderTechnique*                                m_technique;
     std::unique_ptr<ShaderTechnique>                m_ownedTechnique;
+    FeatureMask                                     m_featureMask = 0;
     ID3D11Buffer*                                   m_matrixBuffer;
     bool                                            m_visible;
     bool                                            m_opaque;
@@ -18,17 +18,9 @@ using namespace DirectX;
 REGISTER_INHERITANCE(PBRRenderer, BaseRendererComponent)
 
 
-static VertexLayoutDesc CreateLayout()
-{
-  VertexLayoutDesc layoutDesc;
-  for (const auto& i : Vertex::layout) {
-    layoutDesc.elements.push_back(i);
-  }
-  return layoutDesc;
-}
-
 PBRRenderer::PBRRenderer(ID3D11Device* device)
-  : m_layout(CreateLayout())
+  : m_layout(GetVertexLayoutDesc(VertexFormat::Full)),
+    m_packedLayout(GetVertexLayoutDesc(VertexFormat::Packed))
 {
   m_world = &World::GetInstance();
 
@@ -65,7 +57,8 @@ PBRRenderer::~PBRRenderer()
 
 PBRRenderer::PBRRenderer(PBRRenderer&& other) noexcept
   : BaseRendererComponent(std::move(other)),
-    m_layout(std::move(other.m_layout))
+    m_layout(std::move(other.m_layout)),
+    m_packedLayout(std::move(other.m_packedLayout))
 {
   m_technique = std::move(other.m_technique);
   m_defaultSamplerState = other.m_defaultSamplerState;
@@ -87,6 +80,7 @@ PBRRenderer& PBRRenderer::operator=(PBRRenderer&& other) noexcept
     BaseRendererComponent::operator=(std::move(other));
     m_technique = std::move(other.m_technique);
     m_layout = std::move(other.m_layout);
+    m_packedLayout = std::move(other.m_packedLayout);
 
     if (m_defaultSamplerState) m_defaultSamplerState->Release();
 
@@ -122,10 +116,49 @@ void PBRRenderer::Draw(ID3D11DeviceContext* deviceContext,
   const XMMATRIX worldMatrix = transform->GetWorldMatrix();
   UpdateConstantBuffers(deviceContext, worldMatrix, viewMatrix, projectionMatrix);
 
+  // La couverture écran pilote à la fois le LOD et la demande de streaming des textures
+  float screenSize = 0.0f;
+  if (currentPass == RenderPass::GBuffer || currentPass == RenderPass::Transparency) {
+    screenSize = meshComponent->ComputeScreenSize(worldMatrix, viewMatrix, projectionMatrix);
+  }
+
+  // La vue principale choisit le LOD, les ombres en réutilisent un plus grossier
+  size_t lodIndex = 0;
+  if (meshComponent->HasLODs()) {
+    if (currentPass == RenderPass::Shadow) {
+      lodIndex = meshComponent->GetShadowLODIndex();
+    }
+    else {
+      if (currentPass == RenderPass::GBuffer) {
+        const size_t shadowLODIndex = meshComponent->GetShadowLODIndex();
+        meshComponent->UpdateLOD(screenSize);
+        // Les slices d'ombre en cache ont été rendues avec l'ancien LOD d'ombre : remettre l'entité
+        // à jour dans l'octree marque sa région dirty pour la prochaine passe d'ombre
+        if (meshComponent->GetShadowLODIndex() != shadowLODIndex) {
+          World::GetInstance().UpdateOctreeEntity(GetOwner());
+        }
+      }
+      lodIndex = meshComponent->GetCurrentLODIndex();
+    }
+  }
+
+  const auto mesh = meshComponent->GetMeshForLOD(lodIndex);
+  if (!mesh) return;
+
+  // Passe de profondeur seule : la variante d'ombre ne lit que les positions du flux 0
+  if (currentPass == RenderPass::Shadow) {
+    mesh->DrawPositions(deviceContext);
+    return;
+  }
+
   if (currentPass == RenderPass::GBuffer || currentPass == RenderPass::Transparency) {
-    const auto           features = GetActiveFeatures();
+    // Les maillages compressés demandent la variante qui décode le flux d'attributs
+    const bool packed = mesh->GetVertexFormat() == VertexFormat::Packed;
+    static const FeatureMask packedFeature = ShaderVariantManager::GetFeatureBit(PACKED_VERTEX_FEATURE);
+    const FeatureMask        features = GetFeatureMask() | (packed ? packedFeature : 0);
+
     const ShaderVariant* variant = GetTechnique()->GetVariantForPass(
-      currentPass, features, GetVertexLayout());
+      currentPass, features, packed ? m_packedLayout : GetVertexLayout());
     if (!variant) {
       ErrorLogger::Log("No shader variant found for current pass in PBRRenderer.");
       return;
@@ -137,6 +170,10 @@ void PBRRenderer::Draw(ID3D11DeviceContext* deviceContext,
 
     variant->Apply(deviceContext);
 
+    for (Texture* texture : {m_albedoTexture, m_normalMap, m_metallicRoughnessMap, m_aoMap}) {
+      if (texture) texture->RequestScreenSize(screenSize);
+    }
+
     auto&    texManager = TextureManager::GetInstance();
     Texture* fallbackTex = texManager.GetTexture(L"__white_fallback__");
     Texture* normalFallbackTex = texManager.GetTexture(L"__neutralnormal_fallback__");
@@ -183,9 +220,7 @@ void PBRRenderer::Draw(ID3D11DeviceContext* deviceContext,
     deviceContext->PSSetSamplers(0, 1, &m_defaultSamplerState);
   }
 
-  if (const auto mesh = meshComponent->GetMesh()) {
-    mesh->Draw(deviceContext);
-  }
+  mesh->Draw(deviceContext);
 }
 
 const VertexLayoutDesc& PBRRenderer::GetVertexLayout() const
@@ -94,7 +94,8 @@ namespace FrostFireEngine
   private:
     bool InitializeConstantBuffers(ID3D11Device* device) override;
 
-    VertexLayoutDesc m_layout;
+    VertexLayoutDesc m_layout;        // VertexFormat::Full
+    VertexLayoutDesc m_packedLayout;  // VertexFormat::Packed
 
     Texture* m_albedoTexture = nullptr;
     Texture* m_normalMap = nullptr;
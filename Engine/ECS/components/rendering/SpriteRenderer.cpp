@@ -7,6 +7,7 @@
 #include "Engine/Utils/ErrorLogger.h"
 #include "Engine/ECS/components/transform/TransformComponent.h"
 #include "Engine/ECS/core/World.h"
+#include "Engine/ECS/systems/rendering/SpriteBatcher.h"
 #include <d3d11.h>
 #include <DirectXMath.h>
 
@@ -28,6 +29,13 @@ static VertexLayoutDesc CreateLayout()
   return layoutDesc;
 }
 
+static VertexLayoutDesc CreateInstanceLayout()
+{
+  VertexLayoutDesc layoutDesc;
+  layoutDesc.elements.assign(std::begin(BillboardInstanceLayout), std::end(BillboardInstanceLayout));
+  return layoutDesc;
+}
+
 SpriteRenderer::SpriteRenderer(ID3D11Device* device)
   : m_texture(nullptr), m_defaultSamplerState(nullptr), m_layout(CreateLayout()), m_opacity(1.0f),
     m_billboard(false)
@@ -141,11 +149,11 @@ void SpriteRenderer::Draw(ID3D11DeviceContext* deviceContext,
   }
 
   if (currentPass == RenderPass::Transparency || currentPass == RenderPass::UI) {
-    const auto           features = GetActiveFeatures();
     const ShaderVariant* variant = GetTechnique()->GetVariantForPass(
-      currentPass, features, GetVertexLayout());
+      currentPass, GetFeatureMask(), GetVertexLayout());
     if (!variant) return;
     variant->Apply(deviceContext);
+    if (m_texture) m_texture->RequestScreenSize(1.0f);
     auto&                     texManager = TextureManager::GetInstance();
     Texture*                  fallbackTex = texManager.GetTexture(L"__white_fallback__");
     ID3D11ShaderResourceView* srv = (m_texture && m_texture->GetShaderResourceView())
@@ -157,6 +165,39 @@ void SpriteRenderer::Draw(ID3D11DeviceContext* deviceContext,
   }
 }
 
+void SpriteRenderer::SubmitBillboard(SpriteBatcher& batcher)
+{
+  if (!IsVisible() || !m_billboard) return;
+  auto entity = World::GetInstance().GetEntity(GetOwner());
+  if (!entity) return;
+  auto transform = entity->GetComponent<TransformComponent>();
+  if (!transform) return;
+
+  static const VertexLayoutDesc instanceLayout = CreateInstanceLayout();
+  static const FeatureMask instancingFeature = ShaderVariantManager::GetFeatureBit(SPRITE_INSTANCING_FEATURE);
+  ShaderVariant* variant = GetTechnique()->GetVariantForPass(RenderPass::Transparency,
+                                                             GetFeatureMask() | instancingFeature, instanceLayout);
+  if (!variant) return;
+
+  // Seules la position et l'échelle comptent, l'orientation est celle de la caméra
+  const XMMATRIX worldMatrix = transform->GetWorldMatrix();
+  XMFLOAT3       position;
+  XMFLOAT3       scale;
+  XMStoreFloat3(&position, worldMatrix.r[3]);
+  XMStoreFloat3(&scale, XMVectorSet(XMVectorGetX(XMVector3Length(worldMatrix.r[0])),
+                                    XMVectorGetX(XMVector3Length(worldMatrix.r[1])),
+                                    XMVectorGetX(XMVector3Length(worldMatrix.r[2])), 0.0f));
+
+  if (m_texture) m_texture->RequestScreenSize(1.0f);
+  auto&                     texManager = TextureManager::GetInstance();
+  Texture*                  fallbackTex = texManager.GetTexture(L"__white_fallback__");
+  ID3D11ShaderResourceView* srv = (m_texture && m_texture->GetShaderResourceView())
+                                    ? m_texture->GetShaderResourceView().Get()
+                                    : fallbackTex->GetShaderResourceView().Get();
+
+  batcher.Add(variant, srv, position, scale, m_opacity);
+}
+
 const VertexLayoutDesc& SpriteRenderer::GetVertexLayout() const
 {
   return m_layout;
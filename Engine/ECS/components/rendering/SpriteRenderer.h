@@ -8,6 +8,7 @@
 namespace FrostFireEngine
 {
   class Texture;
+  class SpriteBatcher;
 
   class SpriteRenderer : public BaseRendererComponent {
   public:
@@ -21,6 +22,9 @@ namespace FrostFireEngine
               const DirectX::XMMATRIX& projectionMatrix,
               RenderPass currentPass) override;
 
+    // Billboards : ajoutés au lot instancié de la frame au lieu d'un Draw chacun
+    void SubmitBillboard(SpriteBatcher& batcher);
+
     const VertexLayoutDesc& GetVertexLayout() const override;
     ShaderTechnique* GetTechnique() const override;
 
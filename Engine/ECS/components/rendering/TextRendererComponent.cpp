@@ -1,6 +1,5 @@
 #include "TextRendererComponent.h"
-#include "Engine/ECS/components/transform/TransformComponent.h"
-#include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "Engine/Font/SdfFontAtlas.h"
 #include "Engine/Shaders/ShaderVariant.h"
 #include "Engine/TextureManager.h"
 #include "Engine/Utils/ErrorLogger.h"
@@ -18,248 +17,139 @@ namespace FrostFireEngine
   TextRendererComponent::TextRendererComponent(DispositifD3D11* dispositif)
     : m_dispositif(dispositif)
   {
-    D3D11_INPUT_ELEMENT_DESC posElement = {
-      "POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 0,
-      D3D11_INPUT_PER_VERTEX_DATA, 0
-    };
-    D3D11_INPUT_ELEMENT_DESC uvElement = {
-      "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 8,
-      D3D11_INPUT_PER_VERTEX_DATA, 0
-    };
-    m_layout.elements.push_back(posElement);
-    m_layout.elements.push_back(uvElement);
+    m_layout.elements.assign(std::begin(UIVertexLayout), std::end(UIVertexLayout));
 
     SetTechnique(std::make_unique<TextTechnique>());
-    TextRendererComponent::InitializeConstantBuffers(dispositif->GetD3DDevice());
-  }
-
-  bool TextRendererComponent::InitializeConstantBuffers(ID3D11Device* device)
-  {
-    return UIBaseRendererComponent::InitializeConstantBuffers(device);
   }
 
   void TextRendererComponent::SetText(const std::wstring& text)
   {
+    // Les scripts réaffectent leur texte à chaque frame, le plus souvent à l'identique
+    if (text == m_text) return;
+
+    const size_t commonLength = std::mismatch(m_text.begin(), m_text.end(), text.begin(), text.end()).first
+                                - m_text.begin();
     m_text = text;
-    UpdateTextGeometry(m_dispositif->GetD3DDevice());
+    UpdateContent(commonLength);
   }
 
   void TextRendererComponent::SetFont(Font* font)
   {
     m_font = font;
-    UpdateTextGeometry(m_dispositif->GetD3DDevice());
+    UpdateContent();
+  }
+
+  void TextRendererComponent::UpdateContent(size_t firstChangedChar)
+  {
+    const float previousWidth = m_contentWidth;
+    const float previousHeight = m_contentHeight;
+    UpdateTextGeometry(firstChangedChar);
+    if (m_contentWidth != previousWidth || m_contentHeight != previousHeight) {
+      RequestLayout();
+    }
   }
 
-  void TextRendererComponent::UpdateTextGeometry(ID3D11Device* device)
+  void TextRendererComponent::UpdateTextGeometry(size_t firstChangedChar)
   {
-    if (!m_font || m_text.empty() || !device) {
-      m_vertexBuffer.Reset();
-      m_indexBuffer.Reset();
+    if (!m_font || m_text.empty()) {
+      m_glyphVertices.clear();
+      m_charLayouts.clear();
       m_contentWidth = 0.0f;
       m_contentHeight = 0.0f;
       return;
     }
 
-    std::vector<UIVertex> vertices;
-    std::vector<DWORD>    indices;
-
-    float  lineHeight = m_font->GetLineHeight() * m_fontSize;
-    float  penX = 0.0f;
-    float  penY = 0.0f;
-    float  maxLineWidth = 0.0f;
-    size_t numLines = 1;
+    const float lineHeight = m_font->GetLineHeight() * m_fontSize;
 
-    // Calcul de la largeur max et du nombre de lignes
-    {
-      float currentLineWidth = 0.0f;
-      for (wchar_t c : m_text) {
-        if (c == L'\n') {
-          maxLineWidth = std::max(maxLineWidth, currentLineWidth);
-          currentLineWidth = 0.0f;
-          numLines++;
-          continue;
-        }
-
-        if (!m_font->HasGlyph(c)) continue;
-        const Font::Glyph& glyph = m_font->GetGlyph(c);
-        currentLineWidth += (glyph.xAdvance * m_fontSize);
-      }
-      maxLineWidth = std::max(maxLineWidth, currentLineWidth);
-    }
-
-    m_contentWidth = maxLineWidth;
-    m_contentHeight = (numLines * lineHeight);
-
-    penX = 0.0f;
-    penY = 0.0f;
-    size_t vertexOffset = 0;
+    // Le préfixe commun garde ses glyphes : on repart de l'état du stylo mémorisé devant le
+    // premier caractère modifié (les vecteurs conservent leur capacité)
+    const size_t start = m_charLayouts.empty() ? 0 : std::min(firstChangedChar, m_charLayouts.size() - 1);
+    CharLayout   cursor = start > 0 ? m_charLayouts[start] : CharLayout{};
+    m_charLayouts.resize(start);
+    m_glyphVertices.resize(cursor.firstVertex);
 
     // Génération des vertices en coordonnées "brutes" (en pixels)
-    for (size_t i = 0; i < m_text.length(); ++i) {
-      wchar_t c = m_text[i];
+    for (size_t i = start; i < m_text.length(); ++i) {
+      m_charLayouts.push_back(cursor);
+      const wchar_t c = m_text[i];
 
       if (c == L'\n') {
-        penX = 0.0f;
-        penY += lineHeight;
+        cursor.maxLineWidth = std::max(cursor.maxLineWidth, cursor.penX);
+        cursor.penX = 0.0f;
+        cursor.line++;
         continue;
       }
 
-      if (!m_font->HasGlyph(c)) continue;
+      const Font::Glyph* glyph = m_font->GetOrAddGlyph(c);
+      if (!glyph) continue;
 
-      const Font::Glyph& glyph = m_font->GetGlyph(c);
+      // Espace d'une fonte SDF : rien dans l'atlas, seulement une avance
+      if (glyph->width <= 0.0f || glyph->height <= 0.0f) {
+        cursor.penX += glyph->xAdvance * m_fontSize;
+        continue;
+      }
 
-      float gWidth = glyph.width * m_fontSize;
-      float gHeight = glyph.height * m_fontSize;
-      float gXAdvance = glyph.xAdvance * m_fontSize;
+      float gWidth = glyph->width * m_fontSize;
+      float gHeight = glyph->height * m_fontSize;
 
-      float x0 = penX + glyph.xOffset * m_fontSize;
-      float y0 = penY + glyph.yOffset * m_fontSize;
+      float x0 = cursor.penX + glyph->xOffset * m_fontSize;
+      float y0 = cursor.line * lineHeight + glyph->yOffset * m_fontSize;
       float x1 = x0 + gWidth;
       float y1 = y0 + gHeight;
 
-      UIVertex v[4];
-      v[0].pos = XMFLOAT2(x0, y0);
-      v[0].uv = XMFLOAT2(glyph.u0, glyph.v0);
-
-      v[1].pos = XMFLOAT2(x1, y0);
-      v[1].uv = XMFLOAT2(glyph.u1, glyph.v0);
-
-      v[2].pos = XMFLOAT2(x0, y1);
-      v[2].uv = XMFLOAT2(glyph.u0, glyph.v1);
+      m_glyphVertices.push_back({XMFLOAT2(x0, y0), XMFLOAT2(glyph->u0, glyph->v0)});
+      m_glyphVertices.push_back({XMFLOAT2(x1, y0), XMFLOAT2(glyph->u1, glyph->v0)});
+      m_glyphVertices.push_back({XMFLOAT2(x0, y1), XMFLOAT2(glyph->u0, glyph->v1)});
+      m_glyphVertices.push_back({XMFLOAT2(x1, y1), XMFLOAT2(glyph->u1, glyph->v1)});
 
-      v[3].pos = XMFLOAT2(x1, y1);
-      v[3].uv = XMFLOAT2(glyph.u1, glyph.v1);
-
-      vertices.push_back(v[0]);
-      vertices.push_back(v[1]);
-      vertices.push_back(v[2]);
-      vertices.push_back(v[3]);
-
-      indices.push_back(static_cast<DWORD>(vertexOffset + 0));
-      indices.push_back(static_cast<DWORD>(vertexOffset + 1));
-      indices.push_back(static_cast<DWORD>(vertexOffset + 2));
-      indices.push_back(static_cast<DWORD>(vertexOffset + 1));
-      indices.push_back(static_cast<DWORD>(vertexOffset + 3));
-      indices.push_back(static_cast<DWORD>(vertexOffset + 2));
-
-      vertexOffset += 4;
-      penX += gXAdvance;
+      cursor.penX += glyph->xAdvance * m_fontSize;
+      cursor.firstVertex += 4;
     }
+    m_charLayouts.push_back(cursor);
 
-    if (vertices.empty()) {
-      m_vertexBuffer.Reset();
-      m_indexBuffer.Reset();
+    if (m_glyphVertices.empty()) {
+      // Aucun glyphe affichable : taille des lignes, comme pour un texte vide
+      m_contentWidth = std::max(cursor.maxLineWidth, cursor.penX);
+      m_contentHeight = (cursor.line + 1) * lineHeight;
       return;
     }
 
     // Calcul du bounding box réel basé sur les vertices générés
     float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
-    for (auto& v : vertices) {
+    for (auto& v : m_glyphVertices) {
       if (v.pos.x < minX) minX = v.pos.x;
       if (v.pos.x > maxX) maxX = v.pos.x;
       if (v.pos.y < minY) minY = v.pos.y;
       if (v.pos.y > maxY) maxY = v.pos.y;
     }
 
-    // Mise à jour de m_contentWidth et m_contentHeight si nécessaire
-    float actualWidth = maxX - minX;
-    float actualHeight = maxY - minY;
-
-    // On se base sur actualWidth / actualHeight comme dimension finale du texte
-    // afin d’être cohérent avec la normalisation qui suit
-    m_contentWidth = actualWidth;
-    m_contentHeight = actualHeight;
-
-    // Normalisation des positions dans l’espace [0,1]
-    for (auto& v : vertices) {
-      v.pos.x = (v.pos.x - minX) / m_contentWidth;
-      v.pos.y = (v.pos.y - minY) / m_contentHeight + 0.25f;
-    }
-
-    // Création des buffers
-    D3D11_BUFFER_DESC vbd = {};
-    vbd.Usage = D3D11_USAGE_DEFAULT;
-    vbd.ByteWidth = static_cast<UINT>(sizeof(UIVertex) * vertices.size());
-    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-    D3D11_SUBRESOURCE_DATA vInitData = {};
-    vInitData.pSysMem = vertices.data();
-
-    m_vertexBuffer.Reset();
-    HRESULT hr = device->CreateBuffer(&vbd, &vInitData, &m_vertexBuffer);
-    if (FAILED(hr)) {
-      ErrorLogger::Log(hr, "Failed to create vertex buffer in TextRenderer::UpdateTextGeometry");
-      return;
-    }
-
-    D3D11_BUFFER_DESC ibd = {};
-    ibd.Usage = D3D11_USAGE_DEFAULT;
-    ibd.ByteWidth = static_cast<UINT>(sizeof(DWORD) * indices.size());
-    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-    D3D11_SUBRESOURCE_DATA iInitData = {};
-    iInitData.pSysMem = indices.data();
-
-    m_indexBuffer.Reset();
-    hr = device->CreateBuffer(&ibd, &iInitData, &m_indexBuffer);
-    if (FAILED(hr)) {
-      ErrorLogger::Log(hr, "Failed to create index buffer in TextRenderer::UpdateTextGeometry");
-    }
-
+    // On se base sur la taille réelle des glyphes comme dimension finale du texte
+    // afin d’être cohérent avec la normalisation de SubmitUI
+    m_glyphOrigin = XMFLOAT2(minX, minY);
+    m_contentWidth = maxX - minX;
+    m_contentHeight = maxY - minY;
   }
-  void TextRendererComponent::Draw(ID3D11DeviceContext* deviceContext,
-                                   const XMMATRIX&      viewMatrix,
-                                   const XMMATRIX&      projectionMatrix,
-                                   RenderPass           currentPass)
-  {
-    if (!IsVisible() || !m_font || !m_vertexBuffer || !m_indexBuffer) return;
 
-    auto entity = World::GetInstance().GetEntity(GetOwner());
-    if (!entity) return;
-
-    auto transform = entity->GetComponent<TransformComponent>();
-    auto rectTransform = entity->GetComponent<RectTransformComponent>();
-    if (!transform || !rectTransform) return;
-
-    float viewportWidth = m_dispositif->GetViewportWidth();
-    float viewportHeight = m_dispositif->GetViewportHeight();
-
-    XMMATRIX uiMatrix = rectTransform->GetUITransformMatrix(transform,
-                                                            m_contentWidth,
-                                                            m_contentHeight);
-
-    XMMATRIX world = uiMatrix;
-    XMMATRIX view = XMMatrixIdentity();
-    XMMATRIX proj = XMMatrixOrthographicOffCenterLH(0.0f, viewportWidth, viewportHeight, 0.0f, 0.0f,
-                                                    1.0f);
+  void TextRendererComponent::SubmitUI(UIBatcher& batcher)
+  {
+    if (!IsVisible() || !m_font || m_glyphVertices.empty()) return;
+    if (m_contentWidth <= 0.0f || m_contentHeight <= 0.0f) return;
 
-    UpdateCommonConstantBuffers(deviceContext, world, view, proj);
+    XMMATRIX uiMatrix;
+    if (!ComputeUIMatrix(uiMatrix)) return;
 
-    auto features = GetActiveFeatures();
-    auto variant = GetTechnique()->GetVariantForPass(currentPass, features, GetVertexLayout());
+    static const FeatureMask sdfFeature = ShaderVariantManager::GetFeatureBit(SDF_TEXT_FEATURE);
+    const FeatureMask        features = GetFeatureMask() | (m_font->IsDistanceField() ? sdfFeature : 0);
+    auto variant = GetTechnique()->GetVariantForPass(RenderPass::UI, features, GetVertexLayout());
     if (!variant) return;
 
-    variant->Apply(deviceContext);
-
-    ID3D11ShaderResourceView* srv = m_font->GetAtlasSRV();
-    deviceContext->PSSetShaderResources(0, 1, &srv);
-
-    ApplyCommonUISettings(deviceContext);
-
-    UINT stride = sizeof(UIVertex);
-    UINT offset = 0;
-    deviceContext->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
-    deviceContext->IASetIndexBuffer(m_indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-    deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-    size_t glyphCount = 0;
-    for (wchar_t c : m_text) {
-      if (c != L'\n' && m_font->HasGlyph(c)) {
-        glyphCount++;
-      }
-    }
+    // Normalisation des positions dans l’espace [0,1], décalée d'un quart de ligne vers le bas
+    const XMMATRIX normalize = XMMatrixTranslation(-m_glyphOrigin.x, -m_glyphOrigin.y, 0.0f)
+                               * XMMatrixScaling(1.0f / m_contentWidth, 1.0f / m_contentHeight, 1.0f)
+                               * XMMatrixTranslation(0.0f, 0.25f, 0.0f);
 
-    deviceContext->DrawIndexed(static_cast<UINT>(glyphCount * 6), 0, 0);
+    batcher.AddQuads(variant, m_font->GetAtlasSRV(), GetClipRect(), m_glyphVertices.data(),
+                     m_glyphVertices.size() / 4, normalize * uiMatrix, m_color);
   }
 
 
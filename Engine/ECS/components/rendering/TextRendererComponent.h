@@ -1,19 +1,16 @@
 #pragma once
 #include "UIBaseRendererComponent.h"
 #include <string>
+#include <vector>
 #include <DirectXMath.h>
 #include <wrl/client.h>
 #include "Engine/DispositifD3D11.h"
 #include "Engine/Font/Font.h"
+#include "Engine/ECS/systems/rendering/UIBatcher.h"
 #include "Engine/Shaders/techniques/TextTechnique.h"
 
 namespace FrostFireEngine
 {
-  struct UIVertex {
-    XMFLOAT2 pos;
-    XMFLOAT2 uv;
-  };
-
   class TextRendererComponent : public UIBaseRendererComponent {
   public:
     TextRendererComponent(DispositifD3D11* dispositif);
@@ -49,7 +46,7 @@ namespace FrostFireEngine
     XMFLOAT2 SetFontSize(float size)
     {
       m_fontSize = size;
-      UpdateTextGeometry(m_dispositif->GetD3DDevice());
+      UpdateContent();
       return { m_contentWidth, m_contentHeight };
     }
     float GetFontSize() const
@@ -57,10 +54,7 @@ namespace FrostFireEngine
       return m_fontSize;
     }
 
-    void Draw(ID3D11DeviceContext* deviceContext,
-              const XMMATRIX&      viewMatrix,
-              const XMMATRIX&      projectionMatrix,
-              RenderPass           currentPass) override;
+    void SubmitUI(UIBatcher& batcher) override;
 
     const VertexLayoutDesc& GetVertexLayout() const override;
     ShaderTechnique*        GetTechnique() const override;
@@ -74,11 +68,18 @@ namespace FrostFireEngine
       return m_contentHeight;
     }
 
-  protected:
-    bool InitializeConstantBuffers(ID3D11Device* device) override;
-
   private:
-    void UpdateTextGeometry(ID3D11Device* device);
+    // État du stylo avant un caractère : reprise de la mise en page au premier caractère modifié
+    struct CharLayout {
+      float    penX = 0.0f;
+      float    maxLineWidth = 0.0f;  // des lignes déjà terminées
+      uint32_t line = 0;
+      uint32_t firstVertex = 0;
+    };
+
+    void UpdateTextGeometry(size_t firstChangedChar = 0);
+    // UpdateTextGeometry, puis signale au layout une nouvelle taille de contenu
+    void UpdateContent(size_t firstChangedChar = 0);
 
     Font*        m_font = nullptr;
     std::wstring m_text;
@@ -86,8 +87,11 @@ namespace FrostFireEngine
     float        m_contentHeight = 0.0f;
     float        m_fontSize = 6.0f;
 
-    ComPtr<ID3D11Buffer> m_vertexBuffer;
-    ComPtr<ID3D11Buffer> m_indexBuffer;
+    // Quads des glyphes en pixels ; la normalisation dans [0,1] est appliquée par la matrice
+    // de SubmitUI, un texte qui change de taille ne touche donc pas aux glyphes inchangés
+    std::vector<UIQuadVertex> m_glyphVertices;
+    std::vector<CharLayout>   m_charLayouts;  // m_text.size() + 1 entrées
+    XMFLOAT2                  m_glyphOrigin = {0.0f, 0.0f};
 
     DispositifD3D11* m_dispositif = nullptr;
     VertexLayoutDesc m_layout;
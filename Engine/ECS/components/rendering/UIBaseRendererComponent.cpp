@@ -1,54 +1,29 @@
 ﻿#include "UIBaseRendererComponent.h"
-#include "Engine/Utils/ErrorLogger.h"
-
-struct UIColorCBuffer {
-  XMFLOAT4 color;
-};
+#include "Engine/ECS/core/World.h"
+#include "Engine/ECS/components/transform/TransformComponent.h"
+#include "Engine/ECS/components/transform/RectTransformComponent.h"
 
 using namespace FrostFireEngine;
 
-bool UIBaseRendererComponent::InitializeConstantBuffers(ID3D11Device* device)
+bool UIBaseRendererComponent::ComputeUIMatrix(XMMATRIX& uiMatrix) const
 {
-  if (!BaseRendererComponent::InitializeConstantBuffers(device)) return false;
-
-  D3D11_BUFFER_DESC cbd = {};
-  cbd.Usage = D3D11_USAGE_DEFAULT;
-  cbd.ByteWidth = sizeof(UIColorCBuffer);
-  cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-
-  if (FAILED(device->CreateBuffer(&cbd, nullptr, &m_colorBuffer))) {
-    ErrorLogger::Log("UIBaseRendererComponent: Failed to create color constant buffer.");
-    return false;
-  }
-
-  D3D11_SAMPLER_DESC samplerDesc = {};
-  samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-  samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
-  samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
-  samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+  auto entity = World::GetInstance().GetEntity(GetOwner());
+  if (!entity) return false;
 
-  if (FAILED(device->CreateSamplerState(&samplerDesc, &m_samplerState))) {
-    ErrorLogger::Log("UIBaseRendererComponent: Failed to create sampler state.");
-    return false;
-  }
+  // Calculée par UILayoutSystem avant le rendu, avec le contenu courant de ce renderer
+  auto rectTransform = entity->GetComponent<RectTransformComponent>();
+  if (!rectTransform || !rectTransform->HasLayout()) return false;
 
+  uiMatrix = XMLoadFloat4x4(&rectTransform->GetLayout().uiMatrix);
   return true;
 }
 
-void UIBaseRendererComponent::UpdateCommonConstantBuffers(ID3D11DeviceContext* deviceContext,
-                                                          const XMMATRIX&      worldMatrix,
-                                                          const XMMATRIX&      viewMatrix,
-                                                          const XMMATRIX&      projMatrix) const
+void UIBaseRendererComponent::RequestLayout() const
 {
-  UpdateConstantBuffers(deviceContext, worldMatrix, viewMatrix, projMatrix);
-
-  UIColorCBuffer data;
-  data.color = m_color;
-  deviceContext->UpdateSubresource(m_colorBuffer.Get(), 0, nullptr, &data, 0, 0);
-}
-
-void UIBaseRendererComponent::ApplyCommonUISettings(ID3D11DeviceContext* deviceContext)
-{
-  deviceContext->PSSetConstantBuffers(1, 1, m_colorBuffer.GetAddressOf());
-  deviceContext->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
+  if (GetOwner() == INVALID_ENTITY_ID) return;
+  if (auto entity = World::GetInstance().GetEntity(GetOwner())) {
+    if (auto rectTransform = entity->GetComponent<RectTransformComponent>()) {
+      rectTransform->RequestLayout();
+    }
+  }
 }
@@ -8,6 +8,8 @@ using namespace DirectX;
 
 namespace FrostFireEngine
 {
+  class UIBatcher;
+
   class UIBaseRendererComponent : public BaseRendererComponent {
   public:
     UIBaseRendererComponent() = default;
@@ -17,15 +19,44 @@ namespace FrostFireEngine
     virtual float GetContentWidth() const = 0;
     virtual float GetContentHeight() const = 0;
 
-  protected:
-    bool InitializeConstantBuffers(ID3D11Device* device) override;
+    // Ajoute les quads de l'élément au lot de la frame (RenderingSystem::RenderUI)
+    virtual void SubmitUI(UIBatcher& batcher) = 0;
+
+    // Le contenu de l'élément arrive avec son renderer
+    void OnAttach() override
+    {
+      RequestLayout();
+    }
 
-    void UpdateCommonConstantBuffers(ID3D11DeviceContext* deviceContext,
-                                     const XMMATRIX&      worldMatrix,
-                                     const XMMATRIX&      viewMatrix,
-                                     const XMMATRIX&      projMatrix) const;
+    // L'interface n'est pas dessinée élément par élément : tout passe par SubmitUI
+    void Draw(ID3D11DeviceContext* deviceContext,
+              const XMMATRIX&      viewMatrix,
+              const XMMATRIX&      projectionMatrix,
+              RenderPass           currentPass) override
+    {
+    }
+
+    // Rectangle de découpe en pixels écran ; les enfants ne l'héritent pas
+    void SetClipRect(const D3D11_RECT& rect)
+    {
+      m_clipRect = rect;
+      m_hasClipRect = true;
+    }
+    void ClearClipRect()
+    {
+      m_hasClipRect = false;
+    }
+    const D3D11_RECT* GetClipRect() const
+    {
+      return m_hasClipRect ? &m_clipRect : nullptr;
+    }
+
+  protected:
+    // Matrice espace local [0,1] -> pixels écran du RectTransform de l'entité
+    bool ComputeUIMatrix(XMMATRIX& uiMatrix) const;
 
-    void ApplyCommonUISettings(ID3D11DeviceContext* deviceContext);
+    // Taille de contenu modifiée : UILayoutSystem repasse par le RectTransform de l'entité
+    void RequestLayout() const;
 
     UIBaseRendererComponent(const UIBaseRendererComponent&) = delete;
     UIBaseRendererComponent& operator=(const UIBaseRendererComponent&) = delete;
@@ -33,8 +64,8 @@ namespace FrostFireEngine
     UIBaseRendererComponent(UIBaseRendererComponent&&) = default;
     UIBaseRendererComponent& operator=(UIBaseRendererComponent&&) = default;
 
-    ComPtr<ID3D11Buffer>       m_colorBuffer;
-    ComPtr<ID3D11SamplerState> m_samplerState;
-    XMFLOAT4                   m_color = XMFLOAT4(1, 1, 1, 1);
+    XMFLOAT4   m_color = XMFLOAT4(1, 1, 1, 1);
+    D3D11_RECT m_clipRect = {};
+    bool       m_hasClipRect = false;
   };
 }
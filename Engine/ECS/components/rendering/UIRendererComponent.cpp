@@ -1,8 +1,6 @@
 ﻿#include "UIRendererComponent.h"
 #include "UIBaseRendererComponent.h"
-#include "Engine/ECS/core/World.h"
-#include "Engine/ECS/components/transform/TransformComponent.h"
-#include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "Engine/ECS/systems/rendering/UIBatcher.h"
 #include "Engine/Texture.h"
 #include "Engine/TextureManager.h"
 #include "Engine/Shaders/techniques/GlobaleTechnique.h"
@@ -14,16 +12,21 @@ using namespace DirectX;
 
 REGISTER_INHERITANCE(UIRendererComponent, UIBaseRendererComponent)
 
-VertexLayoutDesc UIRendererComponent::CreateUILayout()
+namespace
 {
-  VertexLayoutDesc         layoutDesc;
-  D3D11_INPUT_ELEMENT_DESC posElement = {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 0,
-    D3D11_INPUT_PER_VERTEX_DATA, 0};
-  D3D11_INPUT_ELEMENT_DESC uvElement = {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 8,
-    D3D11_INPUT_PER_VERTEX_DATA, 0};
+  // Quad unitaire, mis à la taille de l'élément par la matrice du RectTransform
+  const UIQuadVertex QUAD_VERTICES[4] = {
+    {{0.0f, 0.0f}, {0.0f, 0.0f}},
+    {{1.0f, 0.0f}, {1.0f, 0.0f}},
+    {{0.0f, 1.0f}, {0.0f, 1.0f}},
+    {{1.0f, 1.0f}, {1.0f, 1.0f}}
+  };
+}
 
-  layoutDesc.elements.push_back(posElement);
-  layoutDesc.elements.push_back(uvElement);
+VertexLayoutDesc UIRendererComponent::CreateUILayout()
+{
+  VertexLayoutDesc layoutDesc;
+  layoutDesc.elements.assign(std::begin(UIVertexLayout), std::end(UIVertexLayout));
   return layoutDesc;
 }
 
@@ -33,52 +36,10 @@ UIRendererComponent::UIRendererComponent(const DispositifD3D11* dispositif)
   m_layout = CreateUILayout();
   auto technique = std::make_unique<GlobaleTechnique>();
   SetTechnique(std::move(technique));
-
-  UIRendererComponent::InitializeConstantBuffers(dispositif->GetD3DDevice());
-  CreateQuadGeometry(dispositif->GetD3DDevice());
 }
 
 UIRendererComponent::~UIRendererComponent() = default;
 
-bool UIRendererComponent::InitializeConstantBuffers(ID3D11Device* device)
-{
-  // Appel à la classe de base UIBaseRendererComponent qui gère déjà colorBuffer + sampler
-  return UIBaseRendererComponent::InitializeConstantBuffers(device);
-}
-
-void UIRendererComponent::CreateQuadGeometry(ID3D11Device* device)
-{
-  UIVertex vertices[4] = {
-    {{0.0f, 0.0f}, {0.0f, 0.0f}},
-    {{1.0f, 0.0f}, {1.0f, 0.0f}},
-    {{1.0f, 1.0f}, {1.0f, 1.0f}},
-    {{0.0f, 1.0f}, {0.0f, 1.0f}}
-  };
-
-  D3D11_BUFFER_DESC vbd = {};
-  vbd.Usage = D3D11_USAGE_DEFAULT;
-  vbd.ByteWidth = static_cast<UINT>(sizeof(vertices));
-  vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-  D3D11_SUBRESOURCE_DATA initData = {};
-  initData.pSysMem = vertices;
-
-  if (FAILED(device->CreateBuffer(&vbd, &initData, &m_vertexBuffer))) {
-    ErrorLogger::Log("UIRendererComponent: Failed to create vertex buffer.");
-  }
-
-  DWORD             indices[6] = {0, 1, 2, 0, 2, 3};
-  D3D11_BUFFER_DESC ibd = {};
-  ibd.Usage = D3D11_USAGE_DEFAULT;
-  ibd.ByteWidth = sizeof(indices);
-  ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-
-  initData.pSysMem = indices;
-  if (FAILED(device->CreateBuffer(&ibd, &initData, &m_indexBuffer))) {
-    ErrorLogger::Log("UIRendererComponent: Failed to create index buffer.");
-  }
-}
-
 const VertexLayoutDesc& UIRendererComponent::GetVertexLayout() const
 {
   return m_layout;
@@ -100,45 +61,24 @@ void UIRendererComponent::SetTexture(Texture* texture)
     m_contentWidth = 0.0f;
     m_contentHeight = 0.0f;
   }
+  RequestLayout();
 }
 
-void UIRendererComponent::Draw(ID3D11DeviceContext* deviceContext,
-                               const XMMATRIX&      viewMatrix,
-                               const XMMATRIX&      projectionMatrix,
-                               RenderPass           currentPass)
+void UIRendererComponent::SubmitUI(UIBatcher& batcher)
 {
   if (!IsVisible()) return;
 
-  auto entity = World::GetInstance().GetEntity(GetOwner());
-  if (!entity) return;
-
-  auto transform = entity->GetComponent<TransformComponent>();
-  auto rectTransform = entity->GetComponent<RectTransformComponent>();
-  if (!transform || !rectTransform) return;
+  XMMATRIX uiMatrix;
+  if (!ComputeUIMatrix(uiMatrix)) return;
 
-  float viewportWidth = m_dispositif->GetViewportWidth();
-  float viewportHeight = m_dispositif->GetViewportHeight();
-
-  XMMATRIX uiMatrix = rectTransform->GetUITransformMatrix(transform,
-                                                          m_contentWidth,
-                                                          m_contentHeight);
-
-
-  XMMATRIX world = uiMatrix;
-  XMMATRIX view = XMMatrixIdentity();
-  XMMATRIX proj = XMMatrixOrthographicOffCenterLH(0.0f, viewportWidth, viewportHeight, 0.0f, 0.0f,
-                                                  1.0f);
-
-  UpdateCommonConstantBuffers(deviceContext, world, view, proj);
-
-  auto features = GetActiveFeatures();
-  auto variant = GetTechnique()->GetVariantForPass(currentPass, features, GetVertexLayout());
+  auto variant = GetTechnique()->GetVariantForPass(RenderPass::UI, GetFeatureMask(), GetVertexLayout());
   if (!variant) {
     ErrorLogger::Log("UIRendererComponent: No UI shader variant found.");
     return;
   }
 
-  variant->Apply(deviceContext);
+  // Les éléments d'interface sont affichés en pleine résolution
+  if (m_texture) m_texture->RequestScreenSize(1.0f);
 
   auto&                     texManager = TextureManager::GetInstance();
   Texture*                  fallbackTex = texManager.GetTexture(L"__white_fallback__");
@@ -146,15 +86,5 @@ void UIRendererComponent::Draw(ID3D11DeviceContext* deviceContext,
                                     ? m_texture->GetShaderResourceView().Get()
                                     : fallbackTex->GetShaderResourceView().Get();
 
-  deviceContext->PSSetShaderResources(0, 1, &srv);
-
-  ApplyCommonUISettings(deviceContext);
-
-  UINT stride = sizeof(UIVertex);
-  UINT offset = 0;
-  deviceContext->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
-  deviceContext->IASetIndexBuffer(m_indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-  deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-  deviceContext->DrawIndexed(6, 0, 0);
+  batcher.AddQuads(variant, srv, GetClipRect(), QUAD_VERTICES, 1, uiMatrix, m_color);
 }
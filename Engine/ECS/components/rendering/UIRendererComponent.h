@@ -16,10 +16,7 @@ namespace FrostFireEngine
     UIRendererComponent(const DispositifD3D11* dispositif);
     ~UIRendererComponent() override;
 
-    void Draw(ID3D11DeviceContext* deviceContext,
-              const XMMATRIX&      viewMatrix,
-              const XMMATRIX&      projectionMatrix,
-              RenderPass           currentPass) override;
+    void SubmitUI(UIBatcher& batcher) override;
 
     const VertexLayoutDesc& GetVertexLayout() const override;
     ShaderTechnique*        GetTechnique() const override;
@@ -45,17 +42,8 @@ namespace FrostFireEngine
     UIRendererComponent(const UIRendererComponent&) = delete;
     UIRendererComponent& operator=(const UIRendererComponent&) = delete;
 
-  protected:
-    bool InitializeConstantBuffers(ID3D11Device* device) override;
-
   private:
-    struct UIVertex {
-      XMFLOAT2 pos;
-      XMFLOAT2 uv;
-    };
-
     static VertexLayoutDesc CreateUILayout();
-    void                    CreateQuadGeometry(ID3D11Device* device);
 
     Texture* m_texture = nullptr;
     float    m_contentWidth = 0.0f;
@@ -63,7 +51,5 @@ namespace FrostFireEngine
 
     const DispositifD3D11* m_dispositif = nullptr;
     VertexLayoutDesc       m_layout;
-    ComPtr<ID3D11Buffer>   m_vertexBuffer;
-    ComPtr<ID3D11Buffer>   m_indexBuffer;
   };
 }
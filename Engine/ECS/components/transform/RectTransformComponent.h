@@ -1,11 +1,13 @@
 #pragma once
 #include "TransformComponent.h"
 #include <DirectXMath.h>
+#include <cfloat>
 #include <unordered_set>
 #include "Engine/ECS/core/World.h"
 #include "Engine/ECS/core/Entity.h"
 #include "Engine/DispositifD3D11.h"
 #include "Engine/ECS/core/Component.h"
+#include "Engine/ECS/systems/UILayoutSystem.h"
 
 namespace FrostFireEngine
 {
@@ -31,6 +33,13 @@ namespace FrostFireEngine
     Stretch
   };
 
+  // Résultat d'une mise à jour de layout : Frame impose de recalculer les enfants
+  enum class RectLayoutChange {
+    None,
+    Content,  // seule la taille du contenu a changé, uiMatrix recalculée
+    Frame
+  };
+
   class RectTransformComponent : public Component {
   public:
     RectTransformComponent(DispositifD3D11* dispositif)
@@ -47,26 +56,32 @@ namespace FrostFireEngine
     void SetAnchor(RectAnchorPreset anchor)
     {
       anchor_ = anchor;
+      MarkLayoutDirty();
     }
     void SetSizingMode(RectSizingMode mode)
     {
       sizingMode_ = mode;
+      MarkLayoutDirty();
     }
     void SetAnchorOffset(const XMFLOAT2& offset)
     {
       anchorOffset_ = offset;
+      MarkLayoutDirty();
     }
     void SetScale(const XMFLOAT2& scale)
     {
       scale_ = scale;
+      MarkLayoutDirty();
     }
     void SetSize(const XMFLOAT2& size)
     {
       size_ = size;
+      MarkLayoutDirty();
     }
     void SetPivotPoint(const XMFLOAT2& pivot)
     {
       pivotPoint_ = pivot;
+      MarkLayoutDirty();
     }
 
     RectAnchorPreset GetAnchor() const
@@ -94,65 +109,127 @@ namespace FrostFireEngine
       return pivotPoint_;
     }
 
-    XMMATRIX GetUITransformMatrix(TransformComponent* transform,
-                                  float               contentWidth,
-                                  float               contentHeight,
-                                  bool                first = true) const
+    // Layout calculé par UILayoutSystem, en pixels écran
+    struct RectLayout {
+      XMFLOAT4X4 uiMatrix;     // quad unité [0,1]² de l'élément -> écran, pour le rendu
+      XMFLOAT4X4 childMatrix;  // repère transmis aux enfants
+      XMFLOAT2   childSize;    // taille de référence des enfants (ancrage, Stretch, Fit*)
+      XMFLOAT4   screenRect;   // left, top, right, bottom : boîte englobante de uiMatrix
+    };
+
+    void OnAttach() override
     {
-      const RectTransformComponent* parentRect = GetParentRectTransform();
-      float                         parentWidth = 0.0f;
-      float                         parentHeight = 0.0f;
-      if (parentRect) {
-        parentRect->GetFinalSizeForChild(parentWidth, parentHeight);
-      }
-      else {
-        parentWidth = dispositif_->GetViewportWidth();
-        parentHeight = dispositif_->GetViewportHeight();
-      }
+      RequestLayout();
+    }
 
-      float finalWidth = 0.0f;
-      float finalHeight = 0.0f;
-      ComputeFinalSize(contentWidth, contentHeight, finalWidth, finalHeight);
+    // Force le recalcul de l'élément et de ses descendants au prochain passage de UILayoutSystem
+    void MarkLayoutDirty()
+    {
+      layoutDirty_ = true;
+      RequestLayout();
+    }
 
-      XMFLOAT2 anchorPoint = ComputeAnchorPoint(parentWidth, parentHeight);
-      float    posX = anchorPoint.x + anchorOffset_.x;
-      float    posY = anchorPoint.y + anchorOffset_.y;
-      float    pivotOffsetX = pivotPoint_.x * finalWidth;
-      float    pivotOffsetY = pivotPoint_.y * finalHeight;
-      /*posX -= pivotOffsetX;
-      posY -= pivotOffsetY;*/
+    // Demande à UILayoutSystem de repasser par l'élément (rotation, parent ou contenu changés) :
+    // UpdateLayout décide s'il faut recalculer. Les ancêtres sont marqués jusqu'à la racine, mise en
+    // file ; la passe saute les sous-arbres non marqués. On s'arrête au premier ancêtre déjà marqué.
+    void RequestLayout()
+    {
+      layoutPending_ = true;
+      if (owner == INVALID_ENTITY_ID) return;
 
-      if (parentRect) {
-        XMMATRIX pivotTrans = XMMatrixTranslation(-pivotOffsetX, -pivotOffsetY, 0.0f);
-        XMMATRIX rot = XMMatrixRotationZ(transform->GetRotationEuler().z);
-        XMMATRIX localMatrix = first
-                                 ? XMMatrixScaling(scale_.x * finalWidth, scale_.y * finalHeight,
-                                                   1.0f) * pivotTrans
-                                 * rot *  XMMatrixTranslation(posX + pivotOffsetX, posY + pivotOffsetY, 0.0f)
-                                 : XMMatrixScaling(scale_.x, scale_.y, 1.0f) * pivotTrans
-                                 * rot * XMMatrixTranslation(posX + pivotOffsetX, posY + pivotOffsetY, 0.0f);
+      EntityId root = owner;
+      for (RectTransformComponent* parent = GetParentRect(owner); parent; parent = GetParentRect(parent->owner)) {
+        if (parent->layoutPending_) return;
+        parent->layoutPending_ = true;
+        root = parent->owner;
+      }
+      UILayoutSystem::QueueLayoutRoot(root);
+    }
+    bool IsLayoutPending() const
+    {
+      return layoutPending_;
+    }
+    bool HasLayout() const
+    {
+      return hasLayout_;
+    }
+    const RectLayout& GetLayout() const
+    {
+      return layout_;
+    }
 
-       
-        auto parentTransform = GetParentTransform();
+    // Test contre la boîte englobante de la dernière frame affichée
+    bool ContainsPoint(float x, float y) const
+    {
+      const XMFLOAT4& r = layout_.screenRect;
+      return hasLayout_ && x >= r.x && x <= r.z && y >= r.y && y <= r.w;
+    }
 
-        XMMATRIX parentMatrix = parentRect->GetUITransformMatrix(
-          parentTransform, parentWidth, parentHeight, false);
-        return localMatrix * parentMatrix;
+    // Appelé par UILayoutSystem de la racine vers les feuilles : parent est déjà à jour.
+    // Ne recalcule que si l'élément, son parent, sa rotation ou son contenu ont changé ;
+    // parentChanged indique que le parent a renvoyé RectLayoutChange::Frame.
+    RectLayoutChange UpdateLayout(const RectTransformComponent* parent,
+                                  const TransformComponent&     transform,
+                                  float                         viewportWidth,
+                                  float                         viewportHeight,
+                                  float                         contentWidth,
+                                  float                         contentHeight,
+                                  bool                          parentChanged)
+    {
+      layoutPending_ = false;
+
+      const float rotationZ = transform.GetRotationEuler().z;
+      const bool  frameChanged = parentChanged || layoutDirty_ || !hasLayout_ || rotationZ != layoutRotationZ_ ||
+                                 transform.GetParent() != layoutParent_;
+      if (!frameChanged && contentWidth == layoutContent_.x && contentHeight == layoutContent_.y) {
+        return RectLayoutChange::None;
       }
 
-      else {
-        XMMATRIX rot = XMMatrixRotationZ(transform->GetRotationEuler().z);
-        XMMATRIX uiMatrix = first
-                              ? XMMatrixScaling(scale_.x * finalWidth, scale_.y * finalHeight, 1.0f)
-                              * rot * XMMatrixTranslation(posX, posY, 0.0f)
-                              : XMMatrixScaling(scale_.x, scale_.y, 1.0f)
-                              * rot * XMMatrixTranslation(posX, posY, 0.0f);
+      const float    parentWidth = parent ? parent->layout_.childSize.x : viewportWidth;
+      const float    parentHeight = parent ? parent->layout_.childSize.y : viewportHeight;
+      const XMMATRIX parentMatrix = parent ? XMLoadFloat4x4(&parent->layout_.childMatrix) : XMMatrixIdentity();
+      const XMFLOAT2 anchorPoint = ComputeAnchorPoint(parentWidth, parentHeight);
+      const XMFLOAT2 position(anchorPoint.x + anchorOffset_.x, anchorPoint.y + anchorOffset_.y);
 
-      
-        
+      if (frameChanged) {
+        // Taille de référence des enfants : size_, 100 px par défaut
+        const float childContentWidth = (size_.x > 0.0f) ? size_.x : 100.0f;
+        const float childContentHeight = (size_.y > 0.0f) ? size_.y : 100.0f;
+        ComputeFinalSize(childContentWidth, childContentHeight, parentWidth, parentHeight,
+                         layout_.childSize.x, layout_.childSize.y);
 
-        return  uiMatrix;
+        float finalWidth = 0.0f;
+        float finalHeight = 0.0f;
+        ComputeFinalSize(layout_.childSize.x, layout_.childSize.y, parentWidth, parentHeight, finalWidth, finalHeight);
+        XMStoreFloat4x4(&layout_.childMatrix,
+                        ComputeLocalMatrix(scale_.x, scale_.y, finalWidth, finalHeight, rotationZ, position,
+                                           parent != nullptr) * parentMatrix);
       }
+
+      float finalWidth = 0.0f;
+      float finalHeight = 0.0f;
+      ComputeFinalSize(contentWidth, contentHeight, parentWidth, parentHeight, finalWidth, finalHeight);
+      const XMMATRIX uiMatrix = ComputeLocalMatrix(scale_.x * finalWidth, scale_.y * finalHeight, finalWidth,
+                                                   finalHeight, rotationZ, position, parent != nullptr) * parentMatrix;
+      XMStoreFloat4x4(&layout_.uiMatrix, uiMatrix);
+
+      const XMFLOAT2 corners[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}};
+      XMVECTOR       minCorner = XMVectorReplicate(FLT_MAX);
+      XMVECTOR       maxCorner = XMVectorReplicate(-FLT_MAX);
+      for (const XMFLOAT2& corner : corners) {
+        const XMVECTOR point = XMVector2Transform(XMLoadFloat2(&corner), uiMatrix);
+        minCorner = XMVectorMin(minCorner, point);
+        maxCorner = XMVectorMax(maxCorner, point);
+      }
+      layout_.screenRect = XMFLOAT4(XMVectorGetX(minCorner), XMVectorGetY(minCorner),
+                                    XMVectorGetX(maxCorner), XMVectorGetY(maxCorner));
+
+      layoutContent_ = XMFLOAT2(contentWidth, contentHeight);
+      layoutRotationZ_ = rotationZ;
+      layoutParent_ = transform.GetParent();
+      layoutDirty_ = false;
+      hasLayout_ = true;
+      return frameChanged ? RectLayoutChange::Frame : RectLayoutChange::Content;
     }
 
   private:
@@ -164,46 +241,56 @@ namespace FrostFireEngine
     XMFLOAT2         size_;
     XMFLOAT2         pivotPoint_;
 
-    const RectTransformComponent* GetParentRectTransform() const
+    // Résultat de la dernière passe et les entrées qui ne passent pas par un setter
+    RectLayout layout_ = {};
+    XMFLOAT2   layoutContent_ = {0.0f, 0.0f};
+    float      layoutRotationZ_ = 0.0f;
+    EntityId   layoutParent_ = INVALID_ENTITY_ID;
+    bool       layoutDirty_ = true;
+    bool       layoutPending_ = false;  // l'élément ou un descendant attend UILayoutSystem
+    bool       hasLayout_ = false;
+
+    // RectTransform du parent, nul pour une racine (sans parent ou parent hors interface)
+    static RectTransformComponent* GetParentRect(EntityId id)
     {
-      auto entity = World::GetInstance().GetEntity(owner);
+      const World& world = World::GetInstance();
+      const auto   entity = world.GetEntity(id);
       if (!entity) return nullptr;
-      auto transform = entity->GetComponent<TransformComponent>();
-      if (!transform) return nullptr;
-      EntityId p = transform->GetParent();
-      if (p == INVALID_ENTITY_ID) return nullptr;
-      auto parentEntity = World::GetInstance().GetEntity(p);
-      if (!parentEntity) return nullptr;
-      return parentEntity->GetComponent<RectTransformComponent>();
+
+      const auto* transform = entity->GetComponent<TransformComponent>();
+      if (!transform || transform->GetParent() == INVALID_ENTITY_ID) return nullptr;
+
+      const auto parentEntity = world.GetEntity(transform->GetParent());
+      return parentEntity ? parentEntity->GetComponent<RectTransformComponent>() : nullptr;
     }
 
-     TransformComponent *GetParentTransform() const {
-      auto entity = World::GetInstance().GetEntity(owner);
-      if (!entity) return nullptr;
-      auto transform = entity->GetComponent<TransformComponent>();
-      if (!transform) return nullptr;
-      EntityId p = transform->GetParent();
-      if (p == INVALID_ENTITY_ID) return nullptr;
-      auto parentEntity = World::GetInstance().GetEntity(p);
-      if (!parentEntity) return nullptr;
-      return parentEntity->GetComponent<TransformComponent>();
+    // Le pivot ne s'applique que sous un parent : une racine est placée par son coin haut-gauche
+    XMMATRIX ComputeLocalMatrix(float           scaleX,
+                                float           scaleY,
+                                float           finalWidth,
+                                float           finalHeight,
+                                float           rotationZ,
+                                const XMFLOAT2& position,
+                                bool            hasParent) const
+    {
+      const XMMATRIX rot = XMMatrixRotationZ(rotationZ);
+      if (!hasParent) {
+        return XMMatrixScaling(scaleX, scaleY, 1.0f) * rot * XMMatrixTranslation(position.x, position.y, 0.0f);
+      }
+
+      const float pivotOffsetX = pivotPoint_.x * finalWidth;
+      const float pivotOffsetY = pivotPoint_.y * finalHeight;
+      return XMMatrixScaling(scaleX, scaleY, 1.0f) * XMMatrixTranslation(-pivotOffsetX, -pivotOffsetY, 0.0f)
+             * rot * XMMatrixTranslation(position.x + pivotOffsetX, position.y + pivotOffsetY, 0.0f);
     }
 
     void ComputeFinalSize(float  contentWidth,
                           float  contentHeight,
+                          float  parentWidth,
+                          float  parentHeight,
                           float& outWidth,
                           float& outHeight) const
     {
-      float parentWidth = 0.0f;
-      float parentHeight = 0.0f;
-      if (auto parentRect = GetParentRectTransform()) {
-        parentRect->GetFinalSizeForChild(parentWidth, parentHeight);
-      }
-      else {
-        parentWidth = dispositif_->GetViewportWidth();
-        parentHeight = dispositif_->GetViewportHeight();
-      }
-
       switch (sizingMode_) {
         case RectSizingMode::Stretch:
           outWidth = parentWidth;
@@ -297,12 +384,5 @@ namespace FrostFireEngine
       }
       return XMFLOAT2(anchorX, anchorY);
     }
-
-    void GetFinalSizeForChild(float& outWidth, float& outHeight) const
-    {
-      float contentWidth = (size_.x > 0.0f) ? size_.x : 100.0f;
-      float contentHeight = (size_.y > 0.0f) ? size_.y : 100.0f;
-      ComputeFinalSize(contentWidth, contentHeight, outWidth, outHeight);
-    }
   };
 }
@@ -3,6 +3,7 @@
 #include "Engine/ECS/components/physics/ColliderComponent.h"
 #include "Engine/ECS/components/physics/RigidBodyComponent.h"
 #include "Engine/ECS/components/rendering/PBRRenderer.h"
+#include "Engine/ECS/components/transform/RectTransformComponent.h"
 
 namespace FrostFireEngine
 {
@@ -19,8 +20,19 @@ namespace FrostFireEngine
 
     return *this;
   }
+  void TransformComponent::RequestUILayout() const
+  {
+    if (owner == INVALID_ENTITY_ID) return;
+    if (const auto ownerEntity = World::GetInstance().GetEntity(owner)) {
+      if (auto rectTransform = ownerEntity->GetComponent<RectTransformComponent>()) {
+        rectTransform->RequestLayout();
+      }
+    }
+  }
+
   void TransformComponent::MarkDirty() const
   {
+    ++changeVersion;
     if (!isDirty) {
       isDirty = true;
       cachedLocalMatrix.reset();
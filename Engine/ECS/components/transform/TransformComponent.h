@@ -46,6 +46,7 @@ namespace FrostFireEngine
       AddChildInternal(childId);
       childTransform->parent = owner;
       childTransform->MarkDirty();
+      childTransform->RequestUILayout();
     }
 
     void RemoveChild(EntityId childId)
@@ -64,6 +65,7 @@ namespace FrostFireEngine
       if (childTransform->GetParent() == owner) {
         childTransform->parent = INVALID_ENTITY_ID;
         childTransform->MarkDirty();
+        childTransform->RequestUILayout();
       }
     }
 
@@ -91,6 +93,7 @@ namespace FrostFireEngine
           }
         }
       }
+      RequestUILayout();
     }
 
     EntityId GetParent() const
@@ -319,10 +322,18 @@ namespace FrostFireEngine
 
       XMStoreFloat4(&rotation, quatRotation);
       MarkDirty();
+      RequestUILayout();
 
       return *this;
     }
 
+    // Incrémenté à chaque invalidation (y compris via un parent), permet aux
+    // systèmes de détecter un déplacement sans relire la matrice
+    uint32_t GetChangeVersion() const
+    {
+      return changeVersion;
+    }
+
   private:
     void NormalizeRotation()
     {
@@ -330,6 +341,7 @@ namespace FrostFireEngine
       quatVec = XMQuaternionNormalize(quatVec);
       XMStoreFloat4(&rotation, quatVec);
       MarkDirty();
+      RequestUILayout();
     }
 
     void AddChildInternal(EntityId childId)
@@ -350,6 +362,9 @@ namespace FrostFireEngine
 
     void MarkDirty() const;
 
+    // Rotation ou parent changés : le RectTransform de l'entité, s'il existe, attend UILayoutSystem
+    void RequestUILayout() const;
+
 
     // Helper function to get world rotation quaternion
     XMVECTOR GetWorldRotationQuaternion() const
@@ -376,6 +391,7 @@ namespace FrostFireEngine
     EntityId                        parent{INVALID_ENTITY_ID};
     std::vector<EntityId>           children;
     mutable bool                    isDirty{true};
+    mutable uint32_t                changeVersion{0};
     mutable std::optional<XMMATRIX> cachedLocalMatrix;
     mutable std::optional<XMMATRIX> cachedWorldMatrix;
   };
@@ -134,6 +134,24 @@ namespace FrostFireEngine
       }
     }
 
+    // Change dès qu'un composant T (ou dérivé) est ajouté ou retiré
+    template <typename T>
+    size_t GetComponentVersion() const
+    {
+      auto it = g_inheritanceMap.find(std::type_index(typeid(T)));
+      if (it == g_inheritanceMap.end()) {
+        return GetComponentPool<T>().GetVersion();
+      }
+
+      size_t version = 0;
+      for (auto derivedID : it->second) {
+        if (derivedID < componentPools.size() && componentPools[derivedID]) {
+          version += componentPools[derivedID]->GetVersion();
+        }
+      }
+      return version;
+    }
+
     template <typename T>
     std::span<T*> GetAllComponents()
     {
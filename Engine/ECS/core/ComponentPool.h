@@ -20,6 +20,7 @@ namespace FrostFireEngine
     virtual void        Clear() noexcept = 0;
     virtual void*       GetVoidPtr(EntityId entityId) noexcept = 0;
     virtual const void* GetVoidPtr(EntityId entityId) const noexcept = 0;
+    virtual size_t      GetVersion() const noexcept = 0;
   };
 
   template <typename T>
@@ -138,6 +139,12 @@ namespace FrostFireEngine
       return size;
     }
 
+    // Incrémenté à chaque ajout/retrait de composant
+    size_t GetVersion() const noexcept override
+    {
+      return version;
+    }
+
     bool Empty() const noexcept
     {
       return size == 0;
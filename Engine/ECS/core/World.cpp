@@ -26,11 +26,11 @@ namespace FrostFireEngine
 
   World& World::GetInstance()
   {
-    auto activeScene = SceneManager::GetInstance().GetActiveScene();
-    if (!activeScene) {
+    auto contextScene = SceneManager::GetInstance().GetContextScene();
+    if (!contextScene) {
       throw std::runtime_error("No active scene");
     }
-    return activeScene->GetWorld();
+    return contextScene->GetWorld();
   }
 
   void World::InsertOctreeEntity(EntityId id)
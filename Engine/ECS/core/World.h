@@ -143,6 +143,16 @@ namespace FrostFireEngine
       return nullptr;
     }
 
+    // Versions structurelles, pour que les systèmes ne reparcourent le monde qu'après un
+    // changement : création/destruction d'entité, ajout/retrait d'un composant T
+    [[nodiscard]] size_t GetEntityVersion() const noexcept { return entityVersion; }
+
+    template <typename T>
+    [[nodiscard]] size_t GetComponentVersion() const
+    {
+      return componentManager.GetComponentVersion<T>();
+    }
+
     void                                                   Update(float deltaTime);
     void                                                   Init();
     void                                                   InitializeSystems() const;
@@ -3,6 +3,7 @@
 #include "Engine/ECS/core/World.h"
 #include "ECS/components/ButtonComponent.h"
 #include "ECS/core/System.h"
+#include "UIHitTestSystem.h"
 
 namespace FrostFireEngine
 {
@@ -12,25 +13,34 @@ namespace FrostFireEngine
 
     void Update(float deltaTime) override
     {
-
-
       UNREFERENCED_PARAMETER(deltaTime);
 
-      const auto& world = World::GetInstance();
-      const auto  entities = world.GetEntitiesWith<ButtonComponent>();
-      const auto  entitiesSound = world.GetEntitiesWith<ButtonSoundComponent>();
+      const auto&    hitTest = UIHitTestSystem::Get();
+      const EntityId hovered = hitTest.GetHoveredEntity();
+      const bool     pressed = hitTest.IsPointerPressed();
+      const uint32_t revision = hitTest.GetRevision();
 
-      for (const auto& entity : entities) {
-        if (auto* button = world.GetEntity(entity->GetId())->GetComponent<ButtonComponent>()) {
-          button->Update();
+      // Boutons ajoutés ou déplacés : couleurs initiales, et le survol est réévalué ci-dessous
+      const bool layoutChanged = revision != m_revision;
+      if (layoutChanged) {
+        const auto& world = World::GetInstance();
+        for (const auto& entity : world.GetEntitiesWith<ButtonComponent>()) {
+          entity->GetComponent<ButtonComponent>()->EnsureInitialized();
         }
-      }
-
-      for (const auto &entity : entitiesSound) {
-        if (auto *button = world.GetEntity(entity->GetId())->GetComponent<ButtonSoundComponent>()) {
-          button->Update();
+        for (const auto& entity : world.GetEntitiesWith<ButtonSoundComponent>()) {
+          entity->GetComponent<ButtonSoundComponent>()->EnsureInitialized();
         }
+        m_revision = revision;
       }
+
+      // Seuls les boutons quittés ou survolés reçoivent un évènement, et seulement sur transition
+      if (hovered == m_hovered && pressed == m_pressed && !layoutChanged) return;
+
+      const EntityId previous = m_hovered;
+      m_hovered = hovered;
+      m_pressed = pressed;
+      if (previous != hovered) Dispatch(previous, false, pressed);
+      Dispatch(hovered, true, pressed);
     }
 
     void Initialize() override
@@ -48,5 +58,24 @@ namespace FrostFireEngine
       }
       return *system;
     }
+
+  private:
+    static void Dispatch(EntityId id, bool isInside, bool isMousePressed)
+    {
+      if (id == INVALID_ENTITY_ID) return;
+
+      // Un callback de clic peut détruire l'entité : elle est relue à chaque évènement
+      const auto& world = World::GetInstance();
+      if (const auto entity = world.GetEntity(id)) {
+        if (auto* button = entity->GetComponent<ButtonComponent>()) button->OnPointer(isInside, isMousePressed);
+      }
+      if (const auto entity = world.GetEntity(id)) {
+        if (auto* button = entity->GetComponent<ButtonSoundComponent>()) button->OnPointer(isInside, isMousePressed);
+      }
+    }
+
+    EntityId m_hovered = INVALID_ENTITY_ID;
+    bool     m_pressed = false;
+    uint32_t m_revision = 0;
   };
 }
@@ -2,119 +2,297 @@
 #include "Engine/ECS/components/LightComponent.h"
 #include "Engine/ECS/core/World.h"
 #include "Engine/ECS/components/transform/TransformComponent.h"
+#include "Engine/Utils/ErrorLogger.h"
+#include <algorithm>
 
 using namespace DirectX;
 using namespace FrostFireEngine;
 
+#undef min
+#undef max
+
 static const size_t MAX_DIR_LIGHTS = 4;
 
 LightSystem::LightSystem(ID3D11Device* device) : m_device(device)
 {
   CreateLightBuffer();
+  CreateClusterBuffers();
 }
 
 void LightSystem::Update(float /*deltaTime*/)
 {
-  // Mise à jour si nécessaire
+  SyncLights(World::GetInstance());
 }
 
-void LightSystem::FillLightBuffer(ID3D11DeviceContext* context,
-                                  const XMFLOAT3&      cameraPos,
-                                  const World&         world)
+void LightSystem::SyncLights(const World& world)
 {
-  // Sépare les lumières directionnelles des autres
-  std::vector<LightComponent*> directionalLights;
-  std::vector<LightComponent*> otherLights;
-
-  world.ForEachComponent<LightComponent>([&](LightComponent* lc)
-  {
-    if (lc->GetType() == LightType::Directional) {
-      directionalLights.push_back(lc);
+  // Entité créée/détruite, lumière ou transform ajoutée/retirée : on recollecte les sources
+  bool         structural = false;
+  const size_t entityVersion = world.GetEntityVersion();
+  const size_t lightSetVersion = world.GetComponentVersion<LightComponent>();
+  const size_t transformSetVersion = world.GetComponentVersion<TransformComponent>();
+  if (entityVersion != m_entityVersion || lightSetVersion != m_lightSetVersion ||
+    transformSetVersion != m_transformSetVersion) {
+    CollectLightSources(world);
+    m_entityVersion = entityVersion;
+    m_lightSetVersion = lightSetVersion;
+    m_transformSetVersion = transformSetVersion;
+    structural = true;
+  }
+
+  // Une lumière (ou son entité) activée ou désactivée change aussi la liste
+  for (LightSource& source : m_sources) {
+    const bool enabled = source.entity->IsEnabled() && source.light->IsEnabled();
+    if (enabled != source.enabled) {
+      source.enabled = enabled;
+      structural = true;
     }
-    else {
-      otherLights.push_back(lc);
+  }
+
+  // Sinon seules les lumières dont le composant ou la transform a changé sont ré-encodées
+  for (uint32_t slot = 0; !structural && slot < m_records.size(); ++slot) {
+    const LightRecord& record = m_records[slot];
+    const bool         changed = record.lightVersion != record.light->GetVersion() ||
+      (record.transform && record.transformVersion != record.transform->GetChangeVersion());
+    if (!changed) {
+      continue;
     }
-  });
 
-  // Concatène : directionnelles d'abord, puis autres
-  std::vector<LightComponent*> allLights;
-  allLights.reserve(directionalLights.size() + otherLights.size());
-  allLights.insert(allLights.end(), directionalLights.begin(), directionalLights.end());
-  allLights.insert(allLights.end(), otherLights.begin(), otherLights.end());
+    // Une lumière qui devient (ou cesse d'être) directionnelle change l'ordre du buffer
+    if ((record.light->GetType() == LightType::Directional) != record.directional) {
+      structural = true;
+      break;
+    }
+    EncodeLight(slot);
+  }
 
+  if (structural) {
+    RebuildLightRecords();
+  }
+}
+
+void LightSystem::FillLightBuffer(ID3D11DeviceContext* context, const CameraContext& camera)
+{
+  // Les lumières elles-mêmes passent par le structured buffer t7, b3 ne porte que la caméra
   LightBufferData data = {};
-  data.cameraPosition = cameraPos;
-  data.lightCount = static_cast<float>(std::min<size_t>(allLights.size(), MAX_LIGHTS));
+  data.cameraPosition = camera.cameraPosition;
+  data.lightCount = static_cast<float>(m_gpuLights.size());
+
+  D3D11_MAPPED_SUBRESOURCE mappedRes;
+  HRESULT hr = context->Map(m_lightBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedRes);
+  if (SUCCEEDED(hr)) {
+    memcpy(mappedRes.pData, &data, sizeof(LightBufferData));
+    context->Unmap(m_lightBuffer.Get(), 0);
+  }
 
-  for (size_t i = 0; i < std::min<size_t>(allLights.size(), MAX_LIGHTS); ++i) {
-    const LightComponent* lc = allLights[i];
+  context->PSSetConstantBuffers(3, 1, m_lightBuffer.GetAddressOf());
 
-    // Récupère les propriétés de la lumière
-    XMFLOAT3 color = lc->GetColor();
-    float    intensity = lc->GetIntensity();
+  UploadDirtyLights(context);
+  UploadClusters(context, camera);
+}
 
-    XMFLOAT3 direction = lc->GetDirection();
-    float    type;
-    if (lc->GetType() == LightType::Directional) {
-      type = 0.0f;
-    }
-    else if (lc->GetType() == LightType::Point) {
-      type = 1.0f;
+void LightSystem::CollectLightSources(const World& world)
+{
+  const ComponentMask lightMask = ComponentManager::GetMaskForComponentAndDerived<LightComponent>();
+
+  m_sources.clear();
+  for (const auto& entity : world.GetEntities()) {
+    if ((entity->GetComponentMask() & lightMask) == 0) {
+      continue;
     }
-    else {
-      type = 2.0f;
+    const LightComponent* light = entity->GetComponent<LightComponent>();
+    if (light) {
+      m_sources.push_back(LightSource{entity.get(), light, entity->IsEnabled() && light->IsEnabled()});
     }
+  }
+}
+
+void LightSystem::RebuildLightRecords()
+{
+  m_records.clear();
+
+  // Directionnelles d'abord (les MAX_DIR_LIGHTS premières ont une slice d'ombre), puis les autres
+  m_directionalCount = 0;
+  for (int pass = 0; pass < 2; ++pass) {
+    for (const LightSource& source : m_sources) {
+      const bool directional = source.light->GetType() == LightType::Directional;
+      if (!source.enabled || directional != (pass == 0) || m_records.size() >= MAX_CLUSTERED_LIGHTS) {
+        continue;
+      }
 
-    XMFLOAT3 position(0.0f, 0.0f, 0.0f);
-    if (const auto entity = world.GetEntity(lc->GetOwner())) {
-      if (const auto transform = entity->GetComponent<TransformComponent>()) {
-        XMStoreFloat3(&position, transform->GetWorldPosition());
+      m_records.push_back(LightRecord{
+        source.light, source.entity->GetComponent<TransformComponent>(), 0, 0, directional
+      });
+      if (directional) {
+        ++m_directionalCount;
       }
     }
+  }
 
-    float range = lc->GetRange();
-    float spotAngle = lc->GetSpotAngle();
+  // Capacités fixées ici : le chemin par frame (UploadClusters) n'alloue plus
+  m_gpuLights.resize(m_records.size());
+  m_clusterLights.reserve(m_records.size());
+  m_directionalMatrices.resize(std::min<size_t>(m_directionalCount, MAX_DIR_LIGHTS));
+  for (uint32_t slot = 0; slot < m_records.size(); ++slot) {
+    EncodeLight(slot);
+  }
+}
 
-    // Remplir la structure GPU_Light
-    data.lights[i].colorIntensity = XMFLOAT4(color.x, color.y, color.z, intensity);
-    data.lights[i].directionType = XMFLOAT4(direction.x, direction.y, direction.z, type);
-    data.lights[i].positionRange = XMFLOAT4(position.x, position.y, position.z, range);
-    data.lights[i].spotAnglePad = XMFLOAT4(spotAngle, 0.0f, 0.0f, 0.0f);
+void LightSystem::EncodeLight(uint32_t slot)
+{
+  LightRecord&              record = m_records[slot];
+  const LightComponent*     lc = record.light;
+  const TransformComponent* transform = record.transform;
+
+  // Récupère les propriétés de la lumière
+  XMFLOAT3 color = lc->GetColor();
+  float    intensity = lc->GetIntensity();
+
+  XMFLOAT3 direction = lc->GetDirection();
+  float    type;
+  if (lc->GetType() == LightType::Directional) {
+    type = 0.0f;
+  }
+  else if (lc->GetType() == LightType::Point) {
+    type = 1.0f;
+  }
+  else {
+    type = 2.0f;
   }
 
-  D3D11_MAPPED_SUBRESOURCE mappedRes;
-  HRESULT hr = context->Map(m_lightBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedRes);
-  if (SUCCEEDED(hr)) {
-    memcpy(mappedRes.pData, &data, sizeof(LightBufferData));
-    context->Unmap(m_lightBuffer.Get(), 0);
+  XMFLOAT3 position(0.0f, 0.0f, 0.0f);
+  if (transform) {
+    XMStoreFloat3(&position, transform->GetWorldPosition());
   }
 
-  context->PSSetConstantBuffers(3, 1, m_lightBuffer.GetAddressOf());
+  float range = lc->GetRange();
+  float spotAngle = lc->GetSpotAngle();
+
+  // Remplir la structure GPU_Light
+  GPU_Light& gpuLight = m_gpuLights[slot];
+  gpuLight.colorIntensity = XMFLOAT4(color.x, color.y, color.z, intensity);
+  gpuLight.directionType = XMFLOAT4(direction.x, direction.y, direction.z, type);
+  gpuLight.positionRange = XMFLOAT4(position.x, position.y, position.z, range);
+  gpuLight.spotAnglePad = XMFLOAT4(spotAngle, 0.0f, 0.0f, 0.0f);
+
+  // Matrice de la slice d'ombre : ne change qu'avec la lumière ou sa transform
+  if (slot < m_directionalMatrices.size()) {
+    XMVECTOR lightDir = XMVector3Normalize(XMLoadFloat3(&direction));
+
+    XMFLOAT3 lightPosF(50.f, 50.f, 50.f);
+    if (transform) {
+      lightPosF = position;
+    }
+
+    XMVECTOR lightPos = XMLoadFloat3(&lightPosF);
+    XMVECTOR up = XMVectorSet(0, 1, 0, 0);
+    XMMATRIX lightView = XMMatrixLookAtLH(lightPos, XMVectorAdd(lightPos, lightDir), up);
+    XMMATRIX lightProj = XMMatrixOrthographicLH(300.0f, 300.0f, 0.1f, 700.0f);
+    m_directionalMatrices[slot] = XMMatrixMultiply(lightView, lightProj);
+  }
+
+  record.lightVersion = lc->GetVersion();
+  record.transformVersion = transform ? transform->GetChangeVersion() : 0;
+
+  m_dirtyBegin = std::min(m_dirtyBegin, slot);
+  m_dirtyEnd = std::max(m_dirtyEnd, slot + 1);
 }
 
-void LightSystem::GetDirectionalLightMatrices(std::vector<XMMATRIX>& matrices)
+void LightSystem::UploadDirtyLights(ID3D11DeviceContext* context)
 {
-  matrices.clear();
-  World::GetInstance().ForEachComponent<LightComponent>([&](LightComponent* lc)
-  {
-    if (lc->GetType() == LightType::Directional && matrices.size() < MAX_DIR_LIGHTS) {
-      XMFLOAT3 dirF = lc->GetDirection();
-      XMVECTOR lightDir = XMVector3Normalize(XMLoadFloat3(&dirF));
-
-      XMFLOAT3 lightPosF(50.f, 50.f, 50.f);
-      if (auto entity = World::GetInstance().GetEntity(lc->GetOwner())) {
-        if (auto transform = entity->GetComponent<TransformComponent>()) {
-          XMStoreFloat3(&lightPosF, transform->GetWorldPosition());
-        }
-      }
+  if (m_dirtyBegin >= m_dirtyEnd) {
+    return;
+  }
+
+  // Seule la plage des lumières modifiées est envoyée au GPU
+  D3D11_BOX box = {};
+  box.left = m_dirtyBegin * sizeof(GPU_Light);
+  box.right = m_dirtyEnd * sizeof(GPU_Light);
+  box.top = 0;
+  box.bottom = 1;
+  box.front = 0;
+  box.back = 1;
+  context->UpdateSubresource(m_clusterLightBuffer.Get(), 0, &box, &m_gpuLights[m_dirtyBegin], 0, 0);
+
+  m_dirtyBegin = INVALID_SLOT;
+  m_dirtyEnd = 0;
+}
+
+void LightSystem::UploadClusters(ID3D11DeviceContext* context, const CameraContext& camera)
+{
+  // Les lumières locales sont passées en espace vue puis assignées aux clusters
+  m_clusterGrid.UpdateProjection(camera.projMatrix);
+
+  m_clusterLights.clear();
+  for (size_t i = m_directionalCount; i < m_gpuLights.size(); ++i) {
+    const GPU_Light& light = m_gpuLights[i];
 
-      XMVECTOR lightPos = XMLoadFloat3(&lightPosF);
-      XMVECTOR up = XMVectorSet(0, 1, 0, 0);
-      XMMATRIX lightView = XMMatrixLookAtLH(lightPos, XMVectorAdd(lightPos, lightDir), up);
-      XMMATRIX lightProj = XMMatrixOrthographicLH(300.0f, 300.0f, 0.1f, 700.0f);
-      matrices.push_back(XMMatrixMultiply(lightView, lightProj));
+    ClusterLight clusterLight;
+    const XMVECTOR position = XMVectorSet(light.positionRange.x, light.positionRange.y,
+      light.positionRange.z, 1.0f);
+    XMStoreFloat3(&clusterLight.positionVS, XMVector3TransformCoord(position, camera.viewMatrix));
+    clusterLight.range = light.positionRange.w;
+    clusterLight.directionVS = XMFLOAT3(0.0f, 0.0f, 1.0f);
+    clusterLight.cosHalfAngle = -2.0f;
+    clusterLight.sinHalfAngle = 0.0f;
+    clusterLight.index = static_cast<uint32_t>(i);
+
+    if (light.directionType.w == 2.0f) {
+      const XMVECTOR direction = XMVectorSet(light.directionType.x, light.directionType.y,
+        light.directionType.z, 0.0f);
+      XMStoreFloat3(&clusterLight.directionVS,
+        XMVector3Normalize(XMVector3TransformNormal(direction, camera.viewMatrix)));
+      XMScalarSinCos(&clusterLight.sinHalfAngle, &clusterLight.cosHalfAngle,
+        XMConvertToRadians(light.spotAnglePad.x * 0.5f));
     }
-  });
+
+    m_clusterLights.push_back(clusterLight);
+  }
+
+  m_clusterGrid.Build(m_clusterLights.data(), m_clusterLights.size());
+
+  D3D11_MAPPED_SUBRESOURCE mapped;
+  const auto& clusters = m_clusterGrid.GetClusters();
+  if (SUCCEEDED(context->Map(m_clusterBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+    memcpy(mapped.pData, clusters.data(), clusters.size() * sizeof(LightCluster));
+    context->Unmap(m_clusterBuffer.Get(), 0);
+  }
+
+  const auto& indices = m_clusterGrid.GetLightIndices();
+  if (EnsureClusterIndexCapacity(indices.size()) && !indices.empty() &&
+    SUCCEEDED(context->Map(m_clusterIndexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+    memcpy(mapped.pData, indices.data(), indices.size() * sizeof(uint32_t));
+    context->Unmap(m_clusterIndexBuffer.Get(), 0);
+  }
+
+  ClusterParamsData params = {};
+  XMStoreFloat4x4(&params.view, XMMatrixTranspose(camera.viewMatrix));
+  params.sliceScale = m_clusterGrid.GetSliceScale();
+  params.sliceBias = m_clusterGrid.GetSliceBias();
+  params.directionalCount = m_directionalCount;
+  params.lightCount = static_cast<uint32_t>(m_gpuLights.size());
+  params.tilesX = LightClusterGrid::TILES_X;
+  params.tilesY = LightClusterGrid::TILES_Y;
+  params.slicesZ = LightClusterGrid::SLICES_Z;
+  params.screenWidth = static_cast<float>(camera.viewportWidth);
+  params.screenHeight = static_cast<float>(camera.viewportHeight);
+
+  if (SUCCEEDED(context->Map(m_clusterParamsBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+    memcpy(mapped.pData, &params, sizeof(ClusterParamsData));
+    context->Unmap(m_clusterParamsBuffer.Get(), 0);
+  }
+
+  BindClusterResources(context);
+}
+
+void LightSystem::BindClusterResources(ID3D11DeviceContext* context) const
+{
+  ID3D11ShaderResourceView* srvs[3] = {
+    m_clusterLightSRV.Get(), m_clusterSRV.Get(), m_clusterIndexSRV.Get()
+  };
+  context->PSSetShaderResources(7, 3, srvs);
+  context->PSSetConstantBuffers(6, 1, m_clusterParamsBuffer.GetAddressOf());
+  context->PSSetConstantBuffers(3, 1, m_lightBuffer.GetAddressOf());
 }
 
 void LightSystem::CreateLightBuffer()
@@ -130,3 +308,77 @@ void LightSystem::CreateLightBuffer()
   if (FAILED(hr)) {
   }
 }
+
+static bool CreateStructuredBuffer(ID3D11Device*                                     device,
+                                   UINT                                              stride,
+                                   UINT                                              count,
+                                   bool                                              dynamic,
+                                   Microsoft::WRL::ComPtr<ID3D11Buffer>&             buffer,
+                                   Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& srv)
+{
+  // Les buffers non dynamiques sont mis à jour par plage via UpdateSubresource
+  D3D11_BUFFER_DESC bd = {};
+  bd.Usage = dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT;
+  bd.ByteWidth = stride * count;
+  bd.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+  bd.CPUAccessFlags = dynamic ? D3D11_CPU_ACCESS_WRITE : 0;
+  bd.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+  bd.StructureByteStride = stride;
+
+  buffer.Reset();
+  srv.Reset();
+  if (FAILED(device->CreateBuffer(&bd, nullptr, &buffer))) {
+    return false;
+  }
+
+  D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+  srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+  srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+  srvDesc.Buffer.FirstElement = 0;
+  srvDesc.Buffer.NumElements = count;
+
+  return SUCCEEDED(device->CreateShaderResourceView(buffer.Get(), &srvDesc, &srv));
+}
+
+void LightSystem::CreateClusterBuffers()
+{
+  if (!CreateStructuredBuffer(m_device, sizeof(GPU_Light), MAX_CLUSTERED_LIGHTS, false,
+    m_clusterLightBuffer, m_clusterLightSRV)) {
+    ErrorLogger::Log("Failed to create clustered light buffer.");
+  }
+
+  if (!CreateStructuredBuffer(m_device, sizeof(LightCluster), LightClusterGrid::CLUSTER_COUNT, true,
+    m_clusterBuffer, m_clusterSRV)) {
+    ErrorLogger::Log("Failed to create light cluster buffer.");
+  }
+
+  EnsureClusterIndexCapacity(LightClusterGrid::CLUSTER_COUNT);
+
+  D3D11_BUFFER_DESC bd = {};
+  bd.Usage = D3D11_USAGE_DYNAMIC;
+  bd.ByteWidth = sizeof(ClusterParamsData);
+  bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+  bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+  if (FAILED(m_device->CreateBuffer(&bd, nullptr, &m_clusterParamsBuffer))) {
+    ErrorLogger::Log("Failed to create cluster params buffer.");
+  }
+}
+
+bool LightSystem::EnsureClusterIndexCapacity(size_t indexCount)
+{
+  if (indexCount <= m_clusterIndexCapacity && m_clusterIndexBuffer) {
+    return true;
+  }
+
+  // Croissance géométrique pour éviter de recréer le buffer à chaque frame
+  const size_t newCapacity = std::max(indexCount, m_clusterIndexCapacity * 2);
+  if (!CreateStructuredBuffer(m_device, sizeof(uint32_t), static_cast<UINT>(newCapacity), true,
+    m_clusterIndexBuffer, m_clusterIndexSRV)) {
+    m_clusterIndexCapacity = 0;
+    return false;
+  }
+
+  m_clusterIndexCapacity = newCapacity;
+  return true;
+}
@@ -3,11 +3,18 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <wrl/client.h>
+#include <memory>
 #include <vector>
+#include "Engine/CameraContext.h"
 #include "Engine/ECS/core/System.h"
+#include "rendering/LightClusterGrid.h"
 
 namespace FrostFireEngine
 {
+  class LightComponent;
+  class TransformComponent;
+  class Entity;
+
   struct GPU_Light {
     DirectX::XMFLOAT4 colorIntensity; // xyz = color, w = intensity
     DirectX::XMFLOAT4 directionType; // xyz = direction, w = type
@@ -15,12 +22,27 @@ namespace FrostFireEngine
     DirectX::XMFLOAT4 spotAnglePad; // x = spotAngle, y,z,w = pad
   };
 
-  static const int MAX_LIGHTS = 64;
+  // Nombre de lumières du structured buffer partagé par le lighting pass et la transparence
+  static const int MAX_CLUSTERED_LIGHTS = 4096;
 
   struct LightBufferData {
     DirectX::XMFLOAT3 cameraPosition;
     float             lightCount;
-    GPU_Light         lights[MAX_LIGHTS];
+  };
+
+  struct ClusterParamsData {
+    DirectX::XMFLOAT4X4 view;
+    float               sliceScale;
+    float               sliceBias;
+    uint32_t            directionalCount;
+    uint32_t            lightCount;
+    uint32_t            tilesX;
+    uint32_t            tilesY;
+    uint32_t            slicesZ;
+    uint32_t            pad;
+    float               screenWidth;
+    float               screenHeight;
+    float               pad2[2];
   };
 
   class LightSystem : public System {
@@ -28,16 +50,74 @@ namespace FrostFireEngine
     LightSystem(ID3D11Device* device);
     void Update(float deltaTime) override;
 
-    void FillLightBuffer(ID3D11DeviceContext*     context,
-                         const DirectX::XMFLOAT3& cameraPos,
-                         const class World&       world);
+    void FillLightBuffer(ID3D11DeviceContext* context, const CameraContext& camera);
 
-    static void GetDirectionalLightMatrices(std::vector<DirectX::XMMATRIX>& matrices);
+    // Rebind des ressources clusterisées (b3, b6, t7-t9) pour une passe ultérieure
+    void BindClusterResources(ID3D11DeviceContext* context) const;
+
+    // ViewProjection des directionnelles ombrées, recalculées seulement quand elles changent
+    const std::vector<DirectX::XMMATRIX>& GetDirectionalLightMatrices() const
+    {
+      return m_directionalMatrices;
+    }
+
+    const LightClusterGrid& GetClusterGrid() const { return m_clusterGrid; }
 
   private:
+    // Lumière du monde, activée ou non, dans l'ordre des entités
+    struct LightSource {
+      const Entity*         entity;
+      const LightComponent* light;
+      bool                  enabled;
+    };
+
+    // Enregistrement persistant d'une lumière activée, même ordre que m_gpuLights
+    struct LightRecord {
+      const LightComponent*     light;
+      const TransformComponent* transform;
+      uint32_t                  lightVersion;
+      uint32_t                  transformVersion;
+      bool                      directional;
+    };
+
+    static constexpr uint32_t INVALID_SLOT = 0xFFFFFFFFu;
+    static constexpr size_t   INVALID_VERSION = ~size_t(0);
+
+    void SyncLights(const class World& world);
+    void CollectLightSources(const class World& world);
+    void RebuildLightRecords();
+    void EncodeLight(uint32_t slot);
+    void UploadDirtyLights(ID3D11DeviceContext* context);
+
     void CreateLightBuffer();
+    void CreateClusterBuffers();
+    bool EnsureClusterIndexCapacity(size_t indexCount);
+    void UploadClusters(ID3D11DeviceContext* context, const CameraContext& camera);
 
     ID3D11Device*                        m_device;
     Microsoft::WRL::ComPtr<ID3D11Buffer> m_lightBuffer;
+
+    // Lighting clusterisé : lumières (t7), clusters (t8), listes d'indices (t9), paramètres (b6)
+    std::vector<LightSource>       m_sources;
+    std::vector<LightRecord>       m_records;
+    std::vector<DirectX::XMMATRIX> m_directionalMatrices;
+    size_t                         m_entityVersion = INVALID_VERSION;
+    size_t                         m_lightSetVersion = INVALID_VERSION;
+    size_t                         m_transformSetVersion = INVALID_VERSION;
+    uint32_t                       m_dirtyBegin = INVALID_SLOT;
+    uint32_t                       m_dirtyEnd = 0;
+
+    LightClusterGrid                                 m_clusterGrid;
+    std::vector<GPU_Light>                           m_gpuLights;
+    std::vector<ClusterLight>                        m_clusterLights;
+    uint32_t                                         m_directionalCount = 0;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>             m_clusterLightBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_clusterLightSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>             m_clusterBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_clusterSRV;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>             m_clusterIndexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_clusterIndexSRV;
+    size_t                                           m_clusterIndexCapacity = 0;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>             m_clusterParamsBuffer;
   };
 }
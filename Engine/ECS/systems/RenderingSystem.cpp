@@ -3,6 +3,7 @@
 #include <d3d11.h>
 #include <string>
 #include <algorithm>
+#include <cfloat>
 
 #include "CameraSystem.h"
 #include "debug/DebugSystem.h"
@@ -12,6 +13,7 @@
 #include "Engine/TextureManager.h"
 #include "Engine/ECS/components/transform/TransformComponent.h"
 #include "Engine/ECS/components/rendering/PBRRenderer.h"
+#include "Engine/Shaders/ShaderCache.h"
 #include "Engine/Shaders/techniques/GlobaleTechnique.h"
 #include "Engine/Shaders/techniques/ShaderTechniqueFactory.h"
 #include "Engine/Textures/FallbackTextures.h"
@@ -177,6 +179,14 @@ void RenderingSystem::Initialize()
     ErrorLogger::Log("Failed to create transparency states.");
   }
 
+  if (!m_uiBatcher.Initialize(m_device->GetD3DDevice())) {
+    ErrorLogger::Log("Failed to initialize UI batcher.");
+  }
+
+  if (!m_spriteBatcher.Initialize(m_device->GetD3DDevice())) {
+    ErrorLogger::Log("Failed to initialize sprite batcher.");
+  }
+
   // Light matrix buffer array
   {
     D3D11_BUFFER_DESC cbd = {};
@@ -235,6 +245,8 @@ void RenderingSystem::Initialize()
     }
   }
 #endif
+
+  ShaderCache::GetInstance().ReportStats("demarrage");
 }
 
 bool RenderingSystem::CreateShadowMapArray(UINT count)
@@ -254,17 +266,44 @@ bool RenderingSystem::CreateShadowMapArray(UINT count)
     return false;
   }
 
-  D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
-  dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
-  dsvDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
-  dsvDesc.Texture2DArray.ArraySize = count;
-  dsvDesc.Texture2DArray.FirstArraySlice = 0;
-  dsvDesc.Texture2DArray.MipSlice = 0;
+  // Une DSV et un buffer de matrice par slice, créés une seule fois
+  m_shadowSliceDSVs.assign(count, nullptr);
+  m_shadowSliceMatrixBuffers.assign(count, nullptr);
+  m_shadowSliceMatrices.assign(count, XMFLOAT4X4{});
+  m_shadowSliceValid.assign(count, 0);
 
-  if (FAILED(device->CreateDepthStencilView(m_shadowMapArray.Get(), &dsvDesc, &m_shadowDSVArray))) {
-    return false;
+  for (UINT i = 0; i < count; i++) {
+    D3D11_DEPTH_STENCIL_VIEW_DESC dsvDesc = {};
+    dsvDesc.Format = DXGI_FORMAT_D32_FLOAT;
+    dsvDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
+    dsvDesc.Texture2DArray.ArraySize = 1;
+    dsvDesc.Texture2DArray.FirstArraySlice = i;
+    dsvDesc.Texture2DArray.MipSlice = 0;
+
+    if (FAILED(device->CreateDepthStencilView(m_shadowMapArray.Get(), &dsvDesc, &m_shadowSliceDSVs[i]))) {
+      return false;
+    }
+
+    D3D11_BUFFER_DESC cbd = {};
+    cbd.Usage = D3D11_USAGE_DEFAULT;
+    cbd.ByteWidth = sizeof(XMFLOAT4X4);
+    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+
+    if (FAILED(device->CreateBuffer(&cbd, nullptr, &m_shadowSliceMatrixBuffers[i]))) {
+      return false;
+    }
   }
 
+  m_shadowViewport.Width = static_cast<float>(texDesc.Width);
+  m_shadowViewport.Height = static_cast<float>(texDesc.Height);
+  m_shadowViewport.MinDepth = 0.0f;
+  m_shadowViewport.MaxDepth = 1.0f;
+  m_shadowViewport.TopLeftX = 0.0f;
+  m_shadowViewport.TopLeftY = 0.0f;
+
+  // Les ombres ne lisent que la position : valable pour tous les formats de sommets
+  m_shadowLayout.elements.assign(std::begin(PositionOnlyLayout), std::end(PositionOnlyLayout));
+
   D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
   srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
   srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
@@ -363,10 +402,15 @@ void RenderingSystem::Cleanup()
 
   m_transparencyBlendState.Reset();
   m_transparencyDepthState.Reset();
+  m_uiBatcher.Release();
+  m_spriteBatcher.Release();
 
   m_shadowMapArray.Reset();
-  m_shadowDSVArray.Reset();
   m_shadowSRVArray.Reset();
+  m_shadowSliceDSVs.clear();
+  m_shadowSliceMatrixBuffers.clear();
+  m_shadowSliceMatrices.clear();
+  m_shadowSliceValid.clear();
   m_lightMatrixBufferArray.Reset();
 }
 
@@ -381,15 +425,19 @@ void RenderingSystem::SetViewportDepthRange(float minDepth, float maxDepth) cons
   context->RSSetViewports(1, &vp);
 }
 
-void RenderingSystem::RenderUI(const std::vector<BaseRendererComponent *> &uiRenderers) const
+void RenderingSystem::RenderUI(const std::vector<UIBaseRendererComponent *> &uiRenderers)
 {
   const auto context = m_device->GetImmediateContext();
   context->OMSetDepthStencilState(nullptr, 0);
   constexpr float blendFactor[4] = { 1, 1, 1, 1 };
   context->OMSetBlendState(m_transparencyBlendState.Get(), blendFactor, 0xFFFFFFFF);
-  for (auto &uiComp : uiRenderers) {
-    uiComp->Draw(context, XMMatrixIdentity(), XMMatrixIdentity(), RenderPass::UI);
+
+  // Les éléments remplissent le lot dans l'ordre d'affichage, les draws sont émis à la fin
+  m_uiBatcher.Begin(m_device->GetViewportWidth(), m_device->GetViewportHeight());
+  for (auto *uiComp : uiRenderers) {
+    uiComp->SubmitUI(m_uiBatcher);
   }
+  m_uiBatcher.End(context);
 }
 
 void RenderingSystem::Update(float deltaTime)
@@ -441,39 +489,30 @@ void RenderingSystem::Update(float deltaTime)
 
   for (auto *renderer : visibleRenderers)
   {
-    (renderer->IsOpaque() ? m_opaqueRenderers : m_transparentRenderers).push_back(renderer);
+    if (renderer->IsOpaque())
+      m_opaqueRenderers.push_back(renderer);
+    else
+      m_transparentRenderers.push_back({ renderer->GetViewDepth(cameraContext.viewMatrix), renderer });
   }
 
-  // Récupération des Billboards et ajout aux transparents
-  World::GetInstance().ForEachComponent<SpriteRenderer>(
-    [this](SpriteRenderer *comp)
-    {
-      if (comp->IsVisible() && comp->IsBillboard())
-        m_transparentRenderers.push_back(comp);
-    });
-
-  // Tri des transparents par distance
-  {
-    XMVECTOR camPos = XMLoadFloat3(&cameraContext.cameraPosition);
-    std::ranges::sort(m_transparentRenderers,
-      [camPos](const BaseRendererComponent *a, const BaseRendererComponent *b)
-      {
-        const float distA = a->GetDistanceFromCamera(camPos);
-        const float distB = b->GetDistanceFromCamera(camPos);
-        return distA > distB;
-      });
-  }
+  // Tri des transparents de l'arrière vers l'avant, sur la profondeur calculée une seule fois
+  std::ranges::sort(m_transparentRenderers, std::ranges::greater{}, &TransparentDraw::viewDepth);
 
-  // Récupération des SpriteRenderer (non-billboard) et ajout aux transparents
+  // Un seul parcours des SpriteRenderer : les billboards vont au lot instancié (trié à part), les
+  // autres sont dessinés après tous les transparents, comme avant
+  m_spriteBatcher.Begin(cameraContext, frustum);
   World::GetInstance().ForEachComponent<SpriteRenderer>(
     [this](SpriteRenderer *comp)
     {
-      if (comp->IsVisible() && !comp->IsBillboard())
-        m_transparentRenderers.push_back(comp);
+      if (!comp->IsVisible()) return;
+      if (comp->IsBillboard())
+        comp->SubmitBillboard(m_spriteBatcher);
+      else
+        m_transparentRenderers.push_back({ -FLT_MAX, comp });
     });
 
   // Récupération des UI renderers
-  std::vector<BaseRendererComponent *> uiRenderers;
+  std::vector<UIBaseRendererComponent *> uiRenderers;
   World::GetInstance().ForEachComponent<UIRendererComponent>(
     [&uiRenderers](UIRendererComponent *comp)
     {
@@ -539,6 +578,9 @@ void RenderingSystem::Update(float deltaTime)
     EndRenderPass(currentPass);
   }
 
+  // Les renderers ont signalé la résolution voulue pour leurs textures pendant les passes
+  TextureManager::GetInstance().UpdateStreaming(m_device);
+
   m_opaqueRenderers.clear();
   m_transparentRenderers.clear();
 }
@@ -552,18 +594,10 @@ void RenderingSystem::BeginRenderPass(RenderPass pass)
   switch (pass) {
   case RenderPass::Shadow:
   {
+    // Chaque slice est bindée et effacée dans RenderShadowPass, uniquement si elle doit être re-rendue
     ID3D11RenderTargetView *nullRTV[1] = { nullptr };
-    context->OMSetRenderTargets(1, nullRTV, m_shadowDSVArray.Get());
-    context->ClearDepthStencilView(m_shadowDSVArray.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
-
-    D3D11_VIEWPORT vp;
-    vp.Width = 4096.0f;
-    vp.Height = 4096.0f;
-    vp.MinDepth = 0.0f;
-    vp.MaxDepth = 1.0f;
-    vp.TopLeftX = 0.0f;
-    vp.TopLeftY = 0.0f;
-    context->RSSetViewports(1, &vp);
+    context->OMSetRenderTargets(1, nullRTV, nullptr);
+    context->RSSetViewports(1, &m_shadowViewport);
   }
   break;
   case RenderPass::GBuffer:
@@ -685,77 +719,92 @@ void RenderingSystem::RenderShadowPass(const CameraContext &camera)
     return;
   }
 
-  std::vector<XMMATRIX> directionalLightMatrices;
-  lightSystem->GetDirectionalLightMatrices(directionalLightMatrices);
+  m_shadowSlicesRendered = 0;
+  const auto &directionalMatrices = lightSystem->GetDirectionalLightMatrices();
+  const UINT  sliceCount = std::min(static_cast<UINT>(directionalMatrices.size()),
+    m_shadowMapArraySize);
 
-  D3D11_MAPPED_SUBRESOURCE mapped;
-  if (SUCCEEDED(
-    context->Map(m_lightMatrixBufferArray.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
-    for (size_t i = 0; i < directionalLightMatrices.size(); i++) {
-      XMFLOAT4X4 lvp;
-      XMStoreFloat4x4(&lvp, XMMatrixTranspose(directionalLightMatrices[i]));
-      memcpy(static_cast<char *>(mapped.pData) + i * sizeof(XMFLOAT4X4), &lvp, sizeof(XMFLOAT4X4));
-    }
-    context->Unmap(m_lightMatrixBufferArray.Get(), 0);
-  }
+  // Les déplacements de transforms (MarkDirty) remontent jusqu'à l'octree qui garde
+  // les régions modifiées : seules les slices dont le frustum les touche sont re-rendues
+  Octree     &octree = World::GetInstance().GetOctree();
+  const bool  allDirty = !m_staticShadowCaching || octree.AreAllRegionsDirty();
+  const auto &dirtyRegions = octree.GetDirtyRegions();
+
+  const ShaderVariant    *shadowVariant = nullptr;
+  ID3D11RenderTargetView *nullRTV[1] = { nullptr };
+  bool                    matricesChanged = false;
 
-  context->VSSetConstantBuffers(1, 1, m_lightMatrixBufferArray.GetAddressOf());
+  for (UINT i = 0; i < sliceCount; i++) {
+    XMFLOAT4X4 lvp;
+    XMStoreFloat4x4(&lvp, XMMatrixTranspose(directionalMatrices[i]));
+    const bool matrixChanged = memcmp(&lvp, &m_shadowSliceMatrices[i], sizeof(XMFLOAT4X4)) != 0;
 
-  const std::vector<std::string> features;
-  VertexLayoutDesc               shadowLayout;
-  for (const auto &i : Vertex::layout) {
-    shadowLayout.elements.push_back(i);
-  }
+    Frustum lightFrustum;
+    // On suppose que directionalMatrices[i] est une matrice ViewProjection
+    lightFrustum.ConstructFrustumFromMatrix(directionalMatrices[i]);
 
-  const ShaderVariant *shadowVariant = m_globalTechnique->GetVariantForPass(
-    RenderPass::Shadow, features, shadowLayout);
-  if (!shadowVariant) {
-    ErrorLogger::Log("No shadow variant found in global technique.");
-    return;
-  }
+    bool sliceDirty = allDirty || matrixChanged || !m_shadowSliceValid[i];
+    for (size_t r = 0; !sliceDirty && r < dirtyRegions.size(); r++) {
+      sliceDirty = lightFrustum.CheckBox(dirtyRegions[r]);
+    }
+    if (!sliceDirty) {
+      continue;
+    }
 
-  shadowVariant->Apply(context);
+    if (matrixChanged) {
+      m_shadowSliceMatrices[i] = lvp;
+      context->UpdateSubresource(m_shadowSliceMatrixBuffers[i].Get(), 0, nullptr, &lvp, 0, 0);
+      matricesChanged = true;
+    }
 
-  for (UINT i = 0; i < static_cast<UINT>(directionalLightMatrices.size()); i++) {
-    Frustum lightFrustum;
-    // On suppose que directionalLightMatrices[i] est une matrice ViewProjection
-    lightFrustum.ConstructFrustumFromMatrix(directionalLightMatrices[i]);
+    if (!shadowVariant) {
+      shadowVariant = m_globalTechnique->GetVariantForPass(
+        RenderPass::Shadow, m_shadowFeatures, m_shadowLayout);
+      if (!shadowVariant) {
+        ErrorLogger::Log("No shadow variant found in global technique.");
+        return;
+      }
+      shadowVariant->Apply(context);
+    }
 
     // On récupère les objets visibles par cette lumière
-    std::vector<BaseRendererComponent *> lightVisibleRenderers;
-    World::GetInstance().GetOctree().QueryFrustum(lightFrustum, lightVisibleRenderers);
-
-    D3D11_VIEWPORT vp;
-    vp.Width = 4096.0f;
-    vp.Height = 4096.0f;
-    vp.MinDepth = 0.0f;
-    vp.MaxDepth = 1.0f;
-    vp.TopLeftX = 0.0f;
-    vp.TopLeftY = 0.0f;
-    context->RSSetViewports(1, &vp);
+    m_shadowCasters.clear();
+    octree.QueryFrustum(lightFrustum, m_shadowCasters);
 
-    D3D11_DEPTH_STENCIL_VIEW_DESC dsvSliceDesc = {};
-    dsvSliceDesc.Format = DXGI_FORMAT_D32_FLOAT;
-    dsvSliceDesc.ViewDimension = D3D11_DSV_DIMENSION_TEXTURE2DARRAY;
-    dsvSliceDesc.Texture2DArray.ArraySize = 1;
-    dsvSliceDesc.Texture2DArray.FirstArraySlice = i;
-    dsvSliceDesc.Texture2DArray.MipSlice = 0;
+    context->OMSetRenderTargets(1, nullRTV, m_shadowSliceDSVs[i].Get());
+    context->ClearDepthStencilView(m_shadowSliceDSVs[i].Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+    context->VSSetConstantBuffers(1, 1, m_shadowSliceMatrixBuffers[i].GetAddressOf());
 
-    ComPtr<ID3D11DepthStencilView> dsvSlice;
-    if (FAILED(
-      m_device->GetD3DDevice()->CreateDepthStencilView(m_shadowMapArray.Get(), &dsvSliceDesc, &
-        dsvSlice))) {
-      continue;
+    for (const auto &renderer : m_shadowCasters) {
+      renderer->Draw(context, XMMatrixIdentity(), XMMatrixIdentity(), RenderPass::Shadow);
     }
 
-    ID3D11RenderTargetView *nullRTV[1] = { nullptr };
-    context->OMSetRenderTargets(1, nullRTV, dsvSlice.Get());
-    context->ClearDepthStencilView(dsvSlice.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+    m_shadowSliceValid[i] = 1;
+    ++m_shadowSlicesRendered;
+  }
 
-    for (const auto &renderer : lightVisibleRenderers) {
-      renderer->Draw(context, XMMatrixIdentity(), XMMatrixIdentity(), RenderPass::Shadow);
+  // Les matrices utilisées par le lighting pass ne changent qu'avec les lumières
+  if (matricesChanged) {
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (SUCCEEDED(
+      context->Map(m_lightMatrixBufferArray.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+      memcpy(mapped.pData, m_shadowSliceMatrices.data(), sliceCount * sizeof(XMFLOAT4X4));
+      context->Unmap(m_lightMatrixBufferArray.Get(), 0);
     }
   }
+
+  octree.ClearDirtyRegions();
+}
+
+void RenderingSystem::SetStaticShadowCaching(bool enabled)
+{
+  m_staticShadowCaching = enabled;
+  InvalidateShadowCache();
+}
+
+void RenderingSystem::InvalidateShadowCache()
+{
+  std::fill(m_shadowSliceValid.begin(), m_shadowSliceValid.end(), static_cast<uint8_t>(0));
 }
 
 void RenderingSystem::RenderGBufferPass(const CameraContext &camera) const
@@ -795,7 +844,7 @@ void RenderingSystem::ApplyLightingPass(const CameraContext &camera)
   context->PSSetConstantBuffers(1, 1, m_screenSizeBuffer.GetAddressOf());
 
   if (auto *lightSystem = World::GetInstance().GetSystem<LightSystem>()) {
-    lightSystem->FillLightBuffer(context, camera.cameraPosition, World::GetInstance());
+    lightSystem->FillLightBuffer(context, camera);
 
     context->PSSetShaderResources(3, 1, m_shadowSRVArray.GetAddressOf());
     context->PSSetSamplers(1, 1, m_shadowSampler.GetAddressOf());
@@ -889,7 +938,7 @@ void RenderingSystem::RenderSkyboxPass(const CameraContext &camera)
   context->RSSetState(nullptr);
 }
 
-void RenderingSystem::RenderTransparencyPass(const CameraContext &camera) const
+void RenderingSystem::RenderTransparencyPass(const CameraContext &camera)
 {
   if (!m_globalTechnique) {
     ErrorLogger::Log("No global technique set for transparency pass.");
@@ -901,9 +950,18 @@ void RenderingSystem::RenderTransparencyPass(const CameraContext &camera) const
   context->OMSetBlendState(m_transparencyBlendState.Get(), nullptr, 0xFFFFFFFF);
   context->OMSetDepthStencilState(m_transparencyDepthState.Get(), 0);
 
-  for (auto &renderer : m_transparentRenderers) {
+  // Les transparents utilisent la même grille de clusters que le lighting pass
+  if (const auto *lightSystem = World::GetInstance().GetSystem<LightSystem>()) {
+    lightSystem->BindClusterResources(context);
+  }
+
+  // Les billboards plus lointains qu'un transparent sont dessinés avant lui
+  m_spriteBatcher.End(context);
+  for (const auto &[viewDepth, renderer] : m_transparentRenderers) {
+    m_spriteBatcher.DrawFartherThan(context, viewDepth);
     renderer->Draw(context, camera.viewMatrix, camera.projMatrix, RenderPass::Transparency);
   }
+  m_spriteBatcher.DrawRemaining(context);
 }
 
 void RenderingSystem::ApplyPostProcessEffects(const CameraContext &camera) const
@@ -1097,6 +1155,7 @@ void RenderingSystem::SetGlobalTechniqueName(const std::string &techniqueName)
     ErrorLogger::Log("Failed to create global technique with name: " + techniqueName);
   }
   m_globalTechnique = std::move(technique);
+  InvalidateShadowCache();
 
   if (m_globalTechnique) {
     const std::vector<std::string> features;
@@ -1115,6 +1174,7 @@ void RenderingSystem::SetGlobalTechniqueName(const std::string &techniqueName)
 void RenderingSystem::SetGlobalTechnique(std::unique_ptr<ShaderTechnique> technique)
 {
   m_globalTechnique = std::move(technique);
+  InvalidateShadowCache();
 
   if (m_globalTechnique) {
     const std::vector<std::string> features;
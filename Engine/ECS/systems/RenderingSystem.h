@@ -12,6 +12,8 @@
 #include "Engine/Shaders/ShaderManager.h"
 #include "Engine/Shaders/features/RenderPass.h"
 #include "rendering/GBuffer.h"
+#include "rendering/SpriteBatcher.h"
+#include "rendering/UIBatcher.h"
 
 namespace FrostFireEngine
 {
@@ -19,6 +21,7 @@ namespace FrostFireEngine
   class Texture;
   class Mesh;
   class BaseRendererComponent;
+  class UIBaseRendererComponent;
   class ShaderTechnique;
   class ShaderVariant;
 
@@ -34,6 +37,19 @@ namespace FrostFireEngine
     void SetGlobalTechnique(std::unique_ptr<ShaderTechnique> technique);
     void SetSkyboxTexture(Texture* pSkyboxTexture);
 
+    // Cache des ombres statiques : une slice n'est re-rendue que si un objet
+    // de son frustum a bougé (ou si la matrice de la lumière a changé)
+    void SetStaticShadowCaching(bool enabled);
+    bool IsStaticShadowCachingEnabled() const { return m_staticShadowCaching; }
+    void InvalidateShadowCache();
+    UINT GetShadowSlicesRenderedLastFrame() const { return m_shadowSlicesRendered; }
+
+    // Quads, lots et draws de l'interface à la dernière frame
+    const UIBatchStats& GetUIBatchStats() const { return m_uiBatcher.GetStats(); }
+
+    // Billboards soumis, éliminés et draws instanciés à la dernière frame
+    const SpriteBatchStats& GetSpriteBatchStats() const { return m_spriteBatcher.GetStats(); }
+
   private:
     bool CreateLightingTarget();
     bool CreateShadowMapArray(UINT count);
@@ -46,14 +62,14 @@ namespace FrostFireEngine
     void RenderShadowPass(const CameraContext& camera);
     void RenderGBufferPass(const CameraContext& camera) const;
     void ApplyLightingPass(const CameraContext& camera);
-    void RenderTransparencyPass(const CameraContext& camera) const;
+    void RenderTransparencyPass(const CameraContext& camera);
     void ApplyPostProcessEffects(const CameraContext& camera) const;
     void RenderDebugPass(const CameraContext& camera);
     void RenderSkyboxPass(const CameraContext& camera);
     void CompositeFinalImage(const CameraContext& camera) const;
 
     void SetViewportDepthRange(float minDepth, float maxDepth) const;
-    void RenderUI(const std::vector<BaseRendererComponent*>& uiRenderers) const;
+    void RenderUI(const std::vector<UIBaseRendererComponent*>& uiRenderers);
 
   private:
     std::unique_ptr<D3DResources> m_d3dResources;
@@ -69,10 +85,21 @@ namespace FrostFireEngine
 
     // Shadow map array pour plusieurs lumières directionnelles
     ComPtr<ID3D11Texture2D>          m_shadowMapArray;
-    ComPtr<ID3D11DepthStencilView>   m_shadowDSVArray;
     ComPtr<ID3D11ShaderResourceView> m_shadowSRVArray;
     UINT                             m_shadowMapArraySize = 0;
 
+    // Vues et buffers persistants par slice, créés avec la shadow map array
+    std::vector<ComPtr<ID3D11DepthStencilView>> m_shadowSliceDSVs;
+    std::vector<ComPtr<ID3D11Buffer>>           m_shadowSliceMatrixBuffers;
+    std::vector<XMFLOAT4X4>                     m_shadowSliceMatrices;
+    std::vector<uint8_t>                        m_shadowSliceValid;
+    D3D11_VIEWPORT                              m_shadowViewport = {};
+    VertexLayoutDesc                            m_shadowLayout;
+    std::vector<std::string>                    m_shadowFeatures;
+    std::vector<BaseRendererComponent*>         m_shadowCasters;
+    bool                                        m_staticShadowCaching = true;
+    UINT                                        m_shadowSlicesRendered = 0;
+
     // Buffers
     ComPtr<ID3D11Buffer> m_screenSizeBuffer;
     ComPtr<ID3D11Buffer> m_lightMatrixBufferArray;
@@ -102,9 +129,21 @@ namespace FrostFireEngine
     ComPtr<ID3D11BlendState>        m_transparencyBlendState;
     ComPtr<ID3D11DepthStencilState> m_transparencyDepthState;
 
-    std::vector<BaseRendererComponent*> m_transparentRenderers;
+    // Profondeur vue calculée une fois par frame, triée de l'arrière vers l'avant
+    struct TransparentDraw {
+      float                  viewDepth;
+      BaseRendererComponent* renderer;
+    };
+
+    std::vector<TransparentDraw>        m_transparentRenderers;
     std::vector<BaseRendererComponent*> m_opaqueRenderers;
 
+    // Toute l'interface en un vertex buffer dynamique par frame
+    UIBatcher m_uiBatcher;
+
+    // Billboards de SpriteRenderer en draws instanciés, intercalés avec les autres transparents
+    SpriteBatcher m_spriteBatcher;
+
     size_t m_debugVBSizeInBytes = 0;
 
     struct DebugLineVertex {
@@ -2,6 +2,7 @@
 #include "Engine/ECS/core/World.h"
 #include "Engine/ECS/core/System.h"
 #include "Engine/ECS/components/SliderComponent.h"
+#include "UIHitTestSystem.h"
 
 namespace FrostFireEngine
 {
@@ -11,18 +12,26 @@ namespace FrostFireEngine
 
     void Update(float deltaTime) override
     {
-
-
       UNREFERENCED_PARAMETER(deltaTime);
 
-      const auto &world = World::GetInstance();
-      const auto  entities = world.GetEntitiesWith<SliderComponent>();
+      const auto    &hitTest = UIHitTestSystem::Get();
+      const EntityId hovered = hitTest.GetHoveredEntity();
+      const bool     pressed = hitTest.IsPointerPressed();
+      const float    pointerX = hitTest.GetPointerX();
+      const uint32_t revision = hitTest.GetRevision();
 
-      for (const auto &entity : entities) {
-        if (auto *slider = world.GetEntity(entity->GetId())->GetComponent<SliderComponent>()) {
-          slider->Update();
-        }
-      }
+      // Transitions de survol ou de clic, plus chaque déplacement horizontal pendant le glissement
+      const bool transition = hovered != m_hovered || pressed != m_pressed || revision != m_revision;
+      const bool dragging = pressed && hovered == m_hovered && pointerX != m_pointerX;
+      if (!transition && !dragging) return;
+
+      const EntityId previous = m_hovered;
+      m_hovered = hovered;
+      m_pressed = pressed;
+      m_pointerX = pointerX;
+      m_revision = revision;
+      if (previous != hovered) Dispatch(previous, false, pressed, pointerX);
+      Dispatch(hovered, true, pressed, pointerX);
     }
 
     void Initialize() override
@@ -40,5 +49,20 @@ namespace FrostFireEngine
       }
       return *system;
     }
+
+  private:
+    static void Dispatch(EntityId id, bool isInside, bool isMousePressed, float mouseX)
+    {
+      if (id == INVALID_ENTITY_ID) return;
+
+      if (const auto entity = World::GetInstance().GetEntity(id)) {
+        if (auto *slider = entity->GetComponent<SliderComponent>()) slider->OnPointer(isInside, isMousePressed, mouseX);
+      }
+    }
+
+    EntityId m_hovered = INVALID_ENTITY_ID;
+    bool     m_pressed = false;
+    float    m_pointerX = 0.0f;
+    uint32_t m_revision = 0;
   };
 }
@@ -0,0 +1,68 @@
+#include "UIHitGrid.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace FrostFireEngine;
+
+#undef min
+#undef max
+
+void UIHitGrid::Build(const std::vector<UIHitTarget>& targets, float viewportWidth, float viewportHeight)
+{
+  m_targets = targets;
+  m_cellsX = std::clamp(static_cast<uint32_t>(std::ceil(viewportWidth / CELL_SIZE)), 1u, MAX_CELLS_PER_AXIS);
+  m_cellsY = std::clamp(static_cast<uint32_t>(std::ceil(viewportHeight / CELL_SIZE)), 1u, MAX_CELLS_PER_AXIS);
+
+  // Deux passes (comptage puis remplissage) : un seul tableau d'indices pour toutes les cellules
+  const uint32_t cellCount = m_cellsX * m_cellsY;
+  m_cellStart.assign(cellCount + 1, 0);
+  for (const UIHitTarget& target : m_targets) {
+    for (uint32_t y = CellY(target.rect.y); y <= CellY(target.rect.w); y++) {
+      for (uint32_t x = CellX(target.rect.x); x <= CellX(target.rect.z); x++) {
+        m_cellStart[y * m_cellsX + x + 1]++;
+      }
+    }
+  }
+  for (uint32_t cell = 0; cell < cellCount; cell++) {
+    m_cellStart[cell + 1] += m_cellStart[cell];
+  }
+
+  m_cellTargets.resize(m_cellStart[cellCount]);
+  std::vector<uint32_t> cursor(m_cellStart.begin(), m_cellStart.end() - 1);
+  for (uint32_t i = 0; i < m_targets.size(); i++) {
+    const UIHitTarget& target = m_targets[i];
+    for (uint32_t y = CellY(target.rect.y); y <= CellY(target.rect.w); y++) {
+      for (uint32_t x = CellX(target.rect.x); x <= CellX(target.rect.z); x++) {
+        m_cellTargets[cursor[y * m_cellsX + x]++] = i;
+      }
+    }
+  }
+}
+
+EntityId UIHitGrid::HitTest(float x, float y) const
+{
+  if (m_cellStart.empty()) return INVALID_ENTITY_ID;
+
+  // Parcours à rebours : la première cible touchée est la plus haute
+  const uint32_t cell = CellY(y) * m_cellsX + CellX(x);
+  for (uint32_t i = m_cellStart[cell + 1]; i-- > m_cellStart[cell];) {
+    const UIHitTarget& target = m_targets[m_cellTargets[i]];
+    if (x >= target.rect.x && x <= target.rect.z && y >= target.rect.y && y <= target.rect.w) {
+      return target.entity;
+    }
+  }
+  return INVALID_ENTITY_ID;
+}
+
+uint32_t UIHitGrid::CellX(float x) const
+{
+  // Négatif ou NaN : première cellule
+  const float cell = std::floor(x / CELL_SIZE);
+  return cell > 0.0f ? static_cast<uint32_t>(std::min(cell, static_cast<float>(m_cellsX - 1))) : 0;
+}
+
+uint32_t UIHitGrid::CellY(float y) const
+{
+  const float cell = std::floor(y / CELL_SIZE);
+  return cell > 0.0f ? static_cast<uint32_t>(std::min(cell, static_cast<float>(m_cellsY - 1))) : 0;
+}
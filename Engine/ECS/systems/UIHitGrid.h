@@ -0,0 +1,49 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+#include "Engine/ECS/core/Entity.h"
+
+namespace FrostFireEngine
+{
+  // Élément cliquable : boîte englobante écran (left, top, right, bottom) issue du layout
+  struct UIHitTarget {
+    EntityId          entity;
+    DirectX::XMFLOAT4 rect;
+
+    bool operator==(const UIHitTarget& other) const
+    {
+      return entity == other.entity && rect.x == other.rect.x && rect.y == other.rect.y &&
+             rect.z == other.rect.z && rect.w == other.rect.w;
+    }
+  };
+
+  // Grille uniforme en pixels écran : chaque cellule liste les cibles qui la recouvrent, dans
+  // l'ordre d'affichage. Un test de clic ne parcourt que la cellule sous le curseur.
+  // Ne dépend que de DirectXMath et de la STL.
+  class UIHitGrid {
+  public:
+    static constexpr float    CELL_SIZE = 64.0f;
+    static constexpr uint32_t MAX_CELLS_PER_AXIS = 256;
+
+    // targets dans l'ordre d'affichage : en cas de chevauchement, la dernière est au-dessus
+    void Build(const std::vector<UIHitTarget>& targets, float viewportWidth, float viewportHeight);
+
+    // Cible la plus haute contenant le point (bords inclus), INVALID_ENTITY_ID sinon.
+    // Un point hors du viewport est rapporté à la cellule du bord la plus proche.
+    EntityId HitTest(float x, float y) const;
+
+    const std::vector<UIHitTarget>& GetTargets() const { return m_targets; }
+
+  private:
+    uint32_t CellX(float x) const;
+    uint32_t CellY(float y) const;
+
+    std::vector<UIHitTarget> m_targets;
+    uint32_t                 m_cellsX = 0;
+    uint32_t                 m_cellsY = 0;
+    std::vector<uint32_t>    m_cellStart;    // m_cellsX * m_cellsY + 1 débuts dans m_cellTargets
+    std::vector<uint32_t>    m_cellTargets;  // indices dans m_targets, croissants par cellule
+  };
+}
@@ -0,0 +1,106 @@
+#include "UIHitTestSystem.h"
+#include <stdexcept>
+#include "Engine/DispositifD3D11.h"
+#include "Engine/InputManager.h"
+#include "Engine/ECS/core/World.h"
+#include "Engine/ECS/components/ButtonComponent.h"
+#include "Engine/ECS/components/ButtonSoundComponent.h"
+#include "Engine/ECS/components/SliderComponent.h"
+#include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "UILayoutSystem.h"
+
+using namespace FrostFireEngine;
+
+namespace
+{
+  template <typename T>
+  bool HasEnabledComponent(Entity& entity)
+  {
+    const T* component = entity.GetComponent<T>();
+    return component && component->IsEnabled();
+  }
+}
+
+UIHitTestSystem::UIHitTestSystem(DispositifD3D11* dispositif) : m_dispositif(dispositif)
+{
+}
+
+void UIHitTestSystem::Update(float /*deltaTime*/)
+{
+  Refresh(m_dispositif->GetViewportWidth(), m_dispositif->GetViewportHeight());
+
+  const auto& inputManager = InputManager::GetInstance();
+  m_pointerX = static_cast<float>(inputManager.GetMouseX());
+  m_pointerY = static_cast<float>(inputManager.GetMouseY());
+  m_pointerPressed = inputManager.IsMouseButtonPressed(0);
+  m_hovered = m_grid.HitTest(m_pointerX, m_pointerY);
+}
+
+void UIHitTestSystem::Refresh(float viewportWidth, float viewportHeight)
+{
+  // Cibles inchangées tant qu'aucune de leurs sources n'a bougé : ni parcours du World, ni comparaison
+  const TargetSources sources = GetTargetSources();
+  const bool          targetsChanged = sources != m_sources;
+  if (targetsChanged) {
+    CollectTargets();
+    m_sources = sources;
+  }
+
+  if ((targetsChanged && m_targets != m_grid.GetTargets()) || viewportWidth != m_viewportWidth ||
+    viewportHeight != m_viewportHeight) {
+    m_grid.Build(m_targets, viewportWidth, viewportHeight);
+    m_viewportWidth = viewportWidth;
+    m_viewportHeight = viewportHeight;
+    m_revision++;
+    m_stats.rebuilds++;
+  }
+}
+
+UIHitTestSystem::TargetSources UIHitTestSystem::GetTargetSources() const
+{
+  const World&  world = World::GetInstance();
+  TargetSources sources;
+  sources.valid = true;
+  if (const auto* layout = world.GetSystem<UILayoutSystem>()) {
+    sources.layoutRevision = layout->GetRevision();
+  }
+  sources.entityVersion = world.GetEntityVersion();
+  sources.componentVersion = world.GetComponentVersion<RectTransformComponent>() +
+                             world.GetComponentVersion<ButtonComponent>() +
+                             world.GetComponentVersion<ButtonSoundComponent>() +
+                             world.GetComponentVersion<SliderComponent>();
+  sources.targetsVersion = s_targetsVersion;
+  return sources;
+}
+
+void UIHitTestSystem::CollectTargets()
+{
+  const World& world = World::GetInstance();
+  m_stats.scans++;
+
+  // Même ordre que le rendu de l'interface (ordre des entités) : la dernière cible est au-dessus
+  const ComponentMask widgetMask = ComponentManager::GetMaskForComponentAndDerived<ButtonComponent>() |
+                                   ComponentManager::GetMaskForComponentAndDerived<ButtonSoundComponent>() |
+                                   ComponentManager::GetMaskForComponentAndDerived<SliderComponent>();
+  m_targets.clear();
+  for (const auto& entity : world.GetEntitiesWith<RectTransformComponent>()) {
+    if (!(entity->GetComponentMask() & widgetMask)) continue;
+    if (!HasEnabledComponent<ButtonComponent>(*entity) && !HasEnabledComponent<ButtonSoundComponent>(*entity) &&
+      !HasEnabledComponent<SliderComponent>(*entity)) {
+      continue;
+    }
+
+    const RectTransformComponent* rectTransform = entity->GetComponent<RectTransformComponent>();
+    if (!rectTransform->HasLayout()) continue;  // pas encore affiché
+    m_targets.push_back({entity->GetId(), rectTransform->GetLayout().screenRect});
+  }
+}
+
+UIHitTestSystem& UIHitTestSystem::Get()
+{
+  auto* system = World::GetInstance().GetSystem<UIHitTestSystem>();
+  if (!system) {
+    throw std::runtime_error("UIHitTestSystem not initialized");
+  }
+  return *system;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Engine/ECS/core/System.h"
+#include "UIHitGrid.h"
+
+namespace FrostFireEngine
+{
+  class DispositifD3D11;
+
+  struct UIHitTestStats {
+    uint32_t scans = 0;     // relevés des cibles depuis la création du système
+    uint32_t rebuilds = 0;  // reconstructions de la grille
+  };
+
+  // Test de clic partagé par ButtonSystem et SliderSystem, à placer avant eux dans la phase Logic.
+  // Les cibles (Button, ButtonSound, Slider actifs) sont relevées dans l'ordre d'affichage avec la
+  // boîte calculée par UILayoutSystem, seulement quand le layout, les entités, ces composants ou
+  // leur activation ont changé ; la grille n'est reconstruite que si une cible a bougé. Une seule
+  // requête par frame donne l'élément survolé, le plus haut en cas de chevauchement.
+  class UIHitTestSystem : public System {
+  public:
+    explicit UIHitTestSystem(DispositifD3D11* dispositif);
+    void Update(float deltaTime) override;
+
+    // Met à jour les cibles et la grille pour un viewport donné ; Update la lance avec celui du dispositif
+    void Refresh(float viewportWidth, float viewportHeight);
+    EntityId HitTest(float x, float y) const { return m_grid.HitTest(x, y); }
+
+    // Appelé par les composants cliquables quand ils sont activés ou désactivés
+    static void InvalidateTargets() noexcept { s_targetsVersion++; }
+
+    EntityId GetHoveredEntity() const { return m_hovered; }
+    bool     IsPointerPressed() const { return m_pointerPressed; }
+    float    GetPointerX() const { return m_pointerX; }
+    float    GetPointerY() const { return m_pointerY; }
+
+    // Incrémenté à chaque reconstruction de la grille (cibles ajoutées, retirées ou déplacées)
+    uint32_t GetRevision() const { return m_revision; }
+
+    const UIHitTestStats& GetStats() const { return m_stats; }
+
+    static UIHitTestSystem& Get();
+
+  private:
+    // Versions relevées au dernier relevé des cibles
+    struct TargetSources {
+      bool     valid = false;
+      uint32_t layoutRevision = 0;
+      size_t   entityVersion = 0;
+      size_t   componentVersion = 0;
+      uint32_t targetsVersion = 0;
+
+      bool operator==(const TargetSources&) const = default;
+    };
+
+    TargetSources GetTargetSources() const;
+    void          CollectTargets();
+
+    inline static uint32_t s_targetsVersion = 0;
+
+    DispositifD3D11*         m_dispositif;
+    UIHitGrid                m_grid;
+    std::vector<UIHitTarget> m_targets;  // dernier relevé, réutilisé
+    TargetSources            m_sources;
+    float                    m_viewportWidth = 0.0f;
+    float                    m_viewportHeight = 0.0f;
+    uint32_t                 m_revision = 0;
+    UIHitTestStats           m_stats;
+
+    EntityId m_hovered = INVALID_ENTITY_ID;
+    bool     m_pointerPressed = false;
+    float    m_pointerX = 0.0f;
+    float    m_pointerY = 0.0f;
+  };
+}
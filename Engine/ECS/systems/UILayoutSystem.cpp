@@ -0,0 +1,117 @@
+#include "UILayoutSystem.h"
+#include "Engine/DispositifD3D11.h"
+#include "Engine/ECS/core/World.h"
+#include "Engine/ECS/components/transform/TransformComponent.h"
+#include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "Engine/ECS/components/rendering/UIBaseRendererComponent.h"
+
+using namespace FrostFireEngine;
+
+namespace
+{
+  // Racine : pas de parent, ou un parent sans RectTransform (ancré sur le viewport)
+  bool IsLayoutRoot(const World& world, const TransformComponent& transform)
+  {
+    if (transform.GetParent() == INVALID_ENTITY_ID) return true;
+    const auto parentEntity = world.GetEntity(transform.GetParent());
+    return !parentEntity || !parentEntity->HasComponent<RectTransformComponent>();
+  }
+}
+
+UILayoutSystem::UILayoutSystem(DispositifD3D11* dispositif) : m_dispositif(dispositif)
+{
+}
+
+void UILayoutSystem::Update(float /*deltaTime*/)
+{
+  Layout(m_dispositif->GetViewportWidth(), m_dispositif->GetViewportHeight());
+}
+
+void UILayoutSystem::Layout(float viewportWidth, float viewportHeight)
+{
+  const bool viewportChanged = viewportWidth != m_viewportWidth || viewportHeight != m_viewportHeight;
+  m_viewportWidth = viewportWidth;
+  m_viewportHeight = viewportHeight;
+  m_stats = {};
+
+  // Nouveau viewport (ou première passe) : tout élément dépend de sa taille. Les hiérarchies
+  // désactivées sont invalidées et attendent leur réactivation dans la file.
+  const World& world = World::GetInstance();
+  if (viewportChanged) {
+    const ComponentMask mask = ComponentManager::GetMaskForComponentAndDerived<RectTransformComponent>() |
+                               ComponentManager::GetMaskForComponentAndDerived<TransformComponent>();
+    for (const auto& entity : world.GetEntitiesWithMask(mask)) {
+      auto*       rectTransform = entity->GetComponent<RectTransformComponent>();
+      const auto* transform = entity->GetComponent<TransformComponent>();
+      if (!IsLayoutRoot(world, *transform)) continue;
+
+      if (entity->IsEnabled() && rectTransform->IsEnabled() && transform->IsEnabled()) {
+        LayoutSubtree(entity->GetId(), nullptr, true);
+      }
+      else {
+        rectTransform->MarkLayoutDirty();
+      }
+    }
+  }
+
+  // Racines signalées depuis la dernière passe ; déjà traitées si le viewport a changé
+  m_processedRoots.swap(m_dirtyRoots);
+  for (const EntityId id : m_processedRoots) {
+    const auto entity = world.GetEntity(id);
+    if (!entity) continue;
+
+    const auto* rectTransform = entity->GetComponent<RectTransformComponent>();
+    const auto* transform = entity->GetComponent<TransformComponent>();
+    if (!rectTransform || !transform || !rectTransform->IsLayoutPending()) continue;
+
+    // Rattachée depuis sous un RectTransform : la racine de son nouveau parent a été mise en file
+    if (!IsLayoutRoot(world, *transform)) continue;
+
+    // Hiérarchie désactivée : gardée en file jusqu'à sa réactivation
+    if (!entity->IsEnabled() || !rectTransform->IsEnabled() || !transform->IsEnabled()) {
+      m_dirtyRoots.push_back(id);
+      continue;
+    }
+    LayoutSubtree(id, nullptr, false);
+  }
+  m_processedRoots.clear();
+
+  if (m_stats.recomputed > 0) m_revision++;
+}
+
+void UILayoutSystem::QueueLayoutRoot(EntityId root)
+{
+  if (auto* system = World::GetInstance().GetSystem<UILayoutSystem>()) {
+    system->m_dirtyRoots.push_back(root);
+  }
+}
+
+void UILayoutSystem::LayoutSubtree(EntityId id, const RectTransformComponent* parent, bool parentChanged)
+{
+  const auto entity = World::GetInstance().GetEntity(id);
+  if (!entity) return;
+
+  auto* rectTransform = entity->GetComponent<RectTransformComponent>();
+  const auto* transform = entity->GetComponent<TransformComponent>();
+  if (!rectTransform || !transform) return;
+
+  // Sous-arbre propre sous un parent inchangé : rien à recalculer, ni ici ni plus bas
+  if (!parentChanged && !rectTransform->IsLayoutPending()) return;
+
+  // Le contenu vient du renderer de l'élément (taille de texture, texte) ; 0 sans renderer
+  float contentWidth = 0.0f;
+  float contentHeight = 0.0f;
+  if (const auto* renderer = entity->GetComponent<UIBaseRendererComponent>()) {
+    contentWidth = renderer->GetContentWidth();
+    contentHeight = renderer->GetContentHeight();
+  }
+
+  const RectLayoutChange change = rectTransform->UpdateLayout(parent, *transform, m_viewportWidth, m_viewportHeight,
+                                                              contentWidth, contentHeight, parentChanged);
+  m_stats.elements++;
+  if (change != RectLayoutChange::None) m_stats.recomputed++;
+
+  for (const EntityId child : transform->GetChildren()) {
+    LayoutSubtree(child, rectTransform, change == RectLayoutChange::Frame);
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Engine/ECS/core/System.h"
+
+namespace FrostFireEngine
+{
+  class DispositifD3D11;
+  class RectTransformComponent;
+
+  struct UILayoutStats {
+    uint32_t elements = 0;    // RectTransform parcourus cette frame
+    uint32_t recomputed = 0;  // dont le layout a été recalculé
+  };
+
+  // Passe de layout de l'interface, une fois par frame avant le rendu. Chaque invalidation (setter,
+  // contenu du renderer, rotation, reparentage) marque l'élément et ses ancêtres puis met sa racine
+  // en file : la passe ne descend que dans les sous-arbres marqués et ne parcourt toutes les
+  // hiérarchies qu'au redimensionnement du viewport. Le rendu et les tests de clic des
+  // Button/Slider lisent ensuite le layout mis en cache.
+  class UILayoutSystem : public System {
+  public:
+    explicit UILayoutSystem(DispositifD3D11* dispositif);
+    void Update(float deltaTime) override;
+
+    // Passe de layout pour un viewport donné ; Update la lance avec celui du dispositif
+    void Layout(float viewportWidth, float viewportHeight);
+
+    // Racine d'une hiérarchie dont un élément attend la passe (RectTransformComponent::RequestLayout).
+    // Sans système dans le World, la première passe parcourt de toute façon toutes les racines.
+    static void QueueLayoutRoot(EntityId root);
+
+    const UILayoutStats& GetStats() const { return m_stats; }
+
+    // Incrémenté à chaque passe qui recalcule au moins un élément (boîtes écran à relire)
+    uint32_t GetRevision() const { return m_revision; }
+
+  private:
+    void LayoutSubtree(EntityId id, const RectTransformComponent* parent, bool parentChanged);
+
+    DispositifD3D11*      m_dispositif;
+    float                 m_viewportWidth = 0.0f;
+    float                 m_viewportHeight = 0.0f;
+    std::vector<EntityId> m_dirtyRoots;
+    std::vector<EntityId> m_processedRoots;  // file de la passe en cours, réutilisée
+    UILayoutStats         m_stats;
+    uint32_t              m_revision = 0;
+  };
+}
@@ -0,0 +1,238 @@
+#include "LightClusterGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+#undef min
+#undef max
+
+LightClusterGrid::LightClusterGrid()
+  : m_bounds(CLUSTER_COUNT),
+    m_sliceDepths(SLICES_Z + 1),
+    m_sliceCandidates(SLICES_Z),
+    m_sliceIndices(SLICES_Z),
+    m_clusters(CLUSTER_COUNT, LightCluster{0, 0})
+{
+  m_jobCount = std::clamp(std::thread::hardware_concurrency(), 1u, MAX_JOBS);
+  m_workers.reserve(m_jobCount - 1);
+  for (uint32_t job = 1; job < m_jobCount; job++) {
+    m_workers.emplace_back(&LightClusterGrid::WorkerLoop, this, job);
+  }
+}
+
+LightClusterGrid::~LightClusterGrid()
+{
+  {
+    std::lock_guard lock(m_jobMutex);
+    m_stopWorkers = true;
+  }
+  m_jobStart.notify_all();
+  for (auto& worker : m_workers) {
+    worker.join();
+  }
+}
+
+void LightClusterGrid::WorkerLoop(uint32_t job)
+{
+  uint64_t generation = 0;
+  for (;;) {
+    {
+      std::unique_lock lock(m_jobMutex);
+      m_jobStart.wait(lock, [&]() { return m_stopWorkers || m_jobGeneration != generation; });
+      if (m_stopWorkers) {
+        return;
+      }
+      generation = m_jobGeneration;
+    }
+
+    RunJob(job);
+
+    std::lock_guard lock(m_jobMutex);
+    if (--m_jobsPending == 0) {
+      m_jobDone.notify_one();
+    }
+  }
+}
+
+void LightClusterGrid::RunJob(uint32_t job)
+{
+  for (uint32_t z = job; z < SLICES_Z; z += m_jobCount) {
+    BuildSlice(z, m_jobLights, m_jobLightCount);
+  }
+}
+
+void LightClusterGrid::UpdateProjection(const XMMATRIX& projMatrix)
+{
+  XMFLOAT4X4 proj;
+  XMStoreFloat4x4(&proj, projMatrix);
+  if (memcmp(&proj, &m_projection, sizeof(XMFLOAT4X4)) == 0) {
+    return;
+  }
+  m_projection = proj;
+
+  // Projection perspective LH (XMMatrixPerspectiveFovLH) :
+  // _33 = f / (f - n), _43 = -n * f / (f - n)
+  const float xScale = proj._11;
+  const float yScale = proj._22;
+  m_nearZ = -proj._43 / proj._33;
+  m_farZ = proj._33 * m_nearZ / (proj._33 - 1.0f);
+
+  const float logRatio = std::log(m_farZ / m_nearZ);
+  m_sliceScale = static_cast<float>(SLICES_Z) / logRatio;
+  m_sliceBias = -static_cast<float>(SLICES_Z) * std::log(m_nearZ) / logRatio;
+
+  for (uint32_t z = 0; z <= SLICES_Z; z++) {
+    m_sliceDepths[z] = m_nearZ * std::pow(m_farZ / m_nearZ,
+      static_cast<float>(z) / static_cast<float>(SLICES_Z));
+  }
+
+  for (uint32_t z = 0; z < SLICES_Z; z++) {
+    const float dn = m_sliceDepths[z];
+    const float df = m_sliceDepths[z + 1];
+
+    for (uint32_t y = 0; y < TILES_Y; y++) {
+      // La tuile 0 est en haut de l'écran
+      const float ndcTop = 1.0f - 2.0f * static_cast<float>(y) / TILES_Y;
+      const float ndcBottom = 1.0f - 2.0f * static_cast<float>(y + 1) / TILES_Y;
+      const float minY = std::min(ndcBottom * dn, ndcBottom * df) / yScale;
+      const float maxY = std::max(ndcTop * dn, ndcTop * df) / yScale;
+
+      for (uint32_t x = 0; x < TILES_X; x++) {
+        const float ndcLeft = -1.0f + 2.0f * static_cast<float>(x) / TILES_X;
+        const float ndcRight = -1.0f + 2.0f * static_cast<float>(x + 1) / TILES_X;
+        const float minX = std::min(ndcLeft * dn, ndcLeft * df) / xScale;
+        const float maxX = std::max(ndcRight * dn, ndcRight * df) / xScale;
+
+        ClusterBounds& b = m_bounds[GetClusterIndex(x, y, z)];
+        b.center = XMFLOAT3((minX + maxX) * 0.5f, (minY + maxY) * 0.5f, (dn + df) * 0.5f);
+        b.extents = XMFLOAT3((maxX - minX) * 0.5f, (maxY - minY) * 0.5f, (df - dn) * 0.5f);
+        b.radius = std::sqrt(b.extents.x * b.extents.x + b.extents.y * b.extents.y +
+          b.extents.z * b.extents.z);
+        b.pad = 0.0f;
+      }
+    }
+  }
+}
+
+uint32_t LightClusterGrid::GetSliceForDepth(float viewZ) const
+{
+  if (viewZ <= m_nearZ) {
+    return 0;
+  }
+  const float slice = std::log(viewZ) * m_sliceScale + m_sliceBias;
+  return std::min(static_cast<uint32_t>(std::max(slice, 0.0f)), SLICES_Z - 1);
+}
+
+void LightClusterGrid::Build(const ClusterLight* lights, size_t lightCount)
+{
+  // Chaque tranche de profondeur remplit sa propre liste, sans synchronisation
+  if (m_workers.empty() || lightCount < PARALLEL_LIGHT_THRESHOLD) {
+    for (uint32_t z = 0; z < SLICES_Z; z++) {
+      BuildSlice(z, lights, lightCount);
+    }
+  }
+  else {
+    {
+      std::lock_guard lock(m_jobMutex);
+      m_jobLights = lights;
+      m_jobLightCount = lightCount;
+      m_jobsPending = static_cast<uint32_t>(m_workers.size());
+      ++m_jobGeneration;
+    }
+    m_jobStart.notify_all();
+
+    RunJob(0);
+
+    std::unique_lock lock(m_jobMutex);
+    m_jobDone.wait(lock, [this]() { return m_jobsPending == 0; });
+  }
+
+  // Les offsets locaux à chaque tranche deviennent globaux
+  uint32_t total = 0;
+  for (uint32_t z = 0; z < SLICES_Z; z++) {
+    const uint32_t first = GetClusterIndex(0, 0, z);
+    for (uint32_t c = first; c < first + TILES_X * TILES_Y; c++) {
+      m_clusters[c].offset += total;
+    }
+    total += static_cast<uint32_t>(m_sliceIndices[z].size());
+  }
+
+  m_lightIndices.resize(total);
+  uint32_t* out = m_lightIndices.data();
+  for (uint32_t z = 0; z < SLICES_Z; z++) {
+    const auto& indices = m_sliceIndices[z];
+    if (!indices.empty()) {
+      memcpy(out, indices.data(), indices.size() * sizeof(uint32_t));
+      out += indices.size();
+    }
+  }
+}
+
+void LightClusterGrid::BuildSlice(uint32_t z, const ClusterLight* lights, size_t lightCount)
+{
+  const float sliceNear = m_sliceDepths[z];
+  const float sliceFar = m_sliceDepths[z + 1];
+
+  // Pré-filtrage des lumières qui touchent la tranche en profondeur
+  auto& candidates = m_sliceCandidates[z];
+  candidates.clear();
+  for (size_t i = 0; i < lightCount; i++) {
+    const ClusterLight& light = lights[i];
+    if (light.positionVS.z + light.range >= sliceNear &&
+      light.positionVS.z - light.range <= sliceFar) {
+      candidates.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  auto& indices = m_sliceIndices[z];
+  indices.clear();
+
+  for (uint32_t y = 0; y < TILES_Y; y++) {
+    for (uint32_t x = 0; x < TILES_X; x++) {
+      const uint32_t       clusterIndex = GetClusterIndex(x, y, z);
+      const ClusterBounds& b = m_bounds[clusterIndex];
+      LightCluster&        cluster = m_clusters[clusterIndex];
+      cluster.offset = static_cast<uint32_t>(indices.size());
+      cluster.count = 0;
+
+      const XMVECTOR center = XMLoadFloat3(&b.center);
+      const XMVECTOR extents = XMLoadFloat3(&b.extents);
+
+      for (const uint32_t candidate : candidates) {
+        const ClusterLight& light = lights[candidate];
+        const XMVECTOR      position = XMLoadFloat3(&light.positionVS);
+
+        // Sphère / AABB : distance du centre de la lumière au point le plus proche de la boîte
+        const XMVECTOR delta = XMVectorMax(
+          XMVectorSubtract(XMVectorAbs(XMVectorSubtract(position, center)), extents),
+          XMVectorZero());
+        if (XMVectorGetX(XMVector3LengthSq(delta)) > light.range * light.range) {
+          continue;
+        }
+
+        // Cône / sphère englobante du cluster pour les spots
+        if (light.cosHalfAngle > -1.0f) {
+          const XMVECTOR toCluster = XMVectorSubtract(center, position);
+          const XMVECTOR direction = XMLoadFloat3(&light.directionVS);
+          const float    lengthSq = XMVectorGetX(XMVector3LengthSq(toCluster));
+          const float    axial = XMVectorGetX(XMVector3Dot(toCluster, direction));
+          const float    lateral = std::sqrt(std::max(lengthSq - axial * axial, 0.0f));
+          const float    closest = light.cosHalfAngle * lateral - axial * light.sinHalfAngle;
+
+          if (closest > b.radius || axial > b.radius + light.range || axial < -b.radius) {
+            continue;
+          }
+        }
+
+        indices.push_back(light.index);
+        if (++cluster.count >= MAX_LIGHTS_PER_CLUSTER) {
+          break;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <DirectXMath.h>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace FrostFireEngine
+{
+  // Lumière locale (point ou spot) exprimée dans l'espace vue, prête pour le binning
+  struct ClusterLight {
+    DirectX::XMFLOAT3 positionVS;
+    float             range;
+    DirectX::XMFLOAT3 directionVS;   // normalisée, spot uniquement
+    float             cosHalfAngle;  // <= -1 pour une lumière ponctuelle
+    float             sinHalfAngle;
+    uint32_t          index;         // indice dans le buffer GPU des lumières
+  };
+
+  struct LightCluster {
+    uint32_t offset;
+    uint32_t count;
+  };
+
+  // Grille 3D de clusters sur le frustum de la caméra (tuiles écran x tranches
+  // de profondeur exponentielles). Ne dépend que de DirectXMath et de la STL.
+  class LightClusterGrid {
+  public:
+    static constexpr uint32_t TILES_X = 16;
+    static constexpr uint32_t TILES_Y = 9;
+    static constexpr uint32_t SLICES_Z = 24;
+    static constexpr uint32_t CLUSTER_COUNT = TILES_X * TILES_Y * SLICES_Z;
+    static constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 256;
+
+    LightClusterGrid();
+    ~LightClusterGrid();
+
+    LightClusterGrid(const LightClusterGrid&) = delete;
+    LightClusterGrid& operator=(const LightClusterGrid&) = delete;
+
+    // Recalcule les boîtes des clusters uniquement si la projection a changé
+    void UpdateProjection(const DirectX::XMMATRIX& projMatrix);
+
+    // Assigne les lumières aux clusters (en parallèle sur les tranches de profondeur).
+    // Aucune allocation une fois les listes par tranche à leur taille de croisière.
+    void Build(const ClusterLight* lights, size_t lightCount);
+
+    const std::vector<LightCluster>& GetClusters() const { return m_clusters; }
+    const std::vector<uint32_t>&     GetLightIndices() const { return m_lightIndices; }
+
+    static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z)
+    {
+      return (z * TILES_Y + y) * TILES_X + x;
+    }
+
+    uint32_t GetSliceForDepth(float viewZ) const;
+
+    // slice = log(viewZ) * scale + bias, repris tel quel par le shader
+    float GetSliceScale() const { return m_sliceScale; }
+    float GetSliceBias() const { return m_sliceBias; }
+    float GetNearZ() const { return m_nearZ; }
+    float GetFarZ() const { return m_farZ; }
+
+  private:
+    // En dessous, réveiller les workers coûte plus cher que le binning lui-même
+    static constexpr size_t   PARALLEL_LIGHT_THRESHOLD = 32;
+    static constexpr uint32_t MAX_JOBS = 4;
+
+    void BuildSlice(uint32_t z, const ClusterLight* lights, size_t lightCount);
+    void RunJob(uint32_t job);
+    void WorkerLoop(uint32_t job);
+
+    struct ClusterBounds {
+      DirectX::XMFLOAT3 center;
+      float             radius;  // sphère englobante, pour le test de cône
+      DirectX::XMFLOAT3 extents;
+      float             pad;
+    };
+
+    DirectX::XMFLOAT4X4 m_projection = {};
+    float               m_nearZ = 0.1f;
+    float               m_farZ = 1000.0f;
+    float               m_sliceScale = 0.0f;
+    float               m_sliceBias = 0.0f;
+
+    std::vector<ClusterBounds>         m_bounds;
+    std::vector<float>                 m_sliceDepths;  // SLICES_Z + 1 bornes
+    std::vector<std::vector<uint32_t>> m_sliceCandidates;
+    std::vector<std::vector<uint32_t>> m_sliceIndices;
+
+    std::vector<LightCluster> m_clusters;
+    std::vector<uint32_t>     m_lightIndices;
+
+    // Jobs préalloués : le job j traite les tranches j, j + jobCount, ... Le job 0 tourne sur
+    // le thread appelant, les autres sur des threads persistants réveillés à chaque Build.
+    std::vector<std::thread> m_workers;
+    uint32_t                 m_jobCount = 1;
+    std::mutex               m_jobMutex;
+    std::condition_variable  m_jobStart;
+    std::condition_variable  m_jobDone;
+    uint64_t                 m_jobGeneration = 0;
+    uint32_t                 m_jobsPending = 0;
+    bool                     m_stopWorkers = false;
+    const ClusterLight*      m_jobLights = nullptr;
+    size_t                   m_jobLightCount = 0;
+  };
+}
@@ -0,0 +1,249 @@
+#include "SpriteBatcher.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include "Engine/Mesh.h"
+#include "Engine/MeshManager.h"
+#include "Engine/Shaders/ShaderVariant.h"
+#include "Engine/Utils/ErrorLogger.h"
+#include "SpriteSort.h"
+
+using namespace DirectX;
+using Microsoft::WRL::ComPtr;
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  namespace
+  {
+    struct MaterialData {
+      XMFLOAT4 diffuseColor;
+      XMFLOAT4 specularColor;
+      XMFLOAT4 ambientColorMat;
+    };
+  }
+
+  bool SpriteBatcher::Initialize(ID3D11Device* device)
+  {
+    m_device = device;
+    m_quadMesh = MeshManager::GetInstance().GetQuadMesh(device);
+    if (!m_quadMesh) {
+      ErrorLogger::Log("SpriteBatcher: Failed to create quad mesh.");
+      return false;
+    }
+
+    D3D11_BUFFER_DESC cbd = {};
+    cbd.Usage = D3D11_USAGE_DYNAMIC;
+    cbd.ByteWidth = sizeof(FrameConstants);
+    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    if (FAILED(device->CreateBuffer(&cbd, nullptr, &m_frameBuffer))) {
+      ErrorLogger::Log("SpriteBatcher: Failed to create frame constant buffer.");
+      return false;
+    }
+
+    // Mêmes valeurs que le matériau de SpriteRenderer, sans l'opacité
+    const MaterialData material = {
+      XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 32.0f), XMFLOAT4(1.0f, 1.0f, 1.0f, 0.0f)
+    };
+    D3D11_BUFFER_DESC mbd = {};
+    mbd.Usage = D3D11_USAGE_IMMUTABLE;
+    mbd.ByteWidth = sizeof(MaterialData);
+    mbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    D3D11_SUBRESOURCE_DATA materialData = {};
+    materialData.pSysMem = &material;
+    if (FAILED(device->CreateBuffer(&mbd, &materialData, &m_materialBuffer))) {
+      ErrorLogger::Log("SpriteBatcher: Failed to create material buffer.");
+      return false;
+    }
+
+    D3D11_SAMPLER_DESC samplerDesc = {};
+    samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+    samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+    samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    samplerDesc.MaxLOD = D3D11_FLOAT32_MAX;
+    if (FAILED(device->CreateSamplerState(&samplerDesc, &m_samplerState))) {
+      ErrorLogger::Log("SpriteBatcher: Failed to create sampler state.");
+      return false;
+    }
+
+    return EnsureCapacity(INITIAL_INSTANCE_CAPACITY);
+  }
+
+  void SpriteBatcher::Release()
+  {
+    m_instanceBuffer.Reset();
+    m_frameBuffer.Reset();
+    m_materialBuffer.Reset();
+    m_samplerState.Reset();
+    m_quadMesh.reset();
+    m_instanceCapacity = 0;
+    m_sprites.clear();
+    m_order.clear();
+    m_nextSprite = 0;
+    m_device = nullptr;
+  }
+
+  bool SpriteBatcher::EnsureCapacity(uint32_t instanceCount)
+  {
+    if (instanceCount <= m_instanceCapacity) return true;
+
+    uint32_t capacity = std::max(m_instanceCapacity, INITIAL_INSTANCE_CAPACITY);
+    while (capacity < instanceCount) capacity *= 2;
+
+    D3D11_BUFFER_DESC ibd = {};
+    ibd.Usage = D3D11_USAGE_DYNAMIC;
+    ibd.ByteWidth = static_cast<UINT>(sizeof(SpriteInstance) * capacity);
+    ibd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    ibd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    ComPtr<ID3D11Buffer> instanceBuffer;
+    if (FAILED(m_device->CreateBuffer(&ibd, nullptr, &instanceBuffer))) {
+      ErrorLogger::Log("SpriteBatcher: Failed to create instance buffer.");
+      return false;
+    }
+
+    m_instanceBuffer = instanceBuffer;
+    m_instanceCapacity = capacity;
+    return true;
+  }
+
+  void SpriteBatcher::Begin(const CameraContext& camera, const Frustum& frustum)
+  {
+    // Axes de la caméra : lignes de l'inverse de la vue, comme l'ancien chemin par objet
+    const XMMATRIX viewInverse = XMMatrixInverse(nullptr, camera.viewMatrix);
+    XMStoreFloat4x4(&m_frameConstants.viewProjection, XMMatrixTranspose(camera.viewMatrix * camera.projMatrix));
+    XMStoreFloat4(&m_frameConstants.cameraRight, XMVector3Normalize(XMVectorSetW(viewInverse.r[0], 0.0f)));
+    XMStoreFloat4(&m_frameConstants.cameraUp, XMVector3Normalize(XMVectorSetW(viewInverse.r[1], 0.0f)));
+    XMStoreFloat4(&m_frameConstants.cameraForward, XMVector3Normalize(XMVectorSetW(viewInverse.r[2], 0.0f)));
+
+    XMFLOAT4X4 view;
+    XMStoreFloat4x4(&view, camera.viewMatrix);
+    m_depthAxis = {view._13, view._23, view._33, view._43};
+    m_frustum = frustum;
+
+    m_sprites.clear();
+    m_order.clear();
+    m_nextSprite = 0;
+    m_stats = {};
+    m_stats.instanceCapacity = m_instanceCapacity;
+  }
+
+  void SpriteBatcher::Add(ShaderVariant*            variant,
+                          ID3D11ShaderResourceView* texture,
+                          const XMFLOAT3&           position,
+                          const XMFLOAT3&           scale,
+                          float                     opacity)
+  {
+    if (!variant) return;
+    m_stats.submitted++;
+
+    // Sphère englobante du quad unité, orienté face à la caméra
+    const float radius = 0.5f * std::sqrt(scale.x * scale.x + scale.y * scale.y);
+    if (!m_frustum.CheckSphere(position.x, position.y, position.z, radius)) {
+      m_stats.culled++;
+      return;
+    }
+
+    const float viewDepth = position.x * m_depthAxis.x + position.y * m_depthAxis.y + position.z * m_depthAxis.z +
+                            m_depthAxis.w;
+    m_sprites.push_back({variant, texture, viewDepth, {position, opacity, scale}});
+  }
+
+  void SpriteBatcher::End(ID3D11DeviceContext* context)
+  {
+    const uint32_t count = static_cast<uint32_t>(m_sprites.size());
+    m_stats.instances = count;
+    if (count == 0 || !EnsureCapacity(count)) return;
+
+    m_keys.resize(count);
+    m_order.resize(count);
+    for (uint32_t i = 0; i < count; i++) {
+      m_keys[i] = SpriteSort::BackToFrontKey(m_sprites[i].viewDepth);
+      m_order[i] = i;
+    }
+    // Stable : à profondeur égale, l'ordre de soumission est conservé
+    SpriteSort::RadixSort(m_keys, m_order, m_scratchKeys, m_scratchOrder);
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(context->Map(m_instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+      ErrorLogger::Log("SpriteBatcher: Failed to map instance buffer.");
+      m_order.clear();
+      return;
+    }
+    auto* dst = static_cast<SpriteInstance*>(mapped.pData);
+    for (uint32_t i = 0; i < count; i++) {
+      dst[i] = m_sprites[m_order[i]].instance;
+    }
+    context->Unmap(m_instanceBuffer.Get(), 0);
+
+    if (FAILED(context->Map(m_frameBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+      ErrorLogger::Log("SpriteBatcher: Failed to map frame constant buffer.");
+      m_order.clear();
+      return;
+    }
+    memcpy(mapped.pData, &m_frameConstants, sizeof(m_frameConstants));
+    context->Unmap(m_frameBuffer.Get(), 0);
+
+    m_stats.instanceCapacity = m_instanceCapacity;
+  }
+
+  void SpriteBatcher::DrawFartherThan(ID3D11DeviceContext* context, float viewDepth)
+  {
+    // m_order est trié par profondeur décroissante : on avance jusqu'au premier plus proche
+    size_t end = m_nextSprite;
+    while (end < m_order.size() && m_sprites[m_order[end]].viewDepth > viewDepth) end++;
+    DrawUntil(context, end);
+  }
+
+  void SpriteBatcher::DrawRemaining(ID3D11DeviceContext* context)
+  {
+    DrawUntil(context, m_order.size());
+  }
+
+  void SpriteBatcher::DrawUntil(ID3D11DeviceContext* context, size_t end)
+  {
+    if (m_nextSprite >= end) return;
+
+    // Un autre transparent a pu être dessiné depuis le dernier appel : tout est relié
+    ID3D11Buffer* buffers[] = {m_quadMesh->GetVertexBuffer(), m_instanceBuffer.Get()};
+    const UINT    strides[] = {sizeof(Vertex), sizeof(SpriteInstance)};
+    const UINT    offsets[] = {0, 0};
+    context->IASetVertexBuffers(0, 2, buffers, strides, offsets);
+    context->IASetIndexBuffer(m_quadMesh->GetIndexBuffer(), DXGI_FORMAT_R32_UINT, 0);
+    context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context->VSSetConstantBuffers(0, 1, m_frameBuffer.GetAddressOf());
+    context->PSSetConstantBuffers(1, 1, m_materialBuffer.GetAddressOf());
+
+    const UINT     indexCount = m_quadMesh->GetIndexCount();
+    ShaderVariant* currentVariant = nullptr;
+    while (m_nextSprite < end) {
+      const Sprite& first = m_sprites[m_order[m_nextSprite]];
+      size_t        runEnd = m_nextSprite + 1;
+      while (runEnd < end) {
+        const Sprite& sprite = m_sprites[m_order[runEnd]];
+        if (sprite.variant != first.variant || sprite.texture != first.texture) break;
+        runEnd++;
+      }
+
+      if (first.variant != currentVariant) {
+        first.variant->Apply(context);
+        context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
+        currentVariant = first.variant;
+      }
+      ID3D11ShaderResourceView* texture = first.texture;
+      context->PSSetShaderResources(0, 1, &texture);
+
+      context->DrawIndexedInstanced(indexCount, static_cast<UINT>(runEnd - m_nextSprite), 0, 0,
+                                    static_cast<UINT>(m_nextSprite));
+      m_stats.draws++;
+      m_nextSprite = runEnd;
+    }
+  }
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Engine/CameraContext.h"
+#include "Engine/Math/Frustum.h"
+
+namespace FrostFireEngine
+{
+  class Mesh;
+  class ShaderVariant;
+
+  // Define des variants de TransparencyPass qui lisent les billboards instanciés
+  constexpr const char* SPRITE_INSTANCING_FEATURE = "SPRITE_INSTANCING";
+
+  // Données d'un billboard lues par le VS (flux 1 de BillboardInstanceLayout) : l'orientation
+  // est celle de la caméra, commune à toute la frame
+  struct SpriteInstance {
+    DirectX::XMFLOAT3 position;  // centre dans le monde
+    float             opacity;
+    DirectX::XMFLOAT3 scale;
+  };
+  static_assert(sizeof(SpriteInstance) == 28);
+
+  struct SpriteBatchStats {
+    uint32_t submitted = 0;         // billboards soumis, soit un draw chacun sans batching
+    uint32_t culled = 0;            // hors du frustum
+    uint32_t instances = 0;
+    uint32_t draws = 0;             // draws instanciés émis
+    uint32_t instanceCapacity = 0;  // taille de l'instance buffer, doublée quand la frame déborde
+  };
+
+  // Regroupe les billboards d'une frame dans un instance buffer dynamique. Les billboards sont
+  // triés de l'arrière vers l'avant (tri par base sur la profondeur vue, calculée une fois à la
+  // soumission) ; chaque suite de même variant et même texture est un seul draw instancié du quad.
+  // Les autres transparents s'intercalent avec DrawFartherThan pour garder l'ordre de composition.
+  class SpriteBatcher {
+  public:
+    static constexpr uint32_t INITIAL_INSTANCE_CAPACITY = 1024;
+
+    bool Initialize(ID3D11Device* device);
+    void Release();
+
+    void Begin(const CameraContext& camera, const Frustum& frustum);
+
+    // Billboard centré sur position ; ignoré s'il sort du frustum
+    void Add(ShaderVariant*            variant,
+             ID3D11ShaderResourceView* texture,
+             const DirectX::XMFLOAT3&  position,
+             const DirectX::XMFLOAT3&  scale,
+             float                     opacity);
+
+    // Trie les billboards et remplit l'instance buffer ; les draws sont émis ensuite
+    void End(ID3D11DeviceContext* context);
+
+    // Dessine les billboards restants plus lointains que viewDepth. Les états de fusion et de
+    // profondeur sont ceux déjà en place.
+    void DrawFartherThan(ID3D11DeviceContext* context, float viewDepth);
+    void DrawRemaining(ID3D11DeviceContext* context);
+
+    const SpriteBatchStats& GetStats() const { return m_stats; }
+
+  private:
+    struct Sprite {
+      ShaderVariant*            variant;
+      ID3D11ShaderResourceView* texture;
+      float                     viewDepth;
+      SpriteInstance            instance;
+    };
+
+    // Constantes du VS instancié (SpriteFrameBuffer de TransparencyPass.fx)
+    struct FrameConstants {
+      DirectX::XMFLOAT4X4 viewProjection;  // transposée
+      DirectX::XMFLOAT4   cameraRight;
+      DirectX::XMFLOAT4   cameraUp;
+      DirectX::XMFLOAT4   cameraForward;
+    };
+
+    bool EnsureCapacity(uint32_t instanceCount);
+    void DrawUntil(ID3D11DeviceContext* context, size_t end);
+
+    ID3D11Device*                              m_device = nullptr;
+    std::shared_ptr<Mesh>                      m_quadMesh;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>       m_instanceBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>       m_frameBuffer;     // viewProjection et axes caméra
+    Microsoft::WRL::ComPtr<ID3D11Buffer>       m_materialBuffer;  // constant, l'opacité est par instance
+    Microsoft::WRL::ComPtr<ID3D11SamplerState> m_samplerState;
+    uint32_t                                   m_instanceCapacity = 0;
+
+    // Conservés d'une frame à l'autre : pas d'allocation en régime établi
+    std::vector<Sprite>   m_sprites;
+    std::vector<uint32_t> m_keys;
+    std::vector<uint32_t> m_order;  // indices dans m_sprites, de l'arrière vers l'avant
+    std::vector<uint32_t> m_scratchKeys;
+    std::vector<uint32_t> m_scratchOrder;
+    size_t                m_nextSprite = 0;  // premier élément de m_order pas encore dessiné
+
+    FrameConstants    m_frameConstants = {};
+    DirectX::XMFLOAT4 m_depthAxis = {};  // colonne z de la vue : profondeur = dot(position, xyz) + w
+    Frustum           m_frustum;
+    SpriteBatchStats  m_stats;
+  };
+}
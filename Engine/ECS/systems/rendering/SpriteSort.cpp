@@ -0,0 +1,48 @@
+#include "SpriteSort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace FrostFireEngine
+{
+  namespace SpriteSort
+  {
+    uint32_t BackToFrontKey(float viewDepth)
+    {
+      uint32_t bits;
+      memcpy(&bits, &viewDepth, sizeof(bits));
+      bits ^= (bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+      return ~bits;
+    }
+
+    // 4 passes de 8 bits ; une passe dont tous les éléments partagent l'octet est sautée
+    // (profondeurs proches : les octets de poids fort sont souvent identiques)
+    void RadixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& order,
+                   std::vector<uint32_t>& scratchKeys, std::vector<uint32_t>& scratchOrder)
+    {
+      const size_t count = keys.size();
+      scratchKeys.resize(count);
+      scratchOrder.resize(count);
+
+      for (uint32_t shift = 0; shift < 32; shift += 8) {
+        uint32_t histogram[257] = {};
+        for (const uint32_t key : keys) {
+          histogram[((key >> shift) & 0xFF) + 1]++;
+        }
+        if (std::find(std::begin(histogram) + 1, std::end(histogram), count) != std::end(histogram)) continue;
+
+        for (uint32_t bucket = 0; bucket < 256; bucket++) {
+          histogram[bucket + 1] += histogram[bucket];
+        }
+        for (size_t i = 0; i < count; i++) {
+          const uint32_t destination = histogram[(keys[i] >> shift) & 0xFF]++;
+          scratchKeys[destination] = keys[i];
+          scratchOrder[destination] = order[i];
+        }
+        keys.swap(scratchKeys);
+        order.swap(scratchOrder);
+      }
+    }
+  }
+}
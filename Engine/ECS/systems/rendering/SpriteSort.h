@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace FrostFireEngine
+{
+  // Tri des sprites de l'arrière vers l'avant, sans dépendance à D3D11
+  namespace SpriteSort
+  {
+    // Clé croissante de l'arrière vers l'avant : flottant rendu comparable en entier, puis inversé
+    uint32_t BackToFrontKey(float viewDepth);
+
+    // Tri par base stable des clés ; order est permuté avec elles.
+    // Les tampons scratch sont réutilisés d'un appel à l'autre.
+    void RadixSort(std::vector<uint32_t>& keys, std::vector<uint32_t>& order,
+                   std::vector<uint32_t>& scratchKeys, std::vector<uint32_t>& scratchOrder);
+  }
+}
@@ -0,0 +1,273 @@
+#include "UIBatcher.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+
+#include "Engine/Shaders/ShaderVariant.h"
+#include "Engine/Utils/ErrorLogger.h"
+
+using namespace DirectX;
+using Microsoft::WRL::ComPtr;
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  namespace
+  {
+    bool SameRect(const D3D11_RECT& a, const D3D11_RECT& b)
+    {
+      return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+    }
+
+    bool Overlaps(const XMFLOAT4& a, const XMFLOAT4& b)
+    {
+      return a.x < b.z && b.x < a.z && a.y < b.w && b.y < a.w;
+    }
+  }
+
+  bool UIBatcher::Initialize(ID3D11Device* device)
+  {
+    m_device = device;
+
+    D3D11_BUFFER_DESC cbd = {};
+    cbd.Usage = D3D11_USAGE_DYNAMIC;
+    cbd.ByteWidth = sizeof(XMFLOAT4X4);
+    cbd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    cbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    if (FAILED(device->CreateBuffer(&cbd, nullptr, &m_projectionBuffer))) {
+      ErrorLogger::Log("UIBatcher: Failed to create projection constant buffer.");
+      return false;
+    }
+
+    D3D11_SAMPLER_DESC samplerDesc = {};
+    samplerDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+    samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+    samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    if (FAILED(device->CreateSamplerState(&samplerDesc, &m_samplerState))) {
+      ErrorLogger::Log("UIBatcher: Failed to create sampler state.");
+      return false;
+    }
+
+    // Pas de culling : une rotation ou une échelle négative de RectTransform inverse l'ordre des sommets
+    D3D11_RASTERIZER_DESC rasterDesc = {};
+    rasterDesc.FillMode = D3D11_FILL_SOLID;
+    rasterDesc.CullMode = D3D11_CULL_NONE;
+    rasterDesc.DepthClipEnable = TRUE;
+    rasterDesc.ScissorEnable = TRUE;
+    if (FAILED(device->CreateRasterizerState(&rasterDesc, &m_rasterizerState))) {
+      ErrorLogger::Log("UIBatcher: Failed to create rasterizer state.");
+      return false;
+    }
+
+    return EnsureCapacity(INITIAL_QUAD_CAPACITY);
+  }
+
+  void UIBatcher::Release()
+  {
+    m_vertexBuffer.Reset();
+    m_indexBuffer.Reset();
+    m_projectionBuffer.Reset();
+    m_samplerState.Reset();
+    m_rasterizerState.Reset();
+    m_quadCapacity = 0;
+    m_batches.clear();
+    m_batchCount = 0;
+    m_device = nullptr;
+  }
+
+  bool UIBatcher::EnsureCapacity(uint32_t quadCount)
+  {
+    if (quadCount <= m_quadCapacity) return true;
+
+    uint32_t capacity = std::max(m_quadCapacity, INITIAL_QUAD_CAPACITY);
+    while (capacity < quadCount) capacity *= 2;
+
+    D3D11_BUFFER_DESC vbd = {};
+    vbd.Usage = D3D11_USAGE_DYNAMIC;
+    vbd.ByteWidth = static_cast<UINT>(sizeof(UIVertex) * 4 * capacity);
+    vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    vbd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    ComPtr<ID3D11Buffer> vertexBuffer;
+    if (FAILED(m_device->CreateBuffer(&vbd, nullptr, &vertexBuffer))) {
+      ErrorLogger::Log("UIBatcher: Failed to create vertex buffer.");
+      return false;
+    }
+
+    // Tous les lots sont des quads : le motif d'indices est fixe, seul le nombre de quads change
+    std::vector<DWORD> indices(static_cast<size_t>(capacity) * 6);
+    for (uint32_t quad = 0; quad < capacity; quad++) {
+      const DWORD base = quad * 4;
+      DWORD*      out = &indices[static_cast<size_t>(quad) * 6];
+      out[0] = base + 0;
+      out[1] = base + 1;
+      out[2] = base + 2;
+      out[3] = base + 1;
+      out[4] = base + 3;
+      out[5] = base + 2;
+    }
+
+    D3D11_BUFFER_DESC ibd = {};
+    ibd.Usage = D3D11_USAGE_IMMUTABLE;
+    ibd.ByteWidth = static_cast<UINT>(sizeof(DWORD) * indices.size());
+    ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = indices.data();
+
+    ComPtr<ID3D11Buffer> indexBuffer;
+    if (FAILED(m_device->CreateBuffer(&ibd, &initData, &indexBuffer))) {
+      ErrorLogger::Log("UIBatcher: Failed to create index buffer.");
+      return false;
+    }
+
+    m_vertexBuffer = vertexBuffer;
+    m_indexBuffer = indexBuffer;
+    m_quadCapacity = capacity;
+    return true;
+  }
+
+  void UIBatcher::Begin(float viewportWidth, float viewportHeight)
+  {
+    m_viewportWidth = viewportWidth;
+    m_viewportHeight = viewportHeight;
+    m_screenRect = {0, 0, static_cast<LONG>(viewportWidth), static_cast<LONG>(viewportHeight)};
+
+    for (size_t i = 0; i < m_batchCount; i++) {
+      m_batches[i].vertices.clear();
+    }
+    m_batchCount = 0;
+    m_stats = {};
+    m_stats.quadCapacity = m_quadCapacity;
+  }
+
+  void UIBatcher::AddQuads(ShaderVariant*            variant,
+                           ID3D11ShaderResourceView* texture,
+                           const D3D11_RECT*         clipRect,
+                           const UIQuadVertex*       vertices,
+                           size_t                    quadCount,
+                           const XMMATRIX&           transform,
+                           const XMFLOAT4&           color)
+  {
+    if (!variant || quadCount == 0) return;
+
+    // Passage en pixels écran sur le CPU : un seul jeu de constantes pour toute l'interface
+    m_scratch.resize(quadCount * 4);
+    XMFLOAT4 bounds = {FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (size_t i = 0; i < m_scratch.size(); i++) {
+      UIVertex& out = m_scratch[i];
+      XMStoreFloat2(&out.pos, XMVector2Transform(XMLoadFloat2(&vertices[i].pos), transform));
+      out.uv = vertices[i].uv;
+      out.color = color;
+
+      bounds.x = std::min(bounds.x, out.pos.x);
+      bounds.y = std::min(bounds.y, out.pos.y);
+      bounds.z = std::max(bounds.z, out.pos.x);
+      bounds.w = std::max(bounds.w, out.pos.y);
+    }
+
+    const D3D11_RECT clip = clipRect ? *clipRect : m_screenRect;
+
+    // On remonte les lots récents : le premier de même clé reçoit l'élément, sauf si un lot
+    // dessiné entre-temps le chevauche (l'élément passerait alors dessous)
+    Batch*       target = nullptr;
+    const size_t first = m_batchCount > MAX_MERGE_LOOKBACK ? m_batchCount - MAX_MERGE_LOOKBACK : 0;
+    for (size_t i = m_batchCount; i-- > first;) {
+      Batch& batch = m_batches[i];
+      if (batch.variant == variant && batch.texture == texture && SameRect(batch.clipRect, clip)) {
+        target = &batch;
+        break;
+      }
+      if (Overlaps(batch.bounds, bounds)) break;
+    }
+
+    if (target) {
+      target->bounds.x = std::min(target->bounds.x, bounds.x);
+      target->bounds.y = std::min(target->bounds.y, bounds.y);
+      target->bounds.z = std::max(target->bounds.z, bounds.z);
+      target->bounds.w = std::max(target->bounds.w, bounds.w);
+    }
+    else {
+      if (m_batchCount == m_batches.size()) m_batches.emplace_back();
+      target = &m_batches[m_batchCount++];
+      target->variant = variant;
+      target->texture = texture;
+      target->clipRect = clip;
+      target->bounds = bounds;
+    }
+
+    target->vertices.insert(target->vertices.end(), m_scratch.begin(), m_scratch.end());
+    m_stats.elements++;
+    m_stats.quads += static_cast<uint32_t>(quadCount);
+  }
+
+  void UIBatcher::End(ID3D11DeviceContext* context)
+  {
+    if (m_batchCount == 0 || !EnsureCapacity(m_stats.quads)) return;
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(context->Map(m_vertexBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+      ErrorLogger::Log("UIBatcher: Failed to map vertex buffer.");
+      return;
+    }
+    auto* dst = static_cast<UIVertex*>(mapped.pData);
+    for (size_t i = 0; i < m_batchCount; i++) {
+      const auto& vertices = m_batches[i].vertices;
+      memcpy(dst, vertices.data(), sizeof(UIVertex) * vertices.size());
+      dst += vertices.size();
+    }
+    context->Unmap(m_vertexBuffer.Get(), 0);
+
+    if (FAILED(context->Map(m_projectionBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
+      ErrorLogger::Log("UIBatcher: Failed to map projection constant buffer.");
+      return;
+    }
+    const XMMATRIX projection = XMMatrixOrthographicOffCenterLH(0.0f, m_viewportWidth, m_viewportHeight, 0.0f,
+                                                                0.0f, 1.0f);
+    XMStoreFloat4x4(static_cast<XMFLOAT4X4*>(mapped.pData), XMMatrixTranspose(projection));
+    context->Unmap(m_projectionBuffer.Get(), 0);
+
+    UINT stride = sizeof(UIVertex);
+    UINT offset = 0;
+    context->IASetVertexBuffers(0, 1, m_vertexBuffer.GetAddressOf(), &stride, &offset);
+    context->IASetIndexBuffer(m_indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+    context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context->VSSetConstantBuffers(0, 1, m_projectionBuffer.GetAddressOf());
+    context->RSSetState(m_rasterizerState.Get());
+
+    // Les changements d'état ne sont émis que d'un lot à l'autre
+    ShaderVariant*            currentVariant = nullptr;
+    ID3D11ShaderResourceView* currentTexture = nullptr;
+    const D3D11_RECT*         currentClip = nullptr;
+    UINT                      firstQuad = 0;
+    for (size_t i = 0; i < m_batchCount; i++) {
+      const Batch& batch = m_batches[i];
+      if (batch.variant != currentVariant) {
+        batch.variant->Apply(context);
+        context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
+        currentVariant = batch.variant;
+      }
+      if (batch.texture != currentTexture || i == 0) {
+        context->PSSetShaderResources(0, 1, &batch.texture);
+        currentTexture = batch.texture;
+      }
+      if (!currentClip || !SameRect(batch.clipRect, *currentClip)) {
+        context->RSSetScissorRects(1, &batch.clipRect);
+        currentClip = &batch.clipRect;
+      }
+
+      const UINT quadCount = static_cast<UINT>(batch.vertices.size() / 4);
+      context->DrawIndexed(quadCount * 6, firstQuad * 6, 0);
+      firstQuad += quadCount;
+    }
+    m_stats.batches = static_cast<uint32_t>(m_batchCount);
+    m_stats.quadCapacity = m_quadCapacity;
+
+    // Les autres passes supposent l'état de rastérisation par défaut
+    context->RSSetState(nullptr);
+  }
+}
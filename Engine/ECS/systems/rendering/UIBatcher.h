@@ -0,0 +1,89 @@
+#pragma once
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <vector>
+
+namespace FrostFireEngine
+{
+  class ShaderVariant;
+
+  // Coin d'un quad dans l'espace local de l'élément, avant la matrice de RectTransform
+  struct UIQuadVertex {
+    DirectX::XMFLOAT2 pos;
+    DirectX::XMFLOAT2 uv;
+  };
+
+  // Sommet envoyé au GPU : position en pixels écran et teinte (voir UIVertexLayout)
+  struct UIVertex {
+    DirectX::XMFLOAT2 pos;
+    DirectX::XMFLOAT2 uv;
+    DirectX::XMFLOAT4 color;
+  };
+
+  struct UIBatchStats {
+    uint32_t elements = 0;      // composants soumis, soit un draw chacun sans batching
+    uint32_t quads = 0;
+    uint32_t batches = 0;       // draws émis
+    uint32_t quadCapacity = 0;  // taille du vertex buffer, doublée quand la frame déborde
+  };
+
+  // Regroupe les quads de toute l'interface d'une frame dans un seul vertex buffer dynamique.
+  // Un lot partage variant, texture et rectangle de découpe ; l'ordre d'affichage est conservé :
+  // un élément ne rejoint un lot antérieur que s'il ne chevauche aucun des lots dessinés après.
+  class UIBatcher {
+  public:
+    static constexpr uint32_t INITIAL_QUAD_CAPACITY = 1024;
+    static constexpr uint32_t MAX_MERGE_LOOKBACK = 8;  // lots remontés pour trouver la même clé
+
+    bool Initialize(ID3D11Device* device);
+    void Release();
+
+    void Begin(float viewportWidth, float viewportHeight);
+
+    // quadCount quads de 4 sommets (haut-gauche, haut-droit, bas-gauche, bas-droit) transformés
+    // par transform ; clipRect en pixels, nullptr pour tout l'écran
+    void AddQuads(ShaderVariant*            variant,
+                  ID3D11ShaderResourceView* texture,
+                  const D3D11_RECT*         clipRect,
+                  const UIQuadVertex*       vertices,
+                  size_t                    quadCount,
+                  const DirectX::XMMATRIX&  transform,
+                  const DirectX::XMFLOAT4&  color);
+
+    // Remplit le vertex buffer et émet un draw par lot. Les états de fusion et de profondeur
+    // sont ceux déjà en place.
+    void End(ID3D11DeviceContext* context);
+
+    const UIBatchStats& GetStats() const { return m_stats; }
+
+  private:
+    struct Batch {
+      ShaderVariant*            variant;
+      ID3D11ShaderResourceView* texture;
+      D3D11_RECT                clipRect;
+      DirectX::XMFLOAT4         bounds;  // minX, minY, maxX, maxY des quads du lot
+      std::vector<UIVertex>     vertices;
+    };
+
+    bool EnsureCapacity(uint32_t quadCount);
+
+    ID3D11Device*                                 m_device = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>          m_vertexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>          m_indexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer>          m_projectionBuffer;
+    Microsoft::WRL::ComPtr<ID3D11SamplerState>    m_samplerState;
+    Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizerState;  // découpe activée
+    uint32_t                                      m_quadCapacity = 0;
+
+    // Les lots gardent leur vecteur d'une frame à l'autre : pas d'allocation en régime établi
+    std::vector<Batch>    m_batches;
+    size_t                m_batchCount = 0;
+    std::vector<UIVertex> m_scratch;
+    D3D11_RECT            m_screenRect = {};
+    float                 m_viewportWidth = 0.0f;
+    float                 m_viewportHeight = 0.0f;
+    UIBatchStats          m_stats;
+  };
+}
@@ -11,6 +11,7 @@
 #include "Clock.h"
 #include "SceneManager.h"
 #include "Core/PhysicsResources.h"
+#include "Font/FontManager.h"
 #include "ECS/systems/CameraSystem.h"
 #include "ECS/systems/RenderingSystem.h"
 
@@ -55,6 +56,7 @@ namespace FrostFireEngine
     void Cleanup()
     {
       inputManager.Release();
+      FontManager::GetInstance().SaveFontCaches();
 
       if (pDevice) {
         delete pDevice;
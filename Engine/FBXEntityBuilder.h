@@ -4,18 +4,29 @@
 #include <memory>
 #include <DirectXMath.h>
 #include <filesystem>
-#include <map>
 #include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <execution>
+#include <limits>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "Engine/ECS/core/Entity.h"
 #include "TextureManager.h"
 #include "Mesh.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "VertexWelder.h"
+#include "SceneCache.h"
 #include "Engine/ECS/core/World.h"
 #include "ECS/components/mesh/MeshComponent.h"
 #include "ECS/components/physics/ColliderComponent.h"
 #include "ECS/components/physics/RigidBodyComponent.h"
 #include "ECS/components/rendering/PBRRenderer.h"
+#include "Utils/ErrorLogger.h"
 
 namespace FrostFireEngine
 {
@@ -33,17 +44,61 @@ namespace FrostFireEngine
       bool                        addRigidbody = false;
       RigidBodyComponent::Type    rigidBodyType = RigidBodyComponent::Type::Static;
       ColliderComponent::MeshType colliderMeshType = ColliderComponent::MeshType::Convex;
-      bool                        optimizeMeshes = true;
+      bool                        optimizeMeshes = true;  // ordre cache / overdraw / fetch
       bool                        flipUVs = false;
       bool                        importMaterials = true;
       bool                        importTextures = true;
+      bool                        generateLODs = true;
+      VertexWelder::Epsilons      weldEpsilons;  // tolérances de fusion des sommets
+      VertexFormat                vertexFormat = VertexFormat::Packed;  // Full si les UV sortent de la plage
     };
 
+    // Chaîne de LOD générée à l'import : ratio de triangles, erreur relative au rayon
+    // et taille à l'écran (fraction de la hauteur) sous laquelle le niveau est utilisé
+    struct LODSettings {
+      float ratio;
+      float maxError;
+      float screenSize;
+    };
+
+    static constexpr LODSettings LOD_CHAIN[] = {
+      {0.5f, 0.01f, 0.25f},
+      {0.25f, 0.03f, 0.1f},
+      {0.125f, 0.08f, 0.04f},
+    };
+
+    // En dessous, un LOD ne réduit presque rien et coûte de la mémoire
+    static constexpr size_t LOD_MIN_TRIANGLES = 256;
+
+
+    // Statistiques d'optimisation d'un maillage importé (cf. MeshOptimizer::OptimizeWithStats)
+    struct MeshStats : MeshOptimizer::MeshStats {
+      std::string name;
+    };
+
+    // Durée de chaque étape d'un import depuis le FBX, en millisecondes
+    struct ImportTimings {
+      double sceneLoadMs = 0.0;     // lecture et triangulation par le SDK FBX
+      double gatherMs = 0.0;        // copie des données des maillages (un seul thread)
+      double weldMs = 0.0;          // dés-indexation et soudure des sommets (parallèle)
+      double processMs = 0.0;       // optimisation et LODs (parallèle)
+      double colliderCookMs = 0.0;  // cuisson PhysX des colliders (parallèle)
+      double commitMs = 0.0;        // création des entités et des ressources GPU, toutes tranches cumulées
+      double cacheWriteMs = 0.0;
+    };
 
     struct BuildResult {
       bool                    success = false;
       std::shared_ptr<Entity> rootEntity;
       std::string             errorMessage;
+      std::vector<MeshStats>  meshStats;  // vide lors d'un chargement depuis le cache
+      bool                    loadedFromCache = false;
+      double                  loadTimeMs = 0.0;   // import FBX ou lecture du cache, création des entités comprise, hors attente entre les tranches
+      ImportTimings           timings;            // vide lors d'un chargement depuis le cache
+      uint32_t                cornerCount = 0;    // sommets par coin de triangle, avant soudure
+      uint32_t                weldedVertexCount = 0;
+      size_t                  vertexMemorySize = 0;  // octets de sommets sur GPU, LODs compris
+      uint32_t                skippedColliderCount = 0;  // groupes sans collider, faute de cuisson PhysX
     };
 
     FBXEntityBuilder(DispositifD3D11* pDispositif)
@@ -57,75 +112,137 @@ namespace FrostFireEngine
       CleanupFBXSDK();
     }
 
+    // Construction synchrone : préparation puis création de toutes les entités
     BuildResult BuildFromFile(const BuildSettings& settings)
     {
-      BuildResult result;
+      Prepare(settings);
+      while (!Commit()) {}
+      return TakeResult();
+    }
+
+    // Construction en deux temps, pour le chargement asynchrone des scènes :
+    // Prepare() lit le cache ou importe et traite le FBX, sur n'importe quel thread, sans
+    // toucher au World ni au périphérique D3D ; Commit() crée ensuite les entités et les
+    // ressources GPU sur le thread principal, par tranches de budgetMs.
+    bool Prepare(const BuildSettings& settings)
+    {
+      const auto startTime = std::chrono::steady_clock::now();
+
+      m_settings = settings;
+      m_result = {};
+      m_rootEntity.reset();
+      m_commitCursor = 0;
+      m_cacheWriter = {};
+      m_cacheMeshes.clear();
+      m_cacheColliders.clear();
 
       // Chemin du fichier de cache
-      std::filesystem::path fbxFilePath(settings.fbxPath);
-      std::filesystem::path cacheFilePath = fbxFilePath;
-      cacheFilePath.replace_extension(".cache");
-
-      if (exists(cacheFilePath)) {
-        // Charger depuis le cache
-        if (LoadFromCache(cacheFilePath.string(), result)) {
-          result.success = true;
-          return result;
-        }
-        else {
-          result.errorMessage = "Échec du chargement depuis le cache";
-          return result;
-        }
+      const std::filesystem::path fbxFilePath(settings.fbxPath);
+      m_cacheFilePath = fbxFilePath;
+      m_cacheFilePath.replace_extension(".cache");
+      m_cacheKey = MakeCacheKey(fbxFilePath, settings);
+
+      // Un cache absent, périmé ou d'une autre version est reconstruit depuis le FBX
+      if (m_cacheReader.Open(m_cacheFilePath, m_cacheKey)) {
+        m_result.loadedFromCache = true;
+        m_state = CommitState::Cache;
+        m_result.loadTimeMs = ElapsedMs(startTime);
+        return true;
       }
-      else {
-        // Charger depuis le fichier FBX
-        FbxScene* scene = nullptr;
-        if (!LoadFBXScene(settings.fbxPath, scene)) {
-          result.errorMessage = "Échec du chargement de la scène FBX";
-          return result;
-        }
 
-        const auto rootEntity = World::GetInstance().CreateEntity();
+      const auto elapsedMs = [](std::chrono::steady_clock::time_point& since) {
+        const auto now = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(now - since).count();
+        since = now;
+        return ms;
+      };
+      auto stageTime = startTime;
+
+      // Charger depuis le fichier FBX
+      ReleaseFBXScene();
+      if (!LoadFBXScene(settings.fbxPath, m_pScene)) {
+        m_result.errorMessage = "Échec du chargement de la scène FBX";
+        m_state = CommitState::Done;
+        return false;
+      }
+      m_result.timings.sceneLoadMs = elapsedMs(stageTime);
+
+      FbxNode*         rootNode = m_pScene->GetRootNode();
+      const FbxAMatrix rootGlobalTransform = rootNode->EvaluateGlobalTransform();
+
+      FbxVector4       rotationPivot = rootNode->GetRotationPivot(FbxNode::eSourcePivot);
+      FbxVector4       scalingPivot = rootNode->GetScalingPivot(FbxNode::eSourcePivot);
+      const FbxVector4 pivotPoint(
+        (rotationPivot[0] + scalingPivot[0]) * 0.5,
+        (rotationPivot[1] + scalingPivot[1]) * 0.5,
+        (rotationPivot[2] + scalingPivot[2]) * 0.5,
+        1.0
+      );
+      FbxVector4 globalPivot = rootGlobalTransform.MultT(pivotPoint);
 
-        FbxNode*         rootNode = scene->GetRootNode();
-        const FbxAMatrix rootGlobalTransform = rootNode->EvaluateGlobalTransform();
+      m_pivotPosition = XMFLOAT3(
+        static_cast<float>(globalPivot[0] * settings.scaleFactor),
+        static_cast<float>(globalPivot[1] * settings.scaleFactor),
+        static_cast<float>(globalPivot[2] * settings.scaleFactor)
+      );
 
-        FbxVector4       rotationPivot = rootNode->GetRotationPivot(FbxNode::eSourcePivot);
-        FbxVector4       scalingPivot = rootNode->GetScalingPivot(FbxNode::eSourcePivot);
-        const FbxVector4 pivotPoint(
-          (rotationPivot[0] + scalingPivot[0]) * 0.5,
-          (rotationPivot[1] + scalingPivot[1]) * 0.5,
-          (rotationPivot[2] + scalingPivot[2]) * 0.5,
-          1.0
-        );
-        FbxVector4 globalPivot = rootGlobalTransform.MultT(pivotPoint);
+      m_importNodes.clear();
+      m_importMeshes.clear();
+      GatherNode(rootNode, IMPORT_ROOT, settings, globalPivot);
+      m_result.timings.gatherMs = elapsedMs(stageTime);
 
-        const XMFLOAT3 pivotPosition(
-          static_cast<float>(globalPivot[0] * settings.scaleFactor),
-          static_cast<float>(globalPivot[1] * settings.scaleFactor),
-          static_cast<float>(globalPivot[2] * settings.scaleFactor)
-        );
+      WeldImportedMeshes(settings);
+      m_result.timings.weldMs = elapsedMs(stageTime);
 
-        rootEntity->AddComponent<TransformComponent>(
-          XMFLOAT3(
-            settings.basePosition.x + pivotPosition.x,
-            settings.basePosition.y + pivotPosition.y,
-            settings.basePosition.z + pivotPosition.z
-          ),
-          settings.baseRotation,
-          settings.baseScale
-        );
+      PrepareImportedGroups(settings);
+      m_result.timings.processMs = elapsedMs(stageTime);
 
-        ProcessNode(rootNode, rootEntity, settings, globalPivot);
+      CookImportedColliders(settings);
+      m_result.timings.colliderCookMs = elapsedMs(stageTime);
 
-        result.success = true;
-        result.rootEntity = rootEntity;
+      m_state = CommitState::Import;
+      m_result.loadTimeMs = ElapsedMs(startTime);
+      return true;
+    }
+
+    // Renvoie vrai quand la construction est terminée (ou a échoué dans Prepare).
+    // Au moins une entité est créée par appel, même avec un budget nul.
+    bool Commit(double budgetMs = std::numeric_limits<double>::infinity())
+    {
+      const auto startTime = std::chrono::steady_clock::now();
+      bool       done = true;
 
-        // Sauvegarder dans le cache
-        SaveToCache(cacheFilePath.string(), rootEntity);
+      if (m_state == CommitState::Cache) {
+        done = CommitCachedEntities(startTime, budgetMs);
+      }
+      else if (m_state == CommitState::Import) {
+        done = CommitImportedNodes(startTime, budgetMs);
+        m_result.timings.commitMs += ElapsedMs(startTime);
+
+        if (done) {
+          // Un seul message pour tout l'import ; le chargement de la scène continue
+          if (m_result.skippedColliderCount > 0) {
+            ErrorLogger::Log(E_FAIL, std::to_string(m_result.skippedColliderCount) + " collider(s) of " +
+                             m_settings.fbxPath + " could not be cooked and were skipped.");
+          }
 
-        return result;
+          // Sauvegarder dans le cache
+          const auto cacheTime = std::chrono::steady_clock::now();
+          SaveToCache(m_cacheFilePath, m_cacheKey, m_result.rootEntity);
+          m_result.timings.cacheWriteMs = ElapsedMs(cacheTime);
+        }
+      }
+      else {
+        return true;
       }
+
+      m_result.loadTimeMs += ElapsedMs(startTime);
+      return done;
+    }
+
+    BuildResult TakeResult()
+    {
+      return std::move(m_result);
     }
 
   private:
@@ -137,6 +254,36 @@ namespace FrostFireEngine
     XMFLOAT3 m_minBounds{FLT_MAX, FLT_MAX, FLT_MAX};
     XMFLOAT3 m_maxBounds{-FLT_MAX, -FLT_MAX, -FLT_MAX};
 
+    // Construction en cours, entre Prepare() et la fin de Commit()
+    enum class CommitState {
+      Done,
+      Cache,  // entités lues depuis le cache
+      Import  // entités créées depuis le FBX traité
+    };
+
+    CommitState             m_state = CommitState::Done;
+    BuildSettings           m_settings;
+    BuildResult             m_result;
+    std::filesystem::path   m_cacheFilePath;
+    SceneCacheKey           m_cacheKey;
+    SceneCacheReader        m_cacheReader;
+    SceneCacheWriter        m_cacheWriter;  // géométrie importée, copiée à la création des Mesh
+    FbxScene*               m_pScene = nullptr;  // ses matériaux sont lus à la création des entités
+    XMFLOAT3                m_pivotPosition{0.0f, 0.0f, 0.0f};
+    std::shared_ptr<Entity> m_rootEntity;
+    uint32_t                m_commitCursor = 0;  // prochain nœud importé ou enregistrement du cache
+
+    std::vector<std::shared_ptr<Entity>>                        m_nodeEntities;
+    std::vector<std::pair<std::shared_ptr<Entity>, uint32_t>>   m_cacheParents;    // enfants restant à lire
+    std::unordered_map<const Mesh*, uint32_t>                   m_cacheMeshes;     // entrée du cache de chaque maillage de base
+    std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> m_cacheColliders;  // bloc écrit par hachage du flux cuit
+    ColliderComponent::SharedMeshes                             m_colliderMeshes;  // maillages PhysX lus du cache, par hachage
+
+    static double ElapsedMs(std::chrono::steady_clock::time_point since)
+    {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+    }
+
     void InitializeFBXSDK()
     {
       m_pFbxManager = FbxManager::Create();
@@ -146,6 +293,7 @@ namespace FrostFireEngine
 
     void CleanupFBXSDK()
     {
+      ReleaseFBXScene();
       if (m_pIOSettings) {
         m_pIOSettings->Destroy();
         m_pIOSettings = nullptr;
@@ -156,6 +304,14 @@ namespace FrostFireEngine
       }
     }
 
+    void ReleaseFBXScene()
+    {
+      if (m_pScene) {
+        m_pScene->Destroy();
+        m_pScene = nullptr;
+      }
+    }
+
     bool LoadFBXScene(const std::string& filePath, FbxScene*& outScene) const
     {
       FbxImporter* importer = FbxImporter::Create(m_pFbxManager, "");
@@ -181,15 +337,61 @@ namespace FrostFireEngine
 
       return result;
     }
-    void ProcessNode(FbxNode*                       fbxNode,
-                     const std::shared_ptr<Entity>& parentEntity,
-                     const BuildSettings&           settings,
-                     const FbxVector4&              globalPivot)
+
+    // Import en trois étapes :
+    // 1. collecte (thread de Prepare) : parcours du FBX et copie des données brutes de chaque maillage
+    // 2. traitement (parallèle) : dés-indexation par matériau, optimisation, LODs, bornes
+    // 3. validation (thread principal) : création des entités, buffers GPU, matériaux et colliders
+
+    // Géométrie d'un groupe de matériau, préparée en parallèle
+    struct ImportGroup {
+      FbxSurfaceMaterial*                                   material = nullptr;
+      std::vector<Vertex>                                   vertices;
+      std::vector<uint32_t>                                 indices;
+      std::vector<std::pair<float, MeshSimplifier::Result>> lods;  // taille à l'écran, géométrie
+      VertexFormat                                          format = VertexFormat::Full;
+      MeshStats                                             stats;
+      bool                                                  hasStats = false;
+      XMFLOAT3                                              minBounds{FLT_MAX, FLT_MAX, FLT_MAX};
+      XMFLOAT3                                              maxBounds{-FLT_MAX, -FLT_MAX, -FLT_MAX};
+      std::shared_ptr<const ColliderComponent::CookedMesh>  collisionMesh;  // si generateColliders
+    };
+
+    // Copie des données d'un FbxMesh : le SDK FBX n'est utilisé que par le thread de Prepare
+    struct ImportMesh {
+      std::string              name;
+      FbxAMatrix               transform;
+      FbxAMatrix               normalMatrix;
+      std::vector<FbxVector4>  controlPoints;
+      std::vector<int>         polygonVertices;   // 3 indices de point de contrôle par triangle
+      std::vector<int>         polygonMaterials;  // groupe de chaque triangle
+      std::vector<FbxVector4>  normals;           // par sommet de polygone
+      std::vector<FbxVector2>  uvs;               // par sommet de polygone, vide sans UV
+      std::vector<FbxVector4>  tangents;          // par sommet de polygone, vide sans tangentes
+      std::vector<ImportGroup> groups;
+      uint32_t                 cornerCount = 0;   // sommets avant soudure
+    };
+
+    struct ImportNode {
+      uint32_t parent;  // IMPORT_ROOT : enfant de l'entité racine
+      XMFLOAT3 position;
+      XMFLOAT4 rotation;
+      XMFLOAT3 scale;
+      int      mesh = -1;
+    };
+
+    static constexpr uint32_t IMPORT_ROOT = UINT32_MAX;
+
+    std::vector<ImportNode> m_importNodes;
+    std::vector<ImportMesh> m_importMeshes;
+
+    void GatherNode(FbxNode*             fbxNode,
+                    uint32_t             parent,
+                    const BuildSettings& settings,
+                    const FbxVector4&    globalPivot)
     {
       if (!fbxNode) return;
 
-      const auto nodeEntity = World::GetInstance().CreateEntity();
-
       FbxAMatrix globalTransform = fbxNode->EvaluateGlobalTransform();
 
       FbxAMatrix pivotOffset;
@@ -207,122 +409,98 @@ namespace FrostFireEngine
       FbxVector4 rotation = localTransform.GetR();
       FbxVector4 scaling = localTransform.GetS();
 
-      const XMFLOAT4 rotationQuaternion(
+      ImportNode node;
+      node.parent = parent;
+      node.rotation = XMFLOAT4(
         static_cast<float>(rotation[0]),
         static_cast<float>(rotation[1]),
         static_cast<float>(rotation[2]),
         static_cast<float>(rotation[3])
       );
-
-      const XMFLOAT3 position(
+      node.position = XMFLOAT3(
         static_cast<float>(translation[0] * settings.scaleFactor),
         static_cast<float>(translation[1] * settings.scaleFactor),
         static_cast<float>(translation[2] * settings.scaleFactor)
       );
-
-      const auto transform = TransformComponent(
-        position,
-        rotationQuaternion,
-        XMFLOAT3(
-          static_cast<float>(scaling[0]),
-          static_cast<float>(scaling[1]),
-          static_cast<float>(scaling[2])
-        )
+      node.scale = XMFLOAT3(
+        static_cast<float>(scaling[0]),
+        static_cast<float>(scaling[1]),
+        static_cast<float>(scaling[2])
       );
-      nodeEntity->AddComponent<TransformComponent>(std::move(transform));
-
-      if (parentEntity) {
-        if (const auto parentTransform = parentEntity->GetComponent<TransformComponent>()) {
-          parentTransform->AddChild(nodeEntity->GetId());
-        }
-      }
 
       if (fbxNode->GetNodeAttribute() &&
         fbxNode->GetNodeAttribute()->GetAttributeType() == FbxNodeAttribute::eMesh) {
-        ProcessMesh(fbxNode->GetMesh(), nodeEntity, settings, globalPivot);
+        if (GatherMesh(fbxNode->GetMesh(), globalPivot)) {
+          node.mesh = static_cast<int>(m_importMeshes.size() - 1);
+        }
       }
 
+      const uint32_t nodeIndex = static_cast<uint32_t>(m_importNodes.size());
+      m_importNodes.push_back(node);
+
       for (int i = 0; i < fbxNode->GetChildCount(); ++i) {
-        ProcessNode(fbxNode->GetChild(i), nodeEntity, settings, globalPivot);
+        GatherNode(fbxNode->GetChild(i), nodeIndex, settings, globalPivot);
       }
     }
 
+    // Lecture d'un élément de géométrie selon son mapping (point de contrôle ou sommet de polygone)
+    template <typename TElement>
+    static auto ReadElement(TElement* element, int ctrlPointIndex, int polygonVertexIndex)
+    {
+      const int index = element->GetMappingMode() == FbxGeometryElement::eByControlPoint
+                          ? ctrlPointIndex
+                          : polygonVertexIndex;
+      return element->GetReferenceMode() == FbxGeometryElement::eDirect
+               ? element->GetDirectArray().GetAt(index)
+               : element->GetDirectArray().GetAt(element->GetIndexArray().GetAt(index));
+    }
 
-    struct MaterialGroup {
-      std::vector<Vertex>                      vertices;
-      std::vector<uint32_t>                    indices;
-      FbxSurfaceMaterial*                      material = nullptr;
-      int                                      materialIndex = 0;
-      std::map<std::tuple<int, int, int>, int> uniqueVertices;
-      int                                      currentVertexIndex = 0;
-    };
-
-    void ProcessMesh(FbxMesh*                fbxMesh,
-                     std::shared_ptr<Entity> entity,
-                     const BuildSettings&    settings,
-                     const FbxVector4&       globalPivot)
+    bool GatherMesh(FbxMesh* fbxMesh, const FbxVector4& globalPivot)
     {
-      if (!fbxMesh) return;
+      if (!fbxMesh) return false;
 
+      // Modifie le maillage FBX : doit rester sur le thread de Prepare
       fbxMesh->GenerateNormals();
       fbxMesh->GenerateTangentsData();
       FbxLayer*              layer = fbxMesh->GetLayer(0);
       FbxLayerElementNormal* layerElementNormal = layer->GetNormals();
 
-      // Récupération des matériaux
-      std::vector<MaterialGroup> materialGroups;
-      FbxNode*                   node = fbxMesh->GetNode();
-      int                        materialCount = node->GetMaterialCount();
+      ImportMesh& mesh = m_importMeshes.emplace_back();
+      FbxNode*    node = fbxMesh->GetNode();
+      mesh.name = node->GetName();
 
-      // Si aucun matériau, créer un groupe avec matériau par défaut
-      if (materialCount == 0) {
-        MaterialGroup defaultGroup;
-        defaultGroup.material = nullptr;
-        defaultGroup.materialIndex = 0;
-        materialGroups.push_back(defaultGroup);
-      }
-      else {
-        // Créer un groupe pour chaque matériau
-        for (int i = 0; i < materialCount; i++) {
-          MaterialGroup group;
-          group.material = node->GetMaterial(i);
-          group.materialIndex = i;
-          materialGroups.push_back(group);
-        }
+      // Un groupe par matériau, ou un groupe par défaut
+      const int materialCount = node->GetMaterialCount();
+      mesh.groups.resize(std::max(materialCount, 1));
+      for (int i = 0; i < materialCount; i++) {
+        mesh.groups[i].material = node->GetMaterial(i);
       }
 
       // Préparation des matrices de transformation
-      FbxAMatrix meshGlobalTransform = fbxMesh->GetNode()->EvaluateGlobalTransform();
+      mesh.transform = node->EvaluateGlobalTransform();
       FbxAMatrix pivotOffset;
       pivotOffset.SetT(globalPivot);
-      meshGlobalTransform = meshGlobalTransform * pivotOffset.Inverse();
+      mesh.transform = mesh.transform * pivotOffset.Inverse();
 
-      FbxAMatrix normalMatrix = meshGlobalTransform.Inverse().Transpose();
-      normalMatrix.SetT(FbxVector4(0, 0, 0, 1));
+      mesh.normalMatrix = mesh.transform.Inverse().Transpose();
+      mesh.normalMatrix.SetT(FbxVector4(0, 0, 0, 1));
+
+      const FbxVector4* controlPoints = fbxMesh->GetControlPoints();
+      mesh.controlPoints.assign(controlPoints, controlPoints + fbxMesh->GetControlPointsCount());
 
-      // Récupération des éléments de mapping des matériaux
       FbxGeometryElementMaterial* materialElement = fbxMesh->GetElementMaterial();
       FbxGeometryElementUV*       uvElement = fbxMesh->GetElementUV(0);
-      FbxVector4*                 controlPoints = fbxMesh->GetControlPoints();
-
-      // Création de la carte UV si nécessaire
-      std::vector<std::tuple<int, int, FbxVector2>> uvMap;
-      if (uvElement) {
-        uvMap.resize(fbxMesh->GetPolygonVertexCount());
-        int vertexCount = 0;
-        for (int polyIndex = 0; polyIndex < fbxMesh->GetPolygonCount(); polyIndex++) {
-          for (int vertexIndex = 0; vertexIndex < 3; vertexIndex++) {
-            int        ctrlPointIndex = fbxMesh->GetPolygonVertex(polyIndex, vertexIndex);
-            int        uvIndex = fbxMesh->GetTextureUVIndex(polyIndex, vertexIndex);
-            FbxVector2 uv = uvElement->GetDirectArray().GetAt(uvIndex);
-            uvMap[vertexCount++] = std::make_tuple(ctrlPointIndex, uvIndex, uv);
-          }
-        }
-      }
+      FbxGeometryElementTangent*  tangentElement = fbxMesh->GetElementTangent(0);
+
+      const int polygonCount = fbxMesh->GetPolygonCount();
+      mesh.polygonVertices.resize(polygonCount * 3);
+      mesh.polygonMaterials.resize(polygonCount);
+      mesh.normals.resize(polygonCount * 3);
+      if (uvElement) mesh.uvs.resize(polygonCount * 3);
+      if (tangentElement) mesh.tangents.resize(polygonCount * 3);
 
-      // Traitement des polygones
       int vertexCount = 0;
-      for (int polyIndex = 0; polyIndex < fbxMesh->GetPolygonCount(); polyIndex++) {
+      for (int polyIndex = 0; polyIndex < polygonCount; polyIndex++) {
         // Détermination du matériau pour ce polygone
         int materialIndex = 0;
         if (materialElement) {
@@ -341,176 +519,60 @@ namespace FrostFireEngine
         }
 
         // Vérification de la validité de l'index du matériau
-        if (materialIndex >= static_cast<int>(materialGroups.size())) {
+        if (materialIndex < 0 || materialIndex >= static_cast<int>(mesh.groups.size())) {
           materialIndex = 0;
         }
+        mesh.polygonMaterials[polyIndex] = materialIndex;
 
-        MaterialGroup& currentGroup = materialGroups[materialIndex];
+        for (int v = 0; v < 3; v++, vertexCount++) {
+          const int ctrlPointIndex = fbxMesh->GetPolygonVertex(polyIndex, v);
+          mesh.polygonVertices[vertexCount] = ctrlPointIndex;
 
-        // Traitement des sommets du polygone
-        for (int v = 0; v < 3; v++) {
-          int ctrlPointIndex = fbxMesh->GetPolygonVertex(polyIndex, v);
-
-          // Récupération de la normale
-          FbxVector4 normal;
           if (layerElementNormal) {
-            if (layerElementNormal->GetMappingMode() == FbxLayerElement::eByControlPoint) {
-              switch (layerElementNormal->GetReferenceMode()) {
-                case FbxLayerElement::eDirect:
-                  normal = layerElementNormal->GetDirectArray().GetAt(ctrlPointIndex);
-                  break;
-                case FbxLayerElement::eIndexToDirect:
-                  {
-                    int index = layerElementNormal->GetIndexArray().GetAt(ctrlPointIndex);
-                    normal = layerElementNormal->GetDirectArray().GetAt(index);
-                  }
-                  break;
-              }
-            }
-            else if (layerElementNormal->GetMappingMode() == FbxLayerElement::eByPolygonVertex) {
-              switch (layerElementNormal->GetReferenceMode()) {
-                case FbxLayerElement::eDirect:
-                  normal = layerElementNormal->GetDirectArray().GetAt(vertexCount);
-                  break;
-                case FbxLayerElement::eIndexToDirect:
-                  {
-                    int index = layerElementNormal->GetIndexArray().GetAt(vertexCount);
-                    normal = layerElementNormal->GetDirectArray().GetAt(index);
-                  }
-                  break;
-              }
-            }
+            mesh.normals[vertexCount] = ReadElement(layerElementNormal, ctrlPointIndex, vertexCount);
           }
-
-          ProcessVertex(currentGroup, ctrlPointIndex, normal, normalMatrix, meshGlobalTransform,
-                        settings, controlPoints, uvElement, uvMap, vertexCount++, fbxMesh);
-        }
-      }
-
-      // Création des entités pour chaque groupe de matériau
-      for (const auto& group : materialGroups) {
-        if (group.vertices.empty()) continue;
-
-        auto childEntity = World::GetInstance().CreateEntity();
-        auto mesh = std::make_shared<Mesh>(m_pDispositif->GetD3DDevice(), group.vertices,
-                                           group.indices);
-
-
-        childEntity->AddComponent<TransformComponent>();
-        auto& renderer = childEntity->AddComponent<PBRRenderer>(
-          m_pDispositif->GetD3DDevice());
-        auto& meshComponent = childEntity->AddComponent<MeshComponent>();
-        meshComponent.SetMesh(mesh);
-
-        // Configuration du matériau
-        ProcessMaterial(group.material, renderer);
-
-
-        // Configuration des textures
-        if (settings.importTextures) {
-          ProcessTextures(group.material, renderer);
-        }
-
-
-        if (settings.generateColliders) {
-          auto& collider = childEntity->AddComponent<ColliderComponent>(
-            settings.colliderMeshType == ColliderComponent::MeshType::Convex
-              ? ColliderComponent::Type::ConvexMesh
-              : ColliderComponent::Type::TriangleMesh
-          );
-          collider.SetMeshType(settings.colliderMeshType);
-          collider.Initialize(XMFLOAT3(1.0f, 1.0f, 1.0f));
-
-          if (settings.addRigidbody) {
-            auto& rigidBody = childEntity->AddComponent<RigidBodyComponent>(settings.rigidBodyType);
-            rigidBody.Initialize();
+          if (uvElement) {
+            mesh.uvs[vertexCount] = ReadElement(uvElement, ctrlPointIndex, vertexCount);
+          }
+          if (tangentElement) {
+            mesh.tangents[vertexCount] = ReadElement(tangentElement, ctrlPointIndex, vertexCount);
           }
-        }
-
-        auto parentTransform = entity->GetComponent<TransformComponent>();
-        parentTransform->AddChild(childEntity->GetId());
-      }
-
-      // Mise à jour des limites du maillage global
-      for (const auto& group : materialGroups) {
-        for (const auto& vertex : group.vertices) {
-          const XMFLOAT3& pos = vertex.GetPosition();
-          m_minBounds.x = std::min(m_minBounds.x, pos.x);
-          m_minBounds.y = std::min(m_minBounds.y, pos.y);
-          m_minBounds.z = std::min(m_minBounds.z, pos.z);
-
-          m_maxBounds.x = std::max(m_maxBounds.x, pos.x);
-          m_maxBounds.y = std::max(m_maxBounds.y, pos.y);
-          m_maxBounds.z = std::max(m_maxBounds.z, pos.z);
         }
       }
 
-      // Réinitialisation de la transformation de l'entité parente
-      auto transform = entity->GetComponent<TransformComponent>();
-      transform->SetPosition(XMFLOAT3(0, 0, 0));
-      transform->SetRotation(XMFLOAT4(0, 0, 0, 1));
-      transform->SetScale(XMFLOAT3(1, 1, 1));
+      return true;
     }
 
-    void ProcessVertex(MaterialGroup&                                       group,
-                       int                                                  ctrlPointIndex,
-                       const FbxVector4&                                    normal,
-                       const FbxAMatrix&                                    normalMatrix,
-                       const FbxAMatrix&                                    meshTransform,
-                       const BuildSettings&                                 settings,
-                       FbxVector4*                                          controlPoints,
-                       FbxGeometryElementUV*                                uvElement,
-                       const std::vector<std::tuple<int, int, FbxVector2>>& uvMap,
-                       int                                                  vertexIndex,
-                       FbxMesh*                                             fbxMesh)
+    // Dés-indexation d'un maillage dans ses groupes de matériau (sans accès au SDK FBX) :
+    // un sommet est construit par coin de triangle puis soudé sur l'ensemble de ses attributs
+    static void BuildMaterialGroups(ImportMesh& mesh, const BuildSettings& settings)
     {
-      // Création d'une clé unique pour chaque combinaison de position et UV
-      FbxVector2 currentUV(0, 0);
-      if (uvElement) {
-        if (uvElement->GetMappingMode() == FbxGeometryElement::eByPolygonVertex) {
-          int uvIndex;
-          if (uvElement->GetReferenceMode() == FbxGeometryElement::eDirect) {
-            uvIndex = vertexIndex;
-          }
-          else // eIndexToDirect
-          {
-            uvIndex = uvElement->GetIndexArray().GetAt(vertexIndex);
-          }
-          currentUV = uvElement->GetDirectArray().GetAt(uvIndex);
-        }
-        else if (uvElement->GetMappingMode() == FbxGeometryElement::eByControlPoint) {
-          int uvIndex;
-          if (uvElement->GetReferenceMode() == FbxGeometryElement::eDirect) {
-            uvIndex = ctrlPointIndex;
-          }
-          else // eIndexToDirect
-          {
-            uvIndex = uvElement->GetIndexArray().GetAt(ctrlPointIndex);
-          }
-          currentUV = uvElement->GetDirectArray().GetAt(uvIndex);
-        }
+      // Positions calculées une seule fois par point de contrôle
+      std::vector<XMFLOAT3> positions(mesh.controlPoints.size());
+      for (size_t i = 0; i < positions.size(); i++) {
+        const FbxVector4 position = mesh.transform.MultT(mesh.controlPoints[i]);
+        positions[i] = XMFLOAT3(
+          static_cast<float>(position[0] * settings.scaleFactor),
+          static_cast<float>(position[1] * settings.scaleFactor),
+          static_cast<float>(position[2] * settings.scaleFactor)
+        );
       }
 
-      // Création d'une clé unique qui prend en compte à la fois la position et les UVs
-      const auto vertexKey = std::make_tuple(
-        ctrlPointIndex,
-        static_cast<int>(currentUV[0] * 1000),
-        static_cast<int>(currentUV[1] * 1000)
-      );
-      const auto it = group.uniqueVertices.find(vertexKey);
+      const size_t polygonVertexCount = mesh.polygonVertices.size();
 
-      if (it == group.uniqueVertices.end()) {
-        Vertex     vertex;
-        FbxVector4 position = meshTransform.MultT(controlPoints[ctrlPointIndex]);
+      std::vector<VertexWelder> welders;
+      welders.reserve(mesh.groups.size());
+      for (size_t i = 0; i < mesh.groups.size(); i++) {
+        welders.emplace_back(settings.weldEpsilons, polygonVertexCount / (2 * mesh.groups.size()));
+      }
 
-        vertex.SetPosition(XMFLOAT3(
-          static_cast<float>(position[0] * settings.scaleFactor),
-          static_cast<float>(position[1] * settings.scaleFactor),
-          static_cast<float>(position[2] * settings.scaleFactor)
-        ));
+      for (size_t vertexIndex = 0; vertexIndex < polygonVertexCount; vertexIndex++) {
+        const int groupIndex = mesh.polygonMaterials[vertexIndex / 3];
+
+        Vertex vertex;
+        vertex.SetPosition(positions[mesh.polygonVertices[vertexIndex]]);
 
-        // Configuration de la normale...
-        FbxVector4 transformedNormal = normalMatrix.MultT(normal);
+        FbxVector4 transformedNormal = mesh.normalMatrix.MultT(mesh.normals[vertexIndex]);
         transformedNormal.Normalize();
         vertex.SetNormal(XMFLOAT3(
           static_cast<float>(transformedNormal[0]),
@@ -518,39 +580,22 @@ namespace FrostFireEngine
           static_cast<float>(transformedNormal[2])
         ));
 
-        // Configuration des UVs
-        if (uvElement) {
+        if (!mesh.uvs.empty()) {
+          const FbxVector2& uv = mesh.uvs[vertexIndex];
           vertex.SetTexCoord(XMFLOAT2(
-            static_cast<float>(currentUV[0]),
+            static_cast<float>(uv[0]),
             settings.flipUVs
-              ? static_cast<float>(1.0 - currentUV[1])
-              : static_cast<float>(currentUV[1])
+              ? static_cast<float>(1.0 - uv[1])
+              : static_cast<float>(uv[1])
           ));
         }
         else {
           vertex.SetTexCoord(XMFLOAT2(0.0f, 0.0f));
         }
 
-        // Configuration des tangentes...
-        FbxGeometryElementTangent* tangentElement = fbxMesh->GetElementTangent(0);
-        if (tangentElement) {
-          FbxVector4 tangent;
-          if (tangentElement->GetMappingMode() == FbxGeometryElement::eByControlPoint) {
-            int tangentIndex = (tangentElement->GetReferenceMode() == FbxGeometryElement::eDirect)
-                                 ? ctrlPointIndex
-                                 : tangentElement->GetIndexArray().GetAt(ctrlPointIndex);
-            tangent = tangentElement->GetDirectArray().GetAt(tangentIndex);
-          }
-          else if (tangentElement->GetMappingMode() == FbxGeometryElement::eByPolygonVertex) {
-            int tangentIndex = (tangentElement->GetReferenceMode() == FbxGeometryElement::eDirect)
-                                 ? vertexIndex
-                                 : tangentElement->GetIndexArray().GetAt(vertexIndex);
-            tangent = tangentElement->GetDirectArray().GetAt(tangentIndex);
-          }
-
-          FbxVector4 transformedTangent = normalMatrix.MultT(tangent);
+        if (!mesh.tangents.empty()) {
+          FbxVector4 transformedTangent = mesh.normalMatrix.MultT(mesh.tangents[vertexIndex]);
           transformedTangent.Normalize();
-
           vertex.SetTangent(XMFLOAT3(
             static_cast<float>(transformedTangent[0]),
             static_cast<float>(transformedTangent[1]),
@@ -561,14 +606,301 @@ namespace FrostFireEngine
           vertex.SetTangent(XMFLOAT3(1.0f, 0.0f, 0.0f));
         }
 
-        group.vertices.push_back(vertex);
-        group.uniqueVertices[vertexKey] = group.currentVertexIndex;
-        group.indices.push_back(group.currentVertexIndex);
-        group.currentVertexIndex++;
+        mesh.groups[groupIndex].indices.push_back(welders[groupIndex].Add(vertex));
+      }
+
+      for (size_t i = 0; i < mesh.groups.size(); i++) {
+        mesh.groups[i].vertices = welders[i].TakeVertices();
+      }
+      mesh.cornerCount = static_cast<uint32_t>(polygonVertexCount);
+
+      // Les données brutes ne servent plus
+      mesh.controlPoints = {};
+      mesh.polygonVertices = {};
+      mesh.polygonMaterials = {};
+      mesh.normals = {};
+      mesh.uvs = {};
+      mesh.tangents = {};
+    }
+
+    // Optimisation, chaîne de LOD et bornes d'un groupe (sans accès au SDK FBX ni au device)
+    static void PrepareGroup(ImportGroup& group, const std::string& name, const BuildSettings& settings)
+    {
+      if (group.vertices.empty()) return;
+
+      // Les LODs reprennent les UV du maillage de base : ils partagent son format
+      if (settings.vertexFormat == VertexFormat::Packed && CanPackVertices(group.vertices)) {
+        group.format = VertexFormat::Packed;
+      }
+
+      if (settings.optimizeMeshes) {
+        group.stats = {MeshOptimizer::OptimizeWithStats(group.vertices, group.indices), name};
+        group.hasStats = true;
+      }
+
+      if (settings.generateLODs && group.indices.size() / 3 >= LOD_MIN_TRIANGLES) {
+        // Chaque niveau part du niveau précédent : les erreurs se cumulent mais le coût
+        // de simplification diminue à chaque étape
+        group.lods.reserve(std::size(LOD_CHAIN));
+        const std::vector<Vertex>*   sourceVertices = &group.vertices;
+        const std::vector<uint32_t>* sourceIndices = &group.indices;
+        float                        previousRatio = 1.0f;
+
+        for (const auto& lod : LOD_CHAIN) {
+          MeshSimplifier::Result result;
+          if (!MeshSimplifier::GenerateLOD(*sourceVertices, *sourceIndices,
+                                           lod.ratio / previousRatio, lod.maxError, result)) {
+            break;
+          }
+
+          if (settings.optimizeMeshes) {
+            MeshOptimizer::Optimize(result.vertices, result.indices);
+          }
+
+          previousRatio = static_cast<float>(result.indices.size()) /
+            static_cast<float>(group.indices.size());
+          group.lods.emplace_back(lod.screenSize, std::move(result));
+
+          // lods est réservé : ces pointeurs restent valides aux ajouts suivants
+          sourceVertices = &group.lods.back().second.vertices;
+          sourceIndices = &group.lods.back().second.indices;
+        }
+      }
+
+      for (const auto& vertex : group.vertices) {
+        const XMFLOAT3& pos = vertex.GetPosition();
+        group.minBounds.x = std::min(group.minBounds.x, pos.x);
+        group.minBounds.y = std::min(group.minBounds.y, pos.y);
+        group.minBounds.z = std::min(group.minBounds.z, pos.z);
+
+        group.maxBounds.x = std::max(group.maxBounds.x, pos.x);
+        group.maxBounds.y = std::max(group.maxBounds.y, pos.y);
+        group.maxBounds.z = std::max(group.maxBounds.z, pos.z);
+      }
+    }
+
+    void WeldImportedMeshes(const BuildSettings& settings)
+    {
+      std::for_each(std::execution::par, m_importMeshes.begin(), m_importMeshes.end(),
+                    [&settings](ImportMesh& mesh) { BuildMaterialGroups(mesh, settings); });
+    }
+
+    void PrepareImportedGroups(const BuildSettings& settings)
+    {
+      // Un maillage peut porter plusieurs groupes : le travail lourd est réparti par groupe
+      std::vector<std::pair<ImportGroup*, const std::string*>> groups;
+      for (auto& mesh : m_importMeshes) {
+        for (auto& group : mesh.groups) {
+          groups.emplace_back(&group, &mesh.name);
+        }
+      }
+
+      std::for_each(std::execution::par, groups.begin(), groups.end(),
+                    [&settings](const auto& entry) {
+                      PrepareGroup(*entry.first, *entry.second, settings);
+                    });
+    }
+
+    // Cuisson PhysX des colliders sur les threads de travail plutôt qu'à la création des entités,
+    // une seule fois par contenu : les groupes identiques partagent le même flux cuit
+    void CookImportedColliders(const BuildSettings& settings)
+    {
+      if (!settings.generateColliders) return;
+
+      struct CookEntry {
+        ImportGroup* group;
+        uint64_t     hash;
+      };
+      std::vector<CookEntry> entries;
+      for (auto& mesh : m_importMeshes) {
+        for (auto& group : mesh.groups) {
+          if (!group.vertices.empty()) entries.push_back({&group, 0});
+        }
+      }
+
+      const ColliderComponent::MeshType type = settings.colliderMeshType;
+      std::for_each(std::execution::par, entries.begin(), entries.end(), [type](CookEntry& entry) {
+        entry.hash = ColliderComponent::HashCollisionMesh(type, entry.group->vertices, entry.group->indices);
+      });
+
+      std::unordered_map<uint64_t, std::shared_ptr<const ColliderComponent::CookedMesh>> cooked;
+      std::vector<CookEntry*>                                                             unique;
+      for (auto& entry : entries) {
+        if (cooked.emplace(entry.hash, nullptr).second) unique.push_back(&entry);
+      }
+
+      std::for_each(std::execution::par, unique.begin(), unique.end(), [type](CookEntry* entry) {
+        entry->group->collisionMesh = ColliderComponent::CookCollisionMesh(
+          type, entry->group->vertices, entry->group->indices);
+      });
+      for (const CookEntry* entry : unique) {
+        cooked[entry->hash] = entry->group->collisionMesh;
+      }
+
+      // Un échec laisse le pointeur vide : CommitGroup crée le groupe sans collider ni RigidBody
+      for (auto& entry : entries) {
+        entry.group->collisionMesh = cooked[entry.hash];
+      }
+    }
+
+    // Création des entités dans l'ordre du parcours du FBX (nœud, ses groupes, puis ses enfants),
+    // un nœud à la fois jusqu'à épuisement du budget
+    bool CommitImportedNodes(std::chrono::steady_clock::time_point startTime, double budgetMs)
+    {
+      if (!m_rootEntity) {
+        m_rootEntity = World::GetInstance().CreateEntity();
+        m_rootEntity->AddComponent<TransformComponent>(
+          XMFLOAT3(
+            m_settings.basePosition.x + m_pivotPosition.x,
+            m_settings.basePosition.y + m_pivotPosition.y,
+            m_settings.basePosition.z + m_pivotPosition.z
+          ),
+          m_settings.baseRotation,
+          m_settings.baseScale
+        );
+        m_nodeEntities.clear();
+        m_nodeEntities.reserve(m_importNodes.size());
+      }
+
+      while (m_commitCursor < m_importNodes.size()) {
+        CommitImportedNode(m_importNodes[m_commitCursor++]);
+        if (m_commitCursor < m_importNodes.size() && ElapsedMs(startTime) >= budgetMs) {
+          return false;
+        }
+      }
+
+      m_importNodes.clear();
+      m_importMeshes.clear();
+      m_nodeEntities.clear();
+      ReleaseFBXScene();
+
+      m_result.success = true;
+      m_result.rootEntity = m_rootEntity;
+      m_rootEntity.reset();
+      m_state = CommitState::Done;
+      return true;
+    }
+
+    void CommitImportedNode(const ImportNode& node)
+    {
+      const auto nodeEntity = World::GetInstance().CreateEntity();
+      m_nodeEntities.push_back(nodeEntity);
+
+      // Les sommets d'un maillage sont en espace global : son nœud garde une transformation neutre
+      if (node.mesh >= 0) {
+        nodeEntity->AddComponent<TransformComponent>(XMFLOAT3(0, 0, 0), XMFLOAT4(0, 0, 0, 1),
+                                                     XMFLOAT3(1, 1, 1));
       }
       else {
-        group.indices.push_back(it->second);
+        nodeEntity->AddComponent<TransformComponent>(node.position, node.rotation, node.scale);
       }
+
+      const auto& parentEntity = node.parent == IMPORT_ROOT ? m_rootEntity : m_nodeEntities[node.parent];
+      if (const auto parentTransform = parentEntity->GetComponent<TransformComponent>()) {
+        parentTransform->AddChild(nodeEntity->GetId());
+      }
+
+      if (node.mesh >= 0) {
+        ImportMesh& mesh = m_importMeshes[node.mesh];
+        m_result.cornerCount += mesh.cornerCount;
+
+        for (auto& group : mesh.groups) {
+          if (group.vertices.empty()) continue;
+          CommitGroup(group, nodeEntity, m_settings);
+          m_result.weldedVertexCount += static_cast<uint32_t>(group.vertices.size());
+          m_result.vertexMemorySize += group.vertices.size() * GetVertexFormatSize(group.format);
+          for (const auto& lod : group.lods) {
+            m_result.vertexMemorySize += lod.second.vertices.size() * GetVertexFormatSize(group.format);
+          }
+          if (group.hasStats) {
+            m_result.meshStats.push_back(std::move(group.stats));
+          }
+        }
+
+        // La géométrie est sur le GPU : la copie CPU n'est plus utile
+        mesh.groups.clear();
+        mesh.groups.shrink_to_fit();
+      }
+    }
+
+    // Crée le Mesh d'un niveau et copie sa géométrie dans le cache, au format GPU : un maillage
+    // Packed n'est compacté qu'une fois, et le cache est ensuite envoyé au GPU sans conversion.
+    // Le Mesh ne garde que ses bornes, la géométrie doit être copiée tant qu'elle est disponible.
+    std::shared_ptr<Mesh> CreateImportedMesh(const std::vector<Vertex>&   vertices,
+                                             const std::vector<uint32_t>& indices,
+                                             VertexFormat                 format,
+                                             float                        screenSize,
+                                             uint32_t&                    cacheIndex)
+    {
+      if (format == VertexFormat::Packed) {
+        const PackedVertexStreams streams = PackVertexStreams(vertices);
+        cacheIndex = m_cacheWriter.AddMesh(streams.positions, streams.attributes, indices, screenSize);
+        return std::make_shared<Mesh>(m_pDispositif->GetD3DDevice(), streams.positions, streams.attributes,
+                                      indices);
+      }
+
+      cacheIndex = m_cacheWriter.AddMesh(vertices, indices, screenSize);
+      return std::make_shared<Mesh>(m_pDispositif->GetD3DDevice(), vertices, indices);
+    }
+
+    void CommitGroup(const ImportGroup&             group,
+                     const std::shared_ptr<Entity>& entity,
+                     const BuildSettings&           settings)
+    {
+      auto     childEntity = World::GetInstance().CreateEntity();
+      uint32_t cacheIndex = 0;
+      auto     mesh = CreateImportedMesh(group.vertices, group.indices, group.format, 0.0f, cacheIndex);
+      m_cacheMeshes[mesh.get()] = cacheIndex;
+
+      childEntity->AddComponent<TransformComponent>();
+      auto& renderer = childEntity->AddComponent<PBRRenderer>(
+        m_pDispositif->GetD3DDevice());
+      auto& meshComponent = childEntity->AddComponent<MeshComponent>();
+      meshComponent.SetMesh(mesh);
+
+      for (const auto& [screenSize, lod] : group.lods) {
+        meshComponent.AddLODLevel(screenSize,
+                                  CreateImportedMesh(lod.vertices, lod.indices, group.format, screenSize, cacheIndex));
+      }
+
+      // Configuration du matériau
+      ProcessMaterial(group.material, renderer);
+
+      // Configuration des textures
+      if (settings.importTextures) {
+        ProcessTextures(group.material, renderer);
+      }
+
+      if (settings.generateColliders && !group.collisionMesh) {
+        m_result.skippedColliderCount++;
+      }
+      else if (settings.generateColliders) {
+        auto& collider = childEntity->AddComponent<ColliderComponent>(
+          settings.colliderMeshType == ColliderComponent::MeshType::Convex
+            ? ColliderComponent::Type::ConvexMesh
+            : ColliderComponent::Type::TriangleMesh
+        );
+        collider.SetMeshType(settings.colliderMeshType);
+        collider.SetCookedMesh(group.collisionMesh);
+        collider.Initialize(XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+        if (settings.addRigidbody) {
+          auto& rigidBody = childEntity->AddComponent<RigidBodyComponent>(settings.rigidBodyType);
+          rigidBody.Initialize();
+        }
+      }
+
+      auto parentTransform = entity->GetComponent<TransformComponent>();
+      parentTransform->AddChild(childEntity->GetId());
+
+      // Mise à jour des limites du maillage global
+      m_minBounds.x = std::min(m_minBounds.x, group.minBounds.x);
+      m_minBounds.y = std::min(m_minBounds.y, group.minBounds.y);
+      m_minBounds.z = std::min(m_minBounds.z, group.minBounds.z);
+
+      m_maxBounds.x = std::max(m_maxBounds.x, group.maxBounds.x);
+      m_maxBounds.y = std::max(m_maxBounds.y, group.maxBounds.y);
+      m_maxBounds.z = std::max(m_maxBounds.z, group.maxBounds.z);
     }
 
 
@@ -730,317 +1062,258 @@ namespace FrostFireEngine
 
     }
 
+    // Identité du FBX source et des réglages, comparée à l'en-tête du cache
+    static SceneCacheKey MakeCacheKey(const std::filesystem::path& fbxPath, const BuildSettings& settings)
+    {
+      SceneCacheKey   key;
+      std::error_code error;
+      key.sourceSize = std::filesystem::file_size(fbxPath, error);
+      if (!error) {
+        key.sourceWriteTime = std::filesystem::last_write_time(fbxPath, error).time_since_epoch().count();
+      }
+      key.hasSource = !error;
+
+      uint64_t hash = HashBytes(&settings.basePosition, sizeof(settings.basePosition));
+      hash = HashBytes(&settings.baseRotation, sizeof(settings.baseRotation), hash);
+      hash = HashBytes(&settings.baseScale, sizeof(settings.baseScale), hash);
+      hash = HashBytes(&settings.scaleFactor, sizeof(settings.scaleFactor), hash);
+      hash = HashBytes(&settings.rigidBodyType, sizeof(settings.rigidBodyType), hash);
+      hash = HashBytes(&settings.colliderMeshType, sizeof(settings.colliderMeshType), hash);
+      const bool flags[] = {
+        settings.generateColliders, settings.addRigidbody, settings.optimizeMeshes, settings.flipUVs,
+        settings.importMaterials, settings.importTextures, settings.generateLODs
+      };
+      hash = HashBytes(&settings.weldEpsilons, sizeof(settings.weldEpsilons), hash);
+      hash = HashBytes(&settings.vertexFormat, sizeof(settings.vertexFormat), hash);
+      key.settingsHash = HashBytes(flags, sizeof(flags), hash);
+      return key;
+    }
+
     // Fonctions de sérialisation
-    bool SaveToCache(const std::string& cacheFilePath, const std::shared_ptr<Entity>& rootEntity)
+    bool SaveToCache(const std::filesystem::path& cacheFilePath, const SceneCacheKey& key,
+                     const std::shared_ptr<Entity>& rootEntity)
     {
-      std::ofstream ofs(cacheFilePath, std::ios::binary);
-      if (!ofs) return false;
+      WriteCacheEntity(m_cacheWriter, rootEntity);
+      const bool written = m_cacheWriter.Write(cacheFilePath, key);
 
-      return SerializeEntity(ofs, rootEntity);
+      m_cacheWriter = {};
+      m_cacheMeshes.clear();
+      m_cacheColliders.clear();
+      return written;
     }
 
-    bool LoadFromCache(const std::string& cacheFilePath, BuildResult& result)
+    // Lecture du cache un enregistrement à la fois, dans l'ordre du fichier (pré-ordre),
+    // ce qui reproduit l'ordre de création des entités d'un import depuis le FBX
+    bool CommitCachedEntities(std::chrono::steady_clock::time_point startTime, double budgetMs)
     {
-      std::ifstream ifs(cacheFilePath, std::ios::binary);
-      if (!ifs) return false;
-
-      auto rootEntity = DeserializeEntity(ifs);
-      if (rootEntity) {
-        result.rootEntity = rootEntity;
-        return true;
-      }
-      else {
-        return false;
+      while (ReadNextCacheEntity()) {
+        if (ElapsedMs(startTime) >= budgetMs) return false;
       }
+
+      // Les buffers GPU sont créés : la projection du fichier peut être libérée
+      m_cacheReader = {};
+      m_cacheParents.clear();
+      m_colliderMeshes.Clear();
+
+      m_result.success = true;
+      m_result.rootEntity = m_rootEntity;
+      m_rootEntity.reset();
+      m_state = CommitState::Done;
+      return true;
     }
 
-    bool SerializeEntity(std::ofstream& ofs, const std::shared_ptr<Entity>& entity)
+    // Renvoie faux quand l'arbre de la racine est complet
+    bool ReadNextCacheEntity()
     {
-      // Sérialisation de TransformComponent
-      if (auto transform = entity->GetComponent<TransformComponent>()) {
-        ofs.put(1); // Possède TransformComponent
-        SerializeTransformComponent(ofs, *transform);
-      }
-      else {
-        ofs.put(0); // Ne possède pas TransformComponent
-      }
+      const auto entities = m_cacheReader.GetEntities();
+      if (m_commitCursor >= entities.size()) return false;
+
+      const SceneCacheEntity& record = entities[m_commitCursor++];
+      auto                    entity = ReadCacheEntity(m_cacheReader, record);
 
-      // Sérialisation de MeshComponent
-      if (auto meshComponent = entity->GetComponent<MeshComponent>()) {
-        ofs.put(1); // Possède MeshComponent
-        SerializeMeshComponent(ofs, *meshComponent);
+      if (!m_rootEntity) {
+        m_rootEntity = entity;
       }
       else {
-        ofs.put(0); // Ne possède pas BlinnPhongRenderer
+        auto& [parent, remaining] = m_cacheParents.back();
+        if (const auto transform = parent->GetComponent<TransformComponent>()) {
+          transform->AddChild(entity->GetId());
+        }
+        remaining--;
       }
 
-      // Sérialisation de PBRRenderer
-      if (auto renderer = entity->GetComponent<PBRRenderer>()) {
-        ofs.put(1);
-        SerializePBRRenderer(ofs, *renderer);
+      if (record.childCount > 0) {
+        m_cacheParents.emplace_back(entity, record.childCount);
       }
-      else {
-        ofs.put(0);
+      while (!m_cacheParents.empty() && m_cacheParents.back().second == 0) {
+        m_cacheParents.pop_back();
       }
+      return !m_cacheParents.empty();
+    }
 
+    void WriteCacheEntity(SceneCacheWriter& writer, const std::shared_ptr<Entity>& entity)
+    {
+      SceneCacheEntity record{};
+      record.rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+      record.scale = {1.0f, 1.0f, 1.0f};
+      record.meshFirst = SCENE_CACHE_NONE;
+      record.material = SCENE_CACHE_NONE;
+      record.colliderBlob = SCENE_CACHE_NONE;
+      record.rigidBodyType = -1;
+
+      const auto transform = entity->GetComponent<TransformComponent>();
+      if (transform) {
+        record.hasTransform = 1;
+        record.position = transform->GetPosition();
+        record.rotation = transform->GetRotation();
+        record.scale = transform->GetScale();
+      }
 
-      // Sérialisation de ColliderComponent
-      if (auto collider = entity->GetComponent<ColliderComponent>()) {
-        ofs.put(1); // Possède ColliderComponent
-        ColliderComponent::Type colliderType = collider->GetType();
-        ofs.write(reinterpret_cast<const char*>(&colliderType), sizeof(colliderType));
-        collider->Serialize(ofs);
+      // Maillage de base suivi de sa chaîne de LOD, ajoutés consécutivement par CommitGroup
+      if (const auto meshComponent = entity->GetComponent<MeshComponent>()) {
+        if (const auto mesh = meshComponent->GetMesh()) {
+          if (const auto cached = m_cacheMeshes.find(mesh.get()); cached != m_cacheMeshes.end()) {
+            record.meshFirst = cached->second;
+            record.meshCount = 1 + static_cast<uint32_t>(meshComponent->GetLODLevels().size());
+          }
+        }
       }
-      else {
-        ofs.put(0); // Ne possède pas ColliderComponent
+
+      if (const auto renderer = entity->GetComponent<PBRRenderer>()) {
+        SceneCacheMaterial material{};
+        material.baseColor = renderer->GetBaseColor();
+        material.metallic = renderer->GetMetallic();
+        material.roughness = renderer->GetRoughness();
+        material.ao = renderer->GetAO();
+        material.albedo = WriteTextureReference(writer, renderer->GetAlbedoTexture());
+        material.normal = WriteTextureReference(writer, renderer->GetNormalMap());
+        material.occlusion = WriteTextureReference(writer, renderer->GetAOMap());
+        material.metallicRoughness = WriteTextureReference(writer, renderer->GetMetallicRoughnessMap());
+        record.material = writer.AddMaterial(material);
       }
 
-      // Sérialisation de RigidBodyComponent
-      if (auto rigidBody = entity->GetComponent<RigidBodyComponent>()) {
-        ofs.put(1); // Possède RigidBodyComponent
-        RigidBodyComponent::Type type = rigidBody->GetType();
-        ofs.write(reinterpret_cast<const char*>(&type), sizeof(type));
+      // Le collider garde son propre format, stocké tel quel (flux PhysX cuit pour les maillages).
+      // Les colliders d'un même flux cuit, dédupliqué à l'import, partagent un seul bloc.
+      if (const auto collider = entity->GetComponent<ColliderComponent>()) {
+        const uint64_t hash = collider->GetCookedHash();
+        if (const auto written = m_cacheColliders.find(hash); hash != 0 && written != m_cacheColliders.end()) {
+          std::tie(record.colliderBlob, record.colliderSize) = written->second;
+        }
+        else {
+          std::ostringstream out(std::ios::binary);
+          collider->Serialize(out);
+          const std::string bytes = out.str();
+          record.colliderBlob = writer.AddBlob(bytes);
+          record.colliderSize = static_cast<uint32_t>(bytes.size());
+          if (hash != 0) m_cacheColliders.emplace(hash, std::pair(record.colliderBlob, record.colliderSize));
+        }
+        collider->ReleaseCookedMesh();  // le flux cuit ne servait plus qu'au cache
       }
-      else {
-        ofs.put(0); // Ne possède pas RigidBodyComponent
+
+      if (const auto rigidBody = entity->GetComponent<RigidBodyComponent>()) {
+        record.rigidBodyType = static_cast<int32_t>(rigidBody->GetType());
       }
 
+      const uint32_t index = writer.AddEntity(record);
 
-      // Sérialisation des enfants
-      const auto& transform = entity->GetComponent<TransformComponent>();
       if (transform) {
-        const auto& children = transform->GetChildren();
-        uint32_t    numChildren = static_cast<uint32_t>(children.size());
-        ofs.write(reinterpret_cast<const char*>(&numChildren), sizeof(numChildren));
-
-        for (const auto& childId : children) {
-          auto childEntity = World::GetInstance().GetEntity(childId);
-          if (childEntity) {
-            SerializeEntity(ofs, childEntity);
+        for (const auto& childId : transform->GetChildren()) {
+          if (auto childEntity = World::GetInstance().GetEntity(childId)) {
+            WriteCacheEntity(writer, childEntity);
+            writer.GetEntity(index).childCount++;
           }
         }
       }
-      else {
-        uint32_t numChildren = 0;
-        ofs.write(reinterpret_cast<const char*>(&numChildren), sizeof(numChildren));
-      }
-
-      return true;
     }
 
-    void SerializeTransformComponent(std::ofstream& ofs, const TransformComponent& transform)
+    static uint32_t WriteTextureReference(SceneCacheWriter& writer, const Texture* texture)
     {
-      // Sérialisation de la position
-      ofs.write(reinterpret_cast<const char*>(&transform.GetPosition()),
-                sizeof(transform.GetPosition()));
-      // Sérialisation de la rotation
-      ofs.write(reinterpret_cast<const char*>(&transform.GetRotation()),
-                sizeof(transform.GetRotation()));
-      // Sérialisation de l'échelle
-      ofs.write(reinterpret_cast<const char*>(&transform.GetScale()), sizeof(transform.GetScale()));
+      return texture ? writer.AddString(texture->GetFilename()) : SCENE_CACHE_NONE;
     }
 
-    void SerializeMeshComponent(std::ofstream& ofs, const MeshComponent& meshComponent)
-    {
-      if (auto mesh = meshComponent.GetMesh()) {
-        ofs.put(1); // Possède un maillage
-        SerializeMesh(ofs, *mesh);
-      }
-      else {
-        ofs.put(0); // Ne possède pas de maillage
-      }
-    }
-
-    static void SerializePBRRenderer(std::ofstream& ofs, const PBRRenderer& renderer)
-    {
-      XMFLOAT4 baseColor = renderer.GetBaseColor();
-      float    metallic = renderer.GetMetallic();
-      float    roughness = renderer.GetRoughness();
-      float    ao = renderer.GetAO();
-
-      ofs.write(reinterpret_cast<const char*>(&baseColor), sizeof(baseColor));
-      ofs.write(reinterpret_cast<const char*>(&metallic), sizeof(metallic));
-      ofs.write(reinterpret_cast<const char*>(&roughness), sizeof(roughness));
-      ofs.write(reinterpret_cast<const char*>(&ao), sizeof(ao));
-
-      SerializeTextureReference(ofs, renderer.GetAlbedoTexture());
-      SerializeTextureReference(ofs, renderer.GetNormalMap());
-      SerializeTextureReference(ofs, renderer.GetAOMap());
-    }
-
-
-    static void SerializeTextureReference(std::ofstream& ofs, const Texture* texture)
-    {
-      if (texture) {
-        ofs.put(1); // Texture présente
-        std::wstring textureFilename = texture->GetFilename();
-        uint32_t     length = static_cast<uint32_t>(textureFilename.size());
-        ofs.write(reinterpret_cast<const char*>(&length), sizeof(length));
-        ofs.write(reinterpret_cast<const char*>(textureFilename.data()), length * sizeof(wchar_t));
+    // Flux en lecture sur un bloc du fichier projeté, sans copie
+    struct BlobStreamBuffer : std::streambuf {
+      explicit BlobStreamBuffer(std::span<const uint8_t> blob)
+      {
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(blob.data()));
+        setg(begin, begin, begin + blob.size());
       }
-      else {
-        ofs.put(0); // Pas de texture
-      }
-    }
-
-    void SerializeMesh(std::ofstream& ofs, const Mesh& mesh)
-    {
-      // Sérialisation des sommets
-      const auto& vertices = mesh.GetVertices();
-      uint32_t    numVertices = static_cast<uint32_t>(vertices.size());
-      ofs.write(reinterpret_cast<const char*>(&numVertices), sizeof(numVertices));
-      ofs.write(reinterpret_cast<const char*>(vertices.data()), numVertices * sizeof(Vertex));
-
-      // Sérialisation des indices
-      const auto& indices = mesh.GetIndices();
-      uint32_t    numIndices = static_cast<uint32_t>(indices.size());
-      ofs.write(reinterpret_cast<const char*>(&numIndices), sizeof(numIndices));
-      ofs.write(reinterpret_cast<const char*>(indices.data()), numIndices * sizeof(uint32_t));
-    }
+    };
 
-    std::shared_ptr<Entity> DeserializeEntity(std::ifstream& ifs)
+    // Crée l'entité d'un enregistrement, sans ses enfants
+    std::shared_ptr<Entity> ReadCacheEntity(const SceneCacheReader& reader, const SceneCacheEntity& record)
     {
       auto entity = World::GetInstance().CreateEntity();
 
-      // Désérialisation de TransformComponent
-      char hasTransform;
-      ifs.get(hasTransform);
-      if (hasTransform) {
-        DeserializeTransformComponent(ifs, entity);
+      if (record.hasTransform) {
+        entity->AddComponent<TransformComponent>(record.position, record.rotation, record.scale);
       }
 
-      // Désérialisation de MeshComponent
-      char hasMeshComponent;
-      ifs.get(hasMeshComponent);
-      if (hasMeshComponent) {
-        DeserializeMeshComponent(ifs, entity);
+      if (record.meshFirst != SCENE_CACHE_NONE) {
+        auto&      meshComponent = entity->AddComponent<MeshComponent>();
+        const auto meshes = reader.GetMeshes();
+        for (uint32_t i = 0; i < record.meshCount && record.meshFirst + i < meshes.size(); i++) {
+          const SceneCacheMesh& cached = meshes[record.meshFirst + i];
+          // Les buffers GPU sont créés directement depuis la vue projetée du fichier, sans conversion
+          auto mesh = cached.format == VertexFormat::Packed
+                        ? std::make_shared<Mesh>(m_pDispositif->GetD3DDevice(), reader.GetPositions(cached),
+                                                 reader.GetAttributes(cached), reader.GetIndices(cached))
+                        : std::make_shared<Mesh>(m_pDispositif->GetD3DDevice(), reader.GetVertices(cached),
+                                                 reader.GetIndices(cached));
+          if (i == 0) {
+            meshComponent.SetMesh(mesh);
+          }
+          else {
+            meshComponent.AddLODLevel(cached.screenSize, mesh);
+          }
+        }
       }
 
-      // Désérialisation de PBRRenderer
-      char hasPBRRenderer;
-      ifs.get(hasPBRRenderer);
-      if (hasPBRRenderer) {
-        DeserializePBRRenderer(ifs, entity);
+      if (record.material != SCENE_CACHE_NONE && record.material < reader.GetMaterials().size()) {
+        ReadCacheMaterial(reader, reader.GetMaterials()[record.material], entity);
       }
 
-      // Désérialisation de ColliderComponent
-      char hasCollider;
-      ifs.get(hasCollider);
-      if (hasCollider) {
-        ColliderComponent::Type colliderType;
-        ifs.read(reinterpret_cast<char*>(&colliderType), sizeof(colliderType));
-        auto& collider = entity->AddComponent<ColliderComponent>();
-        collider.Deserialize(ifs);
+      if (record.colliderBlob != SCENE_CACHE_NONE) {
+        BlobStreamBuffer buffer(reader.GetBlob(record.colliderBlob, record.colliderSize));
+        std::istream     in(&buffer);
+        auto&            collider = entity->AddComponent<ColliderComponent>();
+        collider.Deserialize(in, &m_colliderMeshes);
       }
 
-      // Désérialisation de RigidBodyComponent
-      char hasRigidBody;
-      ifs.get(hasRigidBody);
-      if (hasRigidBody) {
-        RigidBodyComponent::Type type;
-        ifs.read(reinterpret_cast<char*>(&type), sizeof(type));
-        auto& rigidBody = entity->AddComponent<RigidBodyComponent>(type);
+      if (record.rigidBodyType >= 0) {
+        auto& rigidBody = entity->AddComponent<RigidBodyComponent>(
+          static_cast<RigidBodyComponent::Type>(record.rigidBodyType));
         rigidBody.Initialize();
       }
 
-
-      // Désérialisation des enfants
-      uint32_t numChildren;
-      ifs.read(reinterpret_cast<char*>(&numChildren), sizeof(numChildren));
-
-      auto transform = entity->GetComponent<TransformComponent>();
-      for (uint32_t i = 0; i < numChildren; ++i) {
-        auto childEntity = DeserializeEntity(ifs);
-        if (transform && childEntity) {
-          transform->AddChild(childEntity->GetId());
-        }
-      }
-
       return entity;
     }
 
-    static void DeserializeTransformComponent(std::ifstream&                 ifs,
-                                              const std::shared_ptr<Entity>& entity)
-    {
-      XMFLOAT3 position;
-      XMFLOAT4 rotation;
-      XMFLOAT3 scale;
-
-      ifs.read(reinterpret_cast<char*>(&position), sizeof(position));
-      ifs.read(reinterpret_cast<char*>(&rotation), sizeof(rotation));
-      ifs.read(reinterpret_cast<char*>(&scale), sizeof(scale));
-
-      entity->AddComponent<TransformComponent>(position, rotation, scale);
-    }
-
-    void DeserializeMeshComponent(std::ifstream& ifs, const std::shared_ptr<Entity>& entity) const
-    {
-      auto& meshComponent = entity->AddComponent<MeshComponent>();
-      char  hasMesh;
-      ifs.get(hasMesh);
-      if (hasMesh) {
-        auto mesh = DeserializeMesh(ifs);
-        meshComponent.SetMesh(mesh);
-      }
-    }
-
-    void DeserializePBRRenderer(std::ifstream& ifs, std::shared_ptr<Entity> entity)
+    void ReadCacheMaterial(const SceneCacheReader&        reader,
+                           const SceneCacheMaterial&      material,
+                           const std::shared_ptr<Entity>& entity)
     {
       auto& renderer = entity->AddComponent<PBRRenderer>(m_pDispositif->GetD3DDevice());
 
-      XMFLOAT4 baseColor;
-      float    metallic;
-      float    roughness;
-      float    ao;
-
-      ifs.read(reinterpret_cast<char*>(&baseColor), sizeof(baseColor));
-      ifs.read(reinterpret_cast<char*>(&metallic), sizeof(metallic));
-      ifs.read(reinterpret_cast<char*>(&roughness), sizeof(roughness));
-      ifs.read(reinterpret_cast<char*>(&ao), sizeof(ao));
+      renderer.SetBaseColor(material.baseColor);
+      renderer.SetMetallic(material.metallic);
+      renderer.SetRoughness(material.roughness);
+      renderer.SetAmbientOcclusion(material.ao);
 
-      renderer.SetBaseColor(baseColor);
-      renderer.SetMetallic(metallic);
-      renderer.SetRoughness(roughness);
-      renderer.SetAmbientOcclusion(ao);
-
-      if (auto* albedo = DeserializeTextureReference(ifs)) renderer.SetAlbedoTexture(albedo);
-      if (auto* normal = DeserializeTextureReference(ifs)) renderer.SetNormalMap(normal);
-      if (auto* occlusion = DeserializeTextureReference(ifs)) renderer.SetAOMap(occlusion);
-      // TODO MetallicRoughnessMap
+      if (auto* albedo = ReadTextureReference(reader, material.albedo)) renderer.SetAlbedoTexture(albedo);
+      if (auto* normal = ReadTextureReference(reader, material.normal)) renderer.SetNormalMap(normal);
+      if (auto* occlusion = ReadTextureReference(reader, material.occlusion)) renderer.SetAOMap(occlusion);
+      if (auto* metallicRoughness = ReadTextureReference(reader, material.metallicRoughness)) {
+        renderer.SetMetallicRoughnessMap(metallicRoughness);
+      }
     }
 
-    Texture* DeserializeTextureReference(std::ifstream& ifs) const
+    Texture* ReadTextureReference(const SceneCacheReader& reader, uint32_t offset) const
     {
-      char hasTexture;
-      ifs.get(hasTexture);
-      if (hasTexture) {
-        uint32_t length;
-        ifs.read(reinterpret_cast<char*>(&length), sizeof(length));
-        std::wstring textureFilename(length, L'\0');
-        ifs.read(reinterpret_cast<char*>(textureFilename.data()), length * sizeof(wchar_t));
+      const std::wstring_view filename = reader.GetString(offset);
+      if (filename.empty()) return nullptr;
 
-        return m_textureManager->GetNewTexture(textureFilename.c_str(), m_pDispositif);
-      }
-      return nullptr;
-    }
-    std::shared_ptr<Mesh> DeserializeMesh(std::ifstream& ifs) const
-    {
-      // Désérialisation des sommets
-      uint32_t numVertices;
-      ifs.read(reinterpret_cast<char*>(&numVertices), sizeof(numVertices));
-      std::vector<Vertex> vertices(numVertices);
-      ifs.read(reinterpret_cast<char*>(vertices.data()), numVertices * sizeof(Vertex));
-
-      // Désérialisation des indices
-      uint32_t numIndices;
-      ifs.read(reinterpret_cast<char*>(&numIndices), sizeof(numIndices));
-      std::vector<uint32_t> indices(numIndices);
-      ifs.read(reinterpret_cast<char*>(indices.data()), numIndices * sizeof(uint32_t));
-
-      // Création du maillage
-      auto mesh = std::make_shared<Mesh>(m_pDispositif->GetD3DDevice(), vertices, indices);
-
-      return mesh;
+      return m_textureManager->GetNewTexture(std::wstring(filename), m_pDispositif);
     }
   };
 }
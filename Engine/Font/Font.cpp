@@ -0,0 +1,22 @@
+﻿#include "Font.h"
+
+#include "SdfFontAtlas.h"
+
+namespace FrostFireEngine
+{
+  Font::Font() = default;
+
+  Font::~Font() = default;
+
+  const Font::Glyph* Font::GetOrAddGlyph(wchar_t c)
+  {
+    if (const Glyph* glyph = FindGlyph(c)) return glyph;
+    if (!m_sdfAtlas || !m_sdfAtlas->AddGlyph(c, *this)) return nullptr;
+    return FindGlyph(c);
+  }
+
+  void Font::SetDistanceFieldAtlas(std::unique_ptr<SdfFontAtlas> atlas)
+  {
+    m_sdfAtlas = std::move(atlas);
+  }
+}
@@ -1,12 +1,16 @@
 ﻿#pragma once
 #include <d3d11.h>
 #include <wrl/client.h>
+#include <array>
+#include <memory>
 #include <unordered_map>
 
 namespace FrostFireEngine
 {
   using Microsoft::WRL::ComPtr;
 
+  class SdfFontAtlas;
+
   class Font {
   public:
     struct Glyph {
@@ -16,6 +20,14 @@ namespace FrostFireEngine
       float width, height;
     };
 
+    static constexpr wchar_t ASCII_GLYPH_COUNT = 128;
+
+    Font();
+    ~Font();
+    // m_asciiGlyphs pointe dans m_glyphs
+    Font(const Font&) = delete;
+    Font& operator=(const Font&) = delete;
+
     ID3D11ShaderResourceView* GetAtlasSRV() const
     {
       return m_fontAtlasSRV.Get();
@@ -26,9 +38,20 @@ namespace FrostFireEngine
     }
     bool HasGlyph(wchar_t c) const
     {
-      return m_glyphs.find(c) != m_glyphs.end();
+      return FindGlyph(c) != nullptr;
+    }
+
+    // nullptr si le caractère est absent ; accès direct par tableau pour l'ASCII, sans hachage
+    const Glyph* FindGlyph(wchar_t c) const
+    {
+      if (c < ASCII_GLYPH_COUNT) return m_asciiGlyphs[c];
+      const auto it = m_glyphs.find(c);
+      return it != m_glyphs.end() ? &it->second : nullptr;
     }
 
+    // Comme FindGlyph, mais une fonte SDF rastérise à la demande les caractères pas encore dans l'atlas
+    const Glyph* GetOrAddGlyph(wchar_t c);
+
     float GetLineHeight() const
     {
       return m_lineHeight;
@@ -36,7 +59,10 @@ namespace FrostFireEngine
 
     void AddGlyph(wchar_t c, const Glyph& g)
     {
-      m_glyphs[c] = g;
+      Glyph& stored = m_glyphs[c];
+      stored = g;
+      // Les éléments d'un unordered_map ne sont pas déplacés par un rehash
+      if (c < ASCII_GLYPH_COUNT) m_asciiGlyphs[c] = &stored;
     }
     void SetAtlasSRV(ComPtr<ID3D11ShaderResourceView> srv)
     {
@@ -47,9 +73,22 @@ namespace FrostFireEngine
       m_lineHeight = lh;
     }
 
+    // Atlas en champ de distance : le texte passe par la feature SDF_TEXT de TextTechnique
+    bool IsDistanceField() const
+    {
+      return m_sdfAtlas != nullptr;
+    }
+    SdfFontAtlas* GetDistanceFieldAtlas() const
+    {
+      return m_sdfAtlas.get();
+    }
+    void SetDistanceFieldAtlas(std::unique_ptr<SdfFontAtlas> atlas);
+
   private:
-    std::unordered_map<wchar_t, Glyph> m_glyphs;
-    ComPtr<ID3D11ShaderResourceView>   m_fontAtlasSRV;
-    float                              m_lineHeight = 0.0f;
+    std::unordered_map<wchar_t, Glyph>          m_glyphs;
+    std::array<const Glyph*, ASCII_GLYPH_COUNT> m_asciiGlyphs = {};
+    ComPtr<ID3D11ShaderResourceView>            m_fontAtlasSRV;
+    float                                       m_lineHeight = 0.0f;
+    std::unique_ptr<SdfFontAtlas>               m_sdfAtlas;
   };
 }
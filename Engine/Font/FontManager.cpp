@@ -3,6 +3,7 @@
 #include <fstream>
 #include <sstream>
 
+#include "SdfFontAtlas.h"
 #include "Engine/Texture.h"
 
 namespace FrostFireEngine
@@ -70,4 +71,29 @@ namespace FrostFireEngine
     m_fonts[key] = std::move(font);
     return m_fonts[key].get();
   }
+
+  Font* FontManager::LoadTrueTypeFont(const std::wstring& ttfFile, DispositifD3D11* pDispositif)
+  {
+    if (m_fonts.contains(ttfFile)) return m_fonts[ttfFile].get();
+
+    auto font = std::make_unique<Font>();
+    auto atlas = std::make_unique<SdfFontAtlas>();
+    if (!atlas->Initialize(ttfFile, pDispositif, *font)) {
+      ErrorLogger::Log("FontManager: Could not load TrueType font.");
+      return nullptr;
+    }
+    font->SetDistanceFieldAtlas(std::move(atlas));
+
+    m_fonts[ttfFile] = std::move(font);
+    return m_fonts[ttfFile].get();
+  }
+
+  void FontManager::SaveFontCaches()
+  {
+    for (const auto& [key, font] : m_fonts) {
+      if (SdfFontAtlas* atlas = font->GetDistanceFieldAtlas()) {
+        atlas->SaveCache();
+      }
+    }
+  }
 }
@@ -23,6 +23,13 @@ namespace FrostFireEngine
                    const std::wstring& textureFile,
                    DispositifD3D11*    pDispositif);
 
+    // Charge une fonte TrueType rendue en champ de distance signé (voir SdfFontAtlas) :
+    // un seul atlas pour toutes les tailles, glyphes hors ASCII ajoutés à la demande.
+    Font* LoadTrueTypeFont(const std::wstring& ttfFile, DispositifD3D11* pDispositif);
+
+    // Écrit sur disque les atlas SDF complétés pendant l'exécution
+    void SaveFontCaches();
+
     FontManager(const FontManager&) = delete;
     FontManager& operator=(const FontManager&) = delete;
 
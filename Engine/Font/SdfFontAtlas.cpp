@@ -0,0 +1,319 @@
+﻿#include "SdfFontAtlas.h"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "Engine/DispositifD3D11.h"
+#include "Engine/SceneCache.h"
+#include "Engine/Utils/ErrorLogger.h"
+#include "Engine/Utils/MappedFile.h"
+
+// Implémentations privées à ce fichier (static), indépendantes de celles d'imgui_draw.cpp
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "Engine/ImGui/imstb_rectpack.h"
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "Engine/ImGui/imstb_truetype.h"
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  struct SdfFontAtlas::StbState {
+    stbtt_fontinfo          info = {};
+    stbrp_context           packer = {};
+    std::vector<stbrp_node> nodes;
+  };
+
+  namespace
+  {
+    struct SdfFontCacheHeader {
+      uint32_t magic;
+      uint32_t version;
+      uint64_t key;
+      uint32_t glyphCount;
+      uint32_t rowCount;   // lignes de l'atlas stockées, les suivantes sont vides
+      uint64_t dataHash;
+    };
+    static_assert(sizeof(SdfFontCacheHeader) == 32);
+
+    constexpr wchar_t FIRST_PRELOADED_CHAR = 32;   // ASCII imprimable, rastérisé au premier chargement
+    constexpr wchar_t LAST_PRELOADED_CHAR = 126;
+  }
+
+  const std::filesystem::path SdfFontAtlas::cacheDirectory = L"FontCache";
+
+  SdfFontAtlas::SdfFontAtlas()
+    : m_stb(std::make_unique<StbState>())
+  {
+  }
+
+  SdfFontAtlas::~SdfFontAtlas() = default;
+
+  bool SdfFontAtlas::Initialize(const std::wstring& ttfPath, DispositifD3D11* dispositif, Font& font)
+  {
+    m_dispositif = dispositif;
+
+    {
+      std::ifstream file(ttfPath, std::ios::binary | std::ios::ate);
+      if (!file) return false;
+      m_ttfData.resize(static_cast<size_t>(file.tellg()));
+      file.seekg(0);
+      file.read(reinterpret_cast<char*>(m_ttfData.data()), static_cast<std::streamsize>(m_ttfData.size()));
+      if (!file || m_ttfData.empty()) return false;
+    }
+
+    const int fontOffset = stbtt_GetFontOffsetForIndex(m_ttfData.data(), 0);
+    if (fontOffset < 0 || !stbtt_InitFont(&m_stb->info, m_ttfData.data(), fontOffset)) return false;
+
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(&m_stb->info, &ascent, &descent, &lineGap);
+    m_scale = stbtt_ScaleForPixelHeight(&m_stb->info, GLYPH_PIXEL_HEIGHT);
+    m_ascentPx = static_cast<float>(ascent) * m_scale;
+    m_lineHeightPx = static_cast<float>(ascent - descent + lineGap) * m_scale;
+
+    // Toute modification des paramètres de rastérisation invalide le cache
+    const uint32_t parameters[] = {
+      SDF_FONT_CACHE_VERSION, ATLAS_SIZE, std::bit_cast<uint32_t>(GLYPH_PIXEL_HEIGHT),
+      static_cast<uint32_t>(SDF_PADDING), SDF_ON_EDGE, static_cast<uint32_t>(GLYPH_SPACING)
+    };
+    m_cacheKey = HashBytes(m_ttfData.data(), m_ttfData.size(), HashBytes(parameters, sizeof(parameters)));
+
+    // Les dimensions des glyphes sont normalisées par rapport à la line height, comme pour les
+    // fontes bitmap de FontManager::LoadFont
+    font.SetLineHeight(1.0f);
+
+    ResetAtlas();
+    if (!LoadCache(font)) {
+      ResetAtlas();
+      for (wchar_t c = FIRST_PRELOADED_CHAR; c <= LAST_PRELOADED_CHAR; c++) {
+        AddGlyph(c, font);
+      }
+    }
+
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = ATLAS_SIZE;
+    texDesc.Height = ATLAS_SIZE;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = DXGI_FORMAT_R8_UNORM;
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = m_pixels.data();
+    initData.SysMemPitch = ATLAS_SIZE;
+
+    ID3D11Device* device = dispositif->GetD3DDevice();
+    if (FAILED(device->CreateTexture2D(&texDesc, &initData, &m_texture))) {
+      ErrorLogger::Log("SdfFontAtlas: Failed to create atlas texture.");
+      return false;
+    }
+
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+    if (FAILED(device->CreateShaderResourceView(m_texture.Get(), nullptr, &srv))) {
+      ErrorLogger::Log("SdfFontAtlas: Failed to create atlas SRV.");
+      return false;
+    }
+    font.SetAtlasSRV(srv);
+    return true;
+  }
+
+  void SdfFontAtlas::ResetAtlas()
+  {
+    m_stb->nodes.resize(ATLAS_SIZE);
+    stbrp_init_target(&m_stb->packer, ATLAS_SIZE, ATLAS_SIZE, m_stb->nodes.data(),
+                      static_cast<int>(m_stb->nodes.size()));
+    m_pixels.assign(static_cast<size_t>(ATLAS_SIZE) * ATLAS_SIZE, 0);
+    m_glyphs.clear();
+    m_full = false;
+  }
+
+  bool SdfFontAtlas::AddGlyph(wchar_t c, Font& font)
+  {
+    if (m_full || m_missing.contains(c)) return false;
+
+    PackedGlyph packed;
+    if (!RasterizeGlyph(c, packed)) {
+      if (!m_full) m_missing.insert(c);
+      return false;
+    }
+
+    m_glyphs.push_back(packed);
+    font.AddGlyph(c, packed.glyph);
+    m_dirty = true;
+    return true;
+  }
+
+  bool SdfFontAtlas::PackRect(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y)
+  {
+    stbrp_rect rect = {};
+    rect.w = static_cast<stbrp_coord>(width);
+    rect.h = static_cast<stbrp_coord>(height);
+    stbrp_pack_rects(&m_stb->packer, &rect, 1);
+    if (!rect.was_packed) return false;
+
+    x = static_cast<uint32_t>(rect.x);
+    y = static_cast<uint32_t>(rect.y);
+    return true;
+  }
+
+  bool SdfFontAtlas::RasterizeGlyph(wchar_t c, PackedGlyph& packed)
+  {
+    const int glyphIndex = stbtt_FindGlyphIndex(&m_stb->info, c);
+    if (glyphIndex == 0) return false;  // .notdef : caractère absent de la fonte
+
+    int advance, leftSideBearing;
+    stbtt_GetGlyphHMetrics(&m_stb->info, glyphIndex, &advance, &leftSideBearing);
+
+    int            width = 0, height = 0, xOffset = 0, yOffset = 0;
+    unsigned char* sdf = stbtt_GetGlyphSDF(&m_stb->info, m_scale, glyphIndex, SDF_PADDING, SDF_ON_EDGE,
+                                           static_cast<float>(SDF_ON_EDGE) / SDF_PADDING,
+                                           &width, &height, &xOffset, &yOffset);
+
+    packed = {};
+    packed.codepoint = c;
+
+    // Glyphe sans contour (espace) : seulement une avance, rien dans l'atlas
+    if (sdf) {
+      packed.rectWidth = static_cast<uint32_t>(width) + GLYPH_SPACING;
+      packed.rectHeight = static_cast<uint32_t>(height) + GLYPH_SPACING;
+      if (!PackRect(packed.rectWidth, packed.rectHeight, packed.x, packed.y)) {
+        stbtt_FreeSDF(sdf, nullptr);
+        m_full = true;
+        OutputDebugStringA("SdfFontAtlas : atlas plein, les nouveaux glyphes ne sont plus affiches\n");
+        return false;
+      }
+
+      for (int row = 0; row < height; row++) {
+        memcpy(&m_pixels[(packed.y + row) * ATLAS_SIZE + packed.x], sdf + row * width, width);
+      }
+      stbtt_FreeSDF(sdf, nullptr);
+      UploadRegion(packed.x, packed.y, width, height);
+    }
+
+    const float toLine = 1.0f / m_lineHeightPx;
+    const float toUV = 1.0f / ATLAS_SIZE;
+
+    Font::Glyph& glyph = packed.glyph;
+    glyph.u0 = packed.x * toUV;
+    glyph.v0 = packed.y * toUV;
+    glyph.u1 = (packed.x + width) * toUV;
+    glyph.v1 = (packed.y + height) * toUV;
+    glyph.xOffset = xOffset * toLine;
+    glyph.yOffset = (m_ascentPx + yOffset) * toLine;  // yOffset part de la ligne de base
+    glyph.width = width * toLine;
+    glyph.height = height * toLine;
+    glyph.xAdvance = advance * m_scale * toLine;
+    return true;
+  }
+
+  void SdfFontAtlas::UploadRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+  {
+    // Pendant Initialize, la texture est créée ensuite avec tout l'atlas
+    if (!m_texture || width == 0 || height == 0) return;
+
+    const D3D11_BOX box = {x, y, 0, x + width, y + height, 1};
+    m_dispositif->GetImmediateContext()->UpdateSubresource(m_texture.Get(), 0, &box,
+                                                           &m_pixels[y * ATLAS_SIZE + x], ATLAS_SIZE, 0);
+  }
+
+  std::filesystem::path SdfFontAtlas::GetCachePath() const
+  {
+    wchar_t name[24];
+    swprintf_s(name, L"%016llx.sdf", static_cast<unsigned long long>(m_cacheKey));
+    return cacheDirectory / name;
+  }
+
+  bool SdfFontAtlas::LoadCache(Font& font)
+  {
+    MappedFile file;
+    if (!file.Open(GetCachePath().wstring()) || file.GetSize() < sizeof(SdfFontCacheHeader)) return false;
+
+    SdfFontCacheHeader header;
+    memcpy(&header, file.GetData(), sizeof(header));
+    const size_t glyphBytes = static_cast<size_t>(header.glyphCount) * sizeof(PackedGlyph);
+    const size_t pixelBytes = static_cast<size_t>(header.rowCount) * ATLAS_SIZE;
+    const uint8_t* data = file.GetData() + sizeof(header);
+    if (header.magic != SDF_FONT_CACHE_MAGIC || header.version != SDF_FONT_CACHE_VERSION ||
+      header.key != m_cacheKey || header.rowCount > ATLAS_SIZE ||
+      file.GetSize() != sizeof(header) + glyphBytes + pixelBytes ||
+      header.dataHash != HashBytes(data, glyphBytes + pixelBytes)) {
+      return false;
+    }
+
+    std::vector<PackedGlyph> glyphs(header.glyphCount);
+    memcpy(glyphs.data(), data, glyphBytes);
+
+    // stb_rect_pack est déterministe : rejouer les insertions dans le même ordre redonne les
+    // mêmes positions et l'état du packer, pour continuer à ajouter des glyphes à la demande
+    for (const PackedGlyph& packed : glyphs) {
+      if (packed.rectWidth == 0) continue;
+      uint32_t x, y;
+      if (!PackRect(packed.rectWidth, packed.rectHeight, x, y) || x != packed.x || y != packed.y) {
+        return false;
+      }
+    }
+
+    memcpy(m_pixels.data(), data + glyphBytes, pixelBytes);
+    m_glyphs = std::move(glyphs);
+    for (const PackedGlyph& packed : m_glyphs) {
+      font.AddGlyph(static_cast<wchar_t>(packed.codepoint), packed.glyph);
+    }
+    m_dirty = false;
+    return true;
+  }
+
+  bool SdfFontAtlas::SaveCache()
+  {
+    if (!m_dirty) return true;
+
+    uint32_t rowCount = 0;
+    for (const PackedGlyph& packed : m_glyphs) {
+      rowCount = std::max(rowCount, std::min(packed.y + packed.rectHeight, ATLAS_SIZE));
+    }
+
+    const size_t       glyphBytes = m_glyphs.size() * sizeof(PackedGlyph);
+    const size_t       pixelBytes = static_cast<size_t>(rowCount) * ATLAS_SIZE;
+    std::vector<uint8_t> payload(glyphBytes + pixelBytes);
+    memcpy(payload.data(), m_glyphs.data(), glyphBytes);
+    memcpy(payload.data() + glyphBytes, m_pixels.data(), pixelBytes);
+
+    const SdfFontCacheHeader header = {
+      SDF_FONT_CACHE_MAGIC, SDF_FONT_CACHE_VERSION, m_cacheKey, static_cast<uint32_t>(m_glyphs.size()),
+      rowCount, HashBytes(payload.data(), payload.size())
+    };
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+
+    // Fichier temporaire puis renommage : un cache interrompu n'est jamais lu
+    const std::filesystem::path path = GetCachePath();
+    std::filesystem::path       tempPath = path;
+    tempPath += L".tmp";
+    {
+      std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+      ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      ofs.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+      if (!ofs) {
+        ofs.close();
+        std::filesystem::remove(tempPath, error);
+        return false;
+      }
+    }
+
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+
+    m_dirty = false;
+    return true;
+  }
+}
@@ -0,0 +1,86 @@
+﻿#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Font.h"
+
+namespace FrostFireEngine
+{
+  class DispositifD3D11;
+
+  // Atlas de glyphes en champ de distance signé (SDF) rastérisés depuis un TrueType avec
+  // stb_truetype et rangés par stb_rect_pack. Une seule résolution de rastérisation suffit à
+  // toutes les tailles d'affichage : le shader (define SDF_TEXT) reconstruit un bord net.
+  // L'atlas est mis en cache dans FontCache/, clé = contenu du TTF et paramètres ci-dessous.
+  constexpr const char* SDF_TEXT_FEATURE = "SDF_TEXT";
+
+  constexpr uint32_t SDF_FONT_CACHE_MAGIC = 0x44534646;  // "FFSD"
+  constexpr uint32_t SDF_FONT_CACHE_VERSION = 1;
+
+  class SdfFontAtlas {
+  public:
+    static constexpr uint32_t ATLAS_SIZE = 1024;         // R8, 1 Mo
+    static constexpr float    GLYPH_PIXEL_HEIGHT = 48.0f;
+    static constexpr int      SDF_PADDING = 6;           // pixels de distance autour du contour
+    static constexpr uint8_t  SDF_ON_EDGE = 128;
+    static constexpr int      GLYPH_SPACING = 1;         // entre deux rectangles de l'atlas
+
+    static const std::filesystem::path cacheDirectory;
+
+    SdfFontAtlas();
+    ~SdfFontAtlas();
+
+    SdfFontAtlas(const SdfFontAtlas&) = delete;
+    SdfFontAtlas& operator=(const SdfFontAtlas&) = delete;
+
+    // Lit le TTF, reprend l'atlas en cache s'il correspond, sinon rastérise l'ASCII imprimable.
+    // Renseigne la hauteur de ligne, la texture et les glyphes de font.
+    bool Initialize(const std::wstring& ttfPath, DispositifD3D11* dispositif, Font& font);
+
+    // Rastérise un glyphe absent de font ; false s'il n'existe pas dans le TTF ou si l'atlas est plein
+    bool AddGlyph(wchar_t c, Font& font);
+
+    // N'écrit que si des glyphes ont été ajoutés depuis le chargement
+    bool SaveCache();
+
+  private:
+    struct PackedGlyph {
+      uint32_t    codepoint;
+      uint32_t    rectWidth;   // espacement compris, tel que passé à stb_rect_pack
+      uint32_t    rectHeight;
+      uint32_t    x;
+      uint32_t    y;
+      Font::Glyph glyph;
+    };
+
+    void                  ResetAtlas();
+    bool                  PackRect(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+    bool                  RasterizeGlyph(wchar_t c, PackedGlyph& packed);
+    void                  UploadRegion(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+    std::filesystem::path GetCachePath() const;
+    bool                  LoadCache(Font& font);
+
+    struct StbState;  // stbtt_fontinfo et stbrp_context, confinés au .cpp
+    std::unique_ptr<StbState> m_stb;
+
+    std::vector<uint8_t>        m_ttfData;
+    std::vector<uint8_t>        m_pixels;   // copie CPU de l'atlas, ATLAS_SIZE * ATLAS_SIZE
+    std::vector<PackedGlyph>    m_glyphs;   // ordre d'insertion, rejoué au chargement du cache
+    std::unordered_set<wchar_t> m_missing;  // absents du TTF, pour ne pas les rechercher à chaque frame
+    uint64_t                    m_cacheKey = 0;
+    float                       m_scale = 0.0f;  // unités TTF -> pixels de rastérisation
+    float                       m_lineHeightPx = 0.0f;
+    float                       m_ascentPx = 0.0f;
+    bool                        m_dirty = false;
+    bool                        m_full = false;
+
+    DispositifD3D11*                        m_dispositif = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> m_texture;
+  };
+}
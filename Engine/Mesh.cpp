@@ -7,33 +7,73 @@
 
 namespace FrostFireEngine
 {
-  Mesh::Mesh(ID3D11Device*                device,
-             const std::vector<Vertex>&   vertices,
-             const std::vector<uint32_t>& indices)
-    : indexCount(static_cast<UINT>(indices.size()))
-      , mVertices(vertices)
-      , mIndices(indices)
+  Mesh::Mesh(ID3D11Device*             device,
+             std::span<const Vertex>   vertices,
+             std::span<const uint32_t> indices,
+             VertexFormat              vertexFormat)
+    : vertexCount(static_cast<UINT>(vertices.size()))
+      , indexCount(static_cast<UINT>(indices.size()))
+      , format(vertexFormat)
   {
-    CalculateBounds();
-    CreateBuffers(device);
+    CalculateBounds(vertices, [](const Vertex& vertex) -> const XMFLOAT3& { return vertex.GetPosition(); });
+
+    if (!device || vertices.empty() || indices.empty()) return;
+
+    if (format == VertexFormat::Packed) {
+      const PackedVertexStreams streams = PackVertexStreams(vertices);
+      CreatePackedBuffers(device, streams.positions, streams.attributes);
+    }
+    else {
+      D3D11_BUFFER_DESC vertexBufferDesc{};
+      vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+      vertexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * vertices.size());
+      vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+      D3D11_SUBRESOURCE_DATA vertexData{};
+      vertexData.pSysMem = vertices.data();
+
+      DXEssayer(device->CreateBuffer(&vertexBufferDesc, &vertexData, &pVertexBuffer),
+                DXE_CREATIONVERTEXBUFFER);
+    }
+
+    CreateIndexBuffer(device, indices);
+  }
+
+  Mesh::Mesh(ID3D11Device*                           device,
+             std::span<const XMFLOAT3>               positions,
+             std::span<const PackedVertexAttributes> attributes,
+             std::span<const uint32_t>               indices)
+    : vertexCount(static_cast<UINT>(positions.size()))
+      , indexCount(static_cast<UINT>(indices.size()))
+      , format(VertexFormat::Packed)
+  {
+    CalculateBounds(positions, [](const XMFLOAT3& position) -> const XMFLOAT3& { return position; });
+
+    if (!device || positions.empty() || attributes.size() != positions.size() || indices.empty()) return;
+
+    // Flux lus sur place, par exemple depuis la projection du cache de scène
+    CreatePackedBuffers(device, positions, attributes);
+    CreateIndexBuffer(device, indices);
   }
 
   Mesh::~Mesh()
   {
     DXRelacher(pIndexBuffer);
+    DXRelacher(pAttributeBuffer);
     DXRelacher(pVertexBuffer);
   }
 
-  void Mesh::CalculateBounds()
+  template <typename T, typename Position>
+  void Mesh::CalculateBounds(std::span<const T> vertices, Position position)
   {
-    if (mVertices.empty()) return;
+    if (vertices.empty()) return;
 
-    const XMFLOAT3 firstPos = mVertices[0].GetPosition();
+    const XMFLOAT3 firstPos = position(vertices[0]);
     XMFLOAT3       minBounds = firstPos;
     XMFLOAT3       maxBounds = firstPos;
 
-    for (size_t i = 1; i < mVertices.size(); ++i) {
-      const XMFLOAT3& pos = mVertices[i].GetPosition();
+    for (size_t i = 1; i < vertices.size(); ++i) {
+      const XMFLOAT3& pos = position(vertices[i]);
       minBounds.x = std::min(minBounds.x, pos.x);
       minBounds.y = std::min(minBounds.y, pos.y);
       minBounds.z = std::min(minBounds.z, pos.z);
@@ -53,8 +93,8 @@ namespace FrostFireEngine
     XMStoreFloat3(&mBounds.sphere.center, vCenter);
 
     float maxRadiusSq = 0.0f;
-    for (const auto& vertex : mVertices) {
-      XMVECTOR pos = XMLoadFloat3(&vertex.GetPosition());
+    for (const auto& vertex : vertices) {
+      XMVECTOR pos = XMLoadFloat3(&position(vertex));
       XMVECTOR diff = XMVectorSubtract(pos, vCenter);
       float    distSq = XMVectorGetX(XMVector3LengthSq(diff));
       maxRadiusSq = std::max(maxRadiusSq, distSq);
@@ -63,28 +103,37 @@ namespace FrostFireEngine
     mBounds.sphere.radius = std::sqrt(maxRadiusSq);
   }
 
-  void Mesh::CreateBuffers(ID3D11Device* device)
+  void Mesh::CreatePackedBuffers(ID3D11Device*                           device,
+                                 std::span<const XMFLOAT3>               positions,
+                                 std::span<const PackedVertexAttributes> attributes)
   {
-    if (!device || mVertices.empty() || mIndices.empty()) return;
+    D3D11_BUFFER_DESC bufferDesc{};
+    bufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(XMFLOAT3) * positions.size());
+    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+    D3D11_SUBRESOURCE_DATA bufferData{};
+    bufferData.pSysMem = positions.data();
 
-    D3D11_BUFFER_DESC vertexBufferDesc{};
-    vertexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-    vertexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(Vertex) * mVertices.size());
-    vertexBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    DXEssayer(device->CreateBuffer(&bufferDesc, &bufferData, &pVertexBuffer),
+              DXE_CREATIONVERTEXBUFFER);
 
-    D3D11_SUBRESOURCE_DATA vertexData{};
-    vertexData.pSysMem = mVertices.data();
+    bufferDesc.ByteWidth = static_cast<UINT>(sizeof(PackedVertexAttributes) * attributes.size());
+    bufferData.pSysMem = attributes.data();
 
-    DXEssayer(device->CreateBuffer(&vertexBufferDesc, &vertexData, &pVertexBuffer),
+    DXEssayer(device->CreateBuffer(&bufferDesc, &bufferData, &pAttributeBuffer),
               DXE_CREATIONVERTEXBUFFER);
+  }
 
+  void Mesh::CreateIndexBuffer(ID3D11Device* device, std::span<const uint32_t> indices)
+  {
     D3D11_BUFFER_DESC indexBufferDesc{};
     indexBufferDesc.Usage = D3D11_USAGE_IMMUTABLE;
-    indexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * mIndices.size());
+    indexBufferDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * indices.size());
     indexBufferDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
 
     D3D11_SUBRESOURCE_DATA indexData{};
-    indexData.pSysMem = mIndices.data();
+    indexData.pSysMem = indices.data();
 
     DXEssayer(device->CreateBuffer(&indexBufferDesc, &indexData, &pIndexBuffer),
               DXE_CREATIONINDEXBUFFER);
@@ -94,7 +143,29 @@ namespace FrostFireEngine
   {
     if (!context || !pVertexBuffer || !pIndexBuffer) return;
 
-    static constexpr UINT stride = sizeof(Vertex);
+    if (format == VertexFormat::Packed) {
+      ID3D11Buffer*         buffers[] = {pVertexBuffer, pAttributeBuffer};
+      static constexpr UINT strides[] = {sizeof(XMFLOAT3), sizeof(PackedVertexAttributes)};
+      static constexpr UINT offsets[] = {0, 0};
+      context->IASetVertexBuffers(0, 2, buffers, strides, offsets);
+    }
+    else {
+      static constexpr UINT stride = sizeof(Vertex);
+      static constexpr UINT offset = 0;
+      context->IASetVertexBuffers(0, 1, &pVertexBuffer, &stride, &offset);
+    }
+
+    context->IASetIndexBuffer(pIndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+    context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    context->DrawIndexed(indexCount, 0, 0);
+  }
+
+  void Mesh::DrawPositions(ID3D11DeviceContext* context) const
+  {
+    if (!context || !pVertexBuffer || !pIndexBuffer) return;
+
+    // En Full, les positions sont lues avec le pas d'un Vertex complet
+    const UINT            stride = format == VertexFormat::Packed ? sizeof(XMFLOAT3) : sizeof(Vertex);
     static constexpr UINT offset = 0;
 
     context->IASetVertexBuffers(0, 1, &pVertexBuffer, &stride, &offset);
@@ -2,10 +2,12 @@
 #include <d3d11.h>
 #include <DirectXMath.h>
 #include <vector>
+#include <span>
 #include <memory>
 #include <cfloat>
 #include <algorithm>
 #include "Vertex.h"
+#include "VertexPacking.h"
 #include "Math/AABB.h"
 
 using namespace DirectX;
@@ -13,9 +15,12 @@ using namespace DirectX;
 namespace FrostFireEngine
 {
   class Mesh {
-    ID3D11Buffer* pVertexBuffer = nullptr;
+    ID3D11Buffer* pVertexBuffer = nullptr;     // Vertex (Full) ou positions (Packed)
+    ID3D11Buffer* pAttributeBuffer = nullptr;  // attributs compactés, Packed uniquement
     ID3D11Buffer* pIndexBuffer = nullptr;
+    UINT          vertexCount = 0;
     UINT          indexCount = 0;
+    VertexFormat  format = VertexFormat::Full;
 
     struct Bounds {
       AABB box;
@@ -26,16 +31,35 @@ namespace FrostFireEngine
       } sphere;
     } mBounds;
 
-    std::vector<Vertex>   mVertices;
-    std::vector<uint32_t> mIndices;
-
   public:
-    Mesh(ID3D11Device*                device,
-         const std::vector<Vertex>&   vertices,
-         const std::vector<uint32_t>& indices);
+    // Les données sources peuvent provenir d'un fichier projeté en mémoire (cache de scène).
+    // Elles ne sont lues que pendant la construction : seules les bornes restent côté CPU.
+    // En Packed, les sommets sont compactés ici ; le second constructeur reçoit des flux déjà compactés
+    Mesh(ID3D11Device*             device,
+         std::span<const Vertex>   vertices,
+         std::span<const uint32_t> indices,
+         VertexFormat              vertexFormat = VertexFormat::Full);
+    Mesh(ID3D11Device*                           device,
+         std::span<const XMFLOAT3>               positions,
+         std::span<const PackedVertexAttributes> attributes,
+         std::span<const uint32_t>               indices);
     ~Mesh();
 
-    void          Draw(ID3D11DeviceContext* context) const;
+    void Draw(ID3D11DeviceContext* context) const;
+    // Passes de profondeur : seul le flux 0 est lié, la position est en tête des deux formats
+    void DrawPositions(ID3D11DeviceContext* context) const;
+
+    VertexFormat GetVertexFormat() const
+    {
+      return format;
+    }
+    // Mémoire GPU occupée par les sommets, tous flux confondus
+    size_t GetVertexMemorySize() const
+    {
+      return vertexCount * GetVertexFormatSize(format);
+    }
+
+
     ID3D11Buffer* GetVertexBuffer() const
     {
       return pVertexBuffer;
@@ -44,6 +68,10 @@ namespace FrostFireEngine
     {
       return pIndexBuffer;
     }
+    UINT GetVertexCount() const
+    {
+      return vertexCount;
+    }
     UINT GetIndexCount() const
     {
       return indexCount;
@@ -58,22 +86,17 @@ namespace FrostFireEngine
       return mBounds.box.max;
     }
 
-    const std::vector<Vertex>& GetVertices() const
-    {
-      return mVertices;
-    }
-    const std::vector<uint32_t>& GetIndices() const
-    {
-      return mIndices;
-    }
-
     const Bounds& GetBounds() const
     {
       return mBounds;
     }
 
   private:
-    void CalculateBounds();
-    void CreateBuffers(ID3D11Device* device);
+    // position : projection d'un élément de vertices vers sa position
+    template <typename T, typename Position>
+    void CalculateBounds(std::span<const T> vertices, Position position);
+    void CreatePackedBuffers(ID3D11Device* device, std::span<const XMFLOAT3> positions,
+                             std::span<const PackedVertexAttributes> attributes);
+    void CreateIndexBuffer(ID3D11Device* device, std::span<const uint32_t> indices);
   };
 }
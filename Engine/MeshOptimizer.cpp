@@ -0,0 +1,352 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+
+#undef min
+#undef max
+
+namespace FrostFireEngine
+{
+  namespace
+  {
+    constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+    constexpr uint32_t MAX_VALENCE = 32;
+
+    // Paramètres de l'heuristique de Tom Forsyth ("Linear-Speed Vertex Cache Optimisation")
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    struct ScoreTables {
+      float cache[MeshOptimizer::CACHE_SIZE + 3];
+      float valence[MAX_VALENCE + 1];
+    };
+
+    const ScoreTables& GetScoreTables()
+    {
+      static const ScoreTables tables = [] {
+        ScoreTables t{};
+        for (uint32_t i = 0; i < MeshOptimizer::CACHE_SIZE + 3; i++) {
+          if (i < 3) {
+            // Les sommets du dernier triangle sont légèrement pénalisés pour éviter les bandes
+            t.cache[i] = LAST_TRIANGLE_SCORE;
+          }
+          else if (i < MeshOptimizer::CACHE_SIZE) {
+            const float scaler = 1.0f / static_cast<float>(MeshOptimizer::CACHE_SIZE - 3);
+            t.cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, CACHE_DECAY_POWER);
+          }
+          else {
+            t.cache[i] = 0.0f;
+          }
+        }
+        t.valence[0] = 0.0f;
+        for (uint32_t i = 1; i <= MAX_VALENCE; i++) {
+          // Favorise les sommets presque terminés pour ne pas laisser de triangles isolés
+          t.valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+        }
+        return t;
+      }();
+      return tables;
+    }
+
+    float VertexScore(int32_t cachePosition, uint32_t liveTriangles)
+    {
+      if (liveTriangles == 0) return -1.0f;
+
+      const ScoreTables& tables = GetScoreTables();
+      float              score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+      return score + tables.valence[std::min(liveTriangles, MAX_VALENCE)];
+    }
+  }
+
+  void MeshOptimizer::Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+  {
+    OptimizeVertexCache(indices, vertices.size());
+    OptimizeOverdraw(indices, vertices);
+    OptimizeVertexFetch(vertices, indices);
+  }
+
+  MeshOptimizer::MeshStats MeshOptimizer::OptimizeWithStats(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+  {
+    MeshStats stats;
+    stats.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    stats.before = AnalyzeVertexCache(indices, vertices.size());
+
+    Optimize(vertices, indices);
+
+    stats.vertexCount = static_cast<uint32_t>(vertices.size());
+    stats.after = AnalyzeVertexCache(indices, vertices.size());
+    return stats;
+  }
+
+  void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+  {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    // Adjacence sommet -> triangles encore à émettre (CSR, compactée à chaque émission)
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++) liveCount[indices[i]]++;
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + liveCount[v];
+
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+      std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+      for (size_t i = 0; i < triangleCount * 3; i++) {
+        adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+      }
+    }
+
+    std::vector<int32_t> cachePosition(vertexCount, -1);
+    std::vector<float>   vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+      vertexScore[v] = VertexScore(-1, liveCount[v]);
+    }
+
+    std::vector<float>   triangleScore(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; t++) {
+      triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+        vertexScore[indices[t * 3 + 2]];
+    }
+
+    uint32_t bestTriangle = static_cast<uint32_t>(
+      std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(CACHE_SIZE + 3);
+    newCache.reserve(CACHE_SIZE + 3);
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    size_t scanCursor = 0;
+
+    for (size_t n = 0; n < triangleCount; n++) {
+      // Aucun candidat dans le cache : on reprend au premier triangle non émis
+      if (bestTriangle == INVALID_INDEX) {
+        while (emitted[scanCursor]) scanCursor++;
+        bestTriangle = static_cast<uint32_t>(scanCursor);
+      }
+
+      const uint32_t* tri = &indices[bestTriangle * 3];
+      output.insert(output.end(), tri, tri + 3);
+      emitted[bestTriangle] = 1;
+
+      newCache.clear();
+      for (int k = 0; k < 3; k++) {
+        const uint32_t v = tri[k];
+
+        // Retrait du triangle de la liste du sommet
+        uint32_t* begin = &adjacency[offsets[v]];
+        uint32_t* end = begin + liveCount[v];
+        uint32_t* it = std::find(begin, end, bestTriangle);
+        if (it != end) {
+          *it = *(end - 1);
+          liveCount[v]--;
+        }
+
+        if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+          newCache.push_back(v);
+        }
+      }
+      const size_t triangleVertices = newCache.size();
+      for (const uint32_t v : cache) {
+        const auto triangleEnd = newCache.begin() + triangleVertices;
+        if (std::find(newCache.begin(), triangleEnd, v) == triangleEnd) {
+          newCache.push_back(v);
+        }
+      }
+
+      // Mise à jour des scores des sommets du cache et de ceux qui en sortent
+      for (size_t i = 0; i < newCache.size(); i++) {
+        const uint32_t v = newCache[i];
+        cachePosition[v] = i < CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+
+        const float score = VertexScore(cachePosition[v], liveCount[v]);
+        const float delta = score - vertexScore[v];
+        vertexScore[v] = score;
+        for (uint32_t a = offsets[v]; a < offsets[v] + liveCount[v]; a++) {
+          triangleScore[adjacency[a]] += delta;
+        }
+      }
+
+      if (newCache.size() > CACHE_SIZE) newCache.resize(CACHE_SIZE);
+      std::swap(cache, newCache);
+
+      // Meilleur triangle parmi ceux qui touchent le cache
+      bestTriangle = INVALID_INDEX;
+      float bestScore = -FLT_MAX;
+      for (const uint32_t v : cache) {
+        for (uint32_t a = offsets[v]; a < offsets[v] + liveCount[v]; a++) {
+          const uint32_t t = adjacency[a];
+          if (triangleScore[t] > bestScore) {
+            bestScore = triangleScore[t];
+            bestTriangle = t;
+          }
+        }
+      }
+    }
+
+    indices.swap(output);
+  }
+
+  void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>&     indices,
+                                       const std::vector<Vertex>& vertices,
+                                       float                      threshold)
+  {
+    const size_t triangleCount = indices.size() / 3;
+    const size_t vertexCount = vertices.size();
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    // Découpage en groupes (Sander et al., "Fast Triangle Reordering for Vertex Locality
+    // and Reduced Overdraw") : une frontière dure quand le cache est déjà froid, une
+    // frontière souple dès que l'ACMR local, cache vidé, reste sous threshold * ACMR global
+    const float           globalACMR = AnalyzeVertexCache(indices, vertexCount).acmr;
+    std::vector<uint32_t> clusterStarts;
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    uint32_t              time = STATS_CACHE_SIZE + 1;
+    uint32_t              clusterMisses = 0;
+    uint32_t              clusterBegin = 0;
+
+    clusterStarts.push_back(0);
+    for (uint32_t t = 0; t < triangleCount; t++) {
+      uint32_t misses = 0;
+      for (int k = 0; k < 3; k++) {
+        const uint32_t v = indices[t * 3 + k];
+        if (time - cacheTime[v] > STATS_CACHE_SIZE) {
+          cacheTime[v] = time++;
+          misses++;
+        }
+      }
+
+      if (t > clusterBegin && misses == 3) {
+        clusterStarts.push_back(t);
+        clusterBegin = t;
+        clusterMisses = 0;
+      }
+      clusterMisses += misses;
+
+      const uint32_t clusterTriangles = t - clusterBegin + 1;
+      if (t + 1 < triangleCount &&
+        static_cast<float>(clusterMisses) <= threshold * globalACMR * clusterTriangles) {
+        clusterStarts.push_back(t + 1);
+        clusterBegin = t + 1;
+        clusterMisses = 0;
+        time += STATS_CACHE_SIZE + 1;
+      }
+    }
+    if (clusterStarts.size() < 2) return;
+    clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+    // Centre et normale moyenne (pondérés par l'aire) de chaque groupe
+    const size_t          clusterCount = clusterStarts.size() - 1;
+    std::vector<XMFLOAT3> clusterCentroids(clusterCount);
+    std::vector<XMFLOAT3> clusterNormals(clusterCount);
+    XMVECTOR              meshCentroid = XMVectorZero();
+    float                 meshArea = 0.0f;
+
+    for (size_t c = 0; c < clusterCount; c++) {
+      XMVECTOR centroid = XMVectorZero();
+      XMVECTOR normal = XMVectorZero();
+      float    area = 0.0f;
+
+      for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; t++) {
+        const XMVECTOR p0 = XMLoadFloat3(&vertices[indices[t * 3]].GetPosition());
+        const XMVECTOR p1 = XMLoadFloat3(&vertices[indices[t * 3 + 1]].GetPosition());
+        const XMVECTOR p2 = XMLoadFloat3(&vertices[indices[t * 3 + 2]].GetPosition());
+        const XMVECTOR n = XMVector3Cross(XMVectorSubtract(p1, p0), XMVectorSubtract(p2, p0));
+        const float    triangleArea = XMVectorGetX(XMVector3Length(n));
+
+        centroid = XMVectorAdd(centroid,
+                               XMVectorScale(XMVectorAdd(XMVectorAdd(p0, p1), p2), triangleArea / 3.0f));
+        normal = XMVectorAdd(normal, n);
+        area += triangleArea;
+      }
+
+      meshCentroid = XMVectorAdd(meshCentroid, centroid);
+      meshArea += area;
+      XMStoreFloat3(&clusterCentroids[c], area > 0.0f ? XMVectorScale(centroid, 1.0f / area) : centroid);
+      XMStoreFloat3(&clusterNormals[c], XMVector3Normalize(normal));
+    }
+    if (meshArea > 0.0f) meshCentroid = XMVectorScale(meshCentroid, 1.0f / meshArea);
+
+    // Les groupes les plus tournés vers l'extérieur sont dessinés en premier : ils
+    // occultent le plus souvent le reste du maillage
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+      sortKeys[c] = XMVectorGetX(XMVector3Dot(
+        XMVectorSubtract(XMLoadFloat3(&clusterCentroids[c]), meshCentroid),
+        XMLoadFloat3(&clusterNormals[c])));
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return sortKeys[a] > sortKeys[b];
+    });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (const uint32_t c : order) {
+      output.insert(output.end(), indices.begin() + clusterStarts[c] * 3,
+                    indices.begin() + clusterStarts[c + 1] * 3);
+    }
+    indices.swap(output);
+  }
+
+  void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+  {
+    std::vector<uint32_t> remap(vertices.size(), INVALID_INDEX);
+    std::vector<Vertex>   output;
+    output.reserve(vertices.size());
+
+    for (uint32_t& index : indices) {
+      uint32_t& slot = remap[index];
+      if (slot == INVALID_INDEX) {
+        slot = static_cast<uint32_t>(output.size());
+        output.push_back(vertices[index]);
+      }
+      index = slot;
+    }
+    vertices.swap(output);
+  }
+
+  MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices,
+                                                              size_t                       vertexCount,
+                                                              uint32_t                     cacheSize)
+  {
+    CacheStats stats;
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0) return stats;
+
+    // Cache FIFO simulé par horodatage des insertions
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t>  used(vertexCount, 0);
+    uint32_t              time = cacheSize + 1;
+    uint32_t              misses = 0;
+    uint32_t              uniqueVertices = 0;
+
+    for (size_t i = 0; i < triangleCount * 3; i++) {
+      const uint32_t v = indices[i];
+      if (time - cacheTime[v] > cacheSize) {
+        cacheTime[v] = time++;
+        misses++;
+      }
+      if (!used[v]) {
+        used[v] = 1;
+        uniqueVertices++;
+      }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(uniqueVertices);
+    return stats;
+  }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Vertex.h"
+
+namespace FrostFireEngine
+{
+  // Optimisations des maillages appliquées à l'import, avant la mise en cache :
+  // ordre des triangles pour le cache post-transformation (Forsyth), ordre des groupes
+  // de triangles pour limiter l'overdraw, puis ordre des sommets pour le fetch.
+  class MeshOptimizer {
+  public:
+    struct CacheStats {
+      float acmr = 0.0f;  // sommets transformés par triangle (3 = aucun réemploi)
+      float atvr = 0.0f;  // sommets transformés par sommet unique (1 = optimal)
+    };
+
+    // Efficacité du cache post-transformation d'un maillage, avant et après Optimize
+    struct MeshStats {
+      uint32_t   triangleCount = 0;
+      uint32_t   vertexCount = 0;
+      CacheStats before;
+      CacheStats after;
+    };
+
+    // Taille du cache modélisé par l'heuristique de Forsyth
+    static constexpr uint32_t CACHE_SIZE = 32;
+    // Cache FIFO utilisé pour mesurer ACMR / ATVR (ordre de grandeur des GPU actuels)
+    static constexpr uint32_t STATS_CACHE_SIZE = 16;
+
+    // Enchaîne les trois optimisations
+    static void Optimize(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // Optimize, avec ACMR / ATVR mesurés avant et après
+    static MeshStats OptimizeWithStats(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    // threshold : dégradation d'ACMR tolérée pour découper en groupes (1.05 = 5 %)
+    static void OptimizeOverdraw(std::vector<uint32_t>&     indices,
+                                 const std::vector<Vertex>& vertices,
+                                 float                      threshold = 1.05f);
+
+    // Renumérote les sommets dans l'ordre de leur première utilisation
+    static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    static CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices,
+                                         size_t                       vertexCount,
+                                         uint32_t                     cacheSize = STATS_CACHE_SIZE);
+  };
+}
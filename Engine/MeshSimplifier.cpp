@@ -0,0 +1,297 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#undef min
+#undef max
+
+namespace FrostFireEngine
+{
+  namespace
+  {
+    struct Collapse {
+      uint32_t from;
+      uint32_t to;
+      double   cost;
+    };
+
+    uint64_t PositionKey(const XMFLOAT3& p)
+    {
+      uint32_t x, y, z;
+      memcpy(&x, &p.x, sizeof(uint32_t));
+      memcpy(&y, &p.y, sizeof(uint32_t));
+      memcpy(&z, &p.z, sizeof(uint32_t));
+      // Hachage 64 bits des trois composantes, les collisions sont résolues par comparaison
+      return (static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull) ^
+        (static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4Full) ^
+        (static_cast<uint64_t>(z) * 0x165667B19E3779F9ull);
+    }
+
+    uint64_t EdgeKey(uint32_t a, uint32_t b)
+    {
+      if (a > b) std::swap(a, b);
+      return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    XMVECTOR TriangleNormal(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2)
+    {
+      const XMVECTOR v0 = XMLoadFloat3(&p0);
+      return XMVector3Cross(XMVectorSubtract(XMLoadFloat3(&p1), v0),
+                            XMVectorSubtract(XMLoadFloat3(&p2), v0));
+    }
+  }
+
+  void MeshSimplifier::AddPlane(Quadric& q, double a, double b, double c, double d, double weight)
+  {
+    q.a2 += a * a * weight;
+    q.ab += a * b * weight;
+    q.ac += a * c * weight;
+    q.ad += a * d * weight;
+    q.b2 += b * b * weight;
+    q.bc += b * c * weight;
+    q.bd += b * d * weight;
+    q.c2 += c * c * weight;
+    q.cd += c * d * weight;
+    q.d2 += d * d * weight;
+    q.weight += weight;
+  }
+
+  void MeshSimplifier::AddQuadric(Quadric& q, const Quadric& other)
+  {
+    q.a2 += other.a2;
+    q.ab += other.ab;
+    q.ac += other.ac;
+    q.ad += other.ad;
+    q.b2 += other.b2;
+    q.bc += other.bc;
+    q.bd += other.bd;
+    q.c2 += other.c2;
+    q.cd += other.cd;
+    q.d2 += other.d2;
+    q.weight += other.weight;
+  }
+
+  double MeshSimplifier::Evaluate(const Quadric& q, const XMFLOAT3& p)
+  {
+    const double x = p.x, y = p.y, z = p.z;
+    const double error = q.a2 * x * x + 2.0 * q.ab * x * y + 2.0 * q.ac * x * z + 2.0 * q.ad * x
+      + q.b2 * y * y + 2.0 * q.bc * y * z + 2.0 * q.bd * y
+      + q.c2 * z * z + 2.0 * q.cd * z
+      + q.d2;
+    // Distance quadratique moyenne pondérée par l'aire
+    return q.weight > 0.0 ? std::abs(error) / q.weight : 0.0;
+  }
+
+  bool MeshSimplifier::GenerateLOD(const std::vector<Vertex>&   vertices,
+                                   const std::vector<uint32_t>& indices,
+                                   float                        ratio,
+                                   float                        targetError,
+                                   Result&                      out)
+  {
+    const size_t vertexCount = vertices.size();
+    const size_t sourceTriangles = indices.size() / 3;
+    if (vertexCount == 0 || sourceTriangles == 0) return false;
+
+    const size_t targetTriangles = std::max<size_t>(
+      1, static_cast<size_t>(static_cast<float>(sourceTriangles) * std::clamp(ratio, 0.0f, 1.0f)));
+
+    // Soudure des positions identiques : les sommets dupliqués pour les coutures partagent
+    // la même quadrique
+    std::vector<uint32_t> positionId(vertexCount);
+    std::vector<uint32_t> positionUsers;
+    {
+      std::unordered_multimap<uint64_t, uint32_t> lookup;
+      lookup.reserve(vertexCount);
+      for (uint32_t v = 0; v < vertexCount; v++) {
+        const XMFLOAT3& p = vertices[v].GetPosition();
+        const uint64_t  key = PositionKey(p);
+        uint32_t        id = UINT32_MAX;
+        auto [first, last] = lookup.equal_range(key);
+        for (auto it = first; it != last; ++it) {
+          const XMFLOAT3& other = vertices[it->second].GetPosition();
+          if (other.x == p.x && other.y == p.y && other.z == p.z) {
+            id = positionId[it->second];
+            break;
+          }
+        }
+        if (id == UINT32_MAX) {
+          id = static_cast<uint32_t>(positionUsers.size());
+          positionUsers.push_back(0);
+          lookup.emplace(key, v);
+        }
+        positionId[v] = id;
+        positionUsers[id]++;
+      }
+    }
+
+    const size_t positionCount = positionUsers.size();
+    std::vector<Quadric> quadrics(positionCount, Quadric{});
+    std::unordered_map<uint64_t, uint32_t> edgeUse;
+    edgeUse.reserve(indices.size());
+
+    for (size_t t = 0; t < sourceTriangles; t++) {
+      const uint32_t i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+      const XMVECTOR n = TriangleNormal(vertices[i0].GetPosition(), vertices[i1].GetPosition(),
+                                        vertices[i2].GetPosition());
+      const float length = XMVectorGetX(XMVector3Length(n));
+      if (length > 0.0f) {
+        XMFLOAT3 normal;
+        XMStoreFloat3(&normal, XMVectorScale(n, 1.0f / length));
+        const XMFLOAT3& p0 = vertices[i0].GetPosition();
+        const double    d = -(static_cast<double>(normal.x) * p0.x + static_cast<double>(normal.y) * p0.y
+          + static_cast<double>(normal.z) * p0.z);
+        const double area = 0.5 * length;
+        for (const uint32_t v : {i0, i1, i2}) {
+          AddPlane(quadrics[positionId[v]], normal.x, normal.y, normal.z, d, area);
+        }
+      }
+
+      const uint32_t p0 = positionId[i0], p1 = positionId[i1], p2 = positionId[i2];
+      edgeUse[EdgeKey(p0, p1)]++;
+      edgeUse[EdgeKey(p1, p2)]++;
+      edgeUse[EdgeKey(p2, p0)]++;
+    }
+
+    // Verrouillage : coutures d'attributs (plusieurs sommets pour une position)
+    // et bords ouverts (arête utilisée par un seul triangle)
+    std::vector<uint8_t> locked(vertexCount, 0);
+    std::vector<uint8_t> lockedPosition(positionCount, 0);
+    for (const auto& [key, count] : edgeUse) {
+      if (count == 1) {
+        lockedPosition[static_cast<uint32_t>(key >> 32)] = 1;
+        lockedPosition[static_cast<uint32_t>(key & 0xFFFFFFFFu)] = 1;
+      }
+    }
+    for (uint32_t v = 0; v < vertexCount; v++) {
+      locked[v] = (positionUsers[positionId[v]] > 1 || lockedPosition[positionId[v]]) ? 1 : 0;
+    }
+
+    const float  radius = [&] {
+      XMFLOAT3 minP = vertices[0].GetPosition(), maxP = minP;
+      for (const auto& vertex : vertices) {
+        const XMFLOAT3& p = vertex.GetPosition();
+        minP = {std::min(minP.x, p.x), std::min(minP.y, p.y), std::min(minP.z, p.z)};
+        maxP = {std::max(maxP.x, p.x), std::max(maxP.y, p.y), std::max(maxP.z, p.z)};
+      }
+      const float dx = maxP.x - minP.x, dy = maxP.y - minP.y, dz = maxP.z - minP.z;
+      return 0.5f * std::sqrt(dx * dx + dy * dy + dz * dz);
+    }();
+    const double maxErrorSq = static_cast<double>(targetError) * radius *
+      static_cast<double>(targetError) * radius;
+
+    std::vector<uint32_t> current = indices;
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<uint8_t>  touched(vertexCount);
+    std::vector<uint32_t> triangleOffsets(vertexCount + 1);
+    std::vector<uint32_t> vertexTriangles;
+    std::vector<Collapse> collapses;
+    double                reachedError = 0.0;
+
+    // Passes successives : chaque passe effectue un ensemble indépendant d'effondrements
+    // (voisinages disjoints), puis réécrit les indices
+    while (current.size() / 3 > targetTriangles) {
+      const size_t triangleCount = current.size() / 3;
+
+      // Adjacence sommet -> triangles (CSR)
+      std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0u);
+      for (const uint32_t index : current) triangleOffsets[index + 1]++;
+      for (size_t v = 0; v < vertexCount; v++) triangleOffsets[v + 1] += triangleOffsets[v];
+      vertexTriangles.resize(current.size());
+      {
+        std::vector<uint32_t> cursor(triangleOffsets.begin(), triangleOffsets.end() - 1);
+        for (size_t i = 0; i < current.size(); i++) {
+          vertexTriangles[cursor[current[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+      }
+
+      collapses.clear();
+      for (size_t t = 0; t < triangleCount; t++) {
+        for (int e = 0; e < 3; e++) {
+          const uint32_t a = current[t * 3 + e];
+          const uint32_t b = current[t * 3 + (e + 1) % 3];
+          if (locked[a]) continue;
+          Quadric q = quadrics[positionId[a]];
+          AddQuadric(q, quadrics[positionId[b]]);
+          collapses.push_back({a, b, Evaluate(q, vertices[b].GetPosition())});
+        }
+      }
+      if (collapses.empty()) break;
+
+      std::ranges::sort(collapses, [](const Collapse& l, const Collapse& r) {
+        return l.cost < r.cost;
+      });
+
+      for (uint32_t v = 0; v < vertexCount; v++) remap[v] = v;
+      std::fill(touched.begin(), touched.end(), static_cast<uint8_t>(0));
+
+      // Un effondrement supprime environ deux triangles
+      const size_t maxCollapses = (triangleCount - targetTriangles + 1) / 2 + 1;
+      size_t       collapseCount = 0;
+
+      for (const Collapse& c : collapses) {
+        if (collapseCount >= maxCollapses || c.cost > maxErrorSq) break;
+        if (touched[c.from] || touched[c.to]) continue;
+
+        // Refus si un triangle voisin se retourne
+        const XMFLOAT3& target = vertices[c.to].GetPosition();
+        bool            flips = false;
+        for (uint32_t i = triangleOffsets[c.from]; i < triangleOffsets[c.from + 1] && !flips; i++) {
+          const uint32_t* tri = &current[vertexTriangles[i] * 3];
+          if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) continue;
+
+          XMFLOAT3 p[3];
+          for (int k = 0; k < 3; k++) p[k] = vertices[tri[k]].GetPosition();
+          const XMVECTOR before = TriangleNormal(p[0], p[1], p[2]);
+          for (int k = 0; k < 3; k++) if (tri[k] == c.from) p[k] = target;
+          const XMVECTOR after = TriangleNormal(p[0], p[1], p[2]);
+          flips = XMVectorGetX(XMVector3Dot(before, after)) <= 0.0f;
+        }
+        if (flips) continue;
+
+        remap[c.from] = c.to;
+        AddQuadric(quadrics[positionId[c.to]], quadrics[positionId[c.from]]);
+        for (uint32_t i = triangleOffsets[c.from]; i < triangleOffsets[c.from + 1]; i++) {
+          const uint32_t* tri = &current[vertexTriangles[i] * 3];
+          touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+        }
+        reachedError = std::max(reachedError, c.cost);
+        collapseCount++;
+      }
+
+      if (collapseCount == 0) break;
+
+      size_t write = 0;
+      for (size_t t = 0; t < triangleCount; t++) {
+        const uint32_t i0 = remap[current[t * 3]];
+        const uint32_t i1 = remap[current[t * 3 + 1]];
+        const uint32_t i2 = remap[current[t * 3 + 2]];
+        if (i0 == i1 || i1 == i2 || i2 == i0) continue;
+        current[write++] = i0;
+        current[write++] = i1;
+        current[write++] = i2;
+      }
+      current.resize(write);
+    }
+
+    // Pas de LOD si le gain est inférieur à 10 %
+    if (current.empty() || current.size() * 10 > indices.size() * 9) return false;
+
+    // Compactage des sommets encore référencés
+    std::fill(remap.begin(), remap.end(), UINT32_MAX);
+    out.vertices.clear();
+    out.indices.resize(current.size());
+    for (size_t i = 0; i < current.size(); i++) {
+      uint32_t& slot = remap[current[i]];
+      if (slot == UINT32_MAX) {
+        slot = static_cast<uint32_t>(out.vertices.size());
+        out.vertices.push_back(vertices[current[i]]);
+      }
+      out.indices[i] = slot;
+    }
+    out.error = radius > 0.0f ? static_cast<float>(std::sqrt(reachedError)) / radius : 0.0f;
+    return true;
+  }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Vertex.h"
+
+namespace FrostFireEngine
+{
+  // Simplification de maillage par effondrement d'arêtes guidé par les quadriques d'erreur.
+  // Les sommets ne sont jamais déplacés (effondrement d'un sommet sur un voisin), ce qui
+  // conserve les attributs d'origine. Les bords et les coutures UV/normales sont verrouillés.
+  class MeshSimplifier {
+  public:
+    struct Result {
+      std::vector<Vertex>   vertices;
+      std::vector<uint32_t> indices;
+      float                 error = 0.0f;  // erreur géométrique atteinte, relative au rayon
+    };
+
+    // ratio : fraction des triangles à conserver
+    // targetError : erreur maximale tolérée, relative au rayon du maillage
+    // Renvoie false si la simplification n'apporte pas de réduction significative
+    static bool GenerateLOD(const std::vector<Vertex>&   vertices,
+                            const std::vector<uint32_t>& indices,
+                            float                        ratio,
+                            float                        targetError,
+                            Result&                      out);
+
+  private:
+    struct Quadric {
+      double a2, ab, ac, ad;
+      double b2, bc, bd;
+      double c2, cd;
+      double d2;
+      double weight;
+    };
+
+    static void   AddPlane(Quadric& q, double a, double b, double c, double d, double weight);
+    static void   AddQuadric(Quadric& q, const Quadric& other);
+    static double Evaluate(const Quadric& q, const XMFLOAT3& p);
+  };
+}
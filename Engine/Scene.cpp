@@ -1,5 +1,7 @@
 ﻿#include "Scene.h"
 
+#include <algorithm>
+
 namespace FrostFireEngine
 {
   Scene::~Scene() = default;
@@ -9,6 +11,34 @@ namespace FrostFireEngine
     return world;
   }
 
+  void Scene::Load(SceneLoader& loader, DispositifD3D11* pDevice)
+  {
+    loader.AddStep("Initialize", [this, pDevice]() { Initialize(pDevice); });
+  }
+
+  void Scene::ReferenceTexture(Texture* texture)
+  {
+    if (texture && !textures.contains(texture)) {
+      textures.emplace(texture, TextureHandle(texture));
+    }
+  }
+
+  TextureMemoryReport Scene::GetTextureMemoryReport() const
+  {
+    TextureMemoryReport report;
+    report.textures.reserve(textures.size());
+    for (const auto& [texture, handle] : textures) {
+      const size_t gpuBytes = texture->GetGPUSize();
+      report.textures.push_back({texture->GetFilename(), gpuBytes, texture->GetRefCount()});
+      report.totalBytes += gpuBytes;
+      if (texture->GetRefCount() > 1) {
+        report.sharedBytes += gpuBytes;
+      }
+    }
+    std::ranges::sort(report.textures, [](const auto& a, const auto& b) { return a.gpuBytes > b.gpuBytes; });
+    return report;
+  }
+
   void Scene::Update(float deltaTime)
   {
     world.Update(deltaTime);
@@ -1,6 +1,9 @@
 #pragma once
 #include "DispositifD3D11.h"
 #include "Engine/ECS/core/World.h"
+#include "SceneLoader.h"
+#include "TextureManager.h"
+#include <unordered_map>
 
 namespace FrostFireEngine
 {
@@ -14,9 +17,17 @@ namespace FrostFireEngine
 
     World&       GetWorld();
     virtual void Initialize(DispositifD3D11* pDevice) = 0;
+    // Étapes du chargement asynchrone ; par défaut une seule étape qui appelle Initialize
+    virtual void Load(SceneLoader& loader, DispositifD3D11* pDevice);
     virtual void Update(float deltaTime);
 
+    // Garde la texture chargée tant que la scène existe ; fait par TextureManager::GetNewTexture
+    void ReferenceTexture(Texture* texture);
+    TextureMemoryReport GetTextureMemoryReport() const;
+
   private:
+    // Avant le World : ses composants, qui pointent sur ces textures, sont détruits en premier
+    std::unordered_map<const Texture*, TextureHandle> textures;
     World world;
 
   protected:
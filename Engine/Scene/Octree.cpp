@@ -99,10 +99,11 @@ namespace FrostFireEngine
     m_renderers.push_back({renderer, box});
   }
 
-  bool OctreeNode::Remove(BaseRendererComponent* renderer)
+  bool OctreeNode::Remove(BaseRendererComponent* renderer, AABB* removedBox)
   {
     for (auto it = m_renderers.begin(); it != m_renderers.end(); ++it) {
       if (it->first == renderer) {
+        if (removedBox) *removedBox = it->second;
         m_renderers.erase(it);
         return true;
       }
@@ -110,7 +111,7 @@ namespace FrostFireEngine
 
     if (!IsLeaf()) {
       for (auto& c : m_children) {
-        if (c && c->Remove(renderer)) return true;
+        if (c && c->Remove(renderer, removedBox)) return true;
       }
     }
     return false;
@@ -120,10 +121,12 @@ namespace FrostFireEngine
                                   const AABB&            newBox,
                                   int                    maxDepth,
                                   int                    maxEntities,
-                                  float                  looseness)
+                                  float                  looseness,
+                                  AABB*                  previousBox)
   {
     for (auto it = m_renderers.begin(); it != m_renderers.end(); ++it) {
       if (it->first == renderer) {
+        if (previousBox) *previousBox = it->second;
         AABB loose = GetLooseBounds(looseness);
         if (loose.Contains(newBox)) {
           it->second = newBox;
@@ -146,7 +149,9 @@ namespace FrostFireEngine
 
     if (!IsLeaf()) {
       for (auto& c : m_children) {
-        if (c && c->UpdateRenderer(renderer, newBox, maxDepth, maxEntities, looseness)) return true;
+        if (c && c->UpdateRenderer(renderer, newBox, maxDepth, maxEntities, looseness, previousBox)) {
+          return true;
+        }
       }
     }
     return false;
@@ -195,18 +200,50 @@ namespace FrostFireEngine
       m_root = std::make_unique<OctreeNode>(m_worldBounds);
     }
     m_root->Insert(renderer, box, m_maxDepth, m_maxEntities, m_looseness);
+    MarkRegionDirty(box);
   }
 
   void Octree::RemoveRenderer(BaseRendererComponent* renderer) const
   {
-    m_root->Remove(renderer);
+    if (!m_root) return;
+    AABB removedBox;
+    if (m_root->Remove(renderer, &removedBox)) {
+      MarkRegionDirty(removedBox);
+    }
   }
 
   void Octree::UpdateRenderer(BaseRendererComponent* renderer, const AABB& box)
   {
-    if (!m_root->UpdateRenderer(renderer, box, m_maxDepth, m_maxEntities, m_looseness)) {
+    if (!m_root) {
       InsertRenderer(renderer, box);
+      return;
     }
+    AABB previousBox;
+    if (!m_root->UpdateRenderer(renderer, box, m_maxDepth, m_maxEntities, m_looseness, &previousBox)) {
+      InsertRenderer(renderer, box);
+      return;
+    }
+    // L'ancienne et la nouvelle position doivent être invalidées
+    MarkRegionDirty(previousBox);
+    MarkRegionDirty(box);
+  }
+
+  void Octree::MarkRegionDirty(const AABB& box) const
+  {
+    if (m_allRegionsDirty) return;
+    if (m_dirtyRegions.size() >= MAX_DIRTY_REGIONS) {
+      // Trop de mouvements ce frame : on invalide tout plutôt que de tester chaque boîte
+      m_allRegionsDirty = true;
+      m_dirtyRegions.clear();
+      return;
+    }
+    m_dirtyRegions.push_back(box);
+  }
+
+  void Octree::ClearDirtyRegions()
+  {
+    m_dirtyRegions.clear();
+    m_allRegionsDirty = false;
   }
 
   void Octree::QueryFrustum(const Frustum& f, std::vector<BaseRendererComponent*>& outVisible) const
@@ -216,8 +253,12 @@ namespace FrostFireEngine
 
   void Octree::Clear()
   {
-    m_root->Clear();
-    m_root.reset(); 
+    if (m_root) {
+      m_root->Clear();
+      m_root.reset();
+    }
+    m_dirtyRegions.clear();
+    m_allRegionsDirty = true;
   }
 
   AABB Octree::GetWorldBounds() const
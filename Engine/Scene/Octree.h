@@ -22,13 +22,14 @@ namespace FrostFireEngine
                 int                    maxDepth,
                 int                    maxEntities,
                 float                  looseness);
-    bool Remove(BaseRendererComponent* renderer);
+    bool Remove(BaseRendererComponent* renderer, AABB* removedBox = nullptr);
 
     bool UpdateRenderer(BaseRendererComponent* renderer,
                         const AABB&            newBox,
                         int                    maxDepth,
                         int                    maxEntities,
-                        float                  looseness);
+                        float                  looseness,
+                        AABB*                  previousBox = nullptr);
 
     void QueryFrustum(const Frustum& f, std::vector<BaseRendererComponent*>& out) const;
     void Clear();
@@ -72,12 +73,21 @@ namespace FrostFireEngine
 
     AABB GetWorldBounds() const;
 
+    // Régions modifiées (insertion, déplacement, suppression) depuis le dernier
+    // ClearDirtyRegions(). Utilisé pour invalider les caches d'ombres statiques.
+    const std::vector<AABB>& GetDirtyRegions() const { return m_dirtyRegions; }
+    bool AreAllRegionsDirty() const { return m_allRegionsDirty; }
+    void ClearDirtyRegions();
+
     void PrintToFile(const std::string& filename) const;
 
     const OctreeNode* GetRoot() const { return m_root.get(); }
 
   private:
     static void PrintNodeToFile(std::ofstream& file, const OctreeNode* node, int depth);
+    void        MarkRegionDirty(const AABB& box) const;
+
+    static constexpr size_t MAX_DIRTY_REGIONS = 256;
 
     AABB  m_worldBounds;
     int   m_maxDepth;
@@ -85,5 +95,8 @@ namespace FrostFireEngine
     float m_looseness;
 
     std::unique_ptr<OctreeNode> m_root;
+
+    mutable std::vector<AABB> m_dirtyRegions;
+    mutable bool              m_allRegionsDirty = true;
   };
 }
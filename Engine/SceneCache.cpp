@@ -0,0 +1,320 @@
+#include "SceneCache.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace FrostFireEngine
+{
+  namespace
+  {
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    template <typename T>
+    size_t AppendBytes(std::vector<uint8_t>& buffer, const T* data, size_t count, size_t alignment)
+    {
+      const size_t offset = AlignUp(buffer.size(), alignment);
+      buffer.resize(offset + count * sizeof(T));
+      if (count > 0) {
+        memcpy(buffer.data() + offset, data, count * sizeof(T));
+      }
+      return offset;
+    }
+
+    // Hachage du contenu par mots de 64 bits : plusieurs Go/s, vérifié à chaque ouverture
+    uint64_t HashContent(const uint8_t* data, size_t size)
+    {
+      uint64_t hash = 0xCBF29CE484222325ull ^ size;
+      size_t   i = 0;
+      for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001B3ull;
+        hash ^= hash >> 29;
+      }
+      return HashBytes(data + i, size - i, hash);
+    }
+  }
+
+  uint32_t SceneCacheWriter::AddEntity(const SceneCacheEntity& entity)
+  {
+    m_entities.push_back(entity);
+    return static_cast<uint32_t>(m_entities.size() - 1);
+  }
+
+  uint32_t SceneCacheWriter::AddMesh(std::span<const Vertex>   vertices,
+                                     std::span<const uint32_t> indices,
+                                     float                     screenSize)
+  {
+    SceneCacheMesh mesh{};
+    mesh.vertexOffset = AppendBytes(m_geometry, vertices.data(), vertices.size(), SCENE_CACHE_ALIGNMENT);
+    mesh.indexOffset = AppendBytes(m_geometry, indices.data(), indices.size(), SCENE_CACHE_ALIGNMENT);
+    mesh.vertexCount = static_cast<uint32_t>(vertices.size());
+    mesh.indexCount = static_cast<uint32_t>(indices.size());
+    mesh.screenSize = screenSize;
+    mesh.format = VertexFormat::Full;
+    m_meshes.push_back(mesh);
+    return static_cast<uint32_t>(m_meshes.size() - 1);
+  }
+
+  uint32_t SceneCacheWriter::AddMesh(std::span<const DirectX::XMFLOAT3>      positions,
+                                     std::span<const PackedVertexAttributes> attributes,
+                                     std::span<const uint32_t>               indices,
+                                     float                                   screenSize)
+  {
+    SceneCacheMesh mesh{};
+    mesh.vertexOffset = AppendBytes(m_geometry, positions.data(), positions.size(), SCENE_CACHE_ALIGNMENT);
+    mesh.attributeOffset = AppendBytes(m_geometry, attributes.data(), attributes.size(), SCENE_CACHE_ALIGNMENT);
+    mesh.indexOffset = AppendBytes(m_geometry, indices.data(), indices.size(), SCENE_CACHE_ALIGNMENT);
+    mesh.vertexCount = static_cast<uint32_t>(positions.size());
+    mesh.indexCount = static_cast<uint32_t>(indices.size());
+    mesh.screenSize = screenSize;
+    mesh.format = VertexFormat::Packed;
+    m_meshes.push_back(mesh);
+    return static_cast<uint32_t>(m_meshes.size() - 1);
+  }
+
+  uint32_t SceneCacheWriter::AddMaterial(const SceneCacheMaterial& material)
+  {
+    m_materials.push_back(material);
+    return static_cast<uint32_t>(m_materials.size() - 1);
+  }
+
+  uint32_t SceneCacheWriter::AddString(const std::wstring& str)
+  {
+    // [longueur en wchar_t][caractères]
+    const uint32_t length = static_cast<uint32_t>(str.size());
+    const size_t   offset = AppendBytes(m_strings, &length, 1, sizeof(uint32_t));
+    AppendBytes(m_strings, str.data(), str.size(), sizeof(wchar_t));
+    return static_cast<uint32_t>(offset);
+  }
+
+  uint32_t SceneCacheWriter::AddBlob(const std::string& bytes)
+  {
+    return static_cast<uint32_t>(AppendBytes(m_blobs, bytes.data(), bytes.size(), SCENE_CACHE_ALIGNMENT));
+  }
+
+  bool SceneCacheWriter::Write(const std::filesystem::path& path, const SceneCacheKey& key) const
+  {
+    SceneCacheSection sections[] = {
+      {SceneCacheSectionType::Entities, static_cast<uint32_t>(m_entities.size()), 0,
+        m_entities.size() * sizeof(SceneCacheEntity)},
+      {SceneCacheSectionType::Meshes, static_cast<uint32_t>(m_meshes.size()), 0,
+        m_meshes.size() * sizeof(SceneCacheMesh)},
+      {SceneCacheSectionType::Materials, static_cast<uint32_t>(m_materials.size()), 0,
+        m_materials.size() * sizeof(SceneCacheMaterial)},
+      {SceneCacheSectionType::Strings, 0, 0, m_strings.size()},
+      {SceneCacheSectionType::Blobs, 0, 0, m_blobs.size()},
+      {SceneCacheSectionType::Geometry, 0, 0, m_geometry.size()},
+    };
+    constexpr uint32_t sectionCount = static_cast<uint32_t>(std::size(sections));
+
+    size_t offset = AlignUp(sizeof(SceneCacheHeader) + sizeof(sections), SCENE_CACHE_ALIGNMENT);
+    for (auto& section : sections) {
+      section.offset = offset;
+      offset = AlignUp(offset + section.size, SCENE_CACHE_ALIGNMENT);
+    }
+    const uint64_t geometryOffset = sections[sectionCount - 1].offset;
+
+    SceneCacheHeader header{};
+    header.magic = SCENE_CACHE_MAGIC;
+    header.version = SCENE_CACHE_VERSION;
+    header.vertexStride = sizeof(Vertex);
+    header.sectionCount = sectionCount;
+    header.sourceSize = key.sourceSize;
+    header.sourceWriteTime = key.sourceWriteTime;
+    header.settingsHash = key.settingsHash;
+    header.fileSize = offset;
+
+    // Offsets des maillages rendus absolus
+    std::vector<SceneCacheMesh> meshes = m_meshes;
+    for (auto& mesh : meshes) {
+      mesh.vertexOffset += geometryOffset;
+      mesh.indexOffset += geometryOffset;
+      if (mesh.format == VertexFormat::Packed) {
+        mesh.attributeOffset += geometryOffset;
+      }
+    }
+
+    std::vector<uint8_t> file(offset, 0);
+    memcpy(file.data() + sizeof(header), sections, sizeof(sections));
+
+    const void* payloads[] = {
+      m_entities.data(), meshes.data(), m_materials.data(), m_strings.data(), m_blobs.data(),
+      m_geometry.data()
+    };
+    for (uint32_t i = 0; i < sectionCount; i++) {
+      if (sections[i].size > 0) {
+        memcpy(file.data() + sections[i].offset, payloads[i], sections[i].size);
+      }
+    }
+
+    header.contentHash = HashContent(file.data() + sizeof(header), file.size() - sizeof(header));
+    memcpy(file.data(), &header, sizeof(header));
+
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+    {
+      std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+      if (!ofs) return false;
+      ofs.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+      if (!ofs) return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+      std::filesystem::remove(tempPath, error);
+      return false;
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool SceneCacheReader::ReadSection(const SceneCacheSection& section, std::span<const T>& out) const
+  {
+    if (section.offset % SCENE_CACHE_ALIGNMENT != 0 ||
+      section.offset + section.size > m_file.GetSize() ||
+      section.size % sizeof(T) != 0) {
+      return false;
+    }
+    out = {reinterpret_cast<const T*>(m_file.GetData() + section.offset), section.size / sizeof(T)};
+    return true;
+  }
+
+  bool SceneCacheReader::Open(const std::filesystem::path& path, const SceneCacheKey& key)
+  {
+    if (!m_file.Open(path.wstring())) return false;
+
+    const size_t fileSize = m_file.GetSize();
+    if (fileSize < sizeof(SceneCacheHeader)) {
+      m_file.Close();
+      return false;
+    }
+
+    const auto* header = reinterpret_cast<const SceneCacheHeader*>(m_file.GetData());
+    if (header->magic != SCENE_CACHE_MAGIC ||
+      header->version != SCENE_CACHE_VERSION ||
+      header->vertexStride != sizeof(Vertex) ||
+      header->fileSize != fileSize ||
+      header->settingsHash != key.settingsHash ||
+      (key.hasSource && (header->sourceSize != key.sourceSize ||
+        header->sourceWriteTime != key.sourceWriteTime))) {
+      m_file.Close();
+      return false;
+    }
+
+    if (HashContent(m_file.GetData() + sizeof(SceneCacheHeader), fileSize - sizeof(SceneCacheHeader)) !=
+      header->contentHash) {
+      m_file.Close();
+      return false;
+    }
+
+    if (sizeof(SceneCacheHeader) + header->sectionCount * sizeof(SceneCacheSection) > fileSize) {
+      m_file.Close();
+      return false;
+    }
+
+    const auto* sections = reinterpret_cast<const SceneCacheSection*>(
+      m_file.GetData() + sizeof(SceneCacheHeader));
+    std::span<const uint8_t> geometry;
+    bool                     valid = true;
+
+    for (uint32_t i = 0; i < header->sectionCount && valid; i++) {
+      const SceneCacheSection& section = sections[i];
+      switch (section.type) {
+        case SceneCacheSectionType::Entities:
+          valid = ReadSection(section, m_entities);
+          break;
+        case SceneCacheSectionType::Meshes:
+          valid = ReadSection(section, m_meshes);
+          break;
+        case SceneCacheSectionType::Materials:
+          valid = ReadSection(section, m_materials);
+          break;
+        case SceneCacheSectionType::Strings:
+          valid = ReadSection(section, m_strings);
+          break;
+        case SceneCacheSectionType::Blobs:
+          valid = ReadSection(section, m_blobs);
+          break;
+        case SceneCacheSectionType::Geometry:
+          valid = ReadSection(section, geometry);
+          break;
+        default:
+          // Section inconnue : ignorée
+          break;
+      }
+    }
+
+    // Les maillages doivent pointer dans la section Geometry
+    const uint64_t geometryBegin = geometry.data() - m_file.GetData();
+    const uint64_t geometryEnd = geometryBegin + geometry.size();
+    const auto inGeometry = [&](uint64_t offset, uint64_t size) {
+      return offset >= geometryBegin && offset + size <= geometryEnd;
+    };
+    for (const auto& mesh : m_meshes) {
+      if (!valid) break;
+      if (mesh.format == VertexFormat::Packed) {
+        valid = inGeometry(mesh.vertexOffset, uint64_t(mesh.vertexCount) * sizeof(DirectX::XMFLOAT3)) &&
+          inGeometry(mesh.attributeOffset, uint64_t(mesh.vertexCount) * sizeof(PackedVertexAttributes));
+      }
+      else {
+        valid = mesh.format == VertexFormat::Full &&
+          inGeometry(mesh.vertexOffset, uint64_t(mesh.vertexCount) * sizeof(Vertex));
+      }
+      valid = valid && inGeometry(mesh.indexOffset, uint64_t(mesh.indexCount) * sizeof(uint32_t));
+    }
+
+    if (!valid || m_entities.empty()) {
+      m_entities = {};
+      m_meshes = {};
+      m_materials = {};
+      m_strings = {};
+      m_blobs = {};
+      m_file.Close();
+      return false;
+    }
+    return true;
+  }
+
+  std::wstring_view SceneCacheReader::GetString(uint32_t offset) const
+  {
+    if (offset == SCENE_CACHE_NONE || uint64_t(offset) + sizeof(uint32_t) > m_strings.size()) return {};
+
+    uint32_t length;
+    memcpy(&length, m_strings.data() + offset, sizeof(length));
+    if (offset + sizeof(uint32_t) + uint64_t(length) * sizeof(wchar_t) > m_strings.size()) return {};
+    return {reinterpret_cast<const wchar_t*>(m_strings.data() + offset + sizeof(uint32_t)), length};
+  }
+
+  std::span<const uint8_t> SceneCacheReader::GetBlob(uint32_t offset, uint32_t size) const
+  {
+    if (offset == SCENE_CACHE_NONE || uint64_t(offset) + size > m_blobs.size()) return {};
+    return m_blobs.subspan(offset, size);
+  }
+
+  std::span<const Vertex> SceneCacheReader::GetVertices(const SceneCacheMesh& mesh) const
+  {
+    return {reinterpret_cast<const Vertex*>(m_file.GetData() + mesh.vertexOffset), mesh.vertexCount};
+  }
+
+  std::span<const DirectX::XMFLOAT3> SceneCacheReader::GetPositions(const SceneCacheMesh& mesh) const
+  {
+    return {reinterpret_cast<const DirectX::XMFLOAT3*>(m_file.GetData() + mesh.vertexOffset), mesh.vertexCount};
+  }
+
+  std::span<const PackedVertexAttributes> SceneCacheReader::GetAttributes(const SceneCacheMesh& mesh) const
+  {
+    return {
+      reinterpret_cast<const PackedVertexAttributes*>(m_file.GetData() + mesh.attributeOffset), mesh.vertexCount
+    };
+  }
+
+  std::span<const uint32_t> SceneCacheReader::GetIndices(const SceneCacheMesh& mesh) const
+  {
+    return {reinterpret_cast<const uint32_t*>(m_file.GetData() + mesh.indexOffset), mesh.indexCount};
+  }
+}
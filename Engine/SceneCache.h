@@ -0,0 +1,167 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Vertex.h"
+#include "VertexPacking.h"
+#include "Utils/MappedFile.h"
+
+namespace FrostFireEngine
+{
+  // Cache binaire d'une scène importée (.cache) :
+  // [SceneCacheHeader][SceneCacheSection x sectionCount][sections alignées sur 16 octets]
+  // Le fichier est projeté en mémoire ; les sommets et indices sont lus sur place et
+  // stockés dans le format GPU du maillage, envoyés tels quels aux vertex buffers.
+  // contentHash couvre tout ce qui suit l'en-tête : un fichier corrompu est reconstruit.
+  constexpr uint32_t SCENE_CACHE_MAGIC = 0x43534646;  // "FFSC"
+  constexpr uint32_t SCENE_CACHE_VERSION = 5;
+  constexpr uint32_t SCENE_CACHE_ALIGNMENT = 16;
+  constexpr uint32_t SCENE_CACHE_NONE = UINT32_MAX;
+
+  struct SceneCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexStride;   // invalide le cache si le format de Vertex change
+    uint32_t sectionCount;
+    uint64_t sourceSize;     // taille et date du FBX source
+    int64_t  sourceWriteTime;
+    uint64_t settingsHash;   // hachage des BuildSettings utilisés
+    uint64_t fileSize;
+    uint64_t contentHash;
+    uint64_t reserved;
+  };
+  static_assert(sizeof(SceneCacheHeader) == 64);
+
+  enum class SceneCacheSectionType : uint32_t {
+    Entities,
+    Meshes,
+    Materials,
+    Strings,
+    Blobs,
+    Geometry
+  };
+
+  struct SceneCacheSection {
+    SceneCacheSectionType type;
+    uint32_t              count;
+    uint64_t              offset;
+    uint64_t              size;
+  };
+
+  // Entités stockées en pré-ordre : les childCount entités suivantes (et leurs
+  // descendants) sont les enfants
+  struct SceneCacheEntity {
+    DirectX::XMFLOAT3 position;
+    DirectX::XMFLOAT4 rotation;
+    DirectX::XMFLOAT3 scale;
+    uint32_t          hasTransform;
+    uint32_t          childCount;
+    uint32_t          meshFirst;      // maillage de base puis LODs, SCENE_CACHE_NONE sans MeshComponent
+    uint32_t          meshCount;
+    uint32_t          material;       // SCENE_CACHE_NONE sans PBRRenderer
+    uint32_t          colliderBlob;   // offset dans la section Blobs, SCENE_CACHE_NONE sans collider
+    uint32_t          colliderSize;
+    int32_t           rigidBodyType;  // -1 sans RigidBodyComponent
+  };
+
+  struct SceneCacheMesh {
+    uint64_t     vertexOffset;     // depuis le début du fichier, aligné sur 16 octets
+    uint64_t     attributeOffset;  // Packed : positions en vertexOffset, attributs compactés ici
+    uint64_t     indexOffset;
+    uint32_t     vertexCount;
+    uint32_t     indexCount;
+    float        screenSize;       // seuil du LOD, 0 pour le maillage de base
+    VertexFormat format;
+  };
+
+  struct SceneCacheMaterial {
+    DirectX::XMFLOAT4 baseColor;
+    float             metallic;
+    float             roughness;
+    float             ao;
+    uint32_t          albedo;  // offsets dans la section Strings, SCENE_CACHE_NONE si absent
+    uint32_t          normal;
+    uint32_t          occlusion;
+    uint32_t          metallicRoughness;
+  };
+
+  // Identité de ce qui a produit le cache ; toute différence le rend périmé
+  struct SceneCacheKey {
+    uint64_t sourceSize = 0;
+    int64_t  sourceWriteTime = 0;
+    uint64_t settingsHash = 0;
+    bool     hasSource = true;  // sans FBX source, seul le hachage des réglages est vérifié
+  };
+
+  // FNV-1a 64 bits
+  inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0xCBF29CE484222325ull)
+  {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t    hash = seed;
+    for (size_t i = 0; i < size; i++) {
+      hash ^= bytes[i];
+      hash *= 0x100000001B3ull;
+    }
+    return hash;
+  }
+
+  class SceneCacheWriter {
+  public:
+    uint32_t          AddEntity(const SceneCacheEntity& entity);
+    SceneCacheEntity& GetEntity(uint32_t index) { return m_entities[index]; }
+
+    uint32_t AddMesh(std::span<const Vertex> vertices, std::span<const uint32_t> indices, float screenSize);
+    uint32_t AddMesh(std::span<const DirectX::XMFLOAT3> positions, std::span<const PackedVertexAttributes> attributes,
+                     std::span<const uint32_t> indices, float screenSize);
+    uint32_t AddMaterial(const SceneCacheMaterial& material);
+    uint32_t AddString(const std::wstring& str);
+    uint32_t AddBlob(const std::string& bytes);
+
+    // Écrit dans un fichier temporaire puis le renomme, pour ne jamais laisser de cache tronqué
+    bool Write(const std::filesystem::path& path, const SceneCacheKey& key) const;
+
+  private:
+    std::vector<SceneCacheEntity>   m_entities;
+    std::vector<SceneCacheMesh>     m_meshes;  // offsets relatifs à la section Geometry
+    std::vector<SceneCacheMaterial> m_materials;
+    std::vector<uint8_t>            m_strings;
+    std::vector<uint8_t>            m_blobs;
+    std::vector<uint8_t>            m_geometry;
+  };
+
+  class SceneCacheReader {
+  public:
+    // Échoue si le fichier est absent, corrompu, d'une autre version ou périmé
+    bool Open(const std::filesystem::path& path, const SceneCacheKey& key);
+
+    std::span<const SceneCacheEntity>   GetEntities() const { return m_entities; }
+    std::span<const SceneCacheMesh>     GetMeshes() const { return m_meshes; }
+    std::span<const SceneCacheMaterial> GetMaterials() const { return m_materials; }
+
+    std::wstring_view        GetString(uint32_t offset) const;
+    std::span<const uint8_t> GetBlob(uint32_t offset, uint32_t size) const;
+    // Full uniquement
+    std::span<const Vertex>  GetVertices(const SceneCacheMesh& mesh) const;
+    // Packed uniquement
+    std::span<const DirectX::XMFLOAT3>      GetPositions(const SceneCacheMesh& mesh) const;
+    std::span<const PackedVertexAttributes> GetAttributes(const SceneCacheMesh& mesh) const;
+    std::span<const uint32_t> GetIndices(const SceneCacheMesh& mesh) const;
+
+  private:
+    template <typename T>
+    bool ReadSection(const SceneCacheSection& section, std::span<const T>& out) const;
+
+    MappedFile m_file;
+
+    std::span<const SceneCacheEntity>   m_entities;
+    std::span<const SceneCacheMesh>     m_meshes;
+    std::span<const SceneCacheMaterial> m_materials;
+    std::span<const uint8_t>            m_strings;
+    std::span<const uint8_t>            m_blobs;
+  };
+}
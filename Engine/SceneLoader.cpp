@@ -0,0 +1,95 @@
+#include "SceneLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  void SceneLoader::AddStep(std::string name, std::function<void()> commit, float weight)
+  {
+    AddIncrementalStep(std::move(name), [commit = std::move(commit)](double) {
+      commit();
+      return true;
+    }, weight);
+  }
+
+  void SceneLoader::AddIncrementalStep(std::string name, CommitFunction commit, float weight)
+  {
+    AddAsyncStep(std::move(name), nullptr, std::move(commit), weight);
+  }
+
+  void SceneLoader::AddAsyncStep(std::string           name,
+                                 std::function<void()> work,
+                                 CommitFunction        commit,
+                                 float                 weight)
+  {
+    m_steps.push_back({std::move(name), weight, std::move(work), std::move(commit), {}});
+    m_totalWeight += weight;
+  }
+
+  void SceneLoader::Start()
+  {
+    if (m_started) return;
+    m_started = true;
+
+    // Tous les travaux partent en même temps : ils se recouvrent entre eux et avec les commits
+    for (auto& step : m_steps) {
+      if (step.work) {
+        step.pending = std::async(std::launch::async, std::move(step.work));
+      }
+    }
+  }
+
+  bool SceneLoader::Update(double budgetMs)
+  {
+    Start();
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto elapsedMs = [&startTime]() {
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    };
+    const bool unlimited = std::isinf(budgetMs);
+
+    while (!IsDone()) {
+      Step& step = m_steps[m_current];
+
+      if (step.pending.valid()) {
+        if (!unlimited && step.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+          return false;
+        }
+        step.pending.get();
+      }
+
+      if (!step.commit(std::max(budgetMs - elapsedMs(), 0.0))) {
+        return false;
+      }
+
+      m_doneWeight += step.weight;
+      m_current++;
+
+      if (elapsedMs() >= budgetMs) break;
+    }
+    return IsDone();
+  }
+
+  void SceneLoader::Finish()
+  {
+    Update(std::numeric_limits<double>::infinity());
+  }
+
+  float SceneLoader::GetProgress() const
+  {
+    return m_totalWeight > 0.0f ? std::min(m_doneWeight / m_totalWeight, 1.0f) : 1.0f;
+  }
+
+  const std::string& SceneLoader::GetCurrentStepName() const
+  {
+    static const std::string none;
+    return IsDone() ? none : m_steps[m_current].name;
+  }
+}
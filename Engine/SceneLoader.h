@@ -0,0 +1,53 @@
+#pragma once
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace FrostFireEngine
+{
+  // Chargement d'une scène découpé en étapes, exécutées au fil des frames.
+  // La partie « travail » d'une étape asynchrone (E/S, traitement CPU) démarre sur un thread
+  // dès Start() ; les parties « commit » (World, ressources GPU) s'exécutent sur le thread
+  // principal, dans l'ordre de déclaration et dans le budget de temps accordé à chaque frame.
+  class SceneLoader {
+  public:
+    // Renvoie vrai quand l'étape est terminée, faux pour être rappelée à la frame suivante
+    using CommitFunction = std::function<bool(double budgetMs)>;
+
+    void AddStep(std::string name, std::function<void()> commit, float weight = 1.0f);
+    void AddIncrementalStep(std::string name, CommitFunction commit, float weight = 1.0f);
+    // work ne doit toucher ni au World ni au contexte D3D
+    void AddAsyncStep(std::string name, std::function<void()> work, CommitFunction commit,
+                      float weight = 1.0f);
+
+    void Start();
+
+    // Exécute les commits jusqu'à épuisement du budget ; vrai quand tout est chargé.
+    // Une étape dont le travail n'est pas fini est attendue à la frame suivante, et une
+    // exception levée par ce travail est relancée ici.
+    bool Update(double budgetMs);
+
+    // Termine le chargement sans limite de temps, en attendant les threads
+    void Finish();
+
+    bool               IsDone() const { return m_current >= m_steps.size(); }
+    float              GetProgress() const;  // part des étapes terminées, pondérée, entre 0 et 1
+    const std::string& GetCurrentStepName() const;
+
+  private:
+    struct Step {
+      std::string           name;
+      float                 weight;
+      std::function<void()> work;
+      CommitFunction        commit;
+      std::future<void>     pending;
+    };
+
+    std::vector<Step> m_steps;
+    size_t            m_current = 0;
+    float             m_totalWeight = 0.0f;
+    float             m_doneWeight = 0.0f;
+    bool              m_started = false;
+  };
+}
@@ -1,13 +1,21 @@
 ﻿#pragma once
 #include "Singleton.h"
 #include "Scene.h"
+#include "SceneLoader.h"
 #include <memory>
 #include <functional>
+#include <string>
 
 namespace FrostFireEngine
 {
   class SceneManager : public CSingleton<SceneManager> {
   public:
+    SceneManager()
+    {
+      // Construit avant nous, le TextureManager est détruit après les scènes et leurs références
+      TextureManager::GetInstance();
+    }
+
     void Update(float dt)
     {
       if (pendingSceneLoader) {
@@ -17,6 +25,12 @@ namespace FrostFireEngine
 
         pendingSceneLoader();
         pendingSceneLoader = nullptr;
+        // Après l'initialisation de la nouvelle scène, pour garder les textures qu'elle partage
+        TextureManager::GetInstance().PurgeUnused();
+      }
+
+      if (sceneLoader) {
+        UpdateLoading();
       }
 
       if (activeScene) {
@@ -29,6 +43,13 @@ namespace FrostFireEngine
       return activeScene.get();
     }
 
+    // Scène dont le World est visé par World::GetInstance() : celle en cours de chargement
+    // pendant ses étapes, la scène active sinon
+    Scene* GetContextScene() const
+    {
+      return contextScene ? contextScene : activeScene.get();
+    }
+
     template <typename T, typename... Args>
     void SetActiveScene(DispositifD3D11* pDevice, Args&&... args)
     {
@@ -48,13 +69,86 @@ namespace FrostFireEngine
       }
     }
 
+    // Charge T en arrière-plan pendant que la scène active continue de tourner ;
+    // la bascule n'a lieu qu'une fois toutes les étapes de T terminées
+    template <typename T, typename... Args>
+    void LoadSceneAsync(DispositifD3D11* pDevice, Args&&... args)
+    {
+      static_assert(std::is_base_of_v<Scene, T>, "T doit dériver de Scene.");
+
+      sceneLoader.reset();
+      loadingScene = std::make_unique<T>(std::forward<Args>(args)...);
+      sceneLoader = std::make_unique<SceneLoader>();
+      loadingScene->Load(*sceneLoader, pDevice);
+      sceneLoader->Start();
+    }
+
+    bool IsLoading() const
+    {
+      return sceneLoader != nullptr;
+    }
+
+    float GetLoadProgress() const
+    {
+      return sceneLoader ? sceneLoader->GetProgress() : 1.0f;
+    }
+
+    std::string GetLoadStepName() const
+    {
+      return sceneLoader ? sceneLoader->GetCurrentStepName() : std::string();
+    }
+
+    // Temps accordé par frame aux étapes du chargement sur le thread principal
+    void SetLoadBudget(double budgetMs)
+    {
+      loadBudgetMs = budgetMs;
+    }
+
     void Cleanup()
     {
       activeScene.reset();
     }
 
   private:
+    void UpdateLoading()
+    {
+      bool done;
+      {
+        ContextSceneScope scope(*this, loadingScene.get());
+        done = sceneLoader->Update(loadBudgetMs);
+      }
+
+      if (done) {
+        sceneLoader.reset();
+        Cleanup();
+        activeScene = std::move(loadingScene);
+        TextureManager::GetInstance().PurgeUnused();
+      }
+    }
+
+    struct ContextSceneScope {
+      ContextSceneScope(SceneManager& manager, Scene* scene)
+        : manager(manager), previous(manager.contextScene)
+      {
+        manager.contextScene = scene;
+      }
+
+      ~ContextSceneScope()
+      {
+        manager.contextScene = previous;
+      }
+
+      SceneManager& manager;
+      Scene*        previous;
+    };
+
     std::unique_ptr<Scene> activeScene;
     std::function<void()>  pendingSceneLoader;
+
+    // Le chargeur référence la scène chargée : il est détruit avant elle
+    std::unique_ptr<Scene>       loadingScene;
+    std::unique_ptr<SceneLoader> sceneLoader;
+    Scene*                       contextScene = nullptr;
+    double                       loadBudgetMs = 8.0;
   };
 }
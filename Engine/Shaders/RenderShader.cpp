@@ -28,11 +28,11 @@ namespace FrostFireEngine
     m_variantManager.reset();
   }
 
-  ShaderVariant* RenderShader::GetVariant(const std::vector<std::string>& featureIds,
-                                          const VertexLayoutDesc&         layout) const
+  VariantHandle RenderShader::GetVariant(const std::vector<std::string>& featureIds,
+                                         const VertexLayoutDesc&         layout) const
   {
     if (!m_variantManager->ValidateFeatureCombination(featureIds)) {
-      return nullptr;
+      return {};
     }
 
     std::map<std::string, std::string> defines;
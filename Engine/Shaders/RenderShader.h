@@ -19,7 +19,8 @@ namespace FrostFireEngine
     bool Initialize(const std::wstring& shaderPath);
     void Shutdown();
 
-    ShaderVariant* GetVariant(const std::vector<std::string>& featureIds, const VertexLayoutDesc& layout) const;
+    // Le handle garde le variant en vie : le cache n'évince que les variants sans référence
+    VariantHandle GetVariant(const std::vector<std::string>& featureIds, const VertexLayoutDesc& layout) const;
     const std::wstring& GetShaderPath() const
     {
       return m_shaderPath;
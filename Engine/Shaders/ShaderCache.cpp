@@ -0,0 +1,282 @@
+#include "ShaderCache.h"
+
+#include <d3dcompiler.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Engine/SceneCache.h"
+#include "Engine/Utils/MappedFile.h"
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  namespace
+  {
+    struct ShaderCacheHeader {
+      uint32_t magic;
+      uint32_t version;
+      uint64_t key;
+      uint64_t size;
+      uint64_t dataHash;  // détecte un fichier tronqué ou corrompu
+    };
+    static_assert(sizeof(ShaderCacheHeader) == 32);
+
+    constexpr uint32_t MAX_INCLUDE_DEPTH = 16;
+
+    std::filesystem::path GetCacheFilePath(uint64_t key)
+    {
+      wchar_t name[24];
+      swprintf_s(name, L"%016llx.dxbc", static_cast<unsigned long long>(key));
+      return ShaderCache::directory / name;
+    }
+
+    uint64_t HashString(std::string_view text, uint64_t hash)
+    {
+      // Longueur incluse pour que ("ab", "c") et ("a", "bc") diffèrent
+      const uint64_t length = text.size();
+      hash = HashBytes(&length, sizeof(length), hash);
+      return HashBytes(text.data(), text.size(), hash);
+    }
+
+    // Noms des #include "..." d'un source HLSL ; les #include <...> ne sont pas résolus par
+    // D3D_COMPILE_STANDARD_FILE_INCLUDE relativement au fichier et sont ignorés
+    std::vector<std::string> FindIncludes(const uint8_t* data, size_t size)
+    {
+      std::vector<std::string> includes;
+      const std::string_view   text(reinterpret_cast<const char*>(data), size);
+
+      size_t lineStart = 0;
+      while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) lineEnd = text.size();
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        const size_t hash = line.find_first_not_of(" \t");
+        if (hash == std::string_view::npos || line[hash] != '#') continue;
+        line.remove_prefix(hash + 1);
+        line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+        if (!line.starts_with("include")) continue;
+
+        const size_t open = line.find('"');
+        if (open == std::string_view::npos) continue;
+        const size_t close = line.find('"', open + 1);
+        if (close == std::string_view::npos) continue;
+        includes.emplace_back(line.substr(open + 1, close - open - 1));
+      }
+      return includes;
+    }
+
+    bool ReadCacheFile(const std::filesystem::path& path, uint64_t key, ID3DBlob** shaderBlob)
+    {
+      MappedFile file;
+      if (!file.Open(path.wstring()) || file.GetSize() < sizeof(ShaderCacheHeader)) return false;
+
+      ShaderCacheHeader header;
+      memcpy(&header, file.GetData(), sizeof(header));
+      const uint8_t* data = file.GetData() + sizeof(header);
+      if (header.magic != SHADER_CACHE_MAGIC || header.version != SHADER_CACHE_VERSION || header.key != key ||
+        header.size != file.GetSize() - sizeof(header) || header.dataHash != HashBytes(data, header.size)) {
+        return false;
+      }
+
+      if (FAILED(D3DCreateBlob(header.size, shaderBlob))) return false;
+      memcpy((*shaderBlob)->GetBufferPointer(), data, header.size);
+      return true;
+    }
+
+    // Fichier temporaire propre au thread puis renommage : deux threads qui compilent la même
+    // clé écrivent le même contenu, le dernier renommage l'emporte
+    bool WriteCacheFile(const std::filesystem::path& path, uint64_t key, ID3DBlob* shaderBlob)
+    {
+      const auto*             data = static_cast<const uint8_t*>(shaderBlob->GetBufferPointer());
+      const ShaderCacheHeader header = {
+        SHADER_CACHE_MAGIC, SHADER_CACHE_VERSION, key, shaderBlob->GetBufferSize(),
+        HashBytes(data, shaderBlob->GetBufferSize())
+      };
+
+      std::error_code error;
+      std::filesystem::create_directories(path.parent_path(), error);
+
+      std::filesystem::path tempPath = path;
+      tempPath += L"." + std::to_wstring(std::hash<std::thread::id>{}(std::this_thread::get_id())) + L".tmp";
+      {
+        std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(header.size));
+        if (!ofs) {
+          ofs.close();
+          std::filesystem::remove(tempPath, error);
+          return false;
+        }
+      }
+
+      std::filesystem::rename(tempPath, path, error);
+      if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+      }
+      return true;
+    }
+  }
+
+  const std::filesystem::path ShaderCache::directory = L"ShaderCache";
+
+  UINT ShaderCache::GetDefaultCompileFlags()
+  {
+    UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
+#ifdef _DEBUG
+    flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+    return flags;
+  }
+
+  ShaderCacheResult ShaderCache::Compile(const std::wstring&                       shaderPath,
+                                         const std::string&                        entryPoint,
+                                         const std::string&                        profile,
+                                         const std::map<std::string, std::string>& defines,
+                                         UINT                                      flags,
+                                         ID3DBlob**                                shaderBlob,
+                                         std::string*                              errors)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    const uint64_t              key = MakeKey(shaderPath, entryPoint, profile, defines, flags);
+    const std::filesystem::path cachePath = GetCacheFilePath(key);
+
+    auto startTime = Clock::now();
+    if (ReadCacheFile(cachePath, key, shaderBlob)) {
+      const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+      std::lock_guard lock(m_mutex);
+      m_stats.hits++;
+      m_stats.loadMs += elapsedMs;
+      return ShaderCacheResult::Hit;
+    }
+
+    std::vector<D3D_SHADER_MACRO> macros;
+    macros.reserve(defines.size() + 1);
+    for (const auto& [name, definition] : defines) {
+      macros.push_back({name.c_str(), definition.c_str()});
+    }
+    macros.push_back({nullptr, nullptr});
+
+    startTime = Clock::now();
+    ID3DBlob* errorBlob = nullptr;
+    HRESULT   hr = D3DCompileFromFile(shaderPath.c_str(),
+                                    macros.data(),
+                                    D3D_COMPILE_STANDARD_FILE_INCLUDE,
+                                    entryPoint.c_str(),
+                                    profile.c_str(),
+                                    flags,
+                                    0,
+                                    shaderBlob,
+                                    &errorBlob);
+    const double compileMs = std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+
+    if (errorBlob) {
+      if (errors) {
+        errors->assign(static_cast<const char*>(errorBlob->GetBufferPointer()));
+      }
+      errorBlob->Release();
+    }
+
+    if (FAILED(hr)) {
+      std::lock_guard lock(m_mutex);
+      m_stats.failures++;
+      m_stats.compileMs += compileMs;
+      return ShaderCacheResult::Failed;
+    }
+
+    const bool written = WriteCacheFile(cachePath, key, *shaderBlob);
+
+    std::lock_guard lock(m_mutex);
+    m_stats.misses++;
+    m_stats.compileMs += compileMs;
+    if (!written) m_stats.writeFailures++;
+    return ShaderCacheResult::Compiled;
+  }
+
+  ShaderCacheStats ShaderCache::GetStats() const
+  {
+    std::lock_guard lock(m_mutex);
+    return m_stats;
+  }
+
+  void ShaderCache::ResetStats()
+  {
+    std::lock_guard lock(m_mutex);
+    m_stats = {};
+  }
+
+  void ShaderCache::ReportStats(const char* stage) const
+  {
+    const ShaderCacheStats stats = GetStats();
+
+    char message[256];
+    snprintf(message, sizeof(message),
+             "ShaderCache (%s) : %u en cache (%.1f ms), %u compiles (%.1f ms), %u echecs, %u ecritures ratees\n",
+             stage, stats.hits, stats.loadMs, stats.misses, stats.compileMs, stats.failures, stats.writeFailures);
+    OutputDebugStringA(message);
+  }
+
+  uint64_t ShaderCache::MakeKey(const std::wstring&                       shaderPath,
+                                const std::string&                        entryPoint,
+                                const std::string&                        profile,
+                                const std::map<std::string, std::string>& defines,
+                                UINT                                      flags)
+  {
+    // Le compilateur fait partie de la clé : une autre version de d3dcompiler recompile tout
+    const uint32_t header[] = {SHADER_CACHE_VERSION, D3D_COMPILER_VERSION, flags};
+    uint64_t       hash = HashBytes(header, sizeof(header));
+
+    const uint64_t sourceHash = HashSourceTree(std::filesystem::path(shaderPath).lexically_normal());
+    hash = HashBytes(&sourceHash, sizeof(sourceHash), hash);
+    // Le chemin compte aussi : il apparaît dans les informations de débogage du bytecode
+    hash = HashBytes(shaderPath.data(), shaderPath.size() * sizeof(wchar_t), hash);
+    hash = HashString(entryPoint, hash);
+    hash = HashString(profile, hash);
+    for (const auto& [name, definition] : defines) {  // std::map : déjà triés
+      hash = HashString(name, hash);
+      hash = HashString(definition, hash);
+    }
+    return hash;
+  }
+
+  // Les sources ne changent pas pendant l'exécution : chaque fichier n'est lu et haché qu'une fois
+  uint64_t ShaderCache::HashSourceTree(const std::filesystem::path& path, uint32_t depth)
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      if (const auto it = m_sourceHashes.find(path.native()); it != m_sourceHashes.end()) {
+        return it->second;
+      }
+    }
+
+    // Source absente : valeur fixe, la compilation échouera et rien ne sera mis en cache
+    const std::wstring& name = path.native();
+    uint64_t            hash = HashBytes(name.data(), name.size() * sizeof(wchar_t));
+    MappedFile file;
+    if (file.Open(path.wstring())) {
+      hash = HashBytes(file.GetData(), file.GetSize(), hash);
+      if (depth < MAX_INCLUDE_DEPTH) {
+        for (const std::string& include : FindIncludes(file.GetData(), file.GetSize())) {
+          const std::filesystem::path includePath = (path.parent_path() / include).lexically_normal();
+          const uint64_t              includeHash = HashSourceTree(includePath, depth + 1);
+          hash = HashBytes(&includeHash, sizeof(includeHash), hash);
+        }
+      }
+    }
+
+    std::lock_guard lock(m_mutex);
+    m_sourceHashes.emplace(path.native(), hash);
+    return hash;
+  }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <d3d11.h>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Engine/Singleton.h"
+
+namespace FrostFireEngine
+{
+  // Cache disque du bytecode DXBC compilé, dans ShaderCache/ relatif au répertoire de travail.
+  // La clé hache le contenu du fichier source et de ses #include "..." (récursivement), le point
+  // d'entrée, le profil, les options de compilation et les defines triés : une source modifiée
+  // donne une nouvelle clé, l'ancien fichier n'est simplement plus lu.
+  constexpr uint32_t SHADER_CACHE_MAGIC = 0x48534646;  // "FFSH"
+  constexpr uint32_t SHADER_CACHE_VERSION = 1;
+
+  constexpr const char* VERTEX_SHADER_PROFILE = "vs_5_0";
+  constexpr const char* PIXEL_SHADER_PROFILE = "ps_5_0";
+
+  enum class ShaderCacheResult : uint8_t {
+    Hit,
+    Compiled,
+    Failed
+  };
+
+  struct ShaderCacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;        // compilés puis écrits dans le cache
+    uint32_t failures = 0;      // erreurs de compilation
+    uint32_t writeFailures = 0;
+    double   loadMs = 0.0;      // lecture des blobs trouvés
+    double   compileMs = 0.0;   // D3DCompileFromFile des absents
+  };
+
+  class ShaderCache final : public CSingleton<ShaderCache> {
+    friend class CSingleton;
+
+  public:
+    static const std::filesystem::path directory;
+
+    // Options de compilation utilisées par le moteur pour la configuration courante
+    static UINT GetDefaultCompileFlags();
+
+    // Thread-safe : la compilation se fait hors verrou. errors reçoit le message du compilateur.
+    ShaderCacheResult Compile(const std::wstring&                       shaderPath,
+                              const std::string&                        entryPoint,
+                              const std::string&                        profile,
+                              const std::map<std::string, std::string>& defines,
+                              UINT                                      flags,
+                              ID3DBlob**                                shaderBlob,
+                              std::string*                              errors = nullptr);
+
+    ShaderCacheStats GetStats() const;
+    void             ResetStats();
+
+    // Résumé hits / compilations sur la sortie de débogage (OutputDebugString)
+    void ReportStats(const char* stage) const;
+
+  private:
+    ShaderCache() = default;
+
+    uint64_t MakeKey(const std::wstring&                       shaderPath,
+                     const std::string&                        entryPoint,
+                     const std::string&                        profile,
+                     const std::map<std::string, std::string>& defines,
+                     UINT                                      flags);
+    uint64_t HashSourceTree(const std::filesystem::path& path, uint32_t depth = 0);
+
+    mutable std::mutex                         m_mutex;
+    std::unordered_map<std::wstring, uint64_t> m_sourceHashes;  // par fichier, includes compris
+    ShaderCacheStats                           m_stats;
+  };
+}
@@ -1,11 +1,48 @@
 #include "ShaderManager.h"
 #include "Engine/Utils/ErrorLogger.h"
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <sstream>
 
 namespace FrostFireEngine
 {
+  #undef min
+  #undef max
+
+  namespace
+  {
+    constexpr size_t MIN_LOOKUP_SLOTS = 64;
+
+    size_t GetLookupSlot(uint64_t key, size_t mask)
+    {
+      key ^= key >> 30;
+      key *= 0xBF58476D1CE4E5B9ull;
+      key ^= key >> 27;
+      key *= 0x94D049BB133111EBull;
+      key ^= key >> 31;
+      return static_cast<size_t>(key) & mask;
+    }
+
+    const char* GetPassName(RenderPass pass)
+    {
+      switch (pass) {
+      case RenderPass::Shadow: return "Shadow";
+      case RenderPass::GBuffer: return "GBuffer";
+      case RenderPass::Lighting: return "Lighting";
+      case RenderPass::Skybox: return "Skybox";
+      case RenderPass::Transparency: return "Transparency";
+      case RenderPass::PostProcess: return "PostProcess";
+      case RenderPass::Final: return "Final";
+      case RenderPass::UI: return "UI";
+      case RenderPass::Debug: return "Debug";
+      default: return "None";
+      }
+    }
+  }
+
   const std::wstring ShaderManager::fullPath = L"Assets/Shaders";
 
   RenderShader* ShaderManager::GetOrCreateShader(const std::string& name)
@@ -44,6 +81,76 @@ namespace FrostFireEngine
     m_device = nullptr;
     shaders.clear();
     m_variants.clear();
+    m_lookupKeys.clear();
+    m_lookupVariants.clear();
+    m_lookupCount = 0;
+    m_lazyVariants.clear();
+  }
+
+  uint64_t ShaderManager::MakePassVariantKey(uint32_t techniqueId, RenderPass pass, FeatureMask features)
+  {
+    // bit_width : 0 pour RenderPass::None, 1 à 9 pour les passes
+    const auto passIndex = static_cast<uint64_t>(std::bit_width(static_cast<uint16_t>(pass)));
+    return (uint64_t(techniqueId) << 52) | (passIndex << 48) |
+      (features & ((uint64_t(1) << MAX_SHADER_FEATURES) - 1));
+  }
+
+  uint32_t ShaderManager::GetTechniqueId(const std::string& techniqueName)
+  {
+    const auto [it, inserted] = m_techniqueIds.try_emplace(
+      techniqueName, static_cast<uint32_t>(m_techniqueIds.size() + 1));
+    return it->second;
+  }
+
+  ShaderVariant* ShaderManager::FindPassVariant(uint64_t key)
+  {
+    m_lookupStats.lookups++;
+    if (!m_lookupKeys.empty()) {
+      const size_t mask = m_lookupKeys.size() - 1;
+      for (size_t slot = GetLookupSlot(key, mask); m_lookupKeys[slot] != 0; slot = (slot + 1) & mask) {
+        if (m_lookupKeys[slot] == key) return m_lookupVariants[slot];
+      }
+    }
+    m_lookupStats.misses++;
+    return nullptr;
+  }
+
+  void ShaderManager::AddPassVariant(uint64_t key, ShaderVariant* variant)
+  {
+    // Taux de remplissage maximal de 50 % : les sondages restent courts
+    if ((m_lookupCount + 1) * 2 > m_lookupKeys.size()) {
+      GrowPassVariantTable();
+    }
+
+    const size_t mask = m_lookupKeys.size() - 1;
+    size_t       slot = GetLookupSlot(key, mask);
+    while (m_lookupKeys[slot] != 0 && m_lookupKeys[slot] != key) {
+      slot = (slot + 1) & mask;
+    }
+    if (m_lookupKeys[slot] == 0) m_lookupCount++;
+    m_lookupKeys[slot] = key;
+    m_lookupVariants[slot] = variant;
+  }
+
+  void ShaderManager::GrowPassVariantTable()
+  {
+    std::vector<uint64_t>       oldKeys = std::move(m_lookupKeys);
+    std::vector<ShaderVariant*> oldVariants = std::move(m_lookupVariants);
+
+    const size_t slotCount = std::max(MIN_LOOKUP_SLOTS, oldKeys.size() * 2);
+    m_lookupKeys.assign(slotCount, 0);
+    m_lookupVariants.assign(slotCount, nullptr);
+
+    const size_t mask = slotCount - 1;
+    for (size_t i = 0; i < oldKeys.size(); i++) {
+      if (oldKeys[i] == 0) continue;
+      size_t slot = GetLookupSlot(oldKeys[i], mask);
+      while (m_lookupKeys[slot] != 0) {
+        slot = (slot + 1) & mask;
+      }
+      m_lookupKeys[slot] = oldKeys[i];
+      m_lookupVariants[slot] = oldVariants[i];
+    }
   }
 
   ShaderVariant* ShaderManager::GetOrCreatePassVariant(const std::string&  techniqueName,
@@ -55,12 +162,7 @@ namespace FrostFireEngine
                                                        defines,
                                                        const VertexLayoutDesc& layout)
   {
-    // Crée un string unique pour les defines
-    std::stringstream ss;
-    for (auto& d : defines) {
-      ss << d.first << "=" << d.second << ";";
-    }
-    VariantKey key{techniqueName, pass, ss.str()};
+    VariantKey key = MakeVariantKey(techniqueName, pass, defines);
 
     auto it = m_variants.find(key);
     if (it != m_variants.end()) {
@@ -74,13 +176,65 @@ namespace FrostFireEngine
       featureIds.push_back(d.first);
     }
 
+    const auto startTime = std::chrono::steady_clock::now();
     if (!variant->Initialize(m_device, shaderPath, featureIds, defines, layout, vsEntry, psEntry)) {
       ErrorLogger::Log("Failed to initialize shader variant for pass.");
       return nullptr;
     }
+    const double compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).
+      count();
+
+    char message[512];
+    snprintf(message, sizeof(message), "Variant compile a la demande : %s/%s [%s] en %.1f ms\n",
+             techniqueName.c_str(), GetPassName(pass), key.variantString.c_str(), compileMs);
+    OutputDebugStringA(message);
+    m_lazyVariants.push_back({techniqueName, pass, key.variantString, compileMs});
 
     auto ptr = variant.get();
     m_variants[key] = std::move(variant);
     return ptr;
   }
+
+  ShaderVariant* ShaderManager::CreatePassVariant(const std::string&                        techniqueName,
+                                                  RenderPass                                pass,
+                                                  const std::map<std::string, std::string>& defines,
+                                                  const VertexLayoutDesc&                   layout,
+                                                  ID3DBlob*                                 vertexShaderBlob,
+                                                  ID3DBlob*                                 pixelShaderBlob)
+  {
+    VariantKey key = MakeVariantKey(techniqueName, pass, defines);
+
+    auto it = m_variants.find(key);
+    if (it != m_variants.end()) {
+      return it->second.get();
+    }
+
+    auto                     variant = std::make_unique<ShaderVariant>();
+    std::vector<std::string> featureIds;
+
+    for (auto& d : defines) {
+      featureIds.push_back(d.first);
+    }
+
+    if (!variant->Initialize(m_device, featureIds, defines, layout, vertexShaderBlob, pixelShaderBlob)) {
+      ErrorLogger::Log("Failed to initialize prewarmed shader variant.");
+      return nullptr;
+    }
+
+    auto ptr = variant.get();
+    m_variants[key] = std::move(variant);
+    return ptr;
+  }
+
+  ShaderManager::VariantKey ShaderManager::MakeVariantKey(const std::string&                        techniqueName,
+                                                          RenderPass                                pass,
+                                                          const std::map<std::string, std::string>& defines)
+  {
+    // Crée un string unique pour les defines
+    std::stringstream ss;
+    for (auto& d : defines) {
+      ss << d.first << "=" << d.second << ";";
+    }
+    return {techniqueName, pass, ss.str()};
+  }
 }
@@ -10,6 +10,7 @@
 #include "RenderShader.h"
 #include "Engine/Singleton.h"
 #include "Engine/Shaders/ShaderVariant.h"
+#include "Engine/Shaders/ShaderVariantManager.h"
 #include "features/RenderPass.h"
 
 namespace FrostFireEngine
@@ -50,6 +51,38 @@ namespace FrostFireEngine
                                           const std::map<std::string, std::string>& defines,
                                           const VertexLayoutDesc&                   layout);
 
+    // Recherche des variants par clé entière, sans chaîne ni allocation : technique (12 bits),
+    // passe (4 bits) et features (48 bits). Table à adressage ouvert, sondage linéaire.
+    static uint64_t MakePassVariantKey(uint32_t techniqueId, RenderPass pass, FeatureMask features);
+    uint32_t        GetTechniqueId(const std::string& techniqueName);
+    ShaderVariant*  FindPassVariant(uint64_t key);
+    void            AddPassVariant(uint64_t key, ShaderVariant* variant);
+
+    struct VariantLookupStats {
+      uint64_t lookups = 0;
+      uint64_t misses = 0;  // premier appel d'une combinaison : variant cherché ou compilé par chaîne
+    };
+    const VariantLookupStats& GetLookupStats() const { return m_lookupStats; }
+
+    // Variant dont le bytecode a été compilé ailleurs (ShaderPrewarm) : seuls les objets D3D sont
+    // créés ici. Renvoie le variant existant si la combinaison est déjà connue.
+    ShaderVariant* CreatePassVariant(const std::string&                        techniqueName,
+                                     RenderPass                                pass,
+                                     const std::map<std::string, std::string>& defines,
+                                     const VertexLayoutDesc&                   layout,
+                                     ID3DBlob*                                 vertexShaderBlob,
+                                     ID3DBlob*                                 pixelShaderBlob);
+
+    // Rapport des à-coups : variants compilés à la demande, au moment de leur premier dessin,
+    // faute d'avoir été préchauffés. Chacun est aussi signalé sur la sortie de débogage.
+    struct LazyVariant {
+      std::string technique;
+      RenderPass  pass;
+      std::string defines;
+      double      compileMs;
+    };
+    const std::vector<LazyVariant>& GetLazyVariants() const { return m_lazyVariants; }
+
     ShaderManager(const ShaderManager&) = delete;
     ShaderManager& operator=(const ShaderManager&) = delete;
 
@@ -66,6 +99,18 @@ namespace FrostFireEngine
     }
 
   private:
+    static VariantKey MakeVariantKey(const std::string&                        techniqueName,
+                                     RenderPass                                pass,
+                                     const std::map<std::string, std::string>& defines);
+    void GrowPassVariantTable();
+
     std::map<VariantKey, std::unique_ptr<ShaderVariant>> m_variants;
+
+    std::unordered_map<std::string, uint32_t> m_techniqueIds;  // à partir de 1 : la clé 0 marque un emplacement libre
+    std::vector<uint64_t>                     m_lookupKeys;
+    std::vector<ShaderVariant*>               m_lookupVariants;
+    size_t                                    m_lookupCount = 0;
+    VariantLookupStats                        m_lookupStats;
+    std::vector<LazyVariant>                  m_lazyVariants;
   };
 }
@@ -0,0 +1,95 @@
+#include "ShaderPrewarm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <execution>
+#include <memory>
+
+#include "Engine/SceneLoader.h"
+#include "Engine/Shaders/ShaderCache.h"
+#include "Engine/Shaders/ShaderManager.h"
+
+namespace FrostFireEngine
+{
+  void ShaderPrewarm::AddTechnique(const ShaderTechnique& technique)
+  {
+    ShaderManager&    manager = ShaderManager::GetInstance();
+    const std::string techniqueName = technique.GetTechniqueName();
+    const uint32_t    techniqueId = manager.GetTechniqueId(techniqueName);
+
+    for (VariantRequest& request : technique.GetReachableVariants()) {
+      const uint64_t key = ShaderManager::MakePassVariantKey(techniqueId, request.pass, request.features);
+      if (manager.FindPassVariant(key)) continue;
+
+      Job job;
+      if (!technique.GetVariantShaderInfo(request.pass, request.features, job.info)) continue;
+      job.techniqueName = techniqueName;
+      job.key = key;
+      job.pass = request.pass;
+      job.layout = std::move(request.layout);
+      m_jobs.push_back(std::move(job));
+    }
+  }
+
+  void ShaderPrewarm::Compile()
+  {
+    const UINT flags = ShaderCache::GetDefaultCompileFlags();
+    std::for_each(std::execution::par, m_jobs.begin(), m_jobs.end(), [flags](Job& job) {
+      ShaderCache& cache = ShaderCache::GetInstance();
+      if (cache.Compile(job.info.shaderFile, job.info.vsEntryPoint, VERTEX_SHADER_PROFILE, job.info.defines, flags,
+                        job.vertexShader.ReleaseAndGetAddressOf(), &job.errors) == ShaderCacheResult::Failed) {
+        return;
+      }
+      cache.Compile(job.info.shaderFile, job.info.psEntryPoint, PIXEL_SHADER_PROFILE, job.info.defines, flags,
+                    job.pixelShader.ReleaseAndGetAddressOf(), &job.errors);
+    });
+  }
+
+  bool ShaderPrewarm::Commit(double budgetMs)
+  {
+    ShaderManager& manager = ShaderManager::GetInstance();
+    const auto     startTime = std::chrono::steady_clock::now();
+
+    while (m_committed < m_jobs.size()) {
+      Job& job = m_jobs[m_committed++];
+
+      // Un échec de compilation n'est pas bloquant ici : le variant sera recompilé au premier
+      // dessin, qui signalera l'erreur comme avant
+      if (job.vertexShader && job.pixelShader) {
+        if (ShaderVariant* variant = manager.CreatePassVariant(job.techniqueName, job.pass, job.info.defines,
+                                                               job.layout, job.vertexShader.Get(),
+                                                               job.pixelShader.Get())) {
+          manager.AddPassVariant(job.key, variant);
+        }
+      }
+      else if (!job.errors.empty()) {
+        OutputDebugStringA(job.errors.c_str());
+      }
+      job.vertexShader.Reset();
+      job.pixelShader.Reset();
+
+      if (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count() >= budgetMs) {
+        break;
+      }
+    }
+
+    if (m_committed < m_jobs.size()) return false;
+    ShaderCache::GetInstance().ReportStats("prechauffage");
+    return true;
+  }
+
+  void ShaderPrewarm::AddLoadStep(SceneLoader&                               loader,
+                                  const std::vector<const ShaderTechnique*>& techniques,
+                                  float                                      weight)
+  {
+    auto prewarm = std::make_shared<ShaderPrewarm>();
+    for (const ShaderTechnique* technique : techniques) {
+      prewarm->AddTechnique(*technique);
+    }
+
+    loader.AddAsyncStep("Shaders",
+                        [prewarm]() { prewarm->Compile(); },
+                        [prewarm](double budgetMs) { return prewarm->Commit(budgetMs); },
+                        weight);
+  }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Engine/Shaders/techniques/ShaderTechnique.h"
+
+namespace FrostFireEngine
+{
+  class SceneLoader;
+
+  // Préchauffage des variants pendant un chargement : les combinaisons annoncées par les
+  // techniques (GetReachableVariants) sont compilées en parallèle sur des threads de travail,
+  // à travers le ShaderCache, et le thread principal ne fait que créer les objets D3D.
+  // Ce qui manque encore au premier dessin est signalé par ShaderManager::GetLazyVariants.
+  class ShaderPrewarm {
+  public:
+    // Thread principal : relève les combinaisons que le ShaderManager ne connaît pas encore
+    void AddTechnique(const ShaderTechnique& technique);
+
+    // Thread de travail : ne touche ni au ShaderManager ni au device
+    void Compile();
+
+    // Thread principal, par tranches ; vrai quand tous les variants sont créés
+    bool Commit(double budgetMs);
+
+    size_t GetVariantCount() const { return m_jobs.size(); }
+
+    // Étape asynchrone de chargement qui préchauffe les techniques données
+    static void AddLoadStep(SceneLoader&                               loader,
+                            const std::vector<const ShaderTechnique*>& techniques,
+                            float                                      weight = 1.0f);
+
+  private:
+    struct Job {
+      std::string                      techniqueName;
+      uint64_t                         key = 0;
+      RenderPass                       pass = RenderPass::None;
+      PassShaderInfo                   info;
+      VertexLayoutDesc                 layout;
+      Microsoft::WRL::ComPtr<ID3DBlob> vertexShader;
+      Microsoft::WRL::ComPtr<ID3DBlob> pixelShader;
+      std::string                      errors;
+    };
+
+    std::vector<Job> m_jobs;
+    size_t           m_committed = 0;
+  };
+}
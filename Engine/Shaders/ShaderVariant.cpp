@@ -1,7 +1,7 @@
 ﻿#include "ShaderVariant.h"
+#include "Engine/Shaders/ShaderCache.h"
 #include "Engine/Utils/ErrorLogger.h"
 #include <sstream>
-#include <d3dcompiler.h>
 #include <algorithm>
 
 namespace FrostFireEngine
@@ -21,33 +21,46 @@ namespace FrostFireEngine
                                  const std::string&                        vsEntry,
                                  const std::string&                        psEntry)
   {
-    m_definesList = defines;
-    m_activeFeatures = featureIds;
-
-    {
-      std::stringstream keyStream;
-      for (const auto& id : featureIds) {
-        keyStream << id << "_";
-      }
-      m_variantKey = keyStream.str();
-    }
-
     ID3DBlob* vertexShaderBlob = nullptr;
     ID3DBlob* pixelShaderBlob = nullptr;
 
     // Compile vertex shader
-    if (!CompileShaderFromFile(shaderPath, vsEntry, "vs_5_0", defines, &vertexShaderBlob)) {
+    if (!CompileShaderFromFile(shaderPath, vsEntry, VERTEX_SHADER_PROFILE, defines, &vertexShaderBlob)) {
       ErrorLogger::Log("Failed to compile vertex shader: " + std::string(vsEntry));
       return false;
     }
 
     // Compile pixel shader
-    if (!CompileShaderFromFile(shaderPath, psEntry, "ps_5_0", defines, &pixelShaderBlob)) {
+    if (!CompileShaderFromFile(shaderPath, psEntry, PIXEL_SHADER_PROFILE, defines, &pixelShaderBlob)) {
       ErrorLogger::Log("Failed to compile pixel shader: " + std::string(psEntry));
       if (vertexShaderBlob) vertexShaderBlob->Release();
       return false;
     }
 
+    const bool created = Initialize(device, featureIds, defines, layout, vertexShaderBlob, pixelShaderBlob);
+    vertexShaderBlob->Release();
+    pixelShaderBlob->Release();
+    return created;
+  }
+
+  bool ShaderVariant::Initialize(ID3D11Device*                             device,
+                                 const std::vector<std::string>&           featureIds,
+                                 const std::map<std::string, std::string>& defines,
+                                 const VertexLayoutDesc&                   layout,
+                                 ID3DBlob*                                 vertexShaderBlob,
+                                 ID3DBlob*                                 pixelShaderBlob)
+  {
+    m_definesList = defines;
+    m_activeFeatures = featureIds;
+
+    {
+      std::stringstream keyStream;
+      for (const auto& id : featureIds) {
+        keyStream << id << "_";
+      }
+      m_variantKey = keyStream.str();
+    }
+
     // Create the vertex shader
     HRESULT result = device->CreateVertexShader(vertexShaderBlob->GetBufferPointer(),
                                                 vertexShaderBlob->GetBufferSize(),
@@ -55,8 +68,6 @@ namespace FrostFireEngine
                                                 &m_vertexShader);
     if (FAILED(result)) {
       ErrorLogger::Log("Failed to create vertex shader.");
-      vertexShaderBlob->Release();
-      pixelShaderBlob->Release();
       return false;
     }
 
@@ -67,16 +78,12 @@ namespace FrostFireEngine
                                        &m_pixelShader);
     if (FAILED(result)) {
       ErrorLogger::Log("Failed to create pixel shader.");
-      vertexShaderBlob->Release();
-      pixelShaderBlob->Release();
       return false;
     }
 
     // Create input layout
     if (!CreateInputLayout(device, vertexShaderBlob, layout)) {
       ErrorLogger::Log("Failed to create input layout.");
-      vertexShaderBlob->Release();
-      pixelShaderBlob->Release();
       return false;
     }
 
@@ -93,14 +100,9 @@ namespace FrostFireEngine
     result = device->CreateSamplerState(&samplerDesc, &m_samplerState);
     if (FAILED(result)) {
       ErrorLogger::Log("Failed to create sampler state.");
-      vertexShaderBlob->Release();
-      pixelShaderBlob->Release();
       return false;
     }
 
-    vertexShaderBlob->Release();
-    pixelShaderBlob->Release();
-
     return true;
   }
 
@@ -160,41 +162,16 @@ namespace FrostFireEngine
                                             const std::map<std::string, std::string>& defines,
                                             ID3DBlob**                                shaderBlob)
   {
-    UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
-#ifdef _DEBUG
-    flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-
-    std::vector<D3D_SHADER_MACRO> macros;
-    for (const auto& def : defines) {
-      D3D_SHADER_MACRO m;
-      m.Name = def.first.c_str();
-      m.Definition = def.second.c_str();
-      macros.push_back(m);
-    }
-    D3D_SHADER_MACRO nullMacro = {nullptr, nullptr};
-    macros.push_back(nullMacro);
-
-    ID3DBlob* errorBlob = nullptr;
-    HRESULT   hr = D3DCompileFromFile(shaderPath.c_str(),
-                                    macros.data(),
-                                    D3D_COMPILE_STANDARD_FILE_INCLUDE,
-                                    entryPoint.c_str(),
-                                    shaderModel.c_str(),
-                                    flags,
-                                    0,
-                                    shaderBlob,
-                                    &errorBlob);
-
-    if (FAILED(hr)) {
-      if (errorBlob) {
-        ErrorLogger::Log(static_cast<char*>(errorBlob->GetBufferPointer()));
-        errorBlob->Release();
+    std::string errors;
+    const ShaderCacheResult result = ShaderCache::GetInstance().Compile(
+      shaderPath, entryPoint, shaderModel, defines, ShaderCache::GetDefaultCompileFlags(), shaderBlob, &errors);
+
+    if (result == ShaderCacheResult::Failed) {
+      if (!errors.empty()) {
+        ErrorLogger::Log(errors);
       }
       return false;
     }
-
-    if (errorBlob) errorBlob->Release();
     return true;
   }
 
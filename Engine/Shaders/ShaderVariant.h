@@ -23,6 +23,15 @@ namespace FrostFireEngine
                     const std::string&                        vsEntry = "VS",
                     const std::string&                        psEntry = "PS");
 
+    // Création des objets D3D à partir d'un bytecode déjà compilé (préchauffage des variants) ;
+    // les blobs restent à l'appelant
+    bool Initialize(ID3D11Device*                             device,
+                    const std::vector<std::string>&           featureIds,
+                    const std::map<std::string, std::string>& defines,
+                    const VertexLayoutDesc&                   layout,
+                    ID3DBlob*                                 vertexShaderBlob,
+                    ID3DBlob*                                 pixelShaderBlob);
+
     void        Shutdown();
     bool        Apply(ID3D11DeviceContext* deviceContext) const;
     std::string GetVariantKey() const;
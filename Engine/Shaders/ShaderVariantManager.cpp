@@ -1,8 +1,27 @@
 ﻿#include "ShaderVariantManager.h"
 #include <algorithm>
+#include <bit>
+#include <mutex>
+
+#include "Engine/Utils/ErrorLogger.h"
 
 namespace FrostFireEngine
 {
+  namespace
+  {
+    struct FeatureRegistry {
+      std::mutex                                mutex;
+      std::unordered_map<std::string, uint32_t> indices;
+      std::vector<std::string>                  names;  // par index de bit
+    };
+
+    FeatureRegistry& GetFeatureRegistry()
+    {
+      static FeatureRegistry registry;
+      return registry;
+    }
+  }
+
   ShaderVariantManager::ShaderVariantManager() = default;
 
   ShaderVariantManager::~ShaderVariantManager() = default;
@@ -14,9 +33,52 @@ namespace FrostFireEngine
       return false;
     }
     m_featureMetadata[featureId] = metadata;
+    GetFeatureBit(featureId);
     return true;
   }
 
+  FeatureMask ShaderVariantManager::GetFeatureBit(const std::string& featureId)
+  {
+    FeatureRegistry&       registry = GetFeatureRegistry();
+    const std::scoped_lock lock(registry.mutex);
+
+    if (const auto it = registry.indices.find(featureId); it != registry.indices.end()) {
+      return FeatureMask(1) << it->second;
+    }
+
+    const auto index = static_cast<uint32_t>(registry.names.size());
+    if (index >= MAX_SHADER_FEATURES) {
+      ErrorLogger::Log("Too many shader features registered: " + featureId);
+      return 0;
+    }
+    registry.indices.emplace(featureId, index);
+    registry.names.push_back(featureId);
+    return FeatureMask(1) << index;
+  }
+
+  FeatureMask ShaderVariantManager::GetFeatureMask(const std::vector<std::string>& featureIds)
+  {
+    FeatureMask mask = 0;
+    for (const auto& featureId : featureIds) {
+      mask |= GetFeatureBit(featureId);
+    }
+    return mask;
+  }
+
+  std::vector<std::string> ShaderVariantManager::GetFeatureNames(FeatureMask mask)
+  {
+    FeatureRegistry&       registry = GetFeatureRegistry();
+    const std::scoped_lock lock(registry.mutex);
+
+    std::vector<std::string> names;
+    names.reserve(std::popcount(mask));
+    for (; mask != 0; mask &= mask - 1) {
+      const auto index = static_cast<uint32_t>(std::countr_zero(mask));
+      if (index < registry.names.size()) names.push_back(registry.names[index]);
+    }
+    return names;
+  }
+
   bool ShaderVariantManager::ValidateFeatureCombination(
     const std::vector<std::string>& featureIds) const
   {
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -7,6 +8,12 @@
 
 namespace FrostFireEngine
 {
+  // Un bit par feature, attribué à sa première rencontre et partagé par tous les shaders
+  using FeatureMask = uint64_t;
+
+  // Les 16 bits restants d'une clé de variant identifient la technique et la passe
+  constexpr uint32_t MAX_SHADER_FEATURES = 48;
+
   class ShaderVariantManager {
   public:
     ShaderVariantManager();
@@ -17,6 +24,12 @@ namespace FrostFireEngine
     bool GetFeatureMetadata(const std::string& featureId, FeatureMetadata& outMetadata) const;
     bool AreCompatible(const std::string& feature1, const std::string& feature2) const;
 
+    // Table d'internement des features : les chaînes ne sont plus manipulées qu'à l'ajout
+    // d'une feature ou à la compilation d'un variant
+    static FeatureMask              GetFeatureBit(const std::string& featureId);
+    static FeatureMask              GetFeatureMask(const std::vector<std::string>& featureIds);
+    static std::vector<std::string> GetFeatureNames(FeatureMask mask);
+
   private:
     bool ValidateDependencies(const std::string&              featureId,
                               const std::vector<std::string>& activeFeatures) const;
@@ -1,21 +1,75 @@
 ﻿#include "VariantCache.h"
 #include <algorithm>
 #include <sstream>
+#include <utility>
 
 namespace FrostFireEngine
 {
+  VariantHandle::VariantHandle(CacheEntry* entry) :
+    m_entry(entry)
+  {
+    if (m_entry) VariantCache::Acquire(*m_entry);
+  }
+
+  VariantHandle::~VariantHandle()
+  {
+    Reset();
+  }
+
+  VariantHandle::VariantHandle(const VariantHandle& other) :
+    VariantHandle(other.m_entry)
+  {
+  }
+
+  VariantHandle& VariantHandle::operator=(const VariantHandle& other)
+  {
+    if (m_entry != other.m_entry) {
+      if (other.m_entry) VariantCache::Acquire(*other.m_entry);
+      Reset();
+      m_entry = other.m_entry;
+    }
+    return *this;
+  }
+
+  VariantHandle::VariantHandle(VariantHandle&& other) noexcept :
+    m_entry(std::exchange(other.m_entry, nullptr))
+  {
+  }
+
+  VariantHandle& VariantHandle::operator=(VariantHandle&& other) noexcept
+  {
+    if (this != &other) {
+      Reset();
+      m_entry = std::exchange(other.m_entry, nullptr);
+    }
+    return *this;
+  }
+
+  void VariantHandle::Reset()
+  {
+    if (CacheEntry* entry = std::exchange(m_entry, nullptr)) {
+      VariantCache::Release(*entry);
+    }
+  }
+
   VariantCache::VariantCache(const size_t maxSize) :
-    m_maxCacheSize(maxSize),
-    m_currentTime(0)
+    m_maxCacheSize(maxSize)
   {
   }
 
   VariantCache::~VariantCache()
   {
     Clear();
+
+    // Variants encore référencés : ils se détruiront avec leur dernier handle
+    for (auto& [key, entry] : m_variantCache) {
+      entry->owner = nullptr;
+      entry.release();
+    }
+    m_variantCache.clear();
   }
 
-  ShaderVariant* VariantCache::GetOrCreateVariant(
+  VariantHandle VariantCache::GetOrCreateVariant(
     ID3D11Device*                             device,
     const std::wstring&                       shaderPath,
     const std::vector<std::string>&           featureIds,
@@ -25,68 +79,121 @@ namespace FrostFireEngine
     const std::string key = GenerateVariantKey(shaderPath, featureIds);
 
     if (const auto it = m_variantCache.find(key); it != m_variantCache.end()) {
-      it->second.lastAccessTime = m_currentTime++;
-      it->second.useCount++;
-      return it->second.variant.get();
-    }
-
-    if (m_variantCache.size() >= m_maxCacheSize) {
-      TrimCache();
+      m_stats.hits++;
+      return VariantHandle(it->second.get());
     }
 
     auto newVariant = std::make_unique<ShaderVariant>();
     if (!newVariant->Initialize(device, shaderPath, featureIds, defines, layout)) {
-      return nullptr;
+      return {};
+    }
+    return AddVariant(shaderPath, featureIds, std::move(newVariant));
+  }
+
+  VariantHandle VariantCache::AddVariant(
+    const std::wstring&             shaderPath,
+    const std::vector<std::string>& featureIds,
+    std::unique_ptr<ShaderVariant>  variant)
+  {
+    std::string key = GenerateVariantKey(shaderPath, featureIds);
+    if (const auto it = m_variantCache.find(key); it != m_variantCache.end()) {
+      return VariantHandle(it->second.get());
     }
 
-    CacheEntry entry;
-    entry.variant = std::move(newVariant);
-    entry.lastAccessTime = m_currentTime++;
-    entry.useCount = 1;
+    // Place pour le nouveau variant, prise sur les moins récemment utilisés
+    if (m_maxCacheSize > 0) {
+      TrimCache(m_maxCacheSize - 1);
+    }
+
+    m_stats.misses++;
+    if (m_evictedKeys.erase(key) > 0) {
+      m_stats.recompiles++;
+    }
+
+    auto entry = std::make_unique<CacheEntry>();
+    entry->variant = std::move(variant);
+    entry->key = key;
+    entry->owner = this;
 
-    const auto insertedVariant = entry.variant.get();
-    m_variantCache[key] = std::move(entry);
+    CacheEntry* insertedEntry = entry.get();
+    m_variantCache.emplace(std::move(key), std::move(entry));
+    m_stats.peakSize = std::max(m_stats.peakSize, m_variantCache.size());
 
-    return insertedVariant;
+    return VariantHandle(insertedEntry);
   }
 
   void VariantCache::Clear()
   {
-    m_variantCache.clear();
-    m_currentTime = 0;
+    while (m_lruTail) {
+      Evict(*m_lruTail);
+    }
   }
 
   void VariantCache::SetMaxSize(const size_t size)
   {
     m_maxCacheSize = size;
-    if (m_variantCache.size() > m_maxCacheSize) {
-      TrimCache();
+    TrimCache(m_maxCacheSize);
+  }
+
+  void VariantCache::Acquire(CacheEntry& entry)
+  {
+    if (entry.refCount++ == 0 && entry.owner) {
+      entry.owner->Unlink(entry);
     }
   }
 
-  void VariantCache::TrimCache()
+  void VariantCache::Release(CacheEntry& entry)
   {
-    if (m_variantCache.empty()) {
+    if (--entry.refCount > 0) return;
+
+    if (!entry.owner) {
+      delete &entry;
       return;
     }
 
-    std::vector<std::pair<std::string, float>> scores;
-    scores.reserve(m_variantCache.size());
+    VariantCache& cache = *entry.owner;
+    cache.LinkFront(entry);
+    cache.TrimCache(cache.m_maxCacheSize);
+  }
 
-    for (const auto& entry : m_variantCache) {
-      float score = static_cast<float>(entry.second.useCount) /
-      (m_currentTime - entry.second.lastAccessTime + 1);
-      scores.emplace_back(entry.first, score);
-    }
+  void VariantCache::LinkFront(CacheEntry& entry)
+  {
+    entry.inLru = true;
+    entry.lruPrev = nullptr;
+    entry.lruNext = m_lruHead;
+    if (m_lruHead) m_lruHead->lruPrev = &entry;
+    m_lruHead = &entry;
+    if (!m_lruTail) m_lruTail = &entry;
+  }
 
-    std::ranges::sort(scores, [](const auto& a, const auto& b)
-    {
-      return a.second < b.second;
-    });
+  void VariantCache::Unlink(CacheEntry& entry)
+  {
+    // Entrée neuve ou déjà référencée : hors de la liste, la tête et la queue ne la concernent pas
+    if (!entry.inLru) return;
+
+    entry.inLru = false;
+    (entry.lruPrev ? entry.lruPrev->lruNext : m_lruHead) = entry.lruNext;
+    (entry.lruNext ? entry.lruNext->lruPrev : m_lruTail) = entry.lruPrev;
+    entry.lruPrev = nullptr;
+    entry.lruNext = nullptr;
+  }
+
+  void VariantCache::Evict(CacheEntry& entry)
+  {
+    Unlink(entry);
+    m_evictedKeys.insert(entry.key);
+    m_stats.evictions++;
 
-    const size_t numToRemove = m_variantCache.size() - m_maxCacheSize;
-    for (size_t i = 0; i < numToRemove; ++i) {
-      m_variantCache.erase(scores[i].first);
+    const std::string key = std::move(entry.key);
+    m_variantCache.erase(key);
+  }
+
+  void VariantCache::TrimCache(const size_t targetSize)
+  {
+    // Seuls les variants sans référence sont candidats ; le cache peut rester au-dessus
+    // de la cible si tous sont en usage
+    while (m_variantCache.size() > targetSize && m_lruTail) {
+      Evict(*m_lruTail);
     }
   }
 
@@ -3,14 +3,56 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "ShaderVariant.h"
 
 namespace FrostFireEngine
 {
+  class VariantCache;
+
+  // Un variant référencé n'est jamais détruit : seuls les variants sans référence sont dans la
+  // liste LRU (intrusive), et l'éviction prend la queue en O(1)
   struct CacheEntry {
     std::unique_ptr<ShaderVariant> variant;
-    size_t                         lastAccessTime;
-    size_t                         useCount;
+    std::string                    key;
+    VariantCache*                  owner = nullptr;  // nul si le cache a été détruit avant les références
+    uint32_t                       refCount = 0;
+    CacheEntry*                    lruPrev = nullptr;
+    CacheEntry*                    lruNext = nullptr;
+    bool                           inLru = false;  // une entrée neuve n'est pas encore dans la liste
+  };
+
+  // Référence comptée sur un variant du cache, à garder à la place d'un ShaderVariant* :
+  // le variant reste valide tant qu'un handle existe, même si le cache est vidé ou détruit
+  class VariantHandle {
+  public:
+    VariantHandle() = default;
+    ~VariantHandle();
+
+    VariantHandle(const VariantHandle& other);
+    VariantHandle& operator=(const VariantHandle& other);
+    VariantHandle(VariantHandle&& other) noexcept;
+    VariantHandle& operator=(VariantHandle&& other) noexcept;
+
+    ShaderVariant* Get() const { return m_entry ? m_entry->variant.get() : nullptr; }
+    ShaderVariant* operator->() const { return Get(); }
+    explicit       operator bool() const { return m_entry != nullptr; }
+    void           Reset();
+
+  private:
+    friend class VariantCache;
+    explicit VariantHandle(CacheEntry* entry);
+
+    CacheEntry* m_entry = nullptr;
+  };
+
+  struct VariantCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;      // variants compilés
+    uint64_t recompiles = 0;  // compilations d'une clé déjà évincée : cache trop petit
+    uint64_t evictions = 0;
+    size_t   peakSize = 0;    // peut dépasser maxSize si tous les variants sont référencés
   };
 
   class VariantCache {
@@ -18,25 +60,49 @@ namespace FrostFireEngine
     VariantCache(size_t maxSize = 100);
     ~VariantCache();
 
-    ShaderVariant* GetOrCreateVariant(
+    VariantCache(const VariantCache&) = delete;
+    VariantCache& operator=(const VariantCache&) = delete;
+
+    VariantHandle GetOrCreateVariant(
       ID3D11Device*                             device,
       const std::wstring&                       shaderPath,
       const std::vector<std::string>&           featureIds,
       const std::map<std::string, std::string>& defines,
       const VertexLayoutDesc&                   layout);
 
+    // Ajoute un variant créé ailleurs (bytecode préchauffé, tests) sous la clé de shaderPath et
+    // featureIds. Renvoie le variant existant si la clé est déjà en cache.
+    VariantHandle AddVariant(
+      const std::wstring&             shaderPath,
+      const std::vector<std::string>& featureIds,
+      std::unique_ptr<ShaderVariant>  variant);
+
+    // Détruit les variants sans référence ; les autres restent en cache
     void Clear();
     void SetMaxSize(size_t size);
 
+    size_t                   GetSize() const { return m_variantCache.size(); }
+    const VariantCacheStats& GetStats() const { return m_stats; }
+
   private:
-    void               TrimCache();
+    friend class VariantHandle;
+    static void Acquire(CacheEntry& entry);
+    static void Release(CacheEntry& entry);
+
+    void               LinkFront(CacheEntry& entry);
+    void               Unlink(CacheEntry& entry);
+    void               Evict(CacheEntry& entry);
+    void               TrimCache(size_t targetSize);
     static std::string GenerateVariantKey(
       const std::wstring&             shaderPath,
       const std::vector<std::string>& featureIds);
 
   private:
-    std::map<std::string, CacheEntry> m_variantCache;
-    size_t                            m_maxCacheSize;
-    size_t                            m_currentTime;
+    std::unordered_map<std::string, std::unique_ptr<CacheEntry>> m_variantCache;
+    std::unordered_set<std::string>                              m_evictedKeys;
+    CacheEntry*                                                  m_lruHead = nullptr;  // libéré le plus récemment
+    CacheEntry*                                                  m_lruTail = nullptr;  // prochain évincé
+    size_t                                                       m_maxCacheSize;
+    VariantCacheStats                                            m_stats;
   };
 }
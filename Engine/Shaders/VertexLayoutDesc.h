@@ -7,4 +7,22 @@ namespace FrostFireEngine
   struct VertexLayoutDesc {
     std::vector<D3D11_INPUT_ELEMENT_DESC> elements;
   };
+
+  // Quads 2D de l'interface et du texte (UIVertex de UIBatcher) : position en pixels écran,
+  // UV et teinte par sommet, l'élément n'ayant plus ses propres constantes
+  inline const D3D11_INPUT_ELEMENT_DESC UIVertexLayout[] = {
+    {"POSITION", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 8, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0}
+  };
+
+  // Billboards instanciés : quad en Vertex (flux 0) et SpriteInstance de SpriteBatcher (flux 1)
+  inline const D3D11_INPUT_ELEMENT_DESC BillboardInstanceLayout[] = {
+    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 32, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"INSTANCE_POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+    {"INSTANCE_SCALE", 0, DXGI_FORMAT_R32G32B32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1}
+  };
 }
@@ -50,7 +50,7 @@ void PBRFeature::UpdateParameters(ID3D11DeviceContext* context)
 
 std::string PBRFeature::GetId() const
 {
-  return "PBR";
+  return PBR_FEATURE;
 }
 
 FeatureMetadata PBRFeature::GetMetadata() const
@@ -12,6 +12,8 @@ namespace FrostFireEngine
     float             padding; // Alignement
   };
 
+  constexpr const char* PBR_FEATURE = "PBR";
+
   class PBRFeature : public BaseShaderFeature {
   public:
     PBRFeature(ID3D11Device* device);
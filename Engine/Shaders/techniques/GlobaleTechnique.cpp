@@ -1,5 +1,9 @@
 ﻿#include "GlobaleTechnique.h"
+#include "Engine/Vertex.h"
+#include "Engine/VertexPacking.h"
+#include "Engine/Shaders/features/PBRFeature.h"
 #include "Engine/Shaders/features/RenderPass.h"
+#include "Engine/ECS/systems/rendering/SpriteBatcher.h"
 
 namespace FrostFireEngine
 {
@@ -87,6 +91,43 @@ namespace FrostFireEngine
     }
   }
 
+  std::vector<VariantRequest> GlobaleTechnique::GetReachableVariants() const
+  {
+    const FeatureMask pbr = ShaderVariantManager::GetFeatureBit(PBR_FEATURE);
+    const FeatureMask packed = ShaderVariantManager::GetFeatureBit(PACKED_VERTEX_FEATURE);
+    const FeatureMask instancing = ShaderVariantManager::GetFeatureBit(SPRITE_INSTANCING_FEATURE);
+
+    const VertexLayoutDesc fullLayout = GetVertexLayoutDesc(VertexFormat::Full);
+    const VertexLayoutDesc packedLayout = GetVertexLayoutDesc(VertexFormat::Packed);
+    VertexLayoutDesc       vertexLayout;
+    vertexLayout.elements.assign(std::begin(Vertex::layout), std::end(Vertex::layout));
+    VertexLayoutDesc shadowLayout;
+    shadowLayout.elements.assign(std::begin(PositionOnlyLayout), std::end(PositionOnlyLayout));
+    VertexLayoutDesc uiLayout;
+    uiLayout.elements.assign(std::begin(UIVertexLayout), std::end(UIVertexLayout));
+    VertexLayoutDesc billboardLayout;
+    billboardLayout.elements.assign(std::begin(BillboardInstanceLayout), std::end(BillboardInstanceLayout));
+    const VertexLayoutDesc fullscreenLayout;
+
+    // PBRRenderer (maillages complets ou compressés), SpriteRenderer en Transparency (seul ou
+    // instancié par SpriteBatcher), UIRendererComponent en UI, et les passes de RenderingSystem.
+    // La passe Debug, propre aux builds de débogage, reste compilée à la demande.
+    return {
+      {RenderPass::Shadow, 0, shadowLayout},
+      {RenderPass::GBuffer, pbr, fullLayout},
+      {RenderPass::GBuffer, pbr | packed, packedLayout},
+      {RenderPass::Lighting, 0, fullscreenLayout},
+      {RenderPass::Skybox, 0, vertexLayout},
+      {RenderPass::Transparency, 0, vertexLayout},
+      {RenderPass::Transparency, instancing, billboardLayout},
+      {RenderPass::Transparency, pbr, fullLayout},
+      {RenderPass::Transparency, pbr | packed, packedLayout},
+      {RenderPass::PostProcess, 0, fullscreenLayout},
+      {RenderPass::Final, 0, fullscreenLayout},
+      {RenderPass::UI, 0, uiLayout},
+    };
+  }
+
   bool GlobaleTechnique::GetPassShaderInfo(RenderPass pass, PassShaderInfo& outInfo) const
   {
     auto it = m_passInfos.find(pass);
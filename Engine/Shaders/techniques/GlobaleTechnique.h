@@ -12,6 +12,7 @@ namespace FrostFireEngine
     {
       return "Globale";
     }
+    std::vector<VariantRequest> GetReachableVariants() const override;
 
   private:
     std::unordered_map<RenderPass, PassShaderInfo> m_passInfos;
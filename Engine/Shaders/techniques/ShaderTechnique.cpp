@@ -7,30 +7,56 @@ namespace FrostFireEngine
                                                     const std::vector<std::string>& features,
                                                     const VertexLayoutDesc&         layout) const
   {
-    PassShaderInfo info;
-    if (!GetPassShaderInfo(pass, info)) {
-      return nullptr;
+    return GetVariantForPass(pass, ShaderVariantManager::GetFeatureMask(features), layout);
+  }
+
+  ShaderVariant* ShaderTechnique::GetVariantForPass(RenderPass              pass,
+                                                    FeatureMask             features,
+                                                    const VertexLayoutDesc& layout) const
+  {
+    ShaderManager& manager = ShaderManager::GetInstance();
+    if (m_techniqueId == 0) {
+      m_techniqueId = manager.GetTechniqueId(GetTechniqueName());
     }
 
-    // On combine les defines de la technique pour cette passe avec les features
-    std::map<std::string, std::string> finalDefines = info.defines;
-    // Les features peuvent être traitées comme des defines boolean
-    for (const auto& f : features) {
-      finalDefines[f] = "1";
+    const uint64_t key = ShaderManager::MakePassVariantKey(m_techniqueId, pass, features);
+    if (ShaderVariant* variant = manager.FindPassVariant(key)) {
+      return variant;
+    }
+
+    PassShaderInfo info;
+    if (!GetVariantShaderInfo(pass, features, info)) {
+      return nullptr;
     }
 
     // On utilise le ShaderManager (singleton) pour obtenir un variant
-    ShaderManager& manager = ShaderManager::GetInstance();
     ShaderVariant* variant = manager.GetOrCreatePassVariant(
       GetTechniqueName(),
       pass,
       info.shaderFile,
       info.vsEntryPoint,
       info.psEntryPoint,
-      finalDefines,
+      info.defines,
       layout
     );
 
+    if (variant) {
+      manager.AddPassVariant(key, variant);
+    }
     return variant;
   }
+
+  bool ShaderTechnique::GetVariantShaderInfo(RenderPass pass, FeatureMask features, PassShaderInfo& outInfo) const
+  {
+    if (!GetPassShaderInfo(pass, outInfo)) {
+      return false;
+    }
+
+    // On combine les defines de la technique pour cette passe avec les features
+    // Les features peuvent être traitées comme des defines boolean
+    for (const auto& f : ShaderVariantManager::GetFeatureNames(features)) {
+      outInfo.defines[f] = "1";
+    }
+    return true;
+  }
 }
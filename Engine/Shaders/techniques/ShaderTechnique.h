@@ -3,6 +3,7 @@
 #include <map>
 #include <vector>
 #include "Engine/Shaders/ShaderVariant.h"
+#include "Engine/Shaders/ShaderVariantManager.h"
 #include "Engine/Shaders/features/RenderPass.h"
 
 namespace FrostFireEngine
@@ -15,6 +16,13 @@ namespace FrostFireEngine
     std::map<std::string, std::string> defines; // Defines spécifiques à cette passe
   };
 
+  // Combinaison atteinte par un renderer : le layout fait partie du variant (input layout)
+  struct VariantRequest {
+    RenderPass       pass;
+    FeatureMask      features;
+    VertexLayoutDesc layout;
+  };
+
   // Interface de base d'une technique
   class ShaderTechnique {
   public:
@@ -26,11 +34,25 @@ namespace FrostFireEngine
     // Nom de la technique, utilisé pour le caching dans le shader manager si besoin
     virtual std::string GetTechniqueName() const = 0;
 
+    // Combinaisons passe × features × layout utilisées par les renderers, compilées d'avance
+    // pendant le chargement (ShaderPrewarm) et par l'outil ShaderPrecompiler
+    virtual std::vector<VariantRequest> GetReachableVariants() const { return {}; }
+
     // Récupère un variant pour cette technique, la passe donnée, et les features
     // Cette fonction utilise le ShaderManager pour obtenir un ShaderVariant compilé
     virtual ShaderVariant* GetVariantForPass(RenderPass pass,
                                              const std::vector<std::string>&
                                              features,
                                              const VertexLayoutDesc& layout) const;
+
+    // Chemin des appels par objet : features déjà converties en masque, une seule recherche
+    // par clé entière ; les chaînes ne servent qu'à la première compilation du variant
+    ShaderVariant* GetVariantForPass(RenderPass pass, FeatureMask features, const VertexLayoutDesc& layout) const;
+
+    // Infos de la passe complétées par les defines des features : ce que compile le variant
+    bool GetVariantShaderInfo(RenderPass pass, FeatureMask features, PassShaderInfo& outInfo) const;
+
+  private:
+    mutable uint32_t m_techniqueId = 0;  // attribué au premier appel, GetTechniqueName étant virtuel
   };
 }
@@ -1,4 +1,5 @@
 ﻿#include "TextTechnique.h"
+#include "Engine/Font/SdfFontAtlas.h"
 
 namespace FrostFireEngine
 {
@@ -11,6 +12,17 @@ namespace FrostFireEngine
     m_passInfos[RenderPass::UI] = info;
   }
 
+  std::vector<VariantRequest> TextTechnique::GetReachableVariants() const
+  {
+    // TextRendererComponent, fonte bitmap ou SDF
+    VertexLayoutDesc textLayout;
+    textLayout.elements.assign(std::begin(UIVertexLayout), std::end(UIVertexLayout));
+    return {
+      {RenderPass::UI, 0, textLayout},
+      {RenderPass::UI, ShaderVariantManager::GetFeatureBit(SDF_TEXT_FEATURE), textLayout}
+    };
+  }
+
   bool TextTechnique::GetPassShaderInfo(RenderPass pass, PassShaderInfo& outInfo) const
   {
     auto it = m_passInfos.find(pass);
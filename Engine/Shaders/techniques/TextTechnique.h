@@ -13,6 +13,7 @@ namespace FrostFireEngine
     {
       return "Text";
     }
+    std::vector<VariantRequest> GetReachableVariants() const override;
 
   private:
     std::map<RenderPass, PassShaderInfo> m_passInfos;
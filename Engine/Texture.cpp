@@ -6,7 +6,10 @@
 #include "util.h"
 #include <wincodec.h>
 #include "DDSTextureLoader11.h"
+#include "Textures/DDSParser.h"
+#include "Textures/TextureStreamer.h"
 #include "Utils/ErrorLogger.h"
+#include "Utils/MappedFile.h"
 #include "Utils/WStringUtils.h"
 using namespace DirectX;
 
@@ -50,6 +53,7 @@ namespace FrostFireEngine
 
   UINT Texture::GetWidth() const
   {
+    if (m_isStreamed) return m_Width;
     if (!m_Texture) return 0;
 
     ComPtr<ID3D11Resource> resource;
@@ -66,6 +70,7 @@ namespace FrostFireEngine
 
   UINT Texture::GetHeight() const
   {
+    if (m_isStreamed) return m_Height;
     if (!m_Texture) return 0;
 
     ComPtr<ID3D11Resource> resource;
@@ -80,16 +85,107 @@ namespace FrostFireEngine
     return desc.Height;
   }
 
+  size_t Texture::GetGPUSize() const
+  {
+    if (m_isStreamed) return GetResidentSize();
+    if (!m_Texture) return 0;
+
+    ComPtr<ID3D11Resource> resource;
+    m_Texture->GetResource(&resource);
+
+    ComPtr<ID3D11Texture2D> texture2D;
+    if (FAILED(resource.As(&texture2D))) return 0;
+
+    D3D11_TEXTURE2D_DESC desc;
+    texture2D->GetDesc(&desc);
+
+    // Formats compressés : blocs de 4x4 texels
+    UINT blockBytes = 0;
+    switch (desc.Format) {
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+    case DXGI_FORMAT_BC4_UNORM:
+    case DXGI_FORMAT_BC4_SNORM:
+      blockBytes = 8;
+      break;
+    case DXGI_FORMAT_BC2_UNORM:
+    case DXGI_FORMAT_BC2_UNORM_SRGB:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+    case DXGI_FORMAT_BC5_UNORM:
+    case DXGI_FORMAT_BC5_SNORM:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+      blockBytes = 16;
+      break;
+    default:
+      break;
+    }
+
+    UINT texelBytes = 4;
+    switch (desc.Format) {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+      texelBytes = 16;
+      break;
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R32G32_FLOAT:
+      texelBytes = 8;
+      break;
+    case DXGI_FORMAT_R8_UNORM:
+      texelBytes = 1;
+      break;
+    default:
+      break;
+    }
+
+    size_t size = 0;
+    for (UINT mip = 0; mip < desc.MipLevels; mip++) {
+      const UINT width = GetMipDimension(desc.Width, mip);
+      const UINT height = GetMipDimension(desc.Height, mip);
+      size += blockBytes > 0
+                ? size_t((width + 3) / 4) * ((height + 3) / 4) * blockBytes
+                : size_t(width) * height * texelBytes;
+    }
+    return size * desc.ArraySize;
+  }
+
   void Texture::LoadDDSTexture(const DispositifD3D11* pDispositif, bool enableMipmaps)
   {
     ID3D11Device*        pDevice = pDispositif->GetD3DDevice();
     ID3D11DeviceContext* pContext = pDispositif->GetImmediateContext();
 
+    // Le fichier est projeté en mémoire : les sous-ressources pointent directement dans la
+    // projection, sans copie intermédiaire du contenu dans un tampon
+    MappedFile file;
+    if (!file.Open(m_Filename)) {
+      ErrorLogger::Log(ConvertWStringToString(L"Echec de l'ouverture de la texture DDS: " + m_Filename));
+      return;
+    }
+
+    DDSTextureDesc      dds;
+    const DDSParseError parseError = ParseDDS(file.GetData(), file.GetSize(), dds);
+    if (parseError != DDSParseError::None && parseError != DDSParseError::UnsupportedFormat &&
+      parseError != DDSParseError::UnsupportedDimension) {
+      ErrorLogger::Log(ConvertWStringToString(L"Texture DDS invalide: " + m_Filename) + " (" +
+        GetDDSParseErrorMessage(parseError) + ")");
+      return;
+    }
+
+    // Chemin direct, sauf si les mips doivent être générés sur le GPU (texture non compressée
+    // sans mips) : le chargeur générique s'en charge, toujours depuis la projection
+    const bool needsMipGeneration = enableMipmaps && dds.mipCount == 1 && !dds.isBlockCompressed;
+    if (parseError == DDSParseError::None && !needsMipGeneration && CreateFromDDS(pDevice, file.GetData(), dds)) {
+      return;
+    }
+
     ComPtr<ID3D11Resource> resource;
-    HRESULT                hr = CreateDDSTextureFromFile(
+    HRESULT                hr = CreateDDSTextureFromMemory(
       pDevice,
       pContext,
-      m_Filename.c_str(),
+      file.GetData(),
+      file.GetSize(),
       &resource,
       m_Texture.GetAddressOf()
     );
@@ -122,6 +218,60 @@ namespace FrostFireEngine
     }
   }
 
+  bool Texture::CreateFromDDS(ID3D11Device* pDevice, const uint8_t* data, const DDSTextureDesc& dds)
+  {
+    std::vector<D3D11_SUBRESOURCE_DATA> initData(dds.subresources.size());
+    for (size_t i = 0; i < dds.subresources.size(); i++) {
+      initData[i].pSysMem = data + dds.subresources[i].offset;
+      initData[i].SysMemPitch = dds.subresources[i].rowPitch;
+      initData[i].SysMemSlicePitch = dds.subresources[i].slicePitch;
+    }
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = dds.width;
+    desc.Height = dds.height;
+    desc.MipLevels = dds.mipCount;
+    desc.ArraySize = dds.arraySize;
+    desc.Format = static_cast<DXGI_FORMAT>(dds.dxgiFormat);
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    desc.MiscFlags = dds.isCubeMap ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+
+    ComPtr<ID3D11Texture2D> pTexture2D;
+    HRESULT                 hr = pDevice->CreateTexture2D(&desc, initData.data(), &pTexture2D);
+    if (FAILED(hr)) return false;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    if (dds.isCubeMap && dds.arraySize > 6) {
+      srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBEARRAY;
+      srvDesc.TextureCubeArray.MipLevels = desc.MipLevels;
+      srvDesc.TextureCubeArray.NumCubes = desc.ArraySize / 6;
+    }
+    else if (dds.isCubeMap) {
+      srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+      srvDesc.TextureCube.MipLevels = desc.MipLevels;
+    }
+    else if (dds.arraySize > 1) {
+      srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+      srvDesc.Texture2DArray.MipLevels = desc.MipLevels;
+      srvDesc.Texture2DArray.ArraySize = desc.ArraySize;
+    }
+    else {
+      srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+      srvDesc.Texture2D.MipLevels = desc.MipLevels;
+    }
+
+    hr = pDevice->CreateShaderResourceView(pTexture2D.Get(), &srvDesc, m_Texture.ReleaseAndGetAddressOf());
+    if (FAILED(hr)) return false;
+
+    m_Width = dds.width;
+    m_Height = dds.height;
+    m_isCubeMap = dds.isCubeMap;
+    return true;
+  }
+
   void Texture::LoadWICTexture(DispositifD3D11* pDispositif, bool enableMipmaps)
   {
     ID3D11Device*        pDevice = pDispositif->GetD3DDevice();
@@ -192,4 +342,101 @@ namespace FrostFireEngine
       pContext->GenerateMips(m_Texture.Get());
     }
   }
+
+  size_t Texture::GetResidentSize() const
+  {
+    if (!m_Texture) return 0;
+    return GetMipChainSize(m_Width, m_Height, m_residentMip);
+  }
+
+  bool Texture::LoadMipTail(DispositifD3D11* pDispositif, UINT maxTailSize)
+  {
+    if (!pDispositif || !pDispositif->GetD3DDevice()) return false;
+
+    TextureMipChain chain;
+    {
+      ComInitializer comInit;
+      if (!DecodeMipChain(m_Filename, 0, maxTailSize, chain)) return false;
+    }
+
+    m_Width = chain.fullWidth;
+    m_Height = chain.fullHeight;
+    m_mipCount = GetMipCount(m_Width, m_Height);
+    m_tailMip = chain.firstMip;
+    m_desiredMip = m_tailMip;
+    // Une image qui tient dans la fin de chaîne est entièrement chargée : rien à streamer
+    m_isStreamed = m_tailMip > 0;
+
+    return CreateFromMipChain(pDispositif->GetD3DDevice(), chain);
+  }
+
+  bool Texture::CreateFromMipChain(ID3D11Device* pDevice, const TextureMipChain& chain)
+  {
+    const UINT levelCount = static_cast<UINT>(chain.levels.size());
+    if (levelCount == 0) return false;
+
+    std::vector<D3D11_SUBRESOURCE_DATA> initData(levelCount);
+    for (UINT level = 0; level < levelCount; level++) {
+      initData[level].pSysMem = chain.levels[level].data();
+      initData[level].SysMemPitch = GetMipDimension(m_Width, chain.firstMip + level) * 4;
+    }
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = GetMipDimension(m_Width, chain.firstMip);
+    desc.Height = GetMipDimension(m_Height, chain.firstMip);
+    desc.MipLevels = levelCount;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;  // source et destination des copies lors des évictions
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    ComPtr<ID3D11Texture2D> pTexture2D;
+    HRESULT                 hr = pDevice->CreateTexture2D(&desc, initData.data(), &pTexture2D);
+    if (FAILED(hr)) return false;
+
+    ComPtr<ID3D11ShaderResourceView> srv;
+    hr = pDevice->CreateShaderResourceView(pTexture2D.Get(), nullptr, &srv);
+    if (FAILED(hr)) return false;
+
+    m_Texture = srv;
+    m_residentMip = chain.firstMip;
+    return true;
+  }
+
+  bool Texture::DropTopMips(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, UINT newResidentMip)
+  {
+    if (!m_Texture || newResidentMip <= m_residentMip || newResidentMip >= m_mipCount) return false;
+
+    ComPtr<ID3D11Resource> oldResource;
+    m_Texture->GetResource(&oldResource);
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = GetMipDimension(m_Width, newResidentMip);
+    desc.Height = GetMipDimension(m_Height, newResidentMip);
+    desc.MipLevels = m_mipCount - newResidentMip;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    ComPtr<ID3D11Texture2D> pTexture2D;
+    HRESULT                 hr = pDevice->CreateTexture2D(&desc, nullptr, &pTexture2D);
+    if (FAILED(hr)) return false;
+
+    // Les mips conservés sont recopiés sur le GPU, sans repasser par le fichier
+    for (UINT mip = newResidentMip; mip < m_mipCount; mip++) {
+      pContext->CopySubresourceRegion(pTexture2D.Get(), mip - newResidentMip, 0, 0, 0,
+                                      oldResource.Get(), mip - m_residentMip, nullptr);
+    }
+
+    ComPtr<ID3D11ShaderResourceView> srv;
+    hr = pDevice->CreateShaderResourceView(pTexture2D.Get(), nullptr, &srv);
+    if (FAILED(hr)) return false;
+
+    m_Texture = srv;
+    m_residentMip = newResidentMip;
+    return true;
+  }
 }
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "dispositifd3d11.h"
+#include <cstdint>
 #include <string>
 #include <wrl/client.h>
 #include <d3d11.h>
@@ -8,6 +9,9 @@ namespace FrostFireEngine
 {
   using Microsoft::WRL::ComPtr;
 
+  struct TextureMipChain;
+  struct DDSTextureDesc;
+
   class Texture {
   public:
     Texture();
@@ -34,7 +38,45 @@ namespace FrostFireEngine
     [[nodiscard]] UINT GetWidth() const;
     [[nodiscard]] UINT GetHeight() const;
 
+    // Texture streamée par le TextureManager : seuls les mips [GetResidentMip(), GetMipCount())
+    // sont sur le GPU ; GetWidth()/GetHeight() restent la taille du mip 0
+    [[nodiscard]] bool IsStreamed() const
+    {
+      return m_isStreamed;
+    }
+    [[nodiscard]] UINT GetMipCount() const
+    {
+      return m_mipCount;
+    }
+    [[nodiscard]] UINT GetResidentMip() const
+    {
+      return m_residentMip;
+    }
+    [[nodiscard]] size_t GetResidentSize() const;  // octets sur le GPU d'une texture streamée
+
+    // Octets occupés sur le GPU, tous mips et faces compris
+    [[nodiscard]] size_t GetGPUSize() const;
+
+    // Nombre de TextureHandle qui référencent la texture
+    [[nodiscard]] uint32_t GetRefCount() const
+    {
+      return m_refCount;
+    }
+
+    // Appelé par les renderers à chaque affichage : taille à l'écran en fraction de la hauteur
+    // de la vue (1 = plein écran), dont le TextureManager déduit le mip nécessaire
+    void RequestScreenSize(float screenSize)
+    {
+      if (screenSize > m_requestedScreenSize) {
+        m_requestedScreenSize = screenSize;
+      }
+    }
+
   private:
+    friend class TextureManager;
+    friend class TextureHandle;
+
+    static constexpr UINT NO_PENDING_MIP = UINT32_MAX;
     class ComInitializer {
     public:
       ComInitializer()
@@ -48,12 +90,29 @@ namespace FrostFireEngine
     };
 
     void LoadDDSTexture(const DispositifD3D11* pDispositif, bool enableMipmaps);
+    bool CreateFromDDS(ID3D11Device* pDevice, const uint8_t* data, const DDSTextureDesc& dds);
     void LoadWICTexture(DispositifD3D11* pDispositif, bool enableMipmaps);
 
+    // Streaming, piloté par le TextureManager sur le thread principal
+    bool LoadMipTail(DispositifD3D11* pDispositif, UINT maxTailSize);
+    bool CreateFromMipChain(ID3D11Device* pDevice, const TextureMipChain& chain);
+    bool DropTopMips(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, UINT newResidentMip);
+
     std::wstring                     m_Filename = L"";
     ComPtr<ID3D11ShaderResourceView> m_Texture;
     UINT                             m_Width = 0;
     UINT                             m_Height = 0;
     bool                             m_isCubeMap = false; // Indique si c'est une cube map
+
+    bool     m_isStreamed = false;
+    UINT     m_mipCount = 1;
+    UINT     m_residentMip = 0;
+    UINT     m_tailMip = 0;      // début de la fin de chaîne, toujours résidente
+    UINT     m_desiredMip = 0;   // mip demandé par les renderers à la dernière frame
+    UINT     m_pendingMip = NO_PENDING_MIP;
+    float    m_requestedScreenSize = 0.0f;
+    uint64_t m_lastUsedFrame = 0;
+
+    uint32_t m_refCount = 0;
   };
 }
@@ -1,40 +1,273 @@
 #include "TextureManager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <cwctype>
 
 #include "DispositifD3D11.h"
+#include "SceneManager.h"
 #include "Texture.h"
+#include "Textures/TextureCooker.h"
 
 namespace FrostFireEngine
 {
+  #undef min
+  #undef max
+
+  namespace
+  {
+    bool IsStreamableFile(const std::wstring& filename)
+    {
+      const size_t dot = filename.find_last_of(L'.');
+      return dot != std::wstring::npos && _wcsicmp(filename.c_str() + dot + 1, L"dds") != 0;
+    }
+
+    // Casse et séparateurs normalisés, « ./ » de tête ignoré
+    std::wstring_view TrimCurrentDirectory(std::wstring_view filename)
+    {
+      while (filename.size() >= 2 && filename[0] == L'.' && (filename[1] == L'/' || filename[1] == L'\\')) {
+        filename.remove_prefix(2);
+      }
+      return filename;
+    }
+
+    wchar_t NormalizePathChar(wchar_t c)
+    {
+      return c == L'\\' ? L'/' : static_cast<wchar_t>(towlower(c));
+    }
+
+    [[maybe_unused]] bool SamePath(std::wstring_view a, std::wstring_view b)
+    {
+      return std::ranges::equal(TrimCurrentDirectory(a), TrimCurrentDirectory(b), [](wchar_t x, wchar_t y) {
+        return NormalizePathChar(x) == NormalizePathChar(y);
+      });
+    }
+  }
+
+  uint64_t TextureManager::HashPath(std::wstring_view filename)
+  {
+    // FNV-1a 64 bits sur le chemin normalisé, sans copie
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const wchar_t c : TrimCurrentDirectory(filename)) {
+      hash ^= static_cast<uint64_t>(NormalizePathChar(c));
+      hash *= 0x100000001B3ull;
+    }
+    return hash;
+  }
+
   Texture* TextureManager::GetNewTexture(const std::wstring& filename, DispositifD3D11* pDispositif)
   {
     // Vérifie si la texture est déjà dans la liste
-    Texture* pTexture = GetTexture(filename);
+    const uint64_t hash = HashPath(filename);
+    const auto     it = ListeTextures.find(hash);
+    Texture*       pTexture = it != ListeTextures.end() ? it->second.get() : nullptr;
+    assert(!pTexture || SamePath(pTexture->GetFilename(), filename));
     // Si non, crée-la
     if (!pTexture) {
-      auto texture = std::make_unique<Texture>(filename, pDispositif);
+      std::unique_ptr<Texture> texture;
+      const std::wstring       cookedPath = FindCookedTexture(filename);
+      if (!cookedPath.empty()) {
+        // Version cuite hors ligne : compressée BC, mips déjà calculés
+        texture = std::make_unique<Texture>(cookedPath, pDispositif, false);
+        texture->m_Filename = filename;
+      }
+      else if (IsStreamableFile(filename)) {
+        texture = std::make_unique<Texture>();
+        texture->m_Filename = filename;
+        texture->LoadMipTail(pDispositif, MIP_TAIL_SIZE);
+        if (texture->IsStreamed()) {
+          m_stats.residentBytes += texture->GetResidentSize();
+          m_stats.streamedTextures++;
+        }
+      }
+      else {
+        texture = std::make_unique<Texture>(filename, pDispositif);
+      }
       pTexture = texture.get();
       // Ajoute la texture à la liste
-      ListeTextures.push_back(std::move(texture));
+      ListeTextures.emplace(hash, std::move(texture));
     }
     assert(pTexture);
+
+    if (Scene* scene = SceneManager::GetInstance().GetContextScene()) {
+      scene->ReferenceTexture(pTexture);
+    }
     return pTexture;
   }
 
-  Texture* TextureManager::GetTexture(const std::wstring& filename) const
+  Texture* TextureManager::GetTexture(std::wstring_view filename) const
+  {
+    const auto it = ListeTextures.find(HashPath(filename));
+    if (it == ListeTextures.end()) return nullptr;
+
+    assert(SamePath(it->second->GetFilename(), filename));
+    return it->second.get();
+  }
+
+  void TextureManager::AddTexture(std::unique_ptr<Texture> texture)
+  {
+    texture->m_refCount++;
+    const uint64_t hash = HashPath(texture->GetFilename());
+    ListeTextures.insert_or_assign(hash, std::move(texture));
+  }
+
+  size_t TextureManager::PurgeUnused()
   {
-    for (const auto& texture : ListeTextures) {
-      if (texture->GetFilename() == filename) {
-        return texture.get();
+    size_t freed = 0;
+    for (auto it = ListeTextures.begin(); it != ListeTextures.end();) {
+      Texture& texture = *it->second;
+      if (texture.m_refCount > 0) {
+        ++it;
+        continue;
       }
+
+      // Un décodage en cours ne doit pas revenir vers une texture détruite
+      if (texture.m_isStreamed) {
+        m_streamer.Cancel(&texture);
+        m_stats.residentBytes -= texture.GetResidentSize();
+        m_stats.streamedTextures--;
+      }
+      freed += texture.GetGPUSize();
+      it = ListeTextures.erase(it);
     }
-    return nullptr;
+    return freed;
   }
 
-  void TextureManager::AddTexture(std::unique_ptr<Texture> texture)
+  size_t TextureManager::GetTotalGPUSize() const
+  {
+    size_t size = 0;
+    for (const auto& [hash, texture] : ListeTextures) {
+      size += texture->GetGPUSize();
+    }
+    return size;
+  }
+
+  UINT TextureManager::ComputeDesiredMip(const Texture& texture, float screenPixels) const
+  {
+    // Un texel par pixel : chaque mip divise par deux la taille utile
+    const float textureSize = static_cast<float>(std::max(texture.m_Width, texture.m_Height));
+    if (screenPixels >= textureSize) return 0;
+    if (screenPixels < 1.0f) return texture.m_tailMip;
+
+    const UINT mip = static_cast<UINT>(std::floor(std::log2(textureSize / screenPixels)));
+    return std::min(mip, texture.m_tailMip);
+  }
+
+  void TextureManager::UpdateStreaming(DispositifD3D11* pDispositif)
+  {
+    if (!pDispositif || m_stats.streamedTextures == 0) return;
+
+    m_frame++;
+    const float viewportHeight = pDispositif->GetViewportHeight();
+
+    // Demande de la frame écoulée ; une texture non affichée ne demande que sa fin de chaîne
+    m_stats.requestedBytes = 0;
+    for (const auto& [hash, texture] : ListeTextures) {
+      if (!texture->m_isStreamed) continue;
+
+      if (texture->m_requestedScreenSize > 0.0f) {
+        texture->m_lastUsedFrame = m_frame;
+        texture->m_desiredMip = ComputeDesiredMip(*texture, texture->m_requestedScreenSize * viewportHeight);
+        texture->m_requestedScreenSize = 0.0f;
+      }
+      else {
+        texture->m_desiredMip = texture->m_tailMip;
+      }
+      m_stats.requestedBytes += GetMipChainSize(texture->m_Width, texture->m_Height, texture->m_desiredMip);
+    }
+
+    // Mips chargés en arrière-plan
+    m_streamer.TakeResults(m_streamResults);
+    for (auto& result : m_streamResults) {
+      Texture& texture = *result.texture;
+      texture.m_pendingMip = Texture::NO_PENDING_MIP;
+      if (!result.success || result.chain.firstMip >= texture.m_residentMip) continue;
+
+      const size_t currentSize = texture.GetResidentSize();
+      const size_t growth = GetMipChainSize(texture.m_Width, texture.m_Height, result.chain.firstMip) -
+        currentSize;
+      if (m_stats.residentBytes + growth > m_stats.budgetBytes) {
+        EvictStreamedMips(pDispositif, m_stats.residentBytes + growth - m_stats.budgetBytes, &texture);
+        // Toujours pas de place : la demande sera renouvelée quand le budget le permettra
+        if (m_stats.residentBytes + growth > m_stats.budgetBytes) continue;
+      }
+
+      if (texture.CreateFromMipChain(pDispositif->GetD3DDevice(), result.chain)) {
+        m_stats.residentBytes += texture.GetResidentSize() - currentSize;
+        m_stats.completedLoads++;
+      }
+    }
+    m_streamResults.clear();
+
+    // Place récupérable sur les textures qui ne sont plus affichées
+    size_t reclaimable = 0;
+    for (const auto& [hash, texture] : ListeTextures) {
+      if (texture->m_isStreamed && texture->m_lastUsedFrame < m_frame) {
+        reclaimable += texture->GetResidentSize() -
+          GetMipChainSize(texture->m_Width, texture->m_Height, texture->m_tailMip);
+      }
+    }
+
+    // Nouvelles demandes, seulement si elles peuvent tenir dans le budget
+    for (const auto& [hash, texture] : ListeTextures) {
+      if (!texture->m_isStreamed || texture->m_pendingMip != Texture::NO_PENDING_MIP ||
+        texture->m_desiredMip >= texture->m_residentMip) {
+        continue;
+      }
+
+      const size_t growth = GetMipChainSize(texture->m_Width, texture->m_Height, texture->m_desiredMip) -
+        texture->GetResidentSize();
+      if (m_stats.residentBytes + growth > m_stats.budgetBytes + reclaimable) continue;
+
+      texture->m_pendingMip = texture->m_desiredMip;
+      m_streamer.Request(texture.get(), texture->m_Filename, texture->m_desiredMip);
+    }
+
+    // Budget réduit entre deux frames
+    if (m_stats.residentBytes > m_stats.budgetBytes) {
+      EvictStreamedMips(pDispositif, m_stats.residentBytes - m_stats.budgetBytes, nullptr);
+    }
+
+    m_stats.pendingLoads = static_cast<uint32_t>(m_streamer.GetPendingCount());
+  }
+
+  size_t TextureManager::EvictStreamedMips(DispositifD3D11* pDispositif, size_t bytesNeeded,
+                                           const Texture* keep)
   {
-    ListeTextures.push_back(std::move(texture));
+    std::vector<Texture*> candidates;
+    for (const auto& [hash, texture] : ListeTextures) {
+      if (texture->m_isStreamed && texture.get() != keep && texture->m_residentMip < texture->m_tailMip) {
+        candidates.push_back(texture.get());
+      }
+    }
+    std::ranges::sort(candidates, [](const Texture* a, const Texture* b) {
+      return a->m_lastUsedFrame < b->m_lastUsedFrame;
+    });
+
+    size_t freed = 0;
+    for (Texture* texture : candidates) {
+      if (freed >= bytesNeeded) break;
+
+      // Une texture affichée à cette frame garde au moins le mip qu'elle demande
+      const UINT lowestMip = texture->m_lastUsedFrame == m_frame ? texture->m_desiredMip : texture->m_tailMip;
+      const size_t currentSize = texture->GetResidentSize();
+
+      UINT newMip = texture->m_residentMip;
+      while (newMip < lowestMip &&
+        currentSize - GetMipChainSize(texture->m_Width, texture->m_Height, newMip) < bytesNeeded - freed) {
+        newMip++;
+      }
+      if (newMip == texture->m_residentMip) continue;
+
+      if (texture->DropTopMips(pDispositif->GetD3DDevice(), pDispositif->GetImmediateContext(), newMip)) {
+        freed += currentSize - texture->GetResidentSize();
+        m_stats.evictions++;
+      }
+    }
+
+    m_stats.residentBytes -= freed;
+    return freed;
   }
 
   TextureManager::~TextureManager()
@@ -1,23 +1,138 @@
 ﻿#pragma once
 #include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "Singleton.h"
 #include "Texture.h"
+#include "Textures/TextureStreamer.h"
 
 namespace FrostFireEngine
 {
   class DispositifD3D11;
 
+  // Référence comptée sur une texture du TextureManager. Quand la dernière est libérée, la
+  // texture reste chargée jusqu'au prochain PurgeUnused, ce qui laisse une scène suivante la
+  // reprendre sans la recharger.
+  class TextureHandle {
+  public:
+    TextureHandle() = default;
+
+    explicit TextureHandle(Texture* texture)
+      : m_texture(texture)
+    {
+      if (m_texture) m_texture->m_refCount++;
+    }
+
+    TextureHandle(const TextureHandle& other)
+      : TextureHandle(other.m_texture)
+    {
+    }
+
+    TextureHandle(TextureHandle&& other) noexcept
+      : m_texture(std::exchange(other.m_texture, nullptr))
+    {
+    }
+
+    TextureHandle& operator=(TextureHandle other) noexcept
+    {
+      std::swap(m_texture, other.m_texture);
+      return *this;
+    }
+
+    ~TextureHandle()
+    {
+      if (m_texture) m_texture->m_refCount--;
+    }
+
+    [[nodiscard]] Texture* Get() const
+    {
+      return m_texture;
+    }
+    Texture* operator->() const
+    {
+      return m_texture;
+    }
+    explicit operator bool() const
+    {
+      return m_texture != nullptr;
+    }
+
+  private:
+    Texture* m_texture = nullptr;
+  };
+
+  // Textures référencées par une scène, de la plus lourde à la plus légère
+  struct TextureMemoryReport {
+    struct Entry {
+      std::wstring filename;
+      size_t       gpuBytes;
+      uint32_t     refCount;  // > 1 : partagée avec une autre scène ou le gestionnaire
+    };
+
+    std::vector<Entry> textures;
+    size_t             totalBytes = 0;
+    size_t             sharedBytes = 0;  // part qui ne sera pas libérée avec la scène
+  };
+
   class TextureManager : public CSingleton<TextureManager>
   {
     friend class CSingleton<TextureManager>;
 
   public:
+    // Statistiques du streaming, en octets de mips RGBA8 sur le GPU
+    struct StreamingStats {
+      size_t   residentBytes = 0;
+      size_t   requestedBytes = 0;  // taille des textures streamées au mip demandé par les renderers
+      size_t   budgetBytes = 0;
+      uint32_t streamedTextures = 0;
+      uint32_t pendingLoads = 0;
+      uint32_t completedLoads = 0;  // cumulé
+      uint32_t evictions = 0;       // textures réduites pour tenir le budget, cumulé
+    };
+
+    // Plus grand côté de la fin de chaîne de mips, chargée dès GetNewTexture
+    static constexpr UINT MIP_TAIL_SIZE = 64;
+    static constexpr size_t DEFAULT_STREAMING_BUDGET = 256ull * 1024 * 1024;
+
+    // Une version cuite à jour (voir TextureCooker) est chargée à la place de la source.
+    // Sinon, les images WIC (PNG, JPG...) sont streamées : seule la fin de chaîne est chargée ici,
+    // les mips supérieurs suivent en arrière-plan selon la demande. Les DDS sont chargés entiers.
+    // La scène de contexte du SceneManager garde une référence sur la texture renvoyée.
     Texture* GetNewTexture(const std::wstring& filename, DispositifD3D11* pDispositif);
-    Texture* GetTexture(const std::wstring& filename) const;
+    // Chemins comparés sans tenir compte de la casse ni du séparateur
+    Texture* GetTexture(std::wstring_view filename) const;
+    // Textures créées à la main (fallbacks) : le gestionnaire les garde jusqu'à sa destruction
     void AddTexture(std::unique_ptr<Texture> texture);
 
+    // Libère les textures qui ne sont plus référencées ; appelé après chaque changement de
+    // scène. Renvoie les octets GPU libérés.
+    size_t PurgeUnused();
+
+    size_t GetTextureCount() const
+    {
+      return ListeTextures.size();
+    }
+    size_t GetTotalGPUSize() const;
+
+    static uint64_t HashPath(std::wstring_view filename);
+
+    // Une fois par frame, après le rendu : intègre les mips chargés, envoie les nouvelles
+    // demandes au thread de chargement et réduit les textures les moins récemment utilisées
+    // si le budget est dépassé
+    void UpdateStreaming(DispositifD3D11* pDispositif);
+
+    void SetStreamingBudget(size_t bytes)
+    {
+      m_stats.budgetBytes = bytes;
+    }
+    const StreamingStats& GetStreamingStats() const
+    {
+      return m_stats;
+    }
+
     ~TextureManager() override;
     TextureManager() = default;
 
@@ -25,6 +140,18 @@ namespace FrostFireEngine
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
 
-    std::vector<std::unique_ptr<Texture>> ListeTextures;
+    UINT ComputeDesiredMip(const Texture& texture, float screenPixels) const;
+    // Libère au moins bytesNeeded octets en retirant des mips supérieurs, des textures les
+    // moins récemment utilisées aux plus récentes ; renvoie les octets libérés
+    size_t EvictStreamedMips(DispositifD3D11* pDispositif, size_t bytesNeeded, const Texture* keep);
+
+    // Indexées par HashPath du chemin
+    std::unordered_map<uint64_t, std::unique_ptr<Texture>> ListeTextures;
+
+    // Le thread de chargement ne travaille que sur des copies des noms de fichiers
+    TextureStreamer                      m_streamer;
+    std::vector<TextureStreamer::Result> m_streamResults;
+    StreamingStats                       m_stats{.budgetBytes = DEFAULT_STREAMING_BUDGET};
+    uint64_t                             m_frame = 0;
   };
 }
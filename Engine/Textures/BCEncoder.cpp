@@ -0,0 +1,424 @@
+#include "BCEncoder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <execution>
+#include <numeric>
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  namespace
+  {
+    // Axe principal des texels (itérations de puissance sur la covariance), sur les
+    // `channels` premières composantes
+    template <int channels>
+    void ComputePrincipalAxis(const uint8_t* texels, float (&mean)[channels], float (&axis)[channels])
+    {
+      for (int c = 0; c < channels; c++) {
+        mean[c] = 0.0f;
+        for (int i = 0; i < 16; i++) mean[c] += texels[i * 4 + c];
+        mean[c] /= 16.0f;
+      }
+
+      float covariance[channels][channels] = {};
+      for (int i = 0; i < 16; i++) {
+        float d[channels];
+        for (int c = 0; c < channels; c++) d[c] = texels[i * 4 + c] - mean[c];
+        for (int a = 0; a < channels; a++) {
+          for (int b = 0; b < channels; b++) covariance[a][b] += d[a] * d[b];
+        }
+      }
+
+      // Départ sur la composante la plus dispersée
+      int start = 0;
+      for (int c = 1; c < channels; c++) {
+        if (covariance[c][c] > covariance[start][start]) start = c;
+      }
+      for (int c = 0; c < channels; c++) axis[c] = c == start ? 1.0f : 0.0f;
+
+      for (int iteration = 0; iteration < 8; iteration++) {
+        float next[channels] = {};
+        for (int a = 0; a < channels; a++) {
+          for (int b = 0; b < channels; b++) next[a] += covariance[a][b] * axis[b];
+        }
+        float length = 0.0f;
+        for (int c = 0; c < channels; c++) length += next[c] * next[c];
+        if (length < 1e-6f) break;
+        length = 1.0f / std::sqrt(length);
+        for (int c = 0; c < channels; c++) axis[c] = next[c] * length;
+      }
+    }
+
+    // Texels extrêmes le long de l'axe principal
+    template <int channels>
+    void FindExtremes(const uint8_t* texels, int& minIndex, int& maxIndex)
+    {
+      float mean[channels];
+      float axis[channels];
+      ComputePrincipalAxis<channels>(texels, mean, axis);
+
+      float minProjection = 1e30f;
+      float maxProjection = -1e30f;
+      minIndex = 0;
+      maxIndex = 0;
+      for (int i = 0; i < 16; i++) {
+        float projection = 0.0f;
+        for (int c = 0; c < channels; c++) projection += (texels[i * 4 + c] - mean[c]) * axis[c];
+        if (projection < minProjection) {
+          minProjection = projection;
+          minIndex = i;
+        }
+        if (projection > maxProjection) {
+          maxProjection = projection;
+          maxIndex = i;
+        }
+      }
+    }
+
+    uint16_t PackRGB565(const float* color)
+    {
+      const auto quantize = [](float value, int maxValue) {
+        return static_cast<uint16_t>(std::clamp(static_cast<int>(value * maxValue / 255.0f + 0.5f), 0, maxValue));
+      };
+      return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) |
+        quantize(color[2], 31));
+    }
+
+    void UnpackRGB565(uint16_t packed, int* color)
+    {
+      const int r = (packed >> 11) & 31;
+      const int g = (packed >> 5) & 63;
+      const int b = packed & 31;
+      color[0] = (r << 3) | (r >> 2);
+      color[1] = (g << 2) | (g >> 4);
+      color[2] = (b << 3) | (b >> 2);
+    }
+
+    // Indices BC1 4 couleurs pour c0 > c1 ; renvoie l'erreur quadratique
+    int ComputeColorIndices(const uint8_t* texels, uint16_t c0, uint16_t c1, uint32_t& indices)
+    {
+      int palette[4][3];
+      UnpackRGB565(c0, palette[0]);
+      UnpackRGB565(c1, palette[1]);
+      for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+      }
+
+      indices = 0;
+      int totalError = 0;
+      for (int i = 0; i < 16; i++) {
+        int bestIndex = 0;
+        int bestError = INT32_MAX;
+        for (int p = 0; p < 4; p++) {
+          int error = 0;
+          for (int c = 0; c < 3; c++) {
+            const int d = texels[i * 4 + c] - palette[p][c];
+            error += d * d;
+          }
+          if (error < bestError) {
+            bestError = error;
+            bestIndex = p;
+          }
+        }
+        indices |= uint32_t(bestIndex) << (i * 2);
+        totalError += bestError;
+      }
+      return totalError;
+    }
+
+    void WriteColorBlock(uint16_t c0, uint16_t c1, uint32_t indices, uint8_t* out)
+    {
+      out[0] = static_cast<uint8_t>(c0);
+      out[1] = static_cast<uint8_t>(c0 >> 8);
+      out[2] = static_cast<uint8_t>(c1);
+      out[3] = static_cast<uint8_t>(c1 >> 8);
+      memcpy(out + 4, &indices, 4);
+    }
+
+    // Mode 4 couleurs : c0 > c1
+    void OrderColorEndpoints(uint16_t& c0, uint16_t& c1)
+    {
+      if (c0 < c1) std::swap(c0, c1);
+    }
+
+    // Extrémités par moindres carrés à partir des indices choisis
+    bool RefineColorEndpoints(const uint8_t* texels, uint32_t indices, float* color0, float* color1)
+    {
+      static constexpr float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+      float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+      float ax[3] = {};
+      float bx[3] = {};
+      for (int i = 0; i < 16; i++) {
+        const float a = weights[(indices >> (i * 2)) & 3];
+        const float b = 1.0f - a;
+        aa += a * a;
+        bb += b * b;
+        ab += a * b;
+        for (int c = 0; c < 3; c++) {
+          ax[c] += a * texels[i * 4 + c];
+          bx[c] += b * texels[i * 4 + c];
+        }
+      }
+
+      const float determinant = aa * bb - ab * ab;
+      if (std::abs(determinant) < 1e-6f) return false;
+
+      const float inverse = 1.0f / determinant;
+      for (int c = 0; c < 3; c++) {
+        color0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inverse, 0.0f, 255.0f);
+        color1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inverse, 0.0f, 255.0f);
+      }
+      return true;
+    }
+
+    // Bloc couleur BC1, toujours en mode 4 couleurs (aussi valide dans un bloc BC3)
+    void EncodeColorBlock(const uint8_t* texels, uint8_t* out)
+    {
+      int minIndex;
+      int maxIndex;
+      FindExtremes<3>(texels, minIndex, maxIndex);
+
+      float color0[3];
+      float color1[3];
+      for (int c = 0; c < 3; c++) {
+        // Légèrement rentrées : les extrêmes sont mieux servis par les couleurs interpolées
+        const float high = texels[maxIndex * 4 + c];
+        const float low = texels[minIndex * 4 + c];
+        const float inset = (high - low) / 16.0f;
+        color0[c] = high - inset;
+        color1[c] = low + inset;
+      }
+
+      uint16_t c0 = PackRGB565(color0);
+      uint16_t c1 = PackRGB565(color1);
+      OrderColorEndpoints(c0, c1);
+      if (c0 == c1) {
+        WriteColorBlock(c0, c1, 0, out);
+        return;
+      }
+
+      uint32_t indices;
+      int      error = ComputeColorIndices(texels, c0, c1, indices);
+
+      float refined0[3];
+      float refined1[3];
+      if (RefineColorEndpoints(texels, indices, refined0, refined1)) {
+        uint16_t r0 = PackRGB565(refined0);
+        uint16_t r1 = PackRGB565(refined1);
+        OrderColorEndpoints(r0, r1);
+        if (r0 != r1) {
+          uint32_t refinedIndices;
+          const int refinedError = ComputeColorIndices(texels, r0, r1, refinedIndices);
+          if (refinedError < error) {
+            c0 = r0;
+            c1 = r1;
+            indices = refinedIndices;
+            error = refinedError;
+          }
+        }
+      }
+
+      WriteColorBlock(c0, c1, indices, out);
+    }
+
+    // Bloc BC4 (8 octets) sur une composante, en mode 8 valeurs
+    void EncodeBC4Block(const uint8_t* texels, int channel, uint8_t* out)
+    {
+      uint8_t low = 255;
+      uint8_t high = 0;
+      for (int i = 0; i < 16; i++) {
+        low = std::min(low, texels[i * 4 + channel]);
+        high = std::max(high, texels[i * 4 + channel]);
+      }
+
+      out[0] = high;
+      out[1] = low;
+
+      int palette[8] = {high, low};
+      for (int i = 2; i < 8; i++) {
+        palette[i] = ((8 - i) * high + (i - 1) * low) / 7;
+      }
+
+      uint64_t indices = 0;
+      if (high != low) {
+        for (int i = 0; i < 16; i++) {
+          const int value = texels[i * 4 + channel];
+          int       bestIndex = 0;
+          int       bestError = INT32_MAX;
+          for (int p = 0; p < 8; p++) {
+            const int error = std::abs(value - palette[p]);
+            if (error < bestError) {
+              bestError = error;
+              bestIndex = p;
+            }
+          }
+          indices |= uint64_t(bestIndex) << (i * 3);
+        }
+      }
+
+      for (int i = 0; i < 6; i++) {
+        out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+      }
+    }
+
+    class BitWriter {
+    public:
+      explicit BitWriter(uint8_t* data)
+        : m_data(data)
+      {
+        memset(m_data, 0, 16);
+      }
+
+      void Write(uint32_t value, int bitCount)
+      {
+        for (int bit = 0; bit < bitCount; bit++, m_position++) {
+          if ((value >> bit) & 1) {
+            m_data[m_position >> 3] |= static_cast<uint8_t>(1 << (m_position & 7));
+          }
+        }
+      }
+
+    private:
+      uint8_t* m_data;
+      int      m_position = 0;
+    };
+
+    // Extrémité BC7 mode 6 : 7 bits par composante plus un bit p commun
+    void QuantizeBC7Endpoint(const uint8_t* texel, uint8_t (&quantized)[4], uint8_t& pBit)
+    {
+      int bestError = INT32_MAX;
+      for (uint8_t p = 0; p < 2; p++) {
+        uint8_t candidate[4];
+        int     error = 0;
+        for (int c = 0; c < 4; c++) {
+          candidate[c] = static_cast<uint8_t>(std::clamp((texel[c] - p + 1) / 2, 0, 127));
+          const int d = ((candidate[c] << 1) | p) - texel[c];
+          error += d * d;
+        }
+        if (error < bestError) {
+          bestError = error;
+          pBit = p;
+          memcpy(quantized, candidate, 4);
+        }
+      }
+    }
+  }
+
+  void EncodeBC1Block(const uint8_t* texels, uint8_t* out)
+  {
+    EncodeColorBlock(texels, out);
+  }
+
+  void EncodeBC3Block(const uint8_t* texels, uint8_t* out)
+  {
+    EncodeBC4Block(texels, 3, out);
+    EncodeColorBlock(texels, out + 8);
+  }
+
+  void EncodeBC5Block(const uint8_t* texels, uint8_t* out)
+  {
+    EncodeBC4Block(texels, 0, out);
+    EncodeBC4Block(texels, 1, out + 8);
+  }
+
+  void EncodeBC7Block(const uint8_t* texels, uint8_t* out)
+  {
+    static constexpr int weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    int minIndex;
+    int maxIndex;
+    FindExtremes<4>(texels, minIndex, maxIndex);
+
+    uint8_t endpoints[2][4];
+    uint8_t pBits[2];
+    QuantizeBC7Endpoint(texels + minIndex * 4, endpoints[0], pBits[0]);
+    QuantizeBC7Endpoint(texels + maxIndex * 4, endpoints[1], pBits[1]);
+
+    int palette[16][4];
+    for (int c = 0; c < 4; c++) {
+      const int e0 = (endpoints[0][c] << 1) | pBits[0];
+      const int e1 = (endpoints[1][c] << 1) | pBits[1];
+      for (int i = 0; i < 16; i++) {
+        palette[i][c] = ((64 - weights[i]) * e0 + weights[i] * e1 + 32) >> 6;
+      }
+    }
+
+    uint8_t indices[16];
+    for (int i = 0; i < 16; i++) {
+      int bestError = INT32_MAX;
+      for (int p = 0; p < 16; p++) {
+        int error = 0;
+        for (int c = 0; c < 4; c++) {
+          const int d = texels[i * 4 + c] - palette[p][c];
+          error += d * d;
+        }
+        if (error < bestError) {
+          bestError = error;
+          indices[i] = static_cast<uint8_t>(p);
+        }
+      }
+    }
+
+    // Le bit de poids fort de l'index du premier texel est implicite (0)
+    if (indices[0] & 8) {
+      std::swap(endpoints[0], endpoints[1]);
+      std::swap(pBits[0], pBits[1]);
+      for (auto& index : indices) index = static_cast<uint8_t>(15 - index);
+    }
+
+    BitWriter writer(out);
+    writer.Write(1 << 6, 7);  // mode 6
+    for (int c = 0; c < 4; c++) {
+      writer.Write(endpoints[0][c], 7);
+      writer.Write(endpoints[1][c], 7);
+    }
+    writer.Write(pBits[0], 1);
+    writer.Write(pBits[1], 1);
+    writer.Write(indices[0], 3);
+    for (int i = 1; i < 16; i++) {
+      writer.Write(indices[i], 4);
+    }
+  }
+
+  void CompressBC(BCFormat                    format,
+                  const std::vector<uint8_t>& rgba,
+                  uint32_t                    width,
+                  uint32_t                    height,
+                  std::vector<uint8_t>&       out)
+  {
+    const uint32_t blockColumns = (width + 3) / 4;
+    const uint32_t blockRows = (height + 3) / 4;
+    const size_t   blockSize = GetBCBlockSize(format);
+    out.resize(GetBCLevelSize(format, width, height));
+
+    using EncodeFunction = void (*)(const uint8_t*, uint8_t*);
+    const EncodeFunction encode = format == BCFormat::BC1 ? EncodeBC1Block
+                                : format == BCFormat::BC3 ? EncodeBC3Block
+                                : format == BCFormat::BC5 ? EncodeBC5Block
+                                : EncodeBC7Block;
+
+    std::vector<uint32_t> rows(blockRows);
+    std::iota(rows.begin(), rows.end(), 0u);
+
+    // Chaque ligne de blocs écrit sa propre plage de out
+    std::for_each(std::execution::par, rows.begin(), rows.end(), [&](uint32_t blockY) {
+      uint8_t texels[16 * 4];
+      for (uint32_t blockX = 0; blockX < blockColumns; blockX++) {
+        for (uint32_t y = 0; y < 4; y++) {
+          const uint32_t sourceY = std::min(blockY * 4 + y, height - 1);
+          for (uint32_t x = 0; x < 4; x++) {
+            const uint32_t sourceX = std::min(blockX * 4 + x, width - 1);
+            memcpy(&texels[(y * 4 + x) * 4], &rgba[(size_t(sourceY) * width + sourceX) * 4], 4);
+          }
+        }
+        encode(texels, &out[(size_t(blockY) * blockColumns + blockX) * blockSize]);
+      }
+    });
+  }
+}
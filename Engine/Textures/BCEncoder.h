@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FrostFireEngine
+{
+  enum class BCFormat : uint8_t {
+    BC1,  // RGB, 4 bits par texel
+    BC3,  // RGBA, alpha BC4 + couleur BC1, 8 bits par texel
+    BC5,  // RG (cartes de normales), deux blocs BC4, 8 bits par texel
+    BC7   // RGBA, mode 6 seul, 8 bits par texel
+  };
+
+  // Octets par bloc de 4x4 texels
+  constexpr size_t GetBCBlockSize(BCFormat format)
+  {
+    return format == BCFormat::BC1 ? 8 : 16;
+  }
+
+  // Taille compressée d'un niveau ; les bords incomplets occupent un bloc entier
+  constexpr size_t GetBCLevelSize(BCFormat format, uint32_t width, uint32_t height)
+  {
+    return size_t((width + 3) / 4) * ((height + 3) / 4) * GetBCBlockSize(format);
+  }
+
+  // Compresse une image RGBA8 ; les blocs de bord répètent le dernier texel.
+  // Les lignes de blocs sont réparties sur tous les cœurs.
+  void CompressBC(BCFormat                   format,
+                  const std::vector<uint8_t>& rgba,
+                  uint32_t                    width,
+                  uint32_t                    height,
+                  std::vector<uint8_t>&       out);
+
+  // Encodage d'un bloc : 16 texels RGBA8 dans l'ordre des lignes
+  void EncodeBC1Block(const uint8_t* texels, uint8_t* out);
+  void EncodeBC3Block(const uint8_t* texels, uint8_t* out);
+  void EncodeBC5Block(const uint8_t* texels, uint8_t* out);
+  void EncodeBC7Block(const uint8_t* texels, uint8_t* out);
+}
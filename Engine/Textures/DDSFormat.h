@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+
+namespace FrostFireEngine
+{
+  // Structures du format DDS, indépendantes de la plateforme : entiers 32 bits little-endian,
+  // sans dépendance aux en-têtes Windows
+  constexpr uint32_t MakeDDSFourCC(char a, char b, char c, char d)
+  {
+    return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b)) << 8) | (uint32_t(uint8_t(c)) << 16) |
+      (uint32_t(uint8_t(d)) << 24);
+  }
+
+  constexpr uint32_t DDS_MAGIC = MakeDDSFourCC('D', 'D', 'S', ' ');
+  constexpr uint32_t DDS_FOURCC_DX10 = MakeDDSFourCC('D', 'X', '1', '0');
+
+  constexpr uint32_t DDS_FLAGS_CAPS = 0x1;
+  constexpr uint32_t DDS_FLAGS_HEIGHT = 0x2;
+  constexpr uint32_t DDS_FLAGS_WIDTH = 0x4;
+  constexpr uint32_t DDS_FLAGS_PIXELFORMAT = 0x1000;
+  constexpr uint32_t DDS_FLAGS_MIPMAPCOUNT = 0x20000;
+  constexpr uint32_t DDS_FLAGS_LINEARSIZE = 0x80000;
+
+  constexpr uint32_t DDS_PIXELFORMAT_FOURCC = 0x4;
+
+  constexpr uint32_t DDS_CAPS_COMPLEX = 0x8;
+  constexpr uint32_t DDS_CAPS_TEXTURE = 0x1000;
+  constexpr uint32_t DDS_CAPS_MIPMAP = 0x400000;
+
+  constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+  struct DDSPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask;
+    uint32_t gBitMask;
+    uint32_t bBitMask;
+    uint32_t aBitMask;
+  };
+
+  struct DDSHeader {
+    uint32_t       size;
+    uint32_t       flags;
+    uint32_t       height;
+    uint32_t       width;
+    uint32_t       pitchOrLinearSize;
+    uint32_t       depth;
+    uint32_t       mipMapCount;
+    uint32_t       reserved1[11];
+    DDSPixelFormat pixelFormat;
+    uint32_t       caps;
+    uint32_t       caps2;
+    uint32_t       caps3;
+    uint32_t       caps4;
+    uint32_t       reserved2;
+  };
+
+  struct DDSHeaderDX10 {
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+  };
+
+  static_assert(sizeof(DDSPixelFormat) == 32, "DDS_PIXELFORMAT fait 32 octets");
+  static_assert(sizeof(DDSHeader) == 124, "DDS_HEADER fait 124 octets");
+  static_assert(sizeof(DDSHeaderDX10) == 20, "DDS_HEADER_DXT10 fait 20 octets");
+}
@@ -0,0 +1,252 @@
+#include "DDSParser.h"
+
+#include <cstring>
+
+namespace FrostFireEngine
+{
+  namespace
+  {
+    // Valeurs de DXGI_FORMAT utilisées ici, reprises telles quelles pour ne pas dépendre de dxgiformat.h
+    enum DXGIFormat : uint32_t {
+      R32G32B32A32_FLOAT = 2,
+      R16G16B16A16_FLOAT = 10,
+      R16G16B16A16_UNORM = 11,
+      R16G16B16A16_SNORM = 13,
+      R32G32_FLOAT = 16,
+      R8G8B8A8_UNORM = 28,
+      R16G16_FLOAT = 34,
+      R16G16_UNORM = 35,
+      R32_FLOAT = 41,
+      R16_FLOAT = 54,
+      R16_UNORM = 56,
+      R8_UNORM = 61,
+      A8_UNORM = 65,
+      BC1_UNORM = 71,
+      BC2_UNORM = 74,
+      BC3_UNORM = 77,
+      BC4_UNORM = 80,
+      BC4_SNORM = 81,
+      BC5_UNORM = 83,
+      BC5_SNORM = 84,
+      B5G6R5_UNORM = 85,
+      B5G5R5A1_UNORM = 86,
+      B8G8R8A8_UNORM = 87,
+      B8G8R8X8_UNORM = 88,
+      B4G4R4A4_UNORM = 115
+    };
+
+    constexpr uint32_t DDS_PIXELFORMAT_ALPHA = 0x2;
+    constexpr uint32_t DDS_PIXELFORMAT_RGB = 0x40;
+    constexpr uint32_t DDS_PIXELFORMAT_LUMINANCE = 0x20000;
+    constexpr uint32_t DDS_FLAGS_VOLUME = 0x800000;
+    constexpr uint32_t DDS_CAPS2_CUBEMAP = 0x200;
+    constexpr uint32_t DDS_CAPS2_CUBEMAP_ALLFACES = 0xFC00;
+    constexpr uint32_t DDS_MISC_TEXTURECUBE = 0x4;
+
+    // Limites D3D11 (feature level 11)
+    constexpr uint32_t MAX_TEXTURE_SIZE = 16384;
+    constexpr uint32_t MAX_ARRAY_SIZE = 2048;
+
+    struct FormatInfo {
+      uint32_t bitsPerPixel;  // 0 pour les formats compressés
+      uint32_t blockBytes;    // octets par bloc 4x4, 0 pour les formats non compressés
+    };
+
+    bool GetFormatInfo(uint32_t format, FormatInfo& info)
+    {
+      const auto inRange = [format](uint32_t first, uint32_t last) {
+        return format >= first && format <= last;
+      };
+
+      if (inRange(70, 72) || inRange(79, 81)) info = {0, 8};          // BC1, BC4
+      else if (inRange(73, 78) || inRange(82, 84)) info = {0, 16};    // BC2, BC3, BC5
+      else if (inRange(94, 99)) info = {0, 16};                       // BC6H, BC7
+      else if (inRange(1, 4)) info = {128, 0};                        // R32G32B32A32
+      else if (inRange(5, 8)) info = {96, 0};                         // R32G32B32
+      else if (inRange(9, 18)) info = {64, 0};                        // R16G16B16A16, R32G32
+      else if (inRange(23, 43) || format == 67) info = {32, 0};       // RGBA8, R10G10B10A2, R16G16, R32...
+      else if (inRange(87, 93)) info = {32, 0};                       // BGRA8, BGRX8
+      else if (inRange(48, 59) || inRange(85, 86) || format == B4G4R4A4_UNORM) info = {16, 0};
+      else if (inRange(60, 65)) info = {8, 0};                        // R8, A8
+      else return false;
+      return true;
+    }
+
+    bool HasMasks(const DDSPixelFormat& pf, uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+    {
+      return pf.rBitMask == r && pf.gBitMask == g && pf.bBitMask == b && pf.aBitMask == a;
+    }
+
+    // Formats des en-têtes sans extension DX10 (D3DX, exporteurs anciens) ; 0 si inconnu
+    uint32_t GetLegacyFormat(const DDSPixelFormat& pf)
+    {
+      if (pf.flags & DDS_PIXELFORMAT_FOURCC) {
+        switch (pf.fourCC) {
+        case MakeDDSFourCC('D', 'X', 'T', '1'): return BC1_UNORM;
+        case MakeDDSFourCC('D', 'X', 'T', '2'):
+        case MakeDDSFourCC('D', 'X', 'T', '3'): return BC2_UNORM;
+        case MakeDDSFourCC('D', 'X', 'T', '4'):
+        case MakeDDSFourCC('D', 'X', 'T', '5'): return BC3_UNORM;
+        case MakeDDSFourCC('A', 'T', 'I', '1'):
+        case MakeDDSFourCC('B', 'C', '4', 'U'): return BC4_UNORM;
+        case MakeDDSFourCC('B', 'C', '4', 'S'): return BC4_SNORM;
+        case MakeDDSFourCC('A', 'T', 'I', '2'):
+        case MakeDDSFourCC('B', 'C', '5', 'U'): return BC5_UNORM;
+        case MakeDDSFourCC('B', 'C', '5', 'S'): return BC5_SNORM;
+        // Codes D3DFORMAT numériques
+        case 36: return R16G16B16A16_UNORM;
+        case 110: return R16G16B16A16_SNORM;
+        case 111: return R16_FLOAT;
+        case 112: return R16G16_FLOAT;
+        case 113: return R16G16B16A16_FLOAT;
+        case 114: return R32_FLOAT;
+        case 115: return R32G32_FLOAT;
+        case 116: return R32G32B32A32_FLOAT;
+        default: return 0;
+        }
+      }
+
+      if (pf.flags & DDS_PIXELFORMAT_RGB) {
+        if (pf.rgbBitCount == 32) {
+          if (HasMasks(pf, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000)) return R8G8B8A8_UNORM;
+          if (HasMasks(pf, 0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000)) return B8G8R8A8_UNORM;
+          if (HasMasks(pf, 0x00FF0000, 0x0000FF00, 0x000000FF, 0)) return B8G8R8X8_UNORM;
+          if (HasMasks(pf, 0x0000FFFF, 0xFFFF0000, 0, 0)) return R16G16_UNORM;
+          if (HasMasks(pf, 0xFFFFFFFF, 0, 0, 0)) return R32_FLOAT;
+        }
+        else if (pf.rgbBitCount == 16) {
+          if (HasMasks(pf, 0xF800, 0x07E0, 0x001F, 0)) return B5G6R5_UNORM;
+          if (HasMasks(pf, 0x7C00, 0x03E0, 0x001F, 0x8000)) return B5G5R5A1_UNORM;
+          if (HasMasks(pf, 0x0F00, 0x00F0, 0x000F, 0xF000)) return B4G4R4A4_UNORM;
+        }
+        return 0;
+      }
+
+      if (pf.flags & DDS_PIXELFORMAT_LUMINANCE) {
+        if (pf.rgbBitCount == 8 && pf.rBitMask == 0xFF) return R8_UNORM;
+        if (pf.rgbBitCount == 16 && pf.rBitMask == 0xFFFF) return R16_UNORM;
+        return 0;
+      }
+
+      if ((pf.flags & DDS_PIXELFORMAT_ALPHA) && pf.rgbBitCount == 8) return A8_UNORM;
+      return 0;
+    }
+
+    uint32_t GetMaxMipCount(uint32_t width, uint32_t height)
+    {
+      uint32_t size = width > height ? width : height;
+      uint32_t count = 1;
+      while (size > 1) {
+        size >>= 1;
+        count++;
+      }
+      return count;
+    }
+  }
+
+  DDSParseError ParseDDS(const uint8_t* data, size_t size, DDSTextureDesc& desc)
+  {
+    desc = {};
+    if (!data || size < sizeof(uint32_t) + sizeof(DDSHeader)) return DDSParseError::TooSmall;
+
+    // Copies : le fichier projeté n'offre aucune garantie d'alignement
+    uint32_t magic;
+    memcpy(&magic, data, sizeof(magic));
+    if (magic != DDS_MAGIC) return DDSParseError::BadMagic;
+
+    DDSHeader header;
+    memcpy(&header, data + sizeof(uint32_t), sizeof(header));
+    if (header.size != sizeof(DDSHeader) || header.pixelFormat.size != sizeof(DDSPixelFormat)) {
+      return DDSParseError::BadHeader;
+    }
+
+    size_t offset = sizeof(uint32_t) + sizeof(DDSHeader);
+    desc.arraySize = 1;
+
+    if ((header.pixelFormat.flags & DDS_PIXELFORMAT_FOURCC) && header.pixelFormat.fourCC == DDS_FOURCC_DX10) {
+      if (size < offset + sizeof(DDSHeaderDX10)) return DDSParseError::TooSmall;
+
+      DDSHeaderDX10 dx10;
+      memcpy(&dx10, data + offset, sizeof(dx10));
+      offset += sizeof(dx10);
+
+      if (dx10.resourceDimension != DDS_DIMENSION_TEXTURE2D) return DDSParseError::UnsupportedDimension;
+      if (dx10.arraySize == 0 || dx10.arraySize > MAX_ARRAY_SIZE) return DDSParseError::BadHeader;
+
+      desc.dxgiFormat = dx10.dxgiFormat;
+      desc.arraySize = dx10.arraySize;
+      if (dx10.miscFlag & DDS_MISC_TEXTURECUBE) {
+        desc.isCubeMap = true;
+        desc.arraySize *= 6;
+      }
+    }
+    else {
+      desc.dxgiFormat = GetLegacyFormat(header.pixelFormat);
+      if (desc.dxgiFormat == 0) return DDSParseError::UnsupportedFormat;
+      if (header.flags & DDS_FLAGS_VOLUME) return DDSParseError::UnsupportedDimension;
+
+      if (header.caps2 & DDS_CAPS2_CUBEMAP) {
+        if ((header.caps2 & DDS_CAPS2_CUBEMAP_ALLFACES) != DDS_CAPS2_CUBEMAP_ALLFACES) {
+          return DDSParseError::UnsupportedDimension;
+        }
+        desc.isCubeMap = true;
+        desc.arraySize = 6;
+      }
+    }
+
+    FormatInfo format;
+    if (!GetFormatInfo(desc.dxgiFormat, format)) return DDSParseError::UnsupportedFormat;
+    desc.isBlockCompressed = format.blockBytes > 0;
+
+    desc.width = header.width;
+    desc.height = header.height;
+    desc.mipCount = header.mipMapCount > 0 ? header.mipMapCount : 1;
+    if (desc.width == 0 || desc.height == 0 || desc.width > MAX_TEXTURE_SIZE || desc.height > MAX_TEXTURE_SIZE ||
+      desc.mipCount > GetMaxMipCount(desc.width, desc.height) || (desc.isCubeMap && desc.width != desc.height)) {
+      return DDSParseError::BadDimensions;
+    }
+
+    // Les données suivent l'ordre des sous-ressources : tous les mips d'un élément, puis le suivant
+    desc.subresources.reserve(size_t(desc.arraySize) * desc.mipCount);
+    for (uint32_t item = 0; item < desc.arraySize; item++) {
+      uint32_t width = desc.width;
+      uint32_t height = desc.height;
+      for (uint32_t mip = 0; mip < desc.mipCount; mip++) {
+        uint64_t rowPitch;
+        uint64_t rowCount;
+        if (desc.isBlockCompressed) {
+          rowPitch = uint64_t((width + 3) / 4) * format.blockBytes;
+          rowCount = (height + 3) / 4;
+        }
+        else {
+          rowPitch = (uint64_t(width) * format.bitsPerPixel + 7) / 8;
+          rowCount = height;
+        }
+        const uint64_t slicePitch = rowPitch * rowCount;
+        if (slicePitch > size - offset) return DDSParseError::Truncated;
+
+        desc.subresources.push_back({offset, static_cast<uint32_t>(rowPitch), static_cast<uint32_t>(slicePitch)});
+        offset += static_cast<size_t>(slicePitch);
+
+        width = width > 1 ? width >> 1 : 1;
+        height = height > 1 ? height >> 1 : 1;
+      }
+    }
+    return DDSParseError::None;
+  }
+
+  const char* GetDDSParseErrorMessage(DDSParseError error)
+  {
+    switch (error) {
+    case DDSParseError::None: return "ok";
+    case DDSParseError::TooSmall: return "fichier trop petit";
+    case DDSParseError::BadMagic: return "signature DDS absente";
+    case DDSParseError::BadHeader: return "en-tête invalide";
+    case DDSParseError::UnsupportedFormat: return "format non pris en charge";
+    case DDSParseError::UnsupportedDimension: return "dimension non prise en charge";
+    case DDSParseError::BadDimensions: return "dimensions invalides";
+    case DDSParseError::Truncated: return "données tronquées";
+    }
+    return "erreur inconnue";
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "DDSFormat.h"
+
+namespace FrostFireEngine
+{
+  // Lecture et validation d'un fichier DDS déjà en mémoire, sans API Windows ni D3D.
+  // Toutes les tailles et offsets sont vérifiés contre la taille du fichier : un fichier
+  // tronqué ou corrompu est refusé sans lecture hors limites.
+  enum class DDSParseError : uint8_t {
+    None,
+    TooSmall,
+    BadMagic,
+    BadHeader,
+    UnsupportedFormat,     // le chargeur générique (DDSTextureLoader11) peut encore le lire
+    UnsupportedDimension,  // 1D, volume ou cube map incomplète
+    BadDimensions,
+    Truncated
+  };
+
+  // Sous-ressource D3D11 d'index item * mipCount + mip ; offset depuis le début du fichier
+  struct DDSSubresource {
+    size_t   offset;
+    uint32_t rowPitch;
+    uint32_t slicePitch;
+  };
+
+  struct DDSTextureDesc {
+    uint32_t                    dxgiFormat = 0;
+    uint32_t                    width = 0;
+    uint32_t                    height = 0;
+    uint32_t                    mipCount = 0;
+    uint32_t                    arraySize = 0;  // 6 par cube map
+    bool                        isCubeMap = false;
+    bool                        isBlockCompressed = false;
+    std::vector<DDSSubresource> subresources;
+  };
+
+  DDSParseError ParseDDS(const uint8_t* data, size_t size, DDSTextureDesc& desc);
+
+  const char* GetDDSParseErrorMessage(DDSParseError error);
+}
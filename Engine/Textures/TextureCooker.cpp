@@ -0,0 +1,270 @@
+#include "TextureCooker.h"
+
+#include <dxgiformat.h>
+
+#include <algorithm>
+#include <cwctype>
+#include <fstream>
+#include <vector>
+
+#include "DDSFormat.h"
+#include "TextureStreamer.h"
+#include "Engine/Utils/MappedFile.h"
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  namespace
+  {
+    // Champs de DDSHeader::reserved1 occupés par la cuisson
+    enum CookedField : uint32_t {
+      FieldMagic = 0,
+      FieldVersion,
+      FieldContentHashLow,
+      FieldContentHashHigh,
+      FieldSourceSizeLow,
+      FieldSourceSizeHigh,
+      FieldSourceTimeLow,
+      FieldSourceTimeHigh,
+      FieldFormat
+    };
+
+    struct CookedHeader {
+      uint32_t      magic;
+      DDSHeader     header;
+      DDSHeaderDX10 dx10;
+    };
+    static_assert(sizeof(CookedHeader) == 148, "en-tête DDS sans remplissage");
+
+    struct SourceStamp {
+      uint64_t size = 0;
+      int64_t  writeTime = 0;
+    };
+
+    bool GetSourceStamp(const std::filesystem::path& source, SourceStamp& stamp)
+    {
+      std::error_code error;
+      stamp.size = std::filesystem::file_size(source, error);
+      if (error) return false;
+      stamp.writeTime = std::filesystem::last_write_time(source, error).time_since_epoch().count();
+      return !error;
+    }
+
+    uint64_t ReadField64(const DDSHeader& header, uint32_t low)
+    {
+      return uint64_t(header.reserved1[low]) | (uint64_t(header.reserved1[low + 1]) << 32);
+    }
+
+    void WriteField64(DDSHeader& header, uint32_t low, uint64_t value)
+    {
+      header.reserved1[low] = static_cast<uint32_t>(value);
+      header.reserved1[low + 1] = static_cast<uint32_t>(value >> 32);
+    }
+
+    bool ReadCookedHeader(const std::filesystem::path& path, CookedHeader& cooked)
+    {
+      std::ifstream ifs(path, std::ios::binary);
+      if (!ifs.read(reinterpret_cast<char*>(&cooked), sizeof(cooked))) return false;
+
+      return cooked.magic == DDS_MAGIC && cooked.header.size == sizeof(DDSHeader) &&
+        cooked.header.reserved1[FieldMagic] == COOKED_TEXTURE_MAGIC &&
+        cooked.header.reserved1[FieldVersion] == COOKED_TEXTURE_VERSION;
+    }
+
+    uint32_t GetDXGIFormat(BCFormat format)
+    {
+      switch (format) {
+      case BCFormat::BC1: return DXGI_FORMAT_BC1_UNORM;
+      case BCFormat::BC3: return DXGI_FORMAT_BC3_UNORM;
+      case BCFormat::BC5: return DXGI_FORMAT_BC5_UNORM;
+      case BCFormat::BC7: return DXGI_FORMAT_BC7_UNORM;
+      }
+      return DXGI_FORMAT_UNKNOWN;
+    }
+
+    bool IsNormalMap(const std::filesystem::path& source)
+    {
+      std::wstring stem = source.stem().wstring();
+      std::ranges::transform(stem, stem.begin(), [](wchar_t c) { return static_cast<wchar_t>(towlower(c)); });
+      return stem.find(L"normal") != std::wstring::npos || stem.ends_with(L"_n") || stem.ends_with(L"_nrm");
+    }
+
+    bool HasAlpha(const std::vector<uint8_t>& rgba)
+    {
+      for (size_t i = 3; i < rgba.size(); i += 4) {
+        if (rgba[i] != 255) return true;
+      }
+      return false;
+    }
+
+    // FNV-1a 64 bits du contenu de la source et du format demandé
+    uint64_t HashSource(const MappedFile& file, const TextureCookSettings& settings)
+    {
+      uint64_t hash = 0xCBF29CE484222325ull;
+      const auto mix = [&hash](uint8_t byte) {
+        hash ^= byte;
+        hash *= 0x100000001B3ull;
+      };
+      for (size_t i = 0; i < file.GetSize(); i++) {
+        mix(file.GetData()[i]);
+      }
+      mix(settings.format ? static_cast<uint8_t>(*settings.format) : 0xFF);
+      return hash;
+    }
+
+    void FillResultFromHeader(const CookedHeader& cooked, TextureCookResult& result)
+    {
+      result.format = static_cast<BCFormat>(cooked.header.reserved1[FieldFormat]);
+      result.width = cooked.header.width;
+      result.height = cooked.header.height;
+      result.mipCount = cooked.header.mipMapCount;
+      result.uncompressedBytes = GetMipChainSize(result.width, result.height, 0);
+      for (uint32_t mip = 0; mip < result.mipCount; mip++) {
+        result.cookedBytes += GetBCLevelSize(result.format, GetMipDimension(result.width, mip),
+                                             GetMipDimension(result.height, mip));
+      }
+    }
+  }
+
+  std::filesystem::path GetCookedTexturePath(const std::filesystem::path& source)
+  {
+    std::filesystem::path path = std::filesystem::path(L"Cooked") / source.relative_path();
+    path += L".dds";
+    return path;
+  }
+
+  std::wstring FindCookedTexture(const std::wstring& source)
+  {
+    const std::filesystem::path sourcePath(source);
+    if (_wcsicmp(sourcePath.extension().c_str(), L".dds") == 0) return {};
+
+    const std::filesystem::path cookedPath = GetCookedTexturePath(sourcePath);
+    CookedHeader                cooked;
+    if (!ReadCookedHeader(cookedPath, cooked)) return {};
+
+    SourceStamp stamp;
+    if (GetSourceStamp(sourcePath, stamp) &&
+      (ReadField64(cooked.header, FieldSourceSizeLow) != stamp.size ||
+        static_cast<int64_t>(ReadField64(cooked.header, FieldSourceTimeLow)) != stamp.writeTime)) {
+      return {};
+    }
+    return cookedPath.wstring();
+  }
+
+  TextureCookResult CookTexture(const std::wstring& source, const TextureCookSettings& settings)
+  {
+    TextureCookResult result;
+
+    MappedFile  file;
+    SourceStamp stamp;
+    if (!file.Open(source) || !GetSourceStamp(source, stamp)) {
+      result.error = "source illisible";
+      return result;
+    }
+    const uint64_t contentHash = HashSource(file, settings);
+    file.Close();
+
+    const std::filesystem::path cookedPath = GetCookedTexturePath(source);
+
+    // Contenu identique : seule la date enregistrée est rafraîchie (copie, checkout...)
+    CookedHeader cooked;
+    if (!settings.force && ReadCookedHeader(cookedPath, cooked) &&
+      ReadField64(cooked.header, FieldContentHashLow) == contentHash) {
+      if (ReadField64(cooked.header, FieldSourceSizeLow) != stamp.size ||
+        static_cast<int64_t>(ReadField64(cooked.header, FieldSourceTimeLow)) != stamp.writeTime) {
+        WriteField64(cooked.header, FieldSourceSizeLow, stamp.size);
+        WriteField64(cooked.header, FieldSourceTimeLow, static_cast<uint64_t>(stamp.writeTime));
+
+        std::fstream fs(cookedPath, std::ios::binary | std::ios::in | std::ios::out);
+        fs.write(reinterpret_cast<const char*>(&cooked), sizeof(cooked));
+        if (!fs) {
+          result.error = "mise à jour de l'en-tête impossible";
+          return result;
+        }
+      }
+      FillResultFromHeader(cooked, result);
+      result.status = TextureCookStatus::UpToDate;
+      return result;
+    }
+
+    TextureMipChain chain;
+    if (!DecodeMipChain(source, 0, UINT32_MAX, chain)) {
+      result.error = "décodage impossible";
+      return result;
+    }
+
+    // Seul le mip 0 d'une texture BC doit avoir des côtés multiples de 4
+    if (chain.fullWidth % 4 != 0 || chain.fullHeight % 4 != 0) {
+      result.error = "dimensions non multiples de 4";
+      return result;
+    }
+
+    result.format = settings.format.value_or(
+      IsNormalMap(source) ? BCFormat::BC5 : HasAlpha(chain.levels.front()) ? BCFormat::BC3 : BCFormat::BC1);
+    result.width = chain.fullWidth;
+    result.height = chain.fullHeight;
+    result.mipCount = static_cast<uint32_t>(chain.levels.size());
+    result.uncompressedBytes = GetMipChainSize(result.width, result.height, 0);
+
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> level;
+    for (uint32_t mip = 0; mip < result.mipCount; mip++) {
+      CompressBC(result.format, chain.levels[mip], GetMipDimension(result.width, mip),
+                 GetMipDimension(result.height, mip), level);
+      compressed.insert(compressed.end(), level.begin(), level.end());
+    }
+    result.cookedBytes = compressed.size();
+
+    cooked = {};
+    cooked.magic = DDS_MAGIC;
+    DDSHeader& header = cooked.header;
+    header.size = sizeof(DDSHeader);
+    header.flags = DDS_FLAGS_CAPS | DDS_FLAGS_HEIGHT | DDS_FLAGS_WIDTH | DDS_FLAGS_PIXELFORMAT |
+      DDS_FLAGS_MIPMAPCOUNT | DDS_FLAGS_LINEARSIZE;
+    header.height = result.height;
+    header.width = result.width;
+    header.pitchOrLinearSize = static_cast<uint32_t>(GetBCLevelSize(result.format, result.width, result.height));
+    header.mipMapCount = result.mipCount;
+    header.pixelFormat.size = sizeof(DDSPixelFormat);
+    header.pixelFormat.flags = DDS_PIXELFORMAT_FOURCC;
+    header.pixelFormat.fourCC = DDS_FOURCC_DX10;
+    header.caps = DDS_CAPS_TEXTURE | DDS_CAPS_COMPLEX | DDS_CAPS_MIPMAP;
+    header.reserved1[FieldMagic] = COOKED_TEXTURE_MAGIC;
+    header.reserved1[FieldVersion] = COOKED_TEXTURE_VERSION;
+    WriteField64(header, FieldContentHashLow, contentHash);
+    WriteField64(header, FieldSourceSizeLow, stamp.size);
+    WriteField64(header, FieldSourceTimeLow, static_cast<uint64_t>(stamp.writeTime));
+    header.reserved1[FieldFormat] = static_cast<uint32_t>(result.format);
+    cooked.dx10.dxgiFormat = GetDXGIFormat(result.format);
+    cooked.dx10.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+    cooked.dx10.arraySize = 1;
+
+    // Fichier temporaire puis renommage, pour ne jamais laisser de DDS tronqué
+    std::error_code error;
+    std::filesystem::create_directories(cookedPath.parent_path(), error);
+
+    std::filesystem::path tempPath = cookedPath;
+    tempPath += ".tmp";
+    {
+      std::ofstream ofs(tempPath, std::ios::binary | std::ios::trunc);
+      ofs.write(reinterpret_cast<const char*>(&cooked), sizeof(cooked));
+      ofs.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+      if (!ofs) {
+        result.error = "écriture impossible";
+        return result;
+      }
+    }
+
+    std::filesystem::rename(tempPath, cookedPath, error);
+    if (error) {
+      std::filesystem::remove(tempPath, error);
+      result.error = "écriture impossible";
+      return result;
+    }
+
+    result.status = TextureCookStatus::Cooked;
+    return result;
+  }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "BCEncoder.h"
+
+namespace FrostFireEngine
+{
+  // Cuisson hors ligne des images sources (PNG, JPG...) en DDS compressés BC, mips calculés
+  // sur le CPU. Les fichiers cuits vont dans Cooked/, relatif au répertoire de travail, sous le
+  // chemin de la source suivi de « .dds ». L'en-tête DDS garde dans ses champs réservés le
+  // hachage du contenu de la source et sa taille et date : une source inchangée n'est pas
+  // recuite, et le TextureManager n'utilise le fichier cuit que s'il correspond à la source.
+  constexpr uint32_t COOKED_TEXTURE_MAGIC = 0x54434646;  // "FFCT"
+  constexpr uint32_t COOKED_TEXTURE_VERSION = 1;
+
+  struct TextureCookSettings {
+    std::optional<BCFormat> format;  // vide : BC5 pour les normales, BC3 avec alpha, BC1 sinon
+    bool                    force = false;  // recuit même si le contenu n'a pas changé
+  };
+
+  enum class TextureCookStatus : uint8_t {
+    Cooked,
+    UpToDate,
+    Failed
+  };
+
+  struct TextureCookResult {
+    TextureCookStatus status = TextureCookStatus::Failed;
+    BCFormat          format = BCFormat::BC1;
+    uint32_t          width = 0;
+    uint32_t          height = 0;
+    uint32_t          mipCount = 0;
+    size_t            uncompressedBytes = 0;  // RGBA8 avec mips, ce qu'occuperait la source
+    size_t            cookedBytes = 0;
+    std::string       error;
+  };
+
+  std::filesystem::path GetCookedTexturePath(const std::filesystem::path& source);
+
+  // Chemin du DDS cuit à utiliser à la place de source, vide s'il n'existe pas ou si la source
+  // a changé depuis la cuisson. Sans source (données distribuées), le fichier cuit fait foi.
+  std::wstring FindCookedTexture(const std::wstring& source);
+
+  // COM doit être initialisé sur le thread appelant (décodage WIC)
+  TextureCookResult CookTexture(const std::wstring& source, const TextureCookSettings& settings = {});
+}
@@ -0,0 +1,221 @@
+#include "TextureStreamer.h"
+
+#include <windows.h>
+#include <wincodec.h>
+#include <wrl/client.h>
+
+#include <algorithm>
+
+namespace FrostFireEngine
+{
+  #undef min
+  #undef max
+
+  using Microsoft::WRL::ComPtr;
+
+  namespace
+  {
+    // Moyenne de blocs 2x2 ; sur un côté impair, le dernier texel est répété
+    void DownsampleBox(const std::vector<uint8_t>& source,
+                       uint32_t                    sourceWidth,
+                       uint32_t                    sourceHeight,
+                       std::vector<uint8_t>&       destination,
+                       uint32_t                    width,
+                       uint32_t                    height)
+    {
+      destination.resize(size_t(width) * height * 4);
+
+      for (uint32_t y = 0; y < height; y++) {
+        const uint32_t y0 = std::min(y * 2, sourceHeight - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, sourceHeight - 1);
+
+        for (uint32_t x = 0; x < width; x++) {
+          const uint32_t x0 = std::min(x * 2, sourceWidth - 1);
+          const uint32_t x1 = std::min(x * 2 + 1, sourceWidth - 1);
+
+          const uint8_t* p00 = &source[(size_t(y0) * sourceWidth + x0) * 4];
+          const uint8_t* p01 = &source[(size_t(y0) * sourceWidth + x1) * 4];
+          const uint8_t* p10 = &source[(size_t(y1) * sourceWidth + x0) * 4];
+          const uint8_t* p11 = &source[(size_t(y1) * sourceWidth + x1) * 4];
+          uint8_t*       out = &destination[(size_t(y) * width + x) * 4];
+
+          for (int c = 0; c < 4; c++) {
+            out[c] = static_cast<uint8_t>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+          }
+        }
+      }
+    }
+  }
+
+  uint32_t GetMipCount(uint32_t width, uint32_t height)
+  {
+    uint32_t size = std::max(width, height);
+    uint32_t count = 1;
+    while (size > 1) {
+      size >>= 1;
+      count++;
+    }
+    return count;
+  }
+
+  size_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t firstMip)
+  {
+    const uint32_t mipCount = GetMipCount(width, height);
+    size_t         size = 0;
+    for (uint32_t mip = firstMip; mip < mipCount; mip++) {
+      size += size_t(GetMipDimension(width, mip)) * GetMipDimension(height, mip) * 4;
+    }
+    return size;
+  }
+
+  bool DecodeMipChain(const std::wstring& filename,
+                      uint32_t            firstMip,
+                      uint32_t            maxTopSize,
+                      TextureMipChain&    out)
+  {
+    ComPtr<IWICImagingFactory> pFactory;
+    HRESULT                    hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr,
+                                                     CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pFactory));
+    if (FAILED(hr)) return false;
+
+    ComPtr<IWICBitmapDecoder> pDecoder;
+    hr = pFactory->CreateDecoderFromFilename(filename.c_str(), nullptr, GENERIC_READ,
+                                             WICDecodeMetadataCacheOnLoad, &pDecoder);
+    if (FAILED(hr)) return false;
+
+    ComPtr<IWICBitmapFrameDecode> pFrame;
+    hr = pDecoder->GetFrame(0, &pFrame);
+    if (FAILED(hr)) return false;
+
+    UINT width = 0;
+    UINT height = 0;
+    hr = pFrame->GetSize(&width, &height);
+    if (FAILED(hr) || width == 0 || height == 0) return false;
+
+    const uint32_t mipCount = GetMipCount(width, height);
+    uint32_t       topMip = std::min(firstMip, mipCount - 1);
+    while (topMip + 1 < mipCount &&
+      std::max(GetMipDimension(width, topMip), GetMipDimension(height, topMip)) > maxTopSize) {
+      topMip++;
+    }
+
+    const uint32_t topWidth = GetMipDimension(width, topMip);
+    const uint32_t topHeight = GetMipDimension(height, topMip);
+
+    // Réduction pendant le décodage : les décodeurs JPEG ne décodent alors que ce qu'il faut
+    ComPtr<IWICBitmapSource> pSource = pFrame;
+    if (topMip > 0) {
+      ComPtr<IWICBitmapScaler> pScaler;
+      hr = pFactory->CreateBitmapScaler(&pScaler);
+      if (FAILED(hr)) return false;
+      hr = pScaler->Initialize(pFrame.Get(), topWidth, topHeight, WICBitmapInterpolationModeFant);
+      if (FAILED(hr)) return false;
+      pSource = pScaler;
+    }
+
+    ComPtr<IWICFormatConverter> pConverter;
+    hr = pFactory->CreateFormatConverter(&pConverter);
+    if (FAILED(hr)) return false;
+
+    hr = pConverter->Initialize(pSource.Get(), GUID_WICPixelFormat32bppRGBA,
+                                WICBitmapDitherTypeNone, nullptr, 0.f, WICBitmapPaletteTypeCustom);
+    if (FAILED(hr)) return false;
+
+    out.fullWidth = width;
+    out.fullHeight = height;
+    out.firstMip = topMip;
+    out.levels.clear();
+    out.levels.reserve(mipCount - topMip);
+
+    auto& top = out.levels.emplace_back(size_t(topWidth) * topHeight * 4);
+    hr = pConverter->CopyPixels(nullptr, topWidth * 4, static_cast<UINT>(top.size()), top.data());
+    if (FAILED(hr)) return false;
+
+    for (uint32_t mip = topMip + 1; mip < mipCount; mip++) {
+      std::vector<uint8_t> level;
+      DownsampleBox(out.levels.back(), GetMipDimension(width, mip - 1), GetMipDimension(height, mip - 1),
+                    level, GetMipDimension(width, mip), GetMipDimension(height, mip));
+      out.levels.push_back(std::move(level));
+    }
+    return true;
+  }
+
+  TextureStreamer::~TextureStreamer()
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_stop = true;
+      m_requests.clear();
+    }
+    m_condition.notify_all();
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+  void TextureStreamer::Request(Texture* texture, std::wstring filename, uint32_t mip)
+  {
+    {
+      std::lock_guard lock(m_mutex);
+      m_requests.push_back({texture, std::move(filename), mip});
+      if (!m_thread.joinable()) {
+        m_thread = std::thread(&TextureStreamer::Run, this);
+      }
+    }
+    m_condition.notify_one();
+  }
+
+  void TextureStreamer::Cancel(const Texture* texture)
+  {
+    std::lock_guard lock(m_mutex);
+    std::erase_if(m_requests, [texture](const LoadRequest& request) { return request.texture == texture; });
+    std::erase_if(m_results, [texture](const Result& result) { return result.texture == texture; });
+    if (m_inFlight == texture) {
+      m_inFlightCancelled = true;
+    }
+  }
+
+  void TextureStreamer::TakeResults(std::vector<Result>& out)
+  {
+    std::lock_guard lock(m_mutex);
+    for (auto& result : m_results) {
+      out.push_back(std::move(result));
+    }
+    m_results.clear();
+  }
+
+  size_t TextureStreamer::GetPendingCount() const
+  {
+    std::lock_guard lock(m_mutex);
+    return m_requests.size() + (m_inFlight ? 1 : 0);
+  }
+
+  void TextureStreamer::Run()
+  {
+    CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    std::unique_lock lock(m_mutex);
+    while (true) {
+      m_condition.wait(lock, [this]() { return m_stop || !m_requests.empty(); });
+      if (m_stop) break;
+
+      LoadRequest request = std::move(m_requests.front());
+      m_requests.pop_front();
+      m_inFlight = request.texture;
+      m_inFlightCancelled = false;
+      lock.unlock();
+
+      Result result{request.texture, false, {}};
+      result.success = DecodeMipChain(request.filename, request.mip, UINT32_MAX, result.chain);
+
+      lock.lock();
+      if (!m_inFlightCancelled) {
+        m_results.push_back(std::move(result));
+      }
+      m_inFlight = nullptr;
+    }
+    lock.unlock();
+
+    CoUninitialize();
+  }
+}
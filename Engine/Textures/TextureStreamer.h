@@ -0,0 +1,82 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace FrostFireEngine
+{
+  class Texture;
+
+  // Mips [firstMip, fin de chaîne) d'une image RGBA8, du plus grand au plus petit
+  struct TextureMipChain {
+    uint32_t                          fullWidth = 0;  // taille du mip 0
+    uint32_t                          fullHeight = 0;
+    uint32_t                          firstMip = 0;
+    std::vector<std::vector<uint8_t>> levels;
+  };
+
+  inline uint32_t GetMipDimension(uint32_t size, uint32_t mip)
+  {
+    const uint32_t dimension = size >> mip;
+    return dimension > 0 ? dimension : 1;
+  }
+
+  uint32_t GetMipCount(uint32_t width, uint32_t height);
+
+  // Octets RGBA8 des mips [firstMip, fin de chaîne)
+  size_t GetMipChainSize(uint32_t width, uint32_t height, uint32_t firstMip);
+
+  // Décode l'image (WIC) directement à la taille du premier mip voulu, puis calcule les
+  // suivants par filtre boîte. Ce premier mip est firstMip, ou plus petit si son plus grand
+  // côté dépasse maxTopSize. COM doit être initialisé sur le thread appelant.
+  bool DecodeMipChain(const std::wstring& filename,
+                      uint32_t            firstMip,
+                      uint32_t            maxTopSize,
+                      TextureMipChain&    out);
+
+  // Thread de chargement des mips supérieurs des textures streamées.
+  // Les demandes sont traitées dans l'ordre ; les résultats sont récupérés par le thread
+  // principal, seul à toucher aux Texture et au périphérique D3D.
+  class TextureStreamer {
+  public:
+    struct Result {
+      Texture*        texture;
+      bool            success;
+      TextureMipChain chain;
+    };
+
+    TextureStreamer() = default;
+    ~TextureStreamer();
+
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    void   Request(Texture* texture, std::wstring filename, uint32_t mip);
+    // Retire les demandes et résultats de la texture ; un décodage en cours est abandonné
+    void   Cancel(const Texture* texture);
+    void   TakeResults(std::vector<Result>& out);
+    size_t GetPendingCount() const;
+
+  private:
+    struct LoadRequest {
+      Texture*     texture;
+      std::wstring filename;
+      uint32_t     mip;
+    };
+
+    void Run();
+
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_condition;
+    std::deque<LoadRequest> m_requests;
+    std::vector<Result>     m_results;
+    const Texture*          m_inFlight = nullptr;
+    bool                    m_inFlightCancelled = false;
+    bool                    m_stop = false;
+    std::thread             m_thread;  // démarré à la première demande
+  };
+}
@@ -0,0 +1,77 @@
+#include "MappedFile.h"
+
+#include <Windows.h>
+#include <utility>
+
+namespace FrostFireEngine
+{
+  MappedFile::~MappedFile()
+  {
+    Close();
+  }
+
+  MappedFile::MappedFile(MappedFile&& other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+  {
+    if (this != &other) {
+      Close();
+      m_file = std::exchange(other.m_file, nullptr);
+      m_mapping = std::exchange(other.m_mapping, nullptr);
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  bool MappedFile::Open(const std::wstring& path)
+  {
+    Close();
+
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    m_file = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+      Close();
+      return false;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+      Close();
+      return false;
+    }
+    m_mapping = mapping;
+
+    m_data = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+      Close();
+      return false;
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    return true;
+  }
+
+  void MappedFile::Close()
+  {
+    if (m_data) {
+      UnmapViewOfFile(m_data);
+      m_data = nullptr;
+    }
+    if (m_mapping) {
+      CloseHandle(m_mapping);
+      m_mapping = nullptr;
+    }
+    if (m_file) {
+      CloseHandle(m_file);
+      m_file = nullptr;
+    }
+    m_size = 0;
+  }
+}
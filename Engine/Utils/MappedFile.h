@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace FrostFireEngine
+{
+  // Projection en lecture seule d'un fichier en mémoire (CreateFileMapping / MapViewOfFile).
+  // Les données restent valides tant que l'objet existe.
+  class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::wstring& path);
+    void Close();
+
+    bool           IsOpen() const { return m_data != nullptr; }
+    const uint8_t* GetData() const { return m_data; }
+    size_t         GetSize() const { return m_size; }
+
+  private:
+    void*          m_file = nullptr;     // HANDLE
+    void*          m_mapping = nullptr;  // HANDLE
+    const uint8_t* m_data = nullptr;
+    size_t         m_size = 0;
+  };
+}
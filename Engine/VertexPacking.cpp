@@ -0,0 +1,90 @@
+#include "VertexPacking.h"
+
+#include <DirectXPackedVector.h>
+#include <algorithm>
+#include <cmath>
+
+#undef min
+#undef max
+
+namespace FrostFireEngine
+{
+  namespace
+  {
+    // Projection d'une direction unitaire sur l'octaèdre puis dépliage dans [-1, 1]²
+    XMFLOAT2 OctahedralEncode(const XMFLOAT3& direction)
+    {
+      const float length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+      if (length <= 0.0f) return {0.0f, 0.0f};
+
+      float x = direction.x / length;
+      float y = direction.y / length;
+      if (direction.z < 0.0f) {
+        const float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+      }
+      return {x, y};
+    }
+
+    int16_t ToSnorm16(float value)
+    {
+      return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+  }
+
+  VertexLayoutDesc GetVertexLayoutDesc(VertexFormat format)
+  {
+    VertexLayoutDesc layoutDesc;
+    if (format == VertexFormat::Packed) {
+      layoutDesc.elements.assign(std::begin(PackedVertexLayout), std::end(PackedVertexLayout));
+    }
+    else {
+      layoutDesc.elements.assign(std::begin(Vertex::layout), std::end(Vertex::layout));
+    }
+    return layoutDesc;
+  }
+
+  uint32_t GetVertexFormatSize(VertexFormat format)
+  {
+    return format == VertexFormat::Packed
+             ? static_cast<uint32_t>(sizeof(XMFLOAT3) + sizeof(PackedVertexAttributes))
+             : static_cast<uint32_t>(sizeof(Vertex));
+  }
+
+  bool CanPackVertices(std::span<const Vertex> vertices)
+  {
+    return std::ranges::all_of(vertices, [](const Vertex& vertex) {
+      const XMFLOAT2& uv = vertex.GetTexCoord();
+      return std::abs(uv.x) <= PACKED_TEXCOORD_LIMIT && std::abs(uv.y) <= PACKED_TEXCOORD_LIMIT;
+    });
+  }
+
+  PackedVertexAttributes PackVertexAttributes(const Vertex& vertex)
+  {
+    const XMFLOAT2 normal = OctahedralEncode(vertex.GetNormal());
+    const XMFLOAT2 tangent = OctahedralEncode(vertex.GetTangent());
+
+    PackedVertexAttributes packed;
+    packed.normalTangent[0] = ToSnorm16(normal.x);
+    packed.normalTangent[1] = ToSnorm16(normal.y);
+    packed.normalTangent[2] = ToSnorm16(tangent.x);
+    packed.normalTangent[3] = ToSnorm16(tangent.y);
+    packed.texCoord[0] = PackedVector::XMConvertFloatToHalf(vertex.GetTexCoord().x);
+    packed.texCoord[1] = PackedVector::XMConvertFloatToHalf(vertex.GetTexCoord().y);
+    return packed;
+  }
+
+  PackedVertexStreams PackVertexStreams(std::span<const Vertex> vertices)
+  {
+    PackedVertexStreams streams;
+    streams.positions.resize(vertices.size());
+    streams.attributes.resize(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      streams.positions[i] = vertices[i].GetPosition();
+      streams.attributes[i] = PackVertexAttributes(vertices[i]);
+    }
+    return streams;
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <d3d11.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Vertex.h"
+#include "Engine/Shaders/VertexLayoutDesc.h"
+
+namespace FrostFireEngine
+{
+  // Format des sommets envoyés au GPU.
+  // Full   : un seul flux de Vertex (44 octets).
+  // Packed : flux 0 de positions (12 octets), seul lu par les passes de profondeur et d'ombre,
+  //          et flux 1 d'attributs compactés (12 octets) : normale et tangente en octaédrique
+  //          sur 2 x 16 bits chacune, UV en demi-flottants.
+  enum class VertexFormat : uint32_t {
+    Full,
+    Packed
+  };
+
+  struct PackedVertexAttributes {
+    int16_t  normalTangent[4];  // normale (xy) et tangente (zw) octaédriques, SNORM
+    uint16_t texCoord[2];       // demi-flottants
+  };
+  static_assert(sizeof(PackedVertexAttributes) == 12);
+
+  // Au-delà, un demi-flottant perd plus d'un texel sur une texture 1024 : le maillage reste en Full
+  constexpr float PACKED_TEXCOORD_LIMIT = 2.0f;
+
+  // Define ajouté aux variants qui lisent le format Packed (voir VertexInput.hlsli)
+  constexpr const char* PACKED_VERTEX_FEATURE = "PACKED_VERTEX";
+
+  inline const D3D11_INPUT_ELEMENT_DESC PackedVertexLayout[] = {
+    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"NORMAL", 0, DXGI_FORMAT_R16G16B16A16_SNORM, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+    {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 1, 8, D3D11_INPUT_PER_VERTEX_DATA, 0}
+  };
+
+  // Lit la position au début du flux 0, quel que soit le format
+  inline const D3D11_INPUT_ELEMENT_DESC PositionOnlyLayout[] = {
+    {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0}
+  };
+
+  VertexLayoutDesc GetVertexLayoutDesc(VertexFormat format);
+
+  // Taille par sommet de l'ensemble des flux d'un format
+  uint32_t GetVertexFormatSize(VertexFormat format);
+
+  // Vrai si les UV tiennent sans perte visible dans des demi-flottants
+  bool CanPackVertices(std::span<const Vertex> vertices);
+
+  PackedVertexAttributes PackVertexAttributes(const Vertex& vertex);
+
+  // Flux du format Packed, dans l'ordre des slots d'entrée (voir PackedVertexLayout)
+  struct PackedVertexStreams {
+    std::vector<XMFLOAT3>               positions;
+    std::vector<PackedVertexAttributes> attributes;
+  };
+
+  PackedVertexStreams PackVertexStreams(std::span<const Vertex> vertices);
+}
@@ -0,0 +1,164 @@
+#include "VertexWelder.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#undef min
+#undef max
+
+namespace FrostFireEngine
+{
+  namespace
+  {
+    // La table est agrandie dès qu'elle est à moitié pleine
+    constexpr size_t MIN_SLOT_COUNT = 64;
+
+    // Une tolérance nulle (inverse 0) demande une égalité exacte
+    float Inverse(float epsilon)
+    {
+      return epsilon > 0.0f ? 1.0f / epsilon : 0.0f;
+    }
+
+    // Arrondi à l'entier le plus proche, moitiés loin de zéro comme llround, sans appel de
+    // bibliothèque. Au-delà de 2^52 le double est déjà entier et l'ajout de 0.5 ne le change pas.
+    int64_t Round(double scaled)
+    {
+      return scaled >= 0.0 ? static_cast<int64_t>(scaled + 0.5) : -static_cast<int64_t>(0.5 - scaled);
+    }
+
+    // Une valeur non finie est ramenée à 0 plutôt que de produire une clé indéfinie.
+    // Sans tolérance, la clé est la représentation binaire du flottant.
+    int64_t Quantize64(float value, float invEpsilon)
+    {
+      if (invEpsilon == 0.0f) return std::bit_cast<int32_t>(value);
+
+      const double scaled = static_cast<double>(value) * invEpsilon;
+      if (!std::isfinite(scaled)) return 0;
+      if (scaled >= 0x1p62) return INT64_MAX;
+      if (scaled <= -0x1p62) return INT64_MIN;
+      return Round(scaled);
+    }
+
+    int32_t Quantize32(float value, float invEpsilon)
+    {
+      if (invEpsilon == 0.0f) return std::bit_cast<int32_t>(value);
+
+      const double scaled = static_cast<double>(value * invEpsilon);
+      if (!std::isfinite(scaled)) return 0;
+      if (scaled >= static_cast<double>(INT32_MAX)) return INT32_MAX;
+      if (scaled <= static_cast<double>(INT32_MIN)) return INT32_MIN;
+      return static_cast<int32_t>(Round(scaled));
+    }
+
+    uint64_t Mix(uint64_t hash, uint64_t value)
+    {
+      return (hash ^ value) * 0x9E3779B97F4A7C15ull;
+    }
+  }
+
+  VertexWelder::VertexWelder(const Epsilons& epsilons, size_t expectedVertexCount)
+    : m_invPosition(Inverse(epsilons.position))
+    , m_invNormal(Inverse(epsilons.normal))
+    , m_invTexCoord(Inverse(epsilons.texCoord))
+    , m_invTangent(Inverse(epsilons.tangent))
+  {
+    const size_t slotCount = std::bit_ceil(std::max(expectedVertexCount * 2, MIN_SLOT_COUNT));
+    m_slots.assign(slotCount, EMPTY_SLOT);
+    m_mask = slotCount - 1;
+    m_vertices.reserve(expectedVertexCount);
+    m_keys.reserve(expectedVertexCount);
+  }
+
+  VertexWelder::Key VertexWelder::MakeKey(const Vertex& vertex) const
+  {
+    const XMFLOAT3& position = vertex.GetPosition();
+    const XMFLOAT3& normal = vertex.GetNormal();
+    const XMFLOAT2& texCoord = vertex.GetTexCoord();
+    const XMFLOAT3& tangent = vertex.GetTangent();
+
+    return {
+      {
+        Quantize64(position.x, m_invPosition), Quantize64(position.y, m_invPosition),
+        Quantize64(position.z, m_invPosition)
+      },
+      {
+        Quantize32(normal.x, m_invNormal), Quantize32(normal.y, m_invNormal),
+        Quantize32(normal.z, m_invNormal)
+      },
+      {Quantize32(texCoord.x, m_invTexCoord), Quantize32(texCoord.y, m_invTexCoord)},
+      {
+        Quantize32(tangent.x, m_invTangent), Quantize32(tangent.y, m_invTangent),
+        Quantize32(tangent.z, m_invTangent)
+      }
+    };
+  }
+
+  uint64_t VertexWelder::Hash(const Key& key)
+  {
+    // La clé est lue par mots de 64 bits : 7 multiplications au lieu d'un mélange par composante
+    static_assert(sizeof(Key) % sizeof(uint64_t) == 0, "Key sans remplissage, lue par mots de 64 bits");
+    uint64_t words[sizeof(Key) / sizeof(uint64_t)];
+    std::memcpy(words, &key, sizeof(Key));
+
+    uint64_t hash = 0;
+    for (const uint64_t word : words) hash = Mix(hash, word);
+
+    // Finalisation (splitmix64) : les bits bas servent d'index dans la table
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+  }
+
+  void VertexWelder::Grow()
+  {
+    const size_t slotCount = m_slots.size() * 2;
+    m_slots.assign(slotCount, EMPTY_SLOT);
+    m_mask = slotCount - 1;
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_keys.size()); i++) {
+      size_t slot = Hash(m_keys[i]) & m_mask;
+      while (m_slots[slot] != EMPTY_SLOT) {
+        slot = (slot + 1) & m_mask;
+      }
+      m_slots[slot] = i;
+    }
+  }
+
+  uint32_t VertexWelder::Add(const Vertex& vertex)
+  {
+    const Key key = MakeKey(vertex);
+    size_t    slot = Hash(key) & m_mask;
+
+    while (m_slots[slot] != EMPTY_SLOT) {
+      if (m_keys[m_slots[slot]] == key) {
+        return m_slots[slot];
+      }
+      slot = (slot + 1) & m_mask;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_vertices.size());
+    m_vertices.push_back(vertex);
+    m_keys.push_back(key);
+    m_slots[slot] = index;
+
+    if (m_vertices.size() * 2 > m_slots.size()) {
+      Grow();
+    }
+    return index;
+  }
+
+  std::vector<Vertex> VertexWelder::TakeVertices()
+  {
+    std::vector<Vertex> vertices = std::move(m_vertices);
+    m_vertices = {};
+    m_keys = {};
+    m_slots.assign(MIN_SLOT_COUNT, EMPTY_SLOT);
+    m_mask = MIN_SLOT_COUNT - 1;
+    return vertices;
+  }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "Vertex.h"
+
+namespace FrostFireEngine
+{
+  // Fusion des sommets identiques à l'import : chaque attribut (position, normale, UV,
+  // tangente) est quantifié avec sa propre tolérance, et les clés obtenues sont indexées
+  // dans une table de hachage à adressage ouvert (sondage linéaire).
+  // Deux sommets ne sont fusionnés que si toutes leurs clés sont égales.
+  // Une tolérance nulle compare les bits des flottants : seuls les sommets identiques fusionnent.
+  class VertexWelder {
+  public:
+    struct Epsilons {
+      float position = 1e-5f;  // unités de la scène, après scaleFactor
+      float normal = 1e-3f;
+      float texCoord = 1e-5f;
+      float tangent = 1e-3f;
+    };
+
+    explicit VertexWelder(const Epsilons& epsilons, size_t expectedVertexCount = 0);
+
+    // Index du sommet soudé équivalent, ajouté s'il n'existe pas encore
+    uint32_t Add(const Vertex& vertex);
+
+    const std::vector<Vertex>& GetVertices() const { return m_vertices; }
+    std::vector<Vertex>        TakeVertices();
+
+  private:
+    struct Key {
+      int64_t position[3];  // 64 bits : une petite tolérance sur une grande scène dépasse 2^31
+      int32_t normal[3];
+      int32_t texCoord[2];
+      int32_t tangent[3];
+
+      bool operator==(const Key&) const = default;
+    };
+
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    Key             MakeKey(const Vertex& vertex) const;
+    static uint64_t Hash(const Key& key);
+    void            Grow();
+
+    float m_invPosition;
+    float m_invNormal;
+    float m_invTexCoord;
+    float m_invTangent;
+
+    std::vector<Vertex>   m_vertices;
+    std::vector<Key>      m_keys;   // clé de chaque sommet de m_vertices
+    std::vector<uint32_t> m_slots;  // index dans m_vertices, EMPTY_SLOT si libre
+    size_t                m_mask = 0;
+  };
+}
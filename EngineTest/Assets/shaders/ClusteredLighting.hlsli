@@ -0,0 +1,40 @@
+// Lighting clusterisé partagé par le lighting pass et la passe de transparence.
+// Les directionnelles sont en tête de gClusterLights, les lumières locales sont
+// référencées par cluster (tuile écran x tranche de profondeur) via gClusterLightIndices.
+// GPU_Light doit être déclaré avant l'inclusion.
+
+struct LightCluster {
+  uint offset;
+  uint count;
+};
+
+cbuffer ClusterParams : register(b6)
+{
+  float4x4 gView;
+  float    gSliceScale;
+  float    gSliceBias;
+  uint     gDirectionalCount;
+  uint     gClusterLightCount;
+  uint3    gClusterDims;
+  uint     padCP;
+  float2   gClusterScreenSize;
+  float2   padCP2;
+}
+
+StructuredBuffer<GPU_Light>    gClusterLights       : register(t7);
+StructuredBuffer<LightCluster> gLightClusters       : register(t8);
+StructuredBuffer<uint>         gClusterLightIndices : register(t9);
+
+// pixelPos en pixels (SV_POSITION), même découpage que LightClusterGrid côté CPU
+uint GetClusterIndex(float2 pixelPos, float3 positionW)
+{
+  float viewZ = mul(float4(positionW, 1.0f), gView).z;
+  uint slice = 0;
+  if (viewZ > 0.0f)
+    slice = (uint)clamp(log(viewZ) * gSliceScale + gSliceBias, 0.0f, (float)(gClusterDims.z - 1));
+
+  uint2 tile = (uint2)(pixelPos / gClusterScreenSize * (float2)gClusterDims.xy);
+  tile = min(tile, gClusterDims.xy - 1);
+
+  return (slice * gClusterDims.y + tile.y) * gClusterDims.x + tile.x;
+}
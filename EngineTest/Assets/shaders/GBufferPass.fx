@@ -1,3 +1,5 @@
+#include "VertexInput.hlsli"
+
 cbuffer MatrixBuffer : register(b0)
 {
     float4x4 modelViewProjection;
@@ -20,14 +22,6 @@ Texture2D gMetallicRoughnessTex : register(t2);
 Texture2D gAOTex                : register(t3);
 SamplerState gSampler : register(s0);
 
-struct VS_INPUT
-{
-    float3 position : POSITION;
-    float3 normal   : NORMAL;
-    float2 uv       : TEXCOORD0;
-    float3 tangent  : TANGENT;
-};
-
 struct VS_OUTPUT
 {
     float4 positionH : SV_POSITION;
@@ -44,8 +38,8 @@ VS_OUTPUT VS(VS_INPUT input)
     float4 posW = mul(float4(input.position, 1.0f), world);
     output.positionH = mul(float4(input.position, 1.0f), modelViewProjection);
     output.worldPos = posW.xyz;
-    float3 N = normalize(mul(input.normal, (float3x3)worldInverseTranspose));
-    float3 T = normalize(mul(input.tangent, (float3x3)worldInverseTranspose));
+    float3 N = normalize(mul(GetVertexNormal(input), (float3x3)worldInverseTranspose));
+    float3 T = normalize(mul(GetVertexTangent(input), (float3x3)worldInverseTranspose));
     float3 B = normalize(cross(N, T));
     output.normalW = N;
     output.tangentW = T;
@@ -67,7 +61,10 @@ PS_OUTPUT PS_GBuffer(VS_OUTPUT input)
     PS_OUTPUT output;
     float4 albedoSample = gAlbedoTex.Sample(gSampler, input.uv) * baseColor;
     float4 normalMapSample = gNormalTex.Sample(gSampler, input.uv);
-    float3 normalMap = normalMapSample.xyz * 2.0f - 1.0f;
+    // Z reconstruit depuis XY : valable pour les normal maps RGB comme pour les BC5 à deux canaux du cooker
+    float3 normalMap;
+    normalMap.xy = normalMapSample.xy * 2.0f - 1.0f;
+    normalMap.z = sqrt(saturate(1.0f - dot(normalMap.xy, normalMap.xy)));
     float3 N = normalize(float3(
         dot(normalMap, float3(input.tangentW.x, input.bitangentW.x, input.normalW.x)),
         dot(normalMap, float3(input.tangentW.y, input.bitangentW.y, input.normalW.y)),
@@ -1,5 +1,3 @@
-#define MAX_LIGHTS 64
-
 struct GPU_Light {
   float4 colorIntensity; // xyz = color, w = intensity
   float4 directionType; // xyz = direction, w = type (0 = Dir, 1 = Point, 2 = Spot)
@@ -8,11 +6,12 @@ struct GPU_Light {
 };
 
 cbuffer LightBuffer : register(b3) {
-  float3    cameraPosition;
-  float     lightCount;
-  GPU_Light lights[MAX_LIGHTS];
+  float3 cameraPosition;
+  float  lightCount;
 }
 
+#include "ClusteredLighting.hlsli"
+
 float3 BlinnPhongLighting(float3 positionW, float3 normalW, float3 albedo, float3 cameraPos, float3 lightDir, float lightIntensity, float3 lightColor)
 {
   float3 L = normalize(-lightDir);
@@ -1,4 +1,3 @@
-#define MAX_LIGHTS 64
 #define PI 3.14159265359
 #define SHADOW_MAP_SIZE 4096.0f
 #define LIGHT_SIZE 0.005f
@@ -12,9 +11,8 @@ struct GPU_Light {
 
 cbuffer LightBuffer : register(b3)
 {
-    float3    cameraPosition;
-    float     lightCount;
-    GPU_Light lights[MAX_LIGHTS];
+    float3 cameraPosition;
+    float  lightCount;
 }
 
 cbuffer ScreenSizeBuffer : register(b1)
@@ -38,6 +36,8 @@ cbuffer FrameData : register(b5)
     float padFD3;
 }
 
+#include "ClusteredLighting.hlsli"
+
 Texture2D gPositionTex : register(t0);
 Texture2D gNormalTex   : register(t1);
 Texture2D gAlbedoTex   : register(t2);
@@ -185,6 +185,67 @@ float3 GetIBLContribution(float3 N, float3 V, float roughness, float3 F0, float3
     return ambient;
 }
 
+float3 EvaluateLight(GPU_Light light, float3 positionW, float3 N, float3 V, float NdotV,
+                     float3 F0, float3 albedo, float metallic, float roughness)
+{
+    float3 color     = light.colorIntensity.rgb;
+    float  intensity = light.colorIntensity.w;
+
+    float3 direction = light.directionType.xyz;
+    float  type      = light.directionType.w;
+
+    float3 lightPos  = light.positionRange.xyz;
+    float  range     = light.positionRange.w;
+
+    float  spotAngle = light.spotAnglePad.x;
+
+    float3 L;
+    if (type == 0.0f) {
+        L = normalize(-direction);
+    } else if (type == 1.0f) {
+        float3 toLight = lightPos - positionW;
+        float dist = length(toLight);
+        if (dist > range) intensity = 0;
+        L = toLight/dist;
+        intensity *= saturate(1.0f - dist/range);
+    } else {
+        float3 toLight = lightPos - positionW;
+        float dist = length(toLight);
+        if (dist > range) intensity = 0;
+        L = toLight/dist;
+        float spotCos = dot(L, -normalize(direction));
+        float spotThreshold = cos(radians(spotAngle*0.5f));
+        if (spotCos < spotThreshold) intensity = 0;
+        else {
+            float atten = saturate(1.0f - dist/range);
+            float spotSmooth = (spotCos - spotThreshold)/(1.0f - spotThreshold);
+            intensity *= atten*spotSmooth;
+        }
+    }
+
+    if (intensity <= 0.0f)
+        return 0.0f;
+
+    float3 H = normalize(V+L);
+    float NdotL = saturate(dot(N,L));
+    float NdotH = saturate(dot(N,H));
+    float VdotH = saturate(dot(V,H));
+
+    float D = DistributionGGX(NdotH, roughness);
+    float G = GeometrySmith(NdotV, NdotL, roughness);
+    float3 F = FresnelSchlick(VdotH, F0);
+
+    float3 kS = F;
+    float3 kD = (1.0f - kS)*(1.0f - metallic);
+
+    float3 numerator = D*G*F;
+    float denominator = 4.0f*NdotV*NdotL+0.0001f;
+    float3 specular = numerator/denominator;
+
+    float3 diffuse = kD*albedo/PI;
+    return (diffuse+specular)*NdotL*intensity*color;
+}
+
 struct VS_OUT
 {
     float4 positionH : SV_POSITION;
@@ -230,73 +291,26 @@ float4 PS_Lighting(VS_OUT input) : SV_Target
     F0 = lerp(F0, albedo, metallic);
 
     float3 Lo = 0.0f;
-    int count = (int)lightCount;
 
+    // Les directionnelles s'appliquent toujours, les 4 premières ont une slice d'ombre
+    uint directionalCount = min(gDirectionalCount, gClusterLightCount);
     [loop]
-    for (int i = 0; i < count; i++)
+    for (uint i = 0; i < directionalCount; i++)
     {
-        float3 color     = lights[i].colorIntensity.rgb;
-        float  intensity = lights[i].colorIntensity.w;
-
-        float3 direction = lights[i].directionType.xyz;
-        float  type      = lights[i].directionType.w;
-
-        float3 lightPos  = lights[i].positionRange.xyz;
-        float  range     = lights[i].positionRange.w;
-
-        float  spotAngle = lights[i].spotAnglePad.x;
-
-        float3 L;
-        if (type == 0.0f) {
-            L = normalize(-direction);
-        } else if (type == 1.0f) {
-            float3 toLight = lightPos - positionW;
-            float dist = length(toLight);
-            if (dist > range) intensity = 0;
-            L = toLight/dist;
-            intensity *= saturate(1.0f - dist/range);
-        } else {
-            float3 toLight = lightPos - positionW;
-            float dist = length(toLight);
-            if (dist > range) intensity = 0;
-            L = toLight/dist;
-            float spotCos = dot(L, -normalize(direction));
-            float spotThreshold = cos(radians(spotAngle*0.5f));
-            if (spotCos < spotThreshold) intensity = 0;
-            else {
-                float atten = saturate(1.0f - dist/range);
-                float spotSmooth = (spotCos - spotThreshold)/(1.0f - spotThreshold);
-                intensity *= atten*spotSmooth;
-            }
+        float3 contrib = EvaluateLight(gClusterLights[i], positionW, N, V, NdotV, F0, albedo, metallic, roughness);
+        if (i < 4 && any(contrib > 0.0f)) {
+            contrib *= PCSSShadow(float4(positionW,1.0f), i);
         }
+        Lo += contrib;
+    }
 
-        if (intensity > 0.0f) {
-            float3 H = normalize(V+L);
-            float NdotL = saturate(dot(N,L));
-            float NdotH = saturate(dot(N,H));
-            float VdotH = saturate(dot(V,H));
-
-            float D = DistributionGGX(NdotH, roughness);
-            float G = GeometrySmith(NdotV, NdotL, roughness);
-            float3 F = FresnelSchlick(VdotH, F0);
-
-            float3 kS = F;
-            float3 kD = (1.0f - kS)*(1.0f - metallic);
-
-            float3 numerator = D*G*F;
-            float denominator = 4.0f*NdotV*NdotL+0.0001f;
-            float3 specular = numerator/denominator;
-
-            float3 diffuse = kD*albedo/PI;
-            float3 contrib = (diffuse+specular)*NdotL*intensity*color;
-
-            float shadowFactor=1.0f;
-            if (type == 0.0f && i<4) {
-                shadowFactor = PCSSShadow(float4(positionW,1.0f), i);
-            }
-
-            Lo += contrib*shadowFactor;
-        }
+    // Lumières locales : seulement celles assignées au cluster du pixel
+    LightCluster cluster = gLightClusters[GetClusterIndex(input.positionH.xy, positionW)];
+    [loop]
+    for (uint j = 0; j < cluster.count; j++)
+    {
+        uint lightIndex = gClusterLightIndices[cluster.offset + j];
+        Lo += EvaluateLight(gClusterLights[lightIndex], positionW, N, V, NdotV, F0, albedo, metallic, roughness);
     }
 
     float3 ibl = GetIBLContribution(N, V, roughness, F0, albedo, metallic, ao);
@@ -11,11 +11,10 @@
   }
 
 
+  // Seule la position est lue (flux 0) : le même variant sert aux formats Full et Packed
   struct VS_INPUT
   {
       float3 position : POSITION;
-      float3 normal   : NORMAL;
-      float2 uv       : TEXCOORD0;
   };
 
   struct VS_OUTPUT
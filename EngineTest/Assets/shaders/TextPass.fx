@@ -1,13 +1,6 @@
-cbuffer TransformBuffer : register(b0)
+cbuffer UIProjectionBuffer : register(b0)
 {
-    float4x4 modelViewProjection;
-    float4x4 world;
-    float4x4 worldInverseTranspose;
-};
-
-cbuffer ColorBuffer : register(b1)
-{
-    float4 uiColor;
+    float4x4 projection;
 };
 
 Texture2D fontAtlas : register(t0);
@@ -22,26 +15,38 @@ struct VS_INPUT
 {
     float2 position : POSITION;
     float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
 struct VS_OUTPUT
 {
     float4 position : SV_POSITION;
     float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
 VS_OUTPUT VS_Text(VS_INPUT input)
 {
     VS_OUTPUT output;
-    output.position = mul(float4(input.position, 0.0f, 1.0f), modelViewProjection);
+    output.position = mul(float4(input.position, 0.0f, 1.0f), projection);
     output.uv = input.uv;
+    output.color = input.color;
     return output;
 }
 
 float4 PS_Text(VS_OUTPUT input) : SV_TARGET
 {
     float4 sampled = fontAtlas.Sample(fontSampler, input.uv);
-    return float4(uiColor.rgb, sampled.r);
+#ifdef SDF_TEXT
+    // Distance signée : 0.5 sur le contour. La transition couvre environ un pixel écran
+    // quelle que soit la taille d'affichage, d'où un bord net sans atlas par taille.
+    float dist = sampled.r;
+    float width = max(fwidth(dist), 1e-4f) * 0.7f;
+    float alpha = smoothstep(0.5f - width, 0.5f + width, dist);
+    return float4(input.color.rgb, alpha);
+#else
+    return float4(input.color.rgb, sampled.r);
+#endif
 }
 
 BlendState TextBlending
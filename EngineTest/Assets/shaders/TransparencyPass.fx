@@ -1,11 +1,29 @@
 #include "LightingCommon.hlsli"
+#include "VertexInput.hlsli"
 
+#ifdef SPRITE_INSTANCING
+// Billboards de SpriteBatcher : un draw instancié par texture, la caméra donne l'orientation
+cbuffer SpriteFrameBuffer : register(b0)
+{
+    float4x4 viewProjection;
+    float4   cameraRight;
+    float4   cameraUp;
+    float4   cameraForward;
+};
+
+struct SPRITE_INSTANCE
+{
+    float4 positionOpacity : INSTANCE_POSITION;
+    float3 scale           : INSTANCE_SCALE;
+};
+#else
 cbuffer MatrixBuffer : register(b0)
 {
     float4x4 modelViewProjection;
     float4x4 world;
     float4x4 worldInverseTranspose;
 };
+#endif
 
 cbuffer MaterialBuffer : register(b1)
 {
@@ -17,21 +35,38 @@ cbuffer MaterialBuffer : register(b1)
 Texture2D gDiffuse : register(t0);
 SamplerState gSampler : register(s0);
 
-struct VS_INPUT
-{
-    float3 position : POSITION;
-    float3 normal   : NORMAL;
-    float2 uv       : TEXCOORD;
-};
-
 struct VS_OUTPUT
 {
     float4 positionH : SV_POSITION;
     float2 uv        : TEXCOORD;
     float3 normalW   : NORMAL;
     float3 worldPos  : TEXCOORD1;
+#ifdef SPRITE_INSTANCING
+    float  opacity   : TEXCOORD2;
+#endif
 };
 
+#ifdef SPRITE_INSTANCING
+VS_OUTPUT VS_Transparency(VS_INPUT input, SPRITE_INSTANCE instance)
+{
+    VS_OUTPUT output;
+
+    float3 local = input.position * instance.scale;
+    float3 posW = instance.positionOpacity.xyz + local.x * cameraRight.xyz + local.y * cameraUp.xyz +
+                  local.z * cameraForward.xyz;
+    output.positionH = mul(float4(posW, 1.0f), viewProjection);
+    output.worldPos = posW;
+
+    output.uv = input.uv;
+    // Même normale que le chemin par objet : produit par l'inverse de la matrice monde du billboard
+    float3 normal = GetVertexNormal(input);
+    float3 normalW = float3(dot(normal, cameraRight.xyz), dot(normal, cameraUp.xyz), dot(normal, cameraForward.xyz));
+    output.normalW = normalize(normalW / instance.scale);
+    output.opacity = instance.positionOpacity.w;
+
+    return output;
+}
+#else
 VS_OUTPUT VS_Transparency(VS_INPUT input)
 {
     VS_OUTPUT output;
@@ -42,17 +77,55 @@ VS_OUTPUT VS_Transparency(VS_INPUT input)
     output.worldPos = posW.xyz;
 
     output.uv = input.uv;
-    float3 normalW = mul(input.normal, (float3x3)worldInverseTranspose);
+    float3 normalW = mul(GetVertexNormal(input), (float3x3)worldInverseTranspose);
     output.normalW = normalize(normalW);
 
     return output;
 }
+#endif
 
 struct PS_OUTPUT
 {
     float4 color : SV_Target;
 };
 
+// Contribution d'une lumière, 0 si elle n'éclaire pas le fragment
+float3 ShadeTransparentLight(GPU_Light light, float3 positionW, float3 N, float3 materialDiffuse)
+{
+    float3 lightDirection = light.directionType.xyz;
+    float  lightIntensity = light.colorIntensity.w;
+    float3 lightColor = light.colorIntensity.xyz;
+
+    if (lightIntensity <= 0.0f)
+    {
+        return 0.0f;
+    }
+
+    if (light.directionType.w != 0.0f)
+    {
+        float3 delta = light.positionRange.xyz - positionW;
+        float  dist = length(delta);
+        if (dist > light.positionRange.w)
+        {
+            return 0.0f;
+        }
+        N = abs(N);
+        lightIntensity = 2.0 / (1.0 + 0.1 * dist + 0.01 * (dist * dist));
+    }
+
+    float3 color = PBRLighting(
+        positionW,
+        N,
+        materialDiffuse,
+        cameraPosition,
+        lightDirection,
+        lightIntensity,
+        lightColor
+    );
+
+    return color + ambientColorMat.rgb * materialDiffuse * 0.1f;
+}
+
 [earlydepthstencil]
 PS_OUTPUT PS_Transparency(VS_OUTPUT input)
 {
@@ -63,73 +136,33 @@ PS_OUTPUT PS_Transparency(VS_OUTPUT input)
     float3 N = normalize(input.normalW);
 
   float3 materialDiffuse = diffuseColor.rgb * baseColor.rgb;
-  float shininess = specularColor.w;
-
-  float3 V = normalize(cameraPosition - input.worldPos);
-  float3 L;
-  float3 H;
 
   if (baseColor.a < 0.1)
   {
     discard;
   }
   float3 finalColor = float3(0.0f, 0.0f, 0.0f);
-  for (int i = 0; i < 64; i++)
-  {
-    // On suppose que l'on utilise la première lumière du tableau comme éclairage principal.
-    float3 mainLightDirection = lights[i].directionType.xyz;
-    float mainLightIntensity = lights[i].colorIntensity.w;
-    float3 mainLightColor = lights[i].colorIntensity.xyz;
-
-
-    if (lights[i].directionType.w == 0.0f && mainLightIntensity > 0.0f)
-    {
-    
-      L = normalize(-mainLightDirection);
-      H = normalize(L + V);
-     
-      
-
-     
-    }
-    else if (mainLightIntensity > 0.0f)
-    {
-      float3 delta = lights[i].positionRange.xyz - input.worldPos;
-      mainLightIntensity = 2.0;
-      if (length(delta) <= lights[i].positionRange.w)
-      {
-        L = normalize(delta);
-        H = normalize(L + V);
-        N = abs(N);
-        float attenuation = 1.0 / (1.0 + 0.1 * length(delta) + 0.01 * (length(delta) * length(delta)));
-        mainLightIntensity *= attenuation;
-      }
-      else
-      {
-        continue;
-      }
 
-    }
-    else
-    {
-      continue;
-    }
-
-    float3 finalColorInt = PBRLighting(
-        input.worldPos,
-        N,
-        materialDiffuse,
-        cameraPosition,
-        mainLightDirection,
-        mainLightIntensity,
-        mainLightColor
-    );
-
-    finalColor += finalColorInt + ambientColorMat.rgb * materialDiffuse * 0.1f;
+  // Mêmes lumières que le lighting pass : les directionnelles, puis celles du cluster du fragment
+  uint directionalCount = min(gDirectionalCount, gClusterLightCount);
+  [loop]
+  for (uint i = 0; i < directionalCount; i++)
+  {
+    finalColor += ShadeTransparentLight(gClusterLights[i], input.worldPos, N, materialDiffuse);
+  }
 
+  LightCluster cluster = gLightClusters[GetClusterIndex(input.positionH.xy, input.worldPos)];
+  [loop]
+  for (uint j = 0; j < cluster.count; j++)
+  {
+    uint lightIndex = gClusterLightIndices[cluster.offset + j];
+    finalColor += ShadeTransparentLight(gClusterLights[lightIndex], input.worldPos, N, materialDiffuse);
   }
-    
 
+#ifdef SPRITE_INSTANCING
+    output.color = float4(finalColor, input.opacity);
+#else
     output.color = float4(finalColor, diffuseColor.a);
+#endif
     return output;
 }
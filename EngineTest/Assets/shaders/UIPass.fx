@@ -1,30 +1,26 @@
-cbuffer TransformBuffer : register(b0)
+cbuffer UIProjectionBuffer : register(b0)
 {
-    float4x4 modelViewProjection;
-    float4x4 world;
-    float4x4 worldInverseTranspose;
-};
-
-cbuffer ColorBuffer : register(b1)
-{
-    float4 uiColor;
+    float4x4 projection;
 };
 
 struct VSInput {
     float2 pos : POSITION;
     float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
 struct VSOutput {
     float4 position : SV_POSITION;
     float2 uv : TEXCOORD0;
+    float4 color : COLOR0;
 };
 
 VSOutput VS_UI(VSInput input)
 {
     VSOutput output;
-    output.position = mul(float4(input.pos,0,1), modelViewProjection);
+    output.position = mul(float4(input.pos,0,1), projection);
     output.uv = input.uv;
+    output.color = input.color;
     return output;
 }
 
@@ -34,5 +30,5 @@ SamplerState samLinear : register(s0);
 float4 PS_UI(VSOutput input) : SV_TARGET
 {
     float4 texColor = diffuseTex.Sample(samLinear, input.uv);
-    return texColor * uiColor;
+    return texColor * input.color;
 }
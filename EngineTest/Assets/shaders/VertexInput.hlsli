@@ -0,0 +1,46 @@
+// Entrée des sommets commune aux passes de maillage.
+// PACKED_VERTEX : le flux 0 contient les positions, le flux 1 la normale (xy) et la tangente (zw)
+// octaédriques en SNORM16 et les UV en demi-flottants (voir VertexPacking.h).
+
+#ifdef PACKED_VERTEX
+struct VS_INPUT
+{
+    float3 position      : POSITION;
+    float4 normalTangent : NORMAL;
+    float2 uv            : TEXCOORD0;
+};
+#else
+struct VS_INPUT
+{
+    float3 position : POSITION;
+    float3 normal   : NORMAL;
+    float2 uv       : TEXCOORD0;
+    float3 tangent  : TANGENT;
+};
+#endif
+
+float3 OctahedralDecode(float2 e)
+{
+    float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+    float  t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+float3 GetVertexNormal(VS_INPUT input)
+{
+#ifdef PACKED_VERTEX
+    return OctahedralDecode(input.normalTangent.xy);
+#else
+    return input.normal;
+#endif
+}
+
+float3 GetVertexTangent(VS_INPUT input)
+{
+#ifdef PACKED_VERTEX
+    return OctahedralDecode(input.normalTangent.zw);
+#else
+    return input.tangent;
+#endif
+}
@@ -25,6 +25,21 @@ namespace FrostFireEngine
       renderer.SetVisible(true);
     }
 
+    // Barre de progression du chargement, élargie à chaque frame
+    {
+      progressBar = world.CreateEntity();
+      progressBar->AddComponent<TransformComponent>();
+      auto& rectTransform = progressBar->AddComponent<RectTransformComponent>(pDevice);
+      auto& renderer = progressBar->AddComponent<UIRendererComponent>(pDevice);
+      renderer.SetColor({1.0f, 1.0f, 1.0f, 0.8f});
+      renderer.SetOpaque(false);
+
+      rectTransform.SetAnchor(RectAnchorPreset::BottomLeft);
+      rectTransform.SetAnchorOffset({0.0f, -20.0f});
+      rectTransform.SetSize({0.0f, 8.0f});
+      renderer.SetVisible(true);
+    }
+
     isMainSceneLoading = false;
     hasRenderedOnce = false;
   }
@@ -37,10 +52,17 @@ namespace FrostFireEngine
       return;
     }
 
+    // La scène principale se charge par étapes pendant que cet écran reste affiché ;
+    // le SceneManager bascule dessus une fois toutes les étapes terminées
+    auto& sceneManager = SceneManager::GetInstance();
     if (!isMainSceneLoading) {
       isMainSceneLoading = true;
-      auto& sceneManager = SceneManager::GetInstance();
-      sceneManager.SetActiveScene<MainScene>(EngineWindows::GetInstance().GetDevice());
+      sceneManager.LoadSceneAsync<MainScene>(EngineWindows::GetInstance().GetDevice());
     }
+
+    const DispositifD3D11* pDevice = EngineWindows::GetInstance().GetDevice();
+    progressBar->GetComponent<RectTransformComponent>()->SetSize({
+      pDevice->GetViewportWidth() * sceneManager.GetLoadProgress(), 8.0f
+    });
   }
 }
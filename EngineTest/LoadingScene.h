@@ -8,6 +8,7 @@ namespace FrostFireEngine {
   {
     bool isMainSceneLoading = false;
     bool hasRenderedOnce = false;
+    std::shared_ptr<Entity> progressBar;
     void Initialize(DispositifD3D11 *pDevice) override;
 
   public:
@@ -14,6 +14,9 @@
 #include <FBXEntityBuilder.h>
 #include "CarDynamicScript.h"
 #include "ECS/components/rendering/SpriteRenderer.h"
+#include "Shaders/ShaderPrewarm.h"
+#include "Shaders/techniques/GlobaleTechnique.h"
+#include "Shaders/techniques/TextTechnique.h"
 #include "ScriptDecompte.h"
 #include "AreaSpecificsScript.h"
 
@@ -27,21 +30,76 @@ namespace FrostFireEngine
 
     void Initialize(DispositifD3D11* pDevice) override
     {
-      BaseScene::Initialize(pDevice);
+      // Chargement synchrone : les étapes du chargement asynchrone, exécutées d'un bloc
+      SceneLoader loader;
+      Load(loader, pDevice);
+      loader.Finish();
+    }
 
-      AudioSystem& player = AudioSystem::Get();
-      player.PlaySound("Assets/Sounds/vroom.wav", 0.04f, true);
+    // Les trois modèles sont préparés en parallèle dès le début du chargement ; les étapes
+    // gardent l'ordre de création des entités de la scène (la carte utilise l'entité 88)
+    void Load(SceneLoader& loader, DispositifD3D11* pDevice) override
+    {
+      loader.AddStep("Interface", [this, pDevice]() { CreateInterface(pDevice); });
+      AddModelStep(loader, "Carte", pDevice, mapBuilder, MapSettings(),
+                   [this, pDevice](const FBXEntityBuilder::BuildResult& buildResult) {
+                     SetupMap(buildResult, pDevice);
+                   }, 6.0f);
+      AddModelStep(loader, "Zones hors-piste", pDevice, deadZonesBuilder, DeadZonesSettings(),
+                   [this](const FBXEntityBuilder::BuildResult& buildResult) {
+                     SetupDeadZones(buildResult);
+                   }, 2.0f);
+      loader.AddStep("Zones", [this, pDevice]() { CreateTriggers(pDevice); });
+      AddModelStep(loader, "Véhicule", pDevice, vehicleBuilder, VehicleSettings(),
+                   [this](const FBXEntityBuilder::BuildResult& buildResult) {
+                     SetupVehicle(buildResult);
+                   }, 2.0f);
+      loader.AddStep("Décor", [this, pDevice]() { CreateDecor(pDevice); });
+
+      // Variants compilés sur les threads pendant les étapes précédentes, plutôt qu'au
+      // premier dessin de la scène ; en dernier pour ne pas retarder leurs commits
+      const GlobaleTechnique globale;
+      const TextTechnique    text;
+      ShaderPrewarm::AddLoadStep(loader, {&globale, &text}, 2.0f);
+    }
+
+  private:
+    // Préparation du modèle sur un thread, puis création de ses entités par tranches
+    static void AddModelStep(SceneLoader&                                              loader,
+                             std::string                                               name,
+                             DispositifD3D11*                                          pDevice,
+                             std::unique_ptr<FBXEntityBuilder>&                        builder,
+                             const FBXEntityBuilder::BuildSettings&                    settings,
+                             std::function<void(const FBXEntityBuilder::BuildResult&)> setup,
+                             float                                                     weight)
+    {
+      builder = std::make_unique<FBXEntityBuilder>(pDevice);
+      FBXEntityBuilder* pBuilder = builder.get();
+
+      loader.AddAsyncStep(std::move(name),
+                          [pBuilder, settings]() { pBuilder->Prepare(settings); },
+                          [&builder, setup = std::move(setup)](double budgetMs) {
+                            if (!builder->Commit(budgetMs)) return false;
+                            const auto buildResult = builder->TakeResult();
+                            builder.reset();
+                            setup(buildResult);
+                            return true;
+                          }, weight);
+    }
+
+    void CreateInterface(DispositifD3D11* pDevice)
+    {
+      BaseScene::Initialize(pDevice);
 
       World& world = GetWorld();
       TextureManager& textureManager = TextureManager::GetInstance();
-      MeshManager& meshManager = MeshManager::GetInstance();
       FontManager& fontManager = FontManager::GetInstance();
-      Font* font = fontManager.LoadFont(L"Assets/Fonts/font.txt", L"Assets/Fonts/font.png",
-                                        pDevice);
+      // Texte du HUD en champ de distance : net au décompte en 100 px comme aux petits compteurs
+      Font* font = fontManager.LoadTrueTypeFont(L"Assets/Fonts/DejaVuSans.ttf", pDevice);
       InputManager::GetInstance().SetUIMode(false);
 
       //Lumière Directionelle
-      auto directionalLightEntity = world.CreateEntity();
+      directionalLightEntity = world.CreateEntity();
       {
 
         directionalLightEntity->AddComponent<LightComponent>(
@@ -83,7 +141,7 @@ namespace FrostFireEngine
       }
 
       //Aiguille du cadran
-      auto speedometerIndicator = world.CreateEntity();
+      speedometerIndicator = world.CreateEntity();
       {
         auto& transform = speedometerIndicator->AddComponent<TransformComponent>();
         auto& rectTransform = speedometerIndicator->AddComponent<RectTransformComponent>(pDevice);
@@ -110,7 +168,7 @@ namespace FrostFireEngine
       }
 
       // Décompte
-      auto decompteEntity = world.CreateEntity();
+      decompteEntity = world.CreateEntity();
       {
         auto& transform = decompteEntity->AddComponent<TransformComponent>();
         auto& rectTransform = decompteEntity->AddComponent<RectTransformComponent>(pDevice);
@@ -151,7 +209,7 @@ namespace FrostFireEngine
       
 
       // Screen Pause
-      auto screenPause = world.CreateEntity();
+      screenPause = world.CreateEntity();
       {
         auto& transform = screenPause->AddComponent<TransformComponent>();
         auto& rectTransform = screenPause->AddComponent<RectTransformComponent>(pDevice);
@@ -275,7 +333,7 @@ namespace FrostFireEngine
       }
 
       // Victory Screen
-      auto screenGameOver = world.CreateEntity();
+      screenGameOver = world.CreateEntity();
       {
         auto& transform = screenGameOver->AddComponent<TransformComponent>();
         auto& rectTransform = screenGameOver->AddComponent<RectTransformComponent>(pDevice);
@@ -292,76 +350,92 @@ namespace FrostFireEngine
             static_cast<float>(std::min(pDevice->GetHeight(), texture->GetHeight()))});
 
       }
+    }
 
-      // Load Map
-      {
+    static FBXEntityBuilder::BuildSettings MapSettings()
+    {
+      FBXEntityBuilder::BuildSettings settings;
+      settings.fbxPath = "Assets/objects/test/MapFinale2.fbx";
+      settings.scaleFactor = 0.01f;
+
+      settings.flipUVs = true;
+      settings.generateColliders = true;
+      settings.colliderMeshType = ColliderComponent::MeshType::Triangle;
+      return settings;
+    }
 
-        FBXEntityBuilder                builder(pDevice);
-        FBXEntityBuilder::BuildSettings settings;
-        settings.fbxPath = "Assets/objects/test/MapFinale2.fbx";
-        settings.scaleFactor = 0.01f;
-
-        settings.flipUVs = true;
-        settings.generateColliders = true;
-        settings.colliderMeshType = ColliderComponent::MeshType::Triangle;
-        if (auto buildResult = builder.BuildFromFile(settings); buildResult.success) {
-          if (buildResult.rootEntity->GetId() != INVALID_ENTITY_ID) {
-            TransformComponent& transform = *buildResult.rootEntity->GetComponent<
-              TransformComponent>();
-
-            transform.SetPosition({0.0f, -30.0f, 0.0f});
-
-            buildResult.rootEntity->AddComponent<ColliderComponent>(
-              ColliderComponent(ColliderComponent::Type::Box));
-            buildResult.rootEntity->GetComponent<ColliderComponent>()->Initialize({
-              1.0f, -1.0f, 1.0f
-            });
-            buildResult.rootEntity->AddComponent<RigidBodyComponent>(
-              RigidBodyComponent::Type::Static).Initialize();
-          }
-        }
+    void SetupMap(const FBXEntityBuilder::BuildResult& buildResult, DispositifD3D11* pDevice)
+    {
+      World& world = GetWorld();
+      TextureManager& textureManager = TextureManager::GetInstance();
 
+      if (buildResult.success) {
+        if (buildResult.rootEntity->GetId() != INVALID_ENTITY_ID) {
+          TransformComponent& transform = *buildResult.rootEntity->GetComponent<
+            TransformComponent>();
 
-        auto entity = world.GetEntity(88);
-        auto mapRenderer = entity->GetComponent<PBRRenderer>();
-        //mapRenderer->SetAlbedoTexture(textureManager.GetNewTexture(L"Assets/objects/test/terrain/color.jpg", pDevice));
-        mapRenderer->SetAOMap(textureManager.GetNewTexture(L"Assets/objects/test/terrain/ao.jpg", pDevice));
-        mapRenderer->SetNormalMap(textureManager.GetNewTexture(L"Assets/objects/test/terrain/normal.jpg", pDevice));
-        mapRenderer->SetMetallicRoughnessMap(textureManager.GetNewTexture(L"Assets/objects/test/terrain/roughness.jpg", pDevice));
+          transform.SetPosition({0.0f, -30.0f, 0.0f});
+
+          buildResult.rootEntity->AddComponent<ColliderComponent>(
+            ColliderComponent(ColliderComponent::Type::Box));
+          buildResult.rootEntity->GetComponent<ColliderComponent>()->Initialize({
+            1.0f, -1.0f, 1.0f
+          });
+          buildResult.rootEntity->AddComponent<RigidBodyComponent>(
+            RigidBodyComponent::Type::Static).Initialize();
+        }
       }
 
-      //Zones hors-piste
-      //Lacs de glace et de lave
-      {
 
-        FBXEntityBuilder                builder(pDevice);
-        FBXEntityBuilder::BuildSettings settings;
-        settings.fbxPath = "Assets/objects/test/DeadZones.fbx";
-        settings.scaleFactor = 0.01f;
-
-        settings.flipUVs = true;
-        settings.generateColliders = true;
-        settings.colliderMeshType = ColliderComponent::MeshType::Triangle;
-        if (auto buildResult = builder.BuildFromFile(settings); buildResult.success) {
-          if (buildResult.rootEntity->GetId() != INVALID_ENTITY_ID) {
-            TransformComponent &transform = *buildResult.rootEntity->GetComponent<
-              TransformComponent>();
-
-            transform.SetPosition({ 0.0f, -30.0f, 0.0f });
-
-            buildResult.rootEntity->AddComponent<ColliderComponent>(
-              ColliderComponent(ColliderComponent::Type::Box));
-            buildResult.rootEntity->GetComponent<ColliderComponent>()->Initialize({
-              1.0f, -1.0f, 1.0f
-              });
-            buildResult.rootEntity->AddComponent<RigidBodyComponent>(
-              RigidBodyComponent::Type::Static).Initialize();
-
-            buildResult.rootEntity->AddComponent<DeadZoneScript>();
-          }
-        }
+      auto entity = world.GetEntity(88);
+      auto mapRenderer = entity->GetComponent<PBRRenderer>();
+      //mapRenderer->SetAlbedoTexture(textureManager.GetNewTexture(L"Assets/objects/test/terrain/color.jpg", pDevice));
+      mapRenderer->SetAOMap(textureManager.GetNewTexture(L"Assets/objects/test/terrain/ao.jpg", pDevice));
+      mapRenderer->SetNormalMap(textureManager.GetNewTexture(L"Assets/objects/test/terrain/normal.jpg", pDevice));
+      mapRenderer->SetMetallicRoughnessMap(textureManager.GetNewTexture(L"Assets/objects/test/terrain/roughness.jpg", pDevice));
+    }
+
+    //Zones hors-piste
+    //Lacs de glace et de lave
+    static FBXEntityBuilder::BuildSettings DeadZonesSettings()
+    {
+      FBXEntityBuilder::BuildSettings settings;
+      settings.fbxPath = "Assets/objects/test/DeadZones.fbx";
+      settings.scaleFactor = 0.01f;
+
+      settings.flipUVs = true;
+      settings.generateColliders = true;
+      settings.colliderMeshType = ColliderComponent::MeshType::Triangle;
+      return settings;
+    }
+
+    void SetupDeadZones(const FBXEntityBuilder::BuildResult& buildResult)
+    {
+      if (buildResult.success) {
+        if (buildResult.rootEntity->GetId() != INVALID_ENTITY_ID) {
+          TransformComponent &transform = *buildResult.rootEntity->GetComponent<
+            TransformComponent>();
 
+          transform.SetPosition({ 0.0f, -30.0f, 0.0f });
+
+          buildResult.rootEntity->AddComponent<ColliderComponent>(
+            ColliderComponent(ColliderComponent::Type::Box));
+          buildResult.rootEntity->GetComponent<ColliderComponent>()->Initialize({
+            1.0f, -1.0f, 1.0f
+            });
+          buildResult.rootEntity->AddComponent<RigidBodyComponent>(
+            RigidBodyComponent::Type::Static).Initialize();
+
+          buildResult.rootEntity->AddComponent<DeadZoneScript>();
+        }
       }
+    }
+
+    void CreateTriggers(DispositifD3D11* pDevice)
+    {
+      World& world = GetWorld();
+      MeshManager& meshManager = MeshManager::GetInstance();
+
       //Zone interdite à côté du premier checkpoint
       {
         auto     cubeEntity = world.CreateEntity();
@@ -436,8 +510,8 @@ namespace FrostFireEngine
       }
 
       //Checkpoints
-      int *checkPointManager = new int(0);
-      std::vector<EntityId> checkpointList;
+      checkPointManager = new int(0);
+      checkpointList.clear();
 
       //Premier checkpoint - et l'arrivée accesoirement
       {
@@ -616,47 +690,60 @@ namespace FrostFireEngine
         cubeEntity->AddComponent<AreaSpecificsScript>(directionalLightEntity->GetId(), AreaSpecificsScript::Specifics::LIGHTER);
       
       }
+    }
+
+    static FBXEntityBuilder::BuildSettings VehicleSettings()
+    {
+      FBXEntityBuilder::BuildSettings settings;
+      settings.fbxPath = "Assets/objects/test/LP_VehicleA.fbx";
+      settings.scaleFactor = 0.008f;
+      settings.generateColliders = true;
+      return settings;
+    }
+
+    void SetupVehicle(const FBXEntityBuilder::BuildResult& buildResult)
+    {
+      World& world = GetWorld();
+
+      if (buildResult.success) {
+        if (buildResult.rootEntity->GetId() != INVALID_ENTITY_ID) {
+          TransformComponent& transform = *buildResult.rootEntity->GetComponent<
+            TransformComponent>();
+          transform.SetRotation({0.f, -0.7071068f, 0, 0.7071068f});
+          auto parent = world.CreateEntity();
+
+          TransformComponent& transformParent = parent->AddComponent<TransformComponent>();
+          transformParent.SetPosition({87.5f, -20.5f, -35.5f});
+
+          transformParent.AddChild(buildResult.rootEntity->GetId());
+          transformParent.SetRotation({0.f, 0.7071068f, 0.f, 0.7071068f});
+
+          parent->AddComponent<RigidBodyComponent>(RigidBodyComponent::Type::Dynamic).
+                  Initialize();
+          parent->AddComponent<CarDynamicScript>();
+          parent->AddComponent<ScriptPauseManager>(screenPause->GetId());
+          parent->AddComponent<VictoryScript>(checkPointManager, checkpointList,
+                                              screenGameOver->GetId());
+          auto scriptCamera = freeCameraEntity->AddComponent<CameraScript>(
+            cameraTPSEntity->GetId(), cameraFPSEntity->GetId(), freeCameraEntity->GetId(),
+            buildResult.rootEntity->GetId()
+          );
+
+          decompteEntity->AddComponent<ScriptDecompte>(parent->GetId());
+
+          speedometerIndicator->AddComponent<ScriptSpeedometer>(parent->GetId());
+
+          decompteEntity->AddComponent<ScriptDecompte>(parent->GetId());
 
-      // Load Vehicle
-      {
-        FBXEntityBuilder                builder(pDevice);
-        FBXEntityBuilder::BuildSettings settings;
-        settings.fbxPath = "Assets/objects/test/LP_VehicleA.fbx";
-        settings.scaleFactor = 0.008f;
-        settings.generateColliders = true;
-        if (auto buildResult = builder.BuildFromFile(settings); buildResult.success) {
-          if (buildResult.rootEntity->GetId() != INVALID_ENTITY_ID) {
-            TransformComponent& transform = *buildResult.rootEntity->GetComponent<
-              TransformComponent>();
-            transform.SetRotation({0.f, -0.7071068f, 0, 0.7071068f});
-            auto parent = world.CreateEntity();
-
-            TransformComponent& transformParent = parent->AddComponent<TransformComponent>();
-            transformParent.SetPosition({87.5f, -20.5f, -35.5f});
-
-            transformParent.AddChild(buildResult.rootEntity->GetId());
-            transformParent.SetRotation({0.f, 0.7071068f, 0.f, 0.7071068f});
-
-            parent->AddComponent<RigidBodyComponent>(RigidBodyComponent::Type::Dynamic).
-                    Initialize();
-            parent->AddComponent<CarDynamicScript>();
-            parent->AddComponent<ScriptPauseManager>(screenPause->GetId());
-            parent->AddComponent<VictoryScript>(checkPointManager, checkpointList,
-                                                screenGameOver->GetId());
-            auto scriptCamera = freeCameraEntity->AddComponent<CameraScript>(
-              cameraTPSEntity->GetId(), cameraFPSEntity->GetId(), freeCameraEntity->GetId(),
-              buildResult.rootEntity->GetId()
-            );
-
-            decompteEntity->AddComponent<ScriptDecompte>(parent->GetId());
-
-            speedometerIndicator->AddComponent<ScriptSpeedometer>(parent->GetId());
-
-            decompteEntity->AddComponent<ScriptDecompte>(parent->GetId());
-
-          }
         }
       }
+    }
+
+    void CreateDecor(DispositifD3D11* pDevice)
+    {
+      World& world = GetWorld();
+      TextureManager& textureManager = TextureManager::GetInstance();
+      MeshManager& meshManager = MeshManager::GetInstance();
 
       //Zone de boost
 
@@ -886,6 +973,9 @@ namespace FrostFireEngine
 
 
       world.BuildOctree();
+
+      AudioSystem& player = AudioSystem::Get();
+      player.PlaySound("Assets/Sounds/vroom.wav", 0.04f, true);
     }
 
   protected:
@@ -1481,5 +1571,18 @@ namespace FrostFireEngine
     std::shared_ptr<Entity> freeCameraEntity;
     std::shared_ptr<Entity> cameraTPSEntity;
     std::shared_ptr<Entity> cameraFPSEntity;
+
+    std::shared_ptr<Entity> directionalLightEntity;
+    std::shared_ptr<Entity> speedometerIndicator;
+    std::shared_ptr<Entity> decompteEntity;
+    std::shared_ptr<Entity> screenPause;
+    std::shared_ptr<Entity> screenGameOver;
+    int*                    checkPointManager = nullptr;
+    std::vector<EntityId>   checkpointList;
+
+    // Imports en cours pendant le chargement de la scène
+    std::unique_ptr<FBXEntityBuilder> mapBuilder;
+    std::unique_ptr<FBXEntityBuilder> deadZonesBuilder;
+    std::unique_ptr<FBXEntityBuilder> vehicleBuilder;
   };
 }
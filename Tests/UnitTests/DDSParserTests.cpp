@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Engine/Textures/DDSParser.h"
+#include "TestFramework.h"
+
+using namespace FrostFireEngine;
+
+namespace
+{
+  constexpr uint32_t BC1_UNORM = 71;
+  constexpr uint32_t BC3_UNORM = 77;
+  constexpr uint32_t R8G8B8A8_UNORM = 28;
+  constexpr uint32_t DDS_MISC_TEXTURECUBE = 0x4;
+
+  struct DDSDesc {
+    uint32_t width = 256;
+    uint32_t height = 128;
+    uint32_t mipCount = 1;
+    uint32_t dxgiFormat = BC1_UNORM;
+    uint32_t arraySize = 1;
+    uint32_t miscFlag = 0;
+    bool     dx10 = true;  // sinon en-tête classique, fourCC ou masques selon le format
+    uint32_t dataSize = 0;  // 0 : taille exacte des sous-ressources
+  };
+
+  uint32_t GetDataSize(const DDSDesc& desc)
+  {
+    const bool     compressed = desc.dxgiFormat != R8G8B8A8_UNORM;
+    const uint32_t blockBytes = desc.dxgiFormat == BC1_UNORM ? 8 : 16;
+    const uint32_t items = desc.arraySize * (desc.miscFlag & DDS_MISC_TEXTURECUBE ? 6 : 1);
+
+    // mipMapCount nul : un seul niveau
+    uint32_t total = 0;
+    for (uint32_t mip = 0; mip < std::max(desc.mipCount, 1u); mip++) {
+      const uint32_t width = std::max(desc.width >> mip, 1u);
+      const uint32_t height = std::max(desc.height >> mip, 1u);
+      total += compressed ? ((width + 3) / 4) * ((height + 3) / 4) * blockBytes : width * height * 4;
+    }
+    return total * items;
+  }
+
+  std::vector<uint8_t> MakeDDS(const DDSDesc& desc)
+  {
+    DDSHeader header{};
+    header.size = sizeof(DDSHeader);
+    header.flags = DDS_FLAGS_CAPS | DDS_FLAGS_HEIGHT | DDS_FLAGS_WIDTH | DDS_FLAGS_PIXELFORMAT | DDS_FLAGS_MIPMAPCOUNT;
+    header.width = desc.width;
+    header.height = desc.height;
+    header.mipMapCount = desc.mipCount;
+    header.pixelFormat.size = sizeof(DDSPixelFormat);
+    header.caps = DDS_CAPS_TEXTURE | (desc.mipCount > 1 ? DDS_CAPS_MIPMAP | DDS_CAPS_COMPLEX : 0);
+
+    if (desc.dx10) {
+      header.pixelFormat.flags = DDS_PIXELFORMAT_FOURCC;
+      header.pixelFormat.fourCC = DDS_FOURCC_DX10;
+    }
+    else if (desc.dxgiFormat == R8G8B8A8_UNORM) {
+      header.pixelFormat.flags = 0x40 | 0x1;  // RGB | ALPHAPIXELS
+      header.pixelFormat.rgbBitCount = 32;
+      header.pixelFormat.rBitMask = 0x000000FF;
+      header.pixelFormat.gBitMask = 0x0000FF00;
+      header.pixelFormat.bBitMask = 0x00FF0000;
+      header.pixelFormat.aBitMask = 0xFF000000;
+    }
+    else {
+      header.pixelFormat.flags = DDS_PIXELFORMAT_FOURCC;
+      header.pixelFormat.fourCC = desc.dxgiFormat == BC1_UNORM ? MakeDDSFourCC('D', 'X', 'T', '1')
+                                                               : MakeDDSFourCC('D', 'X', 'T', '5');
+    }
+
+    std::vector<uint8_t> file(sizeof(uint32_t) + sizeof(DDSHeader));
+    memcpy(file.data(), &DDS_MAGIC, sizeof(uint32_t));
+    memcpy(file.data() + sizeof(uint32_t), &header, sizeof(header));
+
+    if (desc.dx10) {
+      DDSHeaderDX10 dx10{};
+      dx10.dxgiFormat = desc.dxgiFormat;
+      dx10.resourceDimension = DDS_DIMENSION_TEXTURE2D;
+      dx10.miscFlag = desc.miscFlag;
+      dx10.arraySize = desc.arraySize;
+      const size_t offset = file.size();
+      file.resize(offset + sizeof(dx10));
+      memcpy(file.data() + offset, &dx10, sizeof(dx10));
+    }
+
+    // Motif qui dépend de la position : une sous-ressource mal placée se voit
+    const size_t headerSize = file.size();
+    file.resize(headerSize + (desc.dataSize > 0 ? desc.dataSize : GetDataSize(desc)));
+    for (size_t i = headerSize; i < file.size(); i++) {
+      file[i] = static_cast<uint8_t>(i * 31);
+    }
+    return file;
+  }
+
+  // Copie dans un bloc de la taille exacte : toute lecture au-delà est visible sous ASan
+  DDSParseError Parse(const std::vector<uint8_t>& file, size_t size, DDSTextureDesc& desc)
+  {
+    const auto exact = std::make_unique<uint8_t[]>(size > 0 ? size : 1);
+    if (size > 0) {
+      memcpy(exact.get(), file.data(), size);
+    }
+    return ParseDDS(size > 0 ? exact.get() : nullptr, size, desc);
+  }
+
+  bool SubresourcesInBounds(const DDSTextureDesc& desc, size_t size)
+  {
+    for (const DDSSubresource& subresource : desc.subresources) {
+      if (subresource.offset > size || subresource.slicePitch > size - subresource.offset) return false;
+    }
+    return true;
+  }
+
+  void SetMipCount(std::vector<uint8_t>& file, uint32_t mipCount)
+  {
+    memcpy(file.data() + sizeof(uint32_t) + offsetof(DDSHeader, mipMapCount), &mipCount, sizeof(mipCount));
+  }
+}
+
+TEST_CASE(DDSParser_ValidTextures)
+{
+  DDSDesc bc1;
+  bc1.mipCount = 9;  // 256x128 -> 1x1
+  const auto bc1File = MakeDDS(bc1);
+
+  DDSTextureDesc desc;
+  REQUIRE(Parse(bc1File, bc1File.size(), desc) == DDSParseError::None);
+  CHECK(desc.dxgiFormat == BC1_UNORM);
+  CHECK(desc.isBlockCompressed);
+  CHECK(desc.width == 256 && desc.height == 128 && desc.mipCount == 9);
+  REQUIRE(desc.subresources.size() == 9);
+  CHECK(desc.subresources[0].rowPitch == 64 * 8);
+  CHECK(desc.subresources.back().slicePitch == 8);  // un bloc pour les mips < 4x4
+  CHECK(desc.subresources.back().offset + desc.subresources.back().slicePitch == bc1File.size());
+
+  // Sous-ressources contiguës
+  for (size_t i = 1; i < desc.subresources.size(); i++) {
+    CHECK(desc.subresources[i].offset == desc.subresources[i - 1].offset + desc.subresources[i - 1].slicePitch);
+  }
+
+  // En-tête classique DXT5 et RGBA8 par masques
+  DDSDesc legacy;
+  legacy.dx10 = false;
+  legacy.dxgiFormat = BC3_UNORM;
+  const auto dxt5 = MakeDDS(legacy);
+  CHECK(Parse(dxt5, dxt5.size(), desc) == DDSParseError::None);
+  CHECK(desc.dxgiFormat == BC3_UNORM);
+
+  legacy.dxgiFormat = R8G8B8A8_UNORM;
+  legacy.mipCount = 0;  // absent : un seul niveau
+  const auto rgba = MakeDDS(legacy);
+  CHECK(Parse(rgba, rgba.size(), desc) == DDSParseError::None);
+  CHECK(desc.dxgiFormat == R8G8B8A8_UNORM);
+  CHECK(desc.mipCount == 1);
+  CHECK(!desc.isBlockCompressed);
+  CHECK(desc.subresources.size() == 1 && desc.subresources[0].rowPitch == 256 * 4);
+
+  // Cube map : 6 éléments de mipCount sous-ressources
+  DDSDesc cube;
+  cube.width = cube.height = 64;
+  cube.mipCount = 7;
+  cube.miscFlag = DDS_MISC_TEXTURECUBE;
+  const auto cubeFile = MakeDDS(cube);
+  CHECK(Parse(cubeFile, cubeFile.size(), desc) == DDSParseError::None);
+  CHECK(desc.isCubeMap && desc.arraySize == 6);
+  CHECK(desc.subresources.size() == 6 * 7);
+}
+
+TEST_CASE(DDSParser_TruncatedFiles)
+{
+  DDSDesc dx10;
+  dx10.mipCount = 9;
+  DDSDesc legacy;
+  legacy.dx10 = false;
+  legacy.mipCount = 4;
+
+  for (const DDSDesc& source : {dx10, legacy}) {
+    const auto     file = MakeDDS(source);
+    const size_t   headerSize = sizeof(uint32_t) + sizeof(DDSHeader) + (source.dx10 ? sizeof(DDSHeaderDX10) : 0);
+    DDSTextureDesc desc;
+
+    // Chaque préfixe strict est refusé : en-tête incomplet, puis données tronquées
+    for (size_t size = 0; size < file.size(); size++) {
+      const DDSParseError error = Parse(file, size, desc);
+      if (size < headerSize) {
+        CHECK(error == DDSParseError::TooSmall);
+      }
+      else {
+        CHECK(error == DDSParseError::Truncated);
+      }
+    }
+    CHECK(Parse(file, file.size(), desc) == DDSParseError::None);
+  }
+}
+
+TEST_CASE(DDSParser_OversizedMipCount)
+{
+  DDSDesc source;
+  source.width = source.height = 256;
+  source.mipCount = 9;
+  auto file = MakeDDS(source);
+
+  DDSTextureDesc desc;
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::None);
+
+  // Au-delà de la chaîne complète (9 niveaux pour 256), avant toute allocation par sous-ressource
+  for (const uint32_t mipCount : {10u, 32u, 0xFFFFu, 0xFFFFFFFFu}) {
+    SetMipCount(file, mipCount);
+    CHECK(Parse(file, file.size(), desc) == DDSParseError::BadDimensions);
+    CHECK(desc.subresources.empty());
+  }
+
+  // Un nombre de mips plausible mais sans les données correspondantes
+  source.mipCount = 1;
+  file = MakeDDS(source);
+  SetMipCount(file, 9);
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::Truncated);
+}
+
+TEST_CASE(DDSParser_InvalidHeaders)
+{
+  DDSTextureDesc desc;
+
+  auto file = MakeDDS({});
+  file[0] = 'X';
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::BadMagic);
+
+  file = MakeDDS({});
+  file[sizeof(uint32_t)] = 100;  // header.size
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::BadHeader);
+
+  DDSDesc source;
+  source.width = 0;
+  file = MakeDDS(source);
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::BadDimensions);
+
+  source = {};
+  source.width = 32768;
+  source.dataSize = 16;
+  file = MakeDDS(source);
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::BadDimensions);
+
+  // Tableaux vide ou démesuré
+  for (const uint32_t arraySize : {0u, 4096u, 0xFFFFFFFFu}) {
+    source = {};
+    source.arraySize = arraySize;
+    source.dataSize = 16;
+    file = MakeDDS(source);
+    CHECK(Parse(file, file.size(), desc) == DDSParseError::BadHeader);
+  }
+
+  // Cube map non carrée
+  source = {};
+  source.miscFlag = DDS_MISC_TEXTURECUBE;
+  file = MakeDDS(source);
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::BadDimensions);
+
+  // Format DXGI inconnu
+  source = {};
+  source.dxgiFormat = 200;
+  source.dataSize = 16;
+  file = MakeDDS(source);
+  CHECK(Parse(file, file.size(), desc) == DDSParseError::UnsupportedFormat);
+}
+
+TEST_CASE(DDSParser_FuzzHeaderMutations)
+{
+  DDSDesc dx10;
+  dx10.mipCount = 6;
+  DDSDesc legacy;
+  legacy.dx10 = false;
+  legacy.mipCount = 3;
+  const std::vector<uint8_t> sources[] = {MakeDDS(dx10), MakeDDS(legacy)};
+
+  std::mt19937                            random(2024);
+  std::uniform_int_distribution<uint32_t> byteValue(0, 255);
+  DDSTextureDesc                          desc;
+
+  for (int iteration = 0; iteration < 20000; iteration++) {
+    std::vector<uint8_t> file = sources[iteration % 2];
+    const size_t         headerSize = sizeof(uint32_t) + sizeof(DDSHeader) + sizeof(DDSHeaderDX10);
+
+    // Quelques octets de l'en-tête modifiés, parfois un champ entier mis à une valeur extrême
+    const int mutations = 1 + static_cast<int>(random() % 4);
+    for (int m = 0; m < mutations; m++) {
+      const size_t offset = random() % headerSize;
+      if (random() % 4 == 0 && offset + sizeof(uint32_t) <= headerSize) {
+        const uint32_t extreme = random() % 2 ? 0xFFFFFFFFu : 0x80000000u;
+        memcpy(file.data() + (offset & ~size_t(3)), &extreme, sizeof(extreme));
+      }
+      else {
+        file[offset] = static_cast<uint8_t>(byteValue(random));
+      }
+    }
+    const size_t size = random() % 8 == 0 ? random() % file.size() : file.size();
+
+    // Jamais de lecture hors du fichier ; un succès ne décrit que des données présentes
+    if (Parse(file, size, desc) == DDSParseError::None) {
+      REQUIRE(SubresourcesInBounds(desc, size));
+      CHECK(desc.subresources.size() == size_t(desc.arraySize) * desc.mipCount);
+    }
+  }
+}
@@ -0,0 +1,238 @@
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Engine/ECS/systems/rendering/LightClusterGrid.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+namespace
+{
+  constexpr float FOV_Y = XM_PIDIV4;
+  constexpr float ASPECT = 16.0f / 9.0f;
+  constexpr float NEAR_Z = 0.1f;
+  constexpr float FAR_Z = 1000.0f;
+
+  XMMATRIX MakeProjection()
+  {
+    return XMMatrixPerspectiveFovLH(FOV_Y, ASPECT, NEAR_Z, FAR_Z);
+  }
+
+  ClusterLight MakePointLight(float x, float y, float z, float range, uint32_t index)
+  {
+    ClusterLight light;
+    light.positionVS = XMFLOAT3(x, y, z);
+    light.range = range;
+    light.directionVS = XMFLOAT3(0.0f, 0.0f, 1.0f);
+    light.cosHalfAngle = -2.0f;
+    light.sinHalfAngle = 0.0f;
+    light.index = index;
+    return light;
+  }
+
+  ClusterLight MakeSpotLight(float x, float y, float z, float range, XMFLOAT3 direction,
+                             float angleDegrees, uint32_t index)
+  {
+    ClusterLight light = MakePointLight(x, y, z, range, index);
+    XMStoreFloat3(&light.directionVS, XMVector3Normalize(XMLoadFloat3(&direction)));
+    XMScalarSinCos(&light.sinHalfAngle, &light.cosHalfAngle, XMConvertToRadians(angleDegrees * 0.5f));
+    return light;
+  }
+
+  XMFLOAT2 ProjectToNdc(const XMFLOAT3& positionVS)
+  {
+    XMFLOAT4X4 proj;
+    XMStoreFloat4x4(&proj, MakeProjection());
+    return XMFLOAT2(positionVS.x * proj._11 / positionVS.z, positionVS.y * proj._22 / positionVS.z);
+  }
+
+  bool IsOnScreen(const XMFLOAT3& positionVS)
+  {
+    const XMFLOAT2 ndc = ProjectToNdc(positionVS);
+    return positionVS.z > NEAR_Z && std::fabs(ndc.x) < 1.0f && std::fabs(ndc.y) < 1.0f;
+  }
+
+  // Cluster qui contient un point de l'espace vue, même découpage que GetClusterIndex du shader
+  uint32_t GetClusterForPoint(const LightClusterGrid& grid, const XMFLOAT3& positionVS)
+  {
+    const XMFLOAT2 ndc = ProjectToNdc(positionVS);
+    const auto     tileX = static_cast<uint32_t>((ndc.x * 0.5f + 0.5f) * LightClusterGrid::TILES_X);
+    const auto     tileY = static_cast<uint32_t>((0.5f - ndc.y * 0.5f) * LightClusterGrid::TILES_Y);
+
+    return LightClusterGrid::GetClusterIndex(std::min(tileX, LightClusterGrid::TILES_X - 1),
+      std::min(tileY, LightClusterGrid::TILES_Y - 1), grid.GetSliceForDepth(positionVS.z));
+  }
+
+  bool ClusterContains(const LightClusterGrid& grid, uint32_t clusterIndex, uint32_t lightIndex)
+  {
+    const LightCluster& cluster = grid.GetClusters()[clusterIndex];
+    const auto&         indices = grid.GetLightIndices();
+    return std::find(indices.begin() + cluster.offset, indices.begin() + cluster.offset + cluster.count,
+      lightIndex) != indices.begin() + cluster.offset + cluster.count;
+  }
+
+  size_t CountClustersWithLight(const LightClusterGrid& grid, uint32_t lightIndex)
+  {
+    size_t count = 0;
+    for (uint32_t c = 0; c < LightClusterGrid::CLUSTER_COUNT; c++) {
+      if (ClusterContains(grid, c, lightIndex)) {
+        ++count;
+      }
+    }
+    return count;
+  }
+}
+
+TEST_CASE(LightClusterGrid_ProjectionDepthRange)
+{
+  LightClusterGrid grid;
+  grid.UpdateProjection(MakeProjection());
+
+  CHECK(std::fabs(grid.GetNearZ() - NEAR_Z) < 1e-4f);
+  CHECK(std::fabs(grid.GetFarZ() - FAR_Z) / FAR_Z < 1e-2f);
+
+  CHECK(grid.GetSliceForDepth(NEAR_Z * 0.5f) == 0);
+  CHECK(grid.GetSliceForDepth(FAR_Z * 2.0f) == LightClusterGrid::SLICES_Z - 1);
+
+  // Tranches exponentielles : monotones avec la profondeur
+  uint32_t previous = 0;
+  for (float z = NEAR_Z; z < FAR_Z; z *= 1.1f) {
+    const uint32_t slice = grid.GetSliceForDepth(z);
+    CHECK(slice >= previous);
+    previous = slice;
+  }
+}
+
+TEST_CASE(LightClusterGrid_EmptyBuild)
+{
+  LightClusterGrid grid;
+  grid.UpdateProjection(MakeProjection());
+  grid.Build(nullptr, 0);
+
+  CHECK(grid.GetClusters().size() == LightClusterGrid::CLUSTER_COUNT);
+  CHECK(grid.GetLightIndices().empty());
+  for (const LightCluster& cluster : grid.GetClusters()) {
+    CHECK(cluster.count == 0);
+  }
+}
+
+TEST_CASE(LightClusterGrid_PointLightBinning)
+{
+  LightClusterGrid grid;
+  grid.UpdateProjection(MakeProjection());
+
+  const ClusterLight lights[] = {
+    MakePointLight(0.0f, 0.0f, 20.0f, 2.0f, 7),
+    MakePointLight(-30.0f, 10.0f, 80.0f, 5.0f, 3),
+  };
+  grid.Build(lights, 2);
+
+  // Chaque lumière est dans le cluster qui contient son centre
+  for (const ClusterLight& light : lights) {
+    CHECK(ClusterContains(grid, GetClusterForPoint(grid, light.positionVS), light.index));
+  }
+
+  // Une lumière de faible portée ne touche qu'une poignée de clusters, loin de la grille entière
+  const size_t touched = CountClustersWithLight(grid, 7);
+  CHECK(touched >= 1);
+  CHECK(touched < 64);
+
+  // Aucun cluster éloigné en profondeur ne la référence
+  const uint32_t farSlice = grid.GetSliceForDepth(500.0f);
+  for (uint32_t y = 0; y < LightClusterGrid::TILES_Y; y++) {
+    for (uint32_t x = 0; x < LightClusterGrid::TILES_X; x++) {
+      CHECK(!ClusterContains(grid, LightClusterGrid::GetClusterIndex(x, y, farSlice), 7));
+    }
+  }
+}
+
+TEST_CASE(LightClusterGrid_OffsetsAreContiguous)
+{
+  LightClusterGrid grid;
+  grid.UpdateProjection(MakeProjection());
+
+  std::mt19937                          random(1234);
+  std::uniform_real_distribution<float> lateral(-60.0f, 60.0f);
+  std::uniform_real_distribution<float> depth(1.0f, 300.0f);
+  std::uniform_real_distribution<float> range(1.0f, 25.0f);
+
+  std::vector<ClusterLight> lights;
+  for (uint32_t i = 0; i < 500; i++) {
+    lights.push_back(MakePointLight(lateral(random), lateral(random), depth(random), range(random), i));
+  }
+  grid.Build(lights.data(), lights.size());
+
+  // Les listes des clusters se suivent sans trou dans le buffer d'indices
+  uint32_t expectedOffset = 0;
+  for (const LightCluster& cluster : grid.GetClusters()) {
+    CHECK(cluster.offset == expectedOffset);
+    CHECK(cluster.count <= LightClusterGrid::MAX_LIGHTS_PER_CLUSTER);
+    expectedOffset += cluster.count;
+  }
+  CHECK(expectedOffset == grid.GetLightIndices().size());
+
+  for (const uint32_t index : grid.GetLightIndices()) {
+    CHECK(index < lights.size());
+  }
+
+  // Reconstruire avec les mêmes lumières donne exactement le même résultat
+  const std::vector<uint32_t> firstIndices = grid.GetLightIndices();
+  grid.Build(lights.data(), lights.size());
+  CHECK(grid.GetLightIndices() == firstIndices);
+
+  // Chaque lumière visible est dans le cluster de son centre (sauf cluster saturé)
+  for (const ClusterLight& light : lights) {
+    if (IsOnScreen(light.positionVS)) {
+      const uint32_t cluster = GetClusterForPoint(grid, light.positionVS);
+      CHECK(grid.GetClusters()[cluster].count == LightClusterGrid::MAX_LIGHTS_PER_CLUSTER ||
+        ClusterContains(grid, cluster, light.index));
+    }
+  }
+}
+
+TEST_CASE(LightClusterGrid_SpotConeCulling)
+{
+  LightClusterGrid grid;
+  grid.UpdateProjection(MakeProjection());
+
+  // Même position et portée : le spot éclairant vers la caméra touche moins de clusters que
+  // la lumière ponctuelle, et aucun de ceux situés derrière lui
+  const ClusterLight point = MakePointLight(0.0f, 0.0f, 40.0f, 15.0f, 0);
+  const ClusterLight spot = MakeSpotLight(0.0f, 0.0f, 40.0f, 15.0f, XMFLOAT3(0.0f, 0.0f, -1.0f), 30.0f, 1);
+  const ClusterLight lights[] = {point, spot};
+  grid.Build(lights, 2);
+
+  const size_t pointClusters = CountClustersWithLight(grid, 0);
+  const size_t spotClusters = CountClustersWithLight(grid, 1);
+  CHECK(spotClusters > 0);
+  CHECK(spotClusters < pointClusters);
+
+  const uint32_t behindSlice = grid.GetSliceForDepth(52.0f);
+  CHECK(!ClusterContains(grid, GetClusterForPoint(grid, XMFLOAT3(0.0f, 0.0f, 52.0f)), 1));
+  CHECK(ClusterContains(grid, GetClusterForPoint(grid, XMFLOAT3(0.0f, 0.0f, 52.0f)), 0));
+  CHECK(behindSlice > grid.GetSliceForDepth(40.0f));
+}
+
+BENCHMARK(LightClusterGrid_Build1000Lights)
+{
+  LightClusterGrid grid;
+  grid.UpdateProjection(MakeProjection());
+
+  std::mt19937                          random(42);
+  std::uniform_real_distribution<float> lateral(-100.0f, 100.0f);
+  std::uniform_real_distribution<float> depth(1.0f, 400.0f);
+  std::uniform_real_distribution<float> range(2.0f, 20.0f);
+
+  std::vector<ClusterLight> lights;
+  for (uint32_t i = 0; i < 1000; i++) {
+    lights.push_back(MakePointLight(lateral(random), lateral(random), depth(random), range(random), i));
+  }
+
+  const double microseconds = Tests::MeasureMicroseconds(200, [&] { grid.Build(lights.data(), lights.size()); });
+  printf("  Build (1000 lumières) : %.1f us, %zu indices\n", microseconds, grid.GetLightIndices().size());
+}
@@ -0,0 +1,51 @@
+#include <cstdio>
+#include <cstring>
+
+#include "TestFramework.h"
+
+using namespace FrostFireEngine::Tests;
+
+// Tests unitaires headless du moteur (sans device D3D), à lancer depuis EngineTest :
+//   UnitTests [--bench] [filtre]...
+// Sans --bench seuls les tests sont exécutés ; avec --bench seuls les benchmarks.
+// Un filtre ne garde que les cas dont le nom le contient.
+namespace
+{
+  bool MatchesFilters(const char* name, int argc, char* argv[])
+  {
+    bool hasFilter = false;
+    for (int i = 1; i < argc; ++i) {
+      if (argv[i][0] == '-') continue;
+      hasFilter = true;
+      if (strstr(name, argv[i])) return true;
+    }
+    return !hasFilter;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  bool benchmarks = false;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--bench") == 0) benchmarks = true;
+  }
+
+  int executed = 0;
+  int failedCases = 0;
+  for (const TestCase& testCase : GetTestCases()) {
+    if (testCase.benchmark != benchmarks || !MatchesFilters(testCase.name, argc, argv)) {
+      continue;
+    }
+
+    printf("%s\n", testCase.name);
+    const int failuresBefore = GetFailureCount();
+    testCase.function();
+    if (GetFailureCount() != failuresBefore) {
+      ++failedCases;
+    }
+    ++executed;
+  }
+
+  printf("%d cas, %d en echec\n", executed, failedCases);
+  return failedCases == 0 ? 0 : 1;
+}
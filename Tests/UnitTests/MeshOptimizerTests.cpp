@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <array>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "Engine/MeshOptimizer.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+namespace
+{
+  constexpr uint32_t GRID_SIZE = 64;  // quads par côté
+
+  // Grille régulière dont les triangles sont mélangés : l'ordre de départ ne profite pas du cache
+  void MakeShuffledGrid(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+  {
+    for (uint32_t y = 0; y <= GRID_SIZE; y++) {
+      for (uint32_t x = 0; x <= GRID_SIZE; x++) {
+        const XMFLOAT2 uv(static_cast<float>(x) / GRID_SIZE, static_cast<float>(y) / GRID_SIZE);
+        vertices.emplace_back(XMFLOAT3(uv.x, 0.0f, uv.y), XMFLOAT3(0.0f, 1.0f, 0.0f), uv);
+      }
+    }
+
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t y = 0; y < GRID_SIZE; y++) {
+      for (uint32_t x = 0; x < GRID_SIZE; x++) {
+        const uint32_t i0 = y * (GRID_SIZE + 1) + x;
+        const uint32_t i1 = i0 + 1;
+        const uint32_t i2 = i0 + GRID_SIZE + 1;
+        const uint32_t i3 = i2 + 1;
+        triangles.push_back({i0, i2, i1});
+        triangles.push_back({i1, i2, i3});
+      }
+    }
+
+    std::mt19937 random(7);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+    for (const auto& triangle : triangles) {
+      indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+  }
+
+  // Triangles décrits par leurs positions, triés : indépendant de l'ordre des sommets et des triangles
+  std::vector<std::array<float, 9>> GetTriangleSet(const std::vector<Vertex>&   vertices,
+                                                   const std::vector<uint32_t>& indices)
+  {
+    std::vector<std::array<float, 9>> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+      // Rotation qui commence par le coin de plus petite position : conserve l'orientation
+      std::array<XMFLOAT3, 3> corners;
+      for (size_t c = 0; c < 3; c++) {
+        corners[c] = vertices[indices[i + c]].GetPosition();
+      }
+      const auto less = [](const XMFLOAT3& a, const XMFLOAT3& b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+      };
+      std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end(), less), corners.end());
+
+      std::array<float, 9> triangle;
+      for (size_t c = 0; c < 3; c++) {
+        triangle[c * 3] = corners[c].x;
+        triangle[c * 3 + 1] = corners[c].y;
+        triangle[c * 3 + 2] = corners[c].z;
+      }
+      triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+  }
+}
+
+TEST_CASE(MeshOptimizer_ImproveAcmrOnShuffledGrid)
+{
+  std::vector<Vertex>   vertices;
+  std::vector<uint32_t> indices;
+  MakeShuffledGrid(vertices, indices);
+
+  const auto trianglesBefore = GetTriangleSet(vertices, indices);
+  const auto stats = MeshOptimizer::OptimizeWithStats(vertices, indices);
+
+  CHECK(stats.triangleCount == GRID_SIZE * GRID_SIZE * 2);
+  CHECK(stats.vertexCount == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+
+  // Ordre aléatoire : presque aucun réemploi. Ordre optimisé : bien en dessous d'un sommet par triangle
+  CHECK(stats.before.acmr > 2.0f);
+  CHECK(stats.after.acmr < 1.0f);
+  CHECK(stats.after.acmr < stats.before.acmr * 0.5f);
+  CHECK(stats.after.atvr < stats.before.atvr);
+
+  // Les statistiques correspondent au maillage renvoyé, qui contient les mêmes triangles
+  const auto measured = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+  CHECK(measured.acmr == stats.after.acmr);
+  CHECK(GetTriangleSet(vertices, indices) == trianglesBefore);
+}
+
+TEST_CASE(MeshOptimizer_VertexFetchOrder)
+{
+  std::vector<Vertex>   vertices;
+  std::vector<uint32_t> indices;
+  MakeShuffledGrid(vertices, indices);
+  MeshOptimizer::Optimize(vertices, indices);
+
+  // Après OptimizeVertexFetch, chaque sommet apparaît pour la première fois dans l'ordre du buffer
+  uint32_t nextVertex = 0;
+  for (const uint32_t index : indices) {
+    REQUIRE(index <= nextVertex);
+    if (index == nextVertex) {
+      ++nextVertex;
+    }
+  }
+  CHECK(nextVertex == vertices.size());
+}
@@ -0,0 +1,240 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "Engine/Mesh.h"
+#include "Engine/SceneCache.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+namespace
+{
+  std::filesystem::path GetCachePath(const char* name)
+  {
+    return std::filesystem::temp_directory_path() / name;
+  }
+
+  SceneCacheKey MakeKey()
+  {
+    SceneCacheKey key;
+    key.sourceSize = 1234;
+    key.sourceWriteTime = 5678;
+    key.settingsHash = 42;
+    return key;
+  }
+
+  SceneCacheEntity MakeEntity()
+  {
+    SceneCacheEntity entity{};
+    entity.rotation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+    entity.scale = XMFLOAT3(1.0f, 1.0f, 1.0f);
+    entity.meshFirst = SCENE_CACHE_NONE;
+    entity.material = SCENE_CACHE_NONE;
+    entity.colliderBlob = SCENE_CACHE_NONE;
+    entity.rigidBodyType = -1;
+    return entity;
+  }
+
+  // Bande de quads : vertexCount sommets, (vertexCount / 2 - 1) * 2 triangles
+  void MakeStrip(uint32_t vertexCount, float offset, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+  {
+    for (uint32_t i = 0; i < vertexCount; i++) {
+      const float x = static_cast<float>(i / 2) + offset;
+      const float z = static_cast<float>(i % 2);
+      vertices.emplace_back(XMFLOAT3(x, 0.0f, z), XMFLOAT3(0.0f, 1.0f, 0.0f), XMFLOAT2(x * 0.1f, z));
+    }
+    for (uint32_t i = 0; i + 3 < vertexCount; i += 2) {
+      indices.insert(indices.end(), {i, i + 1, i + 2, i + 2, i + 1, i + 3});
+    }
+  }
+
+  // Scène de meshCount entités sous une racine, chacune avec un maillage et un LOD
+  bool WriteScene(const std::filesystem::path& path, uint32_t meshCount, uint32_t vertexCount,
+                  VertexFormat format = VertexFormat::Full)
+  {
+    SceneCacheWriter writer;
+    const uint32_t   root = writer.AddEntity(MakeEntity());
+
+    for (uint32_t m = 0; m < meshCount; m++) {
+      std::vector<Vertex>   vertices;
+      std::vector<uint32_t> indices;
+      MakeStrip(vertexCount, static_cast<float>(m), vertices, indices);
+      const std::span<const uint32_t> lodIndices = std::span(indices).first(indices.size() / 2);
+
+      SceneCacheEntity entity = MakeEntity();
+      if (format == VertexFormat::Packed) {
+        const PackedVertexStreams streams = PackVertexStreams(vertices);
+        entity.meshFirst = writer.AddMesh(streams.positions, streams.attributes, indices, 0.0f);
+        writer.AddMesh(streams.positions, streams.attributes, lodIndices, 0.25f);
+      }
+      else {
+        entity.meshFirst = writer.AddMesh(vertices, indices, 0.0f);
+        writer.AddMesh(vertices, lodIndices, 0.25f);
+      }
+      entity.meshCount = 2;
+      writer.AddEntity(entity);
+      writer.GetEntity(root).childCount++;
+    }
+    return writer.Write(path, MakeKey());
+  }
+}
+
+TEST_CASE(SceneCache_RoundTrip)
+{
+  const auto path = GetCachePath("ffe_scene_roundtrip.cache");
+  REQUIRE(WriteScene(path, 3, 64));
+
+  SceneCacheReader reader;
+  REQUIRE(reader.Open(path, MakeKey()));
+  CHECK(reader.GetEntities().size() == 4);
+  CHECK(reader.GetEntities()[0].childCount == 3);
+  REQUIRE(reader.GetMeshes().size() == 6);
+
+  std::vector<Vertex>   vertices;
+  std::vector<uint32_t> indices;
+  MakeStrip(64, 2.0f, vertices, indices);
+
+  const SceneCacheMesh& mesh = reader.GetMeshes()[reader.GetEntities()[3].meshFirst];
+  const auto            cachedVertices = reader.GetVertices(mesh);
+  const auto            cachedIndices = reader.GetIndices(mesh);
+  REQUIRE(cachedVertices.size() == vertices.size());
+  CHECK(memcmp(cachedVertices.data(), vertices.data(), vertices.size() * sizeof(Vertex)) == 0);
+  CHECK(std::equal(cachedIndices.begin(), cachedIndices.end(), indices.begin(), indices.end()));
+  CHECK(reader.GetMeshes()[reader.GetEntities()[3].meshFirst + 1].screenSize == 0.25f);
+
+  // Un Mesh construit depuis la projection ne garde que ses bornes
+  const Mesh loaded(nullptr, cachedVertices, cachedIndices);
+  CHECK(loaded.GetVertexCount() == vertices.size());
+  CHECK(loaded.GetIndexCount() == indices.size());
+  CHECK(loaded.GetMinBounds().x == 2.0f);
+  CHECK(loaded.GetMaxBounds().x == 33.0f);
+
+  reader = {};
+  std::filesystem::remove(path);
+}
+
+TEST_CASE(SceneCache_RejectsStaleKey)
+{
+  const auto path = GetCachePath("ffe_scene_stale.cache");
+  REQUIRE(WriteScene(path, 1, 16));
+
+  SceneCacheKey key = MakeKey();
+  key.settingsHash++;
+  SceneCacheReader reader;
+  CHECK(!reader.Open(path, key));
+
+  key = MakeKey();
+  key.sourceWriteTime++;
+  CHECK(!reader.Open(path, key));
+
+  // Sans FBX source, seul le hachage des réglages compte
+  key = MakeKey();
+  key.hasSource = false;
+  key.sourceSize = 0;
+  CHECK(reader.Open(path, key));
+
+  reader = {};
+  std::filesystem::remove(path);
+}
+
+TEST_CASE(SceneCache_RejectsCorruptedContent)
+{
+  const auto path = GetCachePath("ffe_scene_corrupted.cache");
+  REQUIRE(WriteScene(path, 2, 256));
+
+  // Un octet modifié dans la géométrie, taille et en-tête intacts
+  const auto size = std::filesystem::file_size(path);
+  {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekg(static_cast<std::streamoff>(size - 64));
+    char byte = 0;
+    file.read(&byte, 1);
+    byte = static_cast<char>(byte ^ 0x10);
+    file.seekp(static_cast<std::streamoff>(size - 64));
+    file.write(&byte, 1);
+  }
+
+  SceneCacheReader reader;
+  CHECK(!reader.Open(path, MakeKey()));
+
+  // Fichier tronqué
+  std::filesystem::resize_file(path, size / 2);
+  CHECK(!reader.Open(path, MakeKey()));
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE(SceneCache_PackedStreamsRoundTrip)
+{
+  const auto path = GetCachePath("ffe_scene_packed.cache");
+  REQUIRE(WriteScene(path, 2, 128, VertexFormat::Packed));
+
+  SceneCacheReader reader;
+  REQUIRE(reader.Open(path, MakeKey()));
+  REQUIRE(reader.GetMeshes().size() == 4);
+
+  std::vector<Vertex>   vertices;
+  std::vector<uint32_t> indices;
+  MakeStrip(128, 1.0f, vertices, indices);
+  const PackedVertexStreams expected = PackVertexStreams(vertices);
+
+  // Les flux sont stockés compactés, prêts pour les vertex buffers
+  const SceneCacheMesh& mesh = reader.GetMeshes()[reader.GetEntities()[2].meshFirst];
+  CHECK(mesh.format == VertexFormat::Packed);
+  const auto positions = reader.GetPositions(mesh);
+  const auto attributes = reader.GetAttributes(mesh);
+  REQUIRE(positions.size() == vertices.size());
+  REQUIRE(attributes.size() == vertices.size());
+  CHECK(memcmp(positions.data(), expected.positions.data(), positions.size_bytes()) == 0);
+  CHECK(memcmp(attributes.data(), expected.attributes.data(), attributes.size_bytes()) == 0);
+  CHECK(reinterpret_cast<uintptr_t>(positions.data()) % SCENE_CACHE_ALIGNMENT == 0);
+  CHECK(reinterpret_cast<uintptr_t>(attributes.data()) % SCENE_CACHE_ALIGNMENT == 0);
+
+  const Mesh loaded(nullptr, positions, attributes, reader.GetIndices(mesh));
+  CHECK(loaded.GetVertexFormat() == VertexFormat::Packed);
+  CHECK(loaded.GetVertexMemorySize() == vertices.size() * GetVertexFormatSize(VertexFormat::Packed));
+  CHECK(loaded.GetMinBounds().x == 1.0f);
+  CHECK(loaded.GetMaxBounds().x == 64.0f);
+
+  reader = {};
+  std::filesystem::remove(path);
+}
+
+BENCHMARK(SceneCache_Load)
+{
+  // 100 maillages de 10 000 sommets et leur LOD, dans chaque format
+  for (const VertexFormat format : {VertexFormat::Packed, VertexFormat::Full}) {
+    const auto path = GetCachePath("ffe_scene_bench.cache");
+    if (!WriteScene(path, 100, 10000, format)) {
+      printf("  écriture du cache impossible\n");
+      return;
+    }
+
+    // Ouverture (en-tête, hachage du contenu) puis création des maillages depuis la projection,
+    // sans device : seule la part CPU du chargement est mesurée
+    size_t       vertexCount = 0;
+    const double microseconds = Tests::MeasureMicroseconds(10, [&] {
+      SceneCacheReader reader;
+      if (!reader.Open(path, MakeKey())) return;
+
+      std::vector<std::shared_ptr<Mesh>> meshes;
+      meshes.reserve(reader.GetMeshes().size());
+      vertexCount = 0;
+      for (const SceneCacheMesh& cached : reader.GetMeshes()) {
+        meshes.push_back(cached.format == VertexFormat::Packed
+                           ? std::make_shared<Mesh>(nullptr, reader.GetPositions(cached),
+                                                    reader.GetAttributes(cached), reader.GetIndices(cached))
+                           : std::make_shared<Mesh>(nullptr, reader.GetVertices(cached), reader.GetIndices(cached)));
+        vertexCount += meshes.back()->GetVertexCount();
+      }
+    });
+
+    printf("  Chargement %s (%zu sommets, %.1f Mo) : %.2f ms\n", format == VertexFormat::Packed ? "Packed" : "Full",
+      vertexCount, static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0), microseconds / 1000.0);
+    std::filesystem::remove(path);
+  }
+}
@@ -0,0 +1,181 @@
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Engine/Shaders/ShaderManager.h"
+#include "TestFramework.h"
+
+using namespace FrostFireEngine;
+
+namespace
+{
+  constexpr RenderPass PASSES[] = {RenderPass::Shadow, RenderPass::GBuffer, RenderPass::Lighting,
+                                   RenderPass::Transparency};
+
+  // Features enregistrées une fois pour toutes : le registre est global au processus
+  std::vector<FeatureMask> RegisterFeatures()
+  {
+    std::vector<FeatureMask> bits;
+    for (const char* name : {"TEST_NORMAL_MAP", "TEST_ALPHA_TEST", "TEST_SKINNING", "TEST_EMISSIVE"}) {
+      bits.push_back(ShaderVariantManager::GetFeatureBit(name));
+    }
+    return bits;
+  }
+
+  // Les 16 combinaisons des 4 features de test
+  std::vector<FeatureMask> MakeFeatureCombinations(const std::vector<FeatureMask>& bits)
+  {
+    std::vector<FeatureMask> masks;
+    for (uint32_t combination = 0; combination < (1u << bits.size()); combination++) {
+      FeatureMask mask = 0;
+      for (size_t b = 0; b < bits.size(); b++) {
+        if (combination & (1u << b)) mask |= bits[b];
+      }
+      masks.push_back(mask);
+    }
+    return masks;
+  }
+
+  // Ancien chemin de chaque dessin : defines construits depuis les noms des features, clé texte
+  // (même construction que MakeVariantKey) puis recherche dans la std::map des variants
+  ShaderManager::VariantKey MakeStringKey(const std::string& technique, RenderPass pass, FeatureMask features)
+  {
+    std::map<std::string, std::string> defines;
+    for (const auto& name : ShaderVariantManager::GetFeatureNames(features)) {
+      defines[name] = "1";
+    }
+
+    std::stringstream ss;
+    for (auto& d : defines) {
+      ss << d.first << "=" << d.second << ";";
+    }
+    return {technique, pass, ss.str()};
+  }
+}
+
+TEST_CASE(ShaderManager_PassVariantKeys)
+{
+  const std::vector<FeatureMask> masks = MakeFeatureCombinations(RegisterFeatures());
+
+  // Une clé distincte par technique, passe et combinaison de features
+  std::unordered_set<uint64_t> keys;
+  for (uint32_t techniqueId = 1; techniqueId <= 3; techniqueId++) {
+    for (const RenderPass pass : PASSES) {
+      for (const FeatureMask mask : masks) {
+        const uint64_t key = ShaderManager::MakePassVariantKey(techniqueId, pass, mask);
+        CHECK(key != 0);
+        CHECK(keys.insert(key).second);
+      }
+    }
+  }
+  CHECK(keys.size() == 3 * std::size(PASSES) * masks.size());
+
+  // Les identifiants de technique sont stables et non nuls
+  ShaderManager& manager = ShaderManager::GetInstance();
+  const uint32_t opaque = manager.GetTechniqueId("TestOpaque");
+  CHECK(opaque != 0);
+  CHECK(manager.GetTechniqueId("TestOpaque") == opaque);
+  CHECK(manager.GetTechniqueId("TestTransparent") != opaque);
+}
+
+TEST_CASE(ShaderManager_FindPassVariant)
+{
+  ShaderManager& manager = ShaderManager::GetInstance();
+  manager.Shutdown();
+
+  const uint32_t techniqueId = manager.GetTechniqueId("TestLookup");
+  const auto     stats = manager.GetLookupStats();
+
+  // Table vide : échec compté, sans variant
+  const uint64_t key = ShaderManager::MakePassVariantKey(techniqueId, RenderPass::GBuffer, 0);
+  CHECK(manager.FindPassVariant(key) == nullptr);
+  CHECK(manager.GetLookupStats().lookups == stats.lookups + 1);
+  CHECK(manager.GetLookupStats().misses == stats.misses + 1);
+
+  // Assez d'entrées pour plusieurs agrandissements de la table : chacune reste retrouvable
+  std::vector<std::unique_ptr<ShaderVariant>> variants;
+  for (uint64_t features = 0; features < 1000; features++) {
+    variants.push_back(std::make_unique<ShaderVariant>());
+    manager.AddPassVariant(ShaderManager::MakePassVariantKey(techniqueId, RenderPass::GBuffer, features),
+      variants.back().get());
+  }
+  for (uint64_t features = 0; features < 1000; features++) {
+    CHECK(manager.FindPassVariant(ShaderManager::MakePassVariantKey(techniqueId, RenderPass::GBuffer, features)) ==
+      variants[features].get());
+  }
+  CHECK(manager.FindPassVariant(ShaderManager::MakePassVariantKey(techniqueId, RenderPass::Shadow, 0)) == nullptr);
+
+  // Une nouvelle insertion de la même clé remplace le variant
+  manager.AddPassVariant(key, variants[1].get());
+  CHECK(manager.FindPassVariant(key) == variants[1].get());
+
+  manager.Shutdown();
+  CHECK(manager.FindPassVariant(key) == nullptr);
+}
+
+BENCHMARK(ShaderManager_PerDrawVariantLookup)
+{
+  // 3 techniques x 4 passes x 16 combinaisons de features, 10 000 dessins par image
+  const std::vector<FeatureMask> masks = MakeFeatureCombinations(RegisterFeatures());
+  const char*                    techniques[] = {"BenchOpaque", "BenchTransparent", "BenchSkinned"};
+  constexpr size_t               DRAW_COUNT = 10000;
+
+  ShaderManager& manager = ShaderManager::GetInstance();
+  manager.Shutdown();
+
+  std::vector<std::unique_ptr<ShaderVariant>>          variants;
+  std::map<ShaderManager::VariantKey, ShaderVariant*> stringVariants;
+  for (const char* technique : techniques) {
+    const uint32_t techniqueId = manager.GetTechniqueId(technique);
+    for (const RenderPass pass : PASSES) {
+      for (const FeatureMask mask : masks) {
+        variants.push_back(std::make_unique<ShaderVariant>());
+        manager.AddPassVariant(ShaderManager::MakePassVariantKey(techniqueId, pass, mask), variants.back().get());
+        stringVariants[MakeStringKey(technique, pass, mask)] = variants.back().get();
+      }
+    }
+  }
+
+  // Dessins répartis sur toutes les combinaisons, dans un ordre qui change à chaque dessin
+  struct Draw {
+    uint32_t    technique;
+    RenderPass  pass;
+    FeatureMask features;
+  };
+  std::vector<Draw> draws;
+  for (size_t i = 0; i < DRAW_COUNT; i++) {
+    draws.push_back({static_cast<uint32_t>(i % std::size(techniques)), PASSES[(i / 3) % std::size(PASSES)],
+                     masks[(i * 7) % masks.size()]});
+  }
+
+  size_t       found = 0;
+  const double stringMicroseconds = Tests::MeasureMicroseconds(10, [&] {
+    found = 0;
+    for (const Draw& draw : draws) {
+      const auto it = stringVariants.find(MakeStringKey(techniques[draw.technique], draw.pass, draw.features));
+      if (it != stringVariants.end()) ++found;
+    }
+  });
+  const size_t stringFound = found;
+
+  uint32_t techniqueIds[std::size(techniques)];
+  for (size_t t = 0; t < std::size(techniques); t++) {
+    techniqueIds[t] = manager.GetTechniqueId(techniques[t]);
+  }
+  const double keyMicroseconds = Tests::MeasureMicroseconds(1000, [&] {
+    found = 0;
+    for (const Draw& draw : draws) {
+      const uint64_t key = ShaderManager::MakePassVariantKey(techniqueIds[draw.technique], draw.pass, draw.features);
+      if (manager.FindPassVariant(key)) ++found;
+    }
+  });
+
+  printf("  Clé texte et std::map : %.1f ns par dessin (%zu trouvés)\n", stringMicroseconds * 1000.0 / DRAW_COUNT,
+    stringFound);
+  printf("  Clé entière et table  : %.1f ns par dessin (%zu trouvés)\n", keyMicroseconds * 1000.0 / DRAW_COUNT,
+    found);
+  manager.Shutdown();
+}
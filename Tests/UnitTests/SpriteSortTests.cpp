@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Engine/ECS/systems/rendering/SpriteSort.h"
+#include "TestFramework.h"
+
+using namespace FrostFireEngine;
+
+namespace
+{
+  // Ordre attendu : profondeur décroissante, ordre de soumission conservé à profondeur égale
+  std::vector<uint32_t> ReferenceOrder(const std::vector<float>& depths)
+  {
+    std::vector<uint32_t> order(depths.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return depths[a] > depths[b]; });
+    return order;
+  }
+
+  std::vector<uint32_t> RadixOrder(const std::vector<float>& depths)
+  {
+    std::vector<uint32_t> keys(depths.size());
+    std::vector<uint32_t> order(depths.size());
+    std::vector<uint32_t> scratchKeys;
+    std::vector<uint32_t> scratchOrder;
+    for (uint32_t i = 0; i < depths.size(); i++) {
+      keys[i] = SpriteSort::BackToFrontKey(depths[i]);
+      order[i] = i;
+    }
+    SpriteSort::RadixSort(keys, order, scratchKeys, scratchOrder);
+    CHECK(std::is_sorted(keys.begin(), keys.end()));
+    return order;
+  }
+}
+
+TEST_CASE(SpriteSort_KeyOrdersBackToFront)
+{
+  // Plus loin d'abord, profondeurs négatives (derrière la caméra) comprises
+  const float depths[] = {1e30f, 1000.0f, 2.5f, 1.0f, 1e-30f, 0.0f, -1e-30f, -1.0f, -2.5f, -1000.0f, -1e30f};
+  for (size_t i = 0; i + 1 < std::size(depths); i++) {
+    CHECK(SpriteSort::BackToFrontKey(depths[i]) < SpriteSort::BackToFrontKey(depths[i + 1]));
+  }
+}
+
+TEST_CASE(SpriteSort_MatchesStableSort)
+{
+  std::mt19937 rng(1234);
+
+  // Peu de valeurs distinctes : beaucoup d'égalités, dont des profondeurs négatives
+  std::uniform_int_distribution<int> step(-8, 8);
+  std::vector<float>                 ties(5000);
+  for (float& depth : ties) depth = step(rng) * 0.75f;
+  CHECK(RadixOrder(ties) == ReferenceOrder(ties));
+
+  // Profondeurs proches : les octets de poids fort sont communs et leurs passes sautées
+  std::uniform_real_distribution<float> near(10.0f, 10.5f);
+  std::vector<float>                    close(5000);
+  for (float& depth : close) depth = near(rng);
+  close[17] = close[4000] = close[2500];
+  CHECK(RadixOrder(close) == ReferenceOrder(close));
+
+  // Étendue large, de part et d'autre de la caméra
+  std::uniform_real_distribution<float> wide(-500.0f, 500.0f);
+  std::vector<float>                    spread(5000);
+  for (float& depth : spread) depth = wide(rng);
+  CHECK(RadixOrder(spread) == ReferenceOrder(spread));
+
+  // Toutes égales : toutes les passes sont sautées, l'ordre de soumission reste intact
+  const std::vector<float> same(100, -3.0f);
+  CHECK(RadixOrder(same) == ReferenceOrder(same));
+
+  CHECK(RadixOrder({}).empty());
+  CHECK(RadixOrder({-1.0f}) == std::vector<uint32_t>{0});
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Mini framework de tests : chaque TEST_CASE / BENCHMARK s'enregistre statiquement et
+// UnitTests.exe les exécute tous (les benchmarks uniquement avec --bench).
+namespace FrostFireEngine::Tests
+{
+  using TestFunction = void (*)();
+
+  struct TestCase {
+    const char*  name;
+    TestFunction function;
+    bool         benchmark;
+  };
+
+  inline std::vector<TestCase>& GetTestCases()
+  {
+    static std::vector<TestCase> testCases;
+    return testCases;
+  }
+
+  inline int& GetFailureCount()
+  {
+    static int failureCount = 0;
+    return failureCount;
+  }
+
+  struct TestRegistrar {
+    TestRegistrar(const char* name, TestFunction function, bool benchmark)
+    {
+      GetTestCases().push_back(TestCase{name, function, benchmark});
+    }
+  };
+
+  inline void ReportFailure(const char* file, int line, const char* expression)
+  {
+    fprintf(stderr, "  %s(%d) : CHECK(%s)\n", file, line, expression);
+    ++GetFailureCount();
+  }
+
+  // Durée moyenne d'un appel, en microsecondes, sur `iterations` appels de `function`
+  template <typename Function>
+  double MeasureMicroseconds(int iterations, Function&& function)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      function();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / iterations;
+  }
+}
+
+#define FFE_TEST_REGISTER(name, benchmark)                                                       \
+  static void name();                                                                            \
+  static const ::FrostFireEngine::Tests::TestRegistrar name##Registrar(#name, &name, benchmark); \
+  static void name()
+
+#define TEST_CASE(name) FFE_TEST_REGISTER(name, false)
+#define BENCHMARK(name) FFE_TEST_REGISTER(name, true)
+
+#define CHECK(expression)                                                     \
+  do {                                                                        \
+    if (!(expression)) {                                                      \
+      ::FrostFireEngine::Tests::ReportFailure(__FILE__, __LINE__, #expression); \
+    }                                                                         \
+  } while (0)
+
+// Comme CHECK, mais abandonne le test en cours
+#define REQUIRE(expression)                                                   \
+  do {                                                                        \
+    if (!(expression)) {                                                      \
+      ::FrostFireEngine::Tests::ReportFailure(__FILE__, __LINE__, #expression); \
+      return;                                                                 \
+    }                                                                         \
+  } while (0)
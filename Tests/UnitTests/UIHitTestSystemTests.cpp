@@ -0,0 +1,134 @@
+#include <vector>
+
+#include "Engine/ECS/components/ButtonComponent.h"
+#include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "Engine/ECS/systems/UIHitTestSystem.h"
+#include "Engine/ECS/systems/UILayoutSystem.h"
+#include "TestFramework.h"
+#include "UITestScene.h"
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+namespace
+{
+  RectTransformComponent& GetRect(World& world, EntityId id)
+  {
+    return *world.GetEntity(id)->GetComponent<RectTransformComponent>();
+  }
+
+  // Élément ancré en haut à gauche du viewport, bouton sans renderer ni dispositif
+  EntityId CreateElement(World& world, const XMFLOAT2& offset, const XMFLOAT2& size, bool button)
+  {
+    const auto entity = world.CreateEntity();
+    entity->AddComponent<TransformComponent>();
+    auto& rectTransform = entity->AddComponent<RectTransformComponent>(nullptr);
+    rectTransform.SetAnchor(RectAnchorPreset::TopLeft);
+    rectTransform.SetAnchorOffset(offset);
+    rectTransform.SetSize(size);
+    if (button) {
+      entity->AddComponent<ButtonComponent>(nullptr);
+    }
+    return entity->GetId();
+  }
+
+  // Une frame de l'interface, dans l'ordre des phases : test de clic (Logic) puis layout (Rendering)
+  void RunFrame(UIHitTestSystem& hitTest, UILayoutSystem& layout, float width = 800.0f, float height = 600.0f)
+  {
+    hitTest.Refresh(width, height);
+    layout.Layout(width, height);
+  }
+}
+
+TEST_CASE(UIHitTest_RebuildsOnlyOnChange)
+{
+  World&           world = Tests::ResetUITestWorld();
+  UILayoutSystem&  layout = world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, nullptr);
+  UIHitTestSystem& hitTest = world.AddSystem<UIHitTestSystem>(SystemPhase::Logic, nullptr);
+
+  // Deux boutons qui se chevauchent, un troisième à l'écart et un élément non cliquable
+  const EntityId below = CreateElement(world, {100.0f, 100.0f}, {200.0f, 100.0f}, true);
+  const EntityId above = CreateElement(world, {150.0f, 120.0f}, {200.0f, 100.0f}, true);
+  const EntityId apart = CreateElement(world, {500.0f, 400.0f}, {100.0f, 50.0f}, true);
+  const EntityId label = CreateElement(world, {20.0f, 20.0f}, {60.0f, 20.0f}, false);
+
+  // Les boîtes n'existent qu'après la première passe de layout
+  RunFrame(hitTest, layout);
+  hitTest.Refresh(800.0f, 600.0f);
+  CHECK(hitTest.HitTest(200.0f, 150.0f) == above);
+  CHECK(hitTest.HitTest(120.0f, 110.0f) == below);
+  CHECK(hitTest.HitTest(550.0f, 420.0f) == apart);
+  CHECK(hitTest.HitTest(30.0f, 30.0f) == INVALID_ENTITY_ID);
+
+  // Interface inchangée : ni relevé des cibles, ni reconstruction
+  UIHitTestStats stats = hitTest.GetStats();
+  for (int frame = 0; frame < 10; frame++) {
+    RunFrame(hitTest, layout);
+  }
+  CHECK(hitTest.GetStats().scans == stats.scans);
+  CHECK(hitTest.GetStats().rebuilds == stats.rebuilds);
+
+  // Un élément non cliquable change : les cibles sont relevées, la grille reste la même
+  GetRect(world, label).SetSize({80.0f, 20.0f});
+  RunFrame(hitTest, layout);
+  hitTest.Refresh(800.0f, 600.0f);
+  CHECK(hitTest.GetStats().scans == stats.scans + 1);
+  CHECK(hitTest.GetStats().rebuilds == stats.rebuilds);
+
+  // Un bouton déplacé : la grille suit sa nouvelle boîte
+  stats = hitTest.GetStats();
+  const uint32_t revision = hitTest.GetRevision();
+  GetRect(world, apart).SetAnchorOffset({600.0f, 300.0f});
+  RunFrame(hitTest, layout);
+  hitTest.Refresh(800.0f, 600.0f);
+  CHECK(hitTest.GetStats().scans == stats.scans + 1);
+  CHECK(hitTest.GetStats().rebuilds == stats.rebuilds + 1);
+  CHECK(hitTest.GetRevision() == revision + 1);
+  CHECK(hitTest.HitTest(650.0f, 320.0f) == apart);
+  CHECK(hitTest.HitTest(550.0f, 420.0f) == INVALID_ENTITY_ID);
+
+  // Un bouton désactivé n'est plus une cible, sans passe de layout
+  world.GetEntity(above)->GetComponent<ButtonComponent>()->SetEnabled(false);
+  hitTest.Refresh(800.0f, 600.0f);
+  CHECK(hitTest.HitTest(200.0f, 150.0f) == below);
+  world.GetEntity(above)->GetComponent<ButtonComponent>()->SetEnabled(true);
+  hitTest.Refresh(800.0f, 600.0f);
+  CHECK(hitTest.HitTest(200.0f, 150.0f) == above);
+
+  // Un bouton ajouté devient une cible après sa passe de layout
+  const EntityId added = CreateElement(world, {20.0f, 500.0f}, {50.0f, 50.0f}, true);
+  RunFrame(hitTest, layout);
+  CHECK(hitTest.HitTest(40.0f, 520.0f) == INVALID_ENTITY_ID);
+  hitTest.Refresh(800.0f, 600.0f);
+  CHECK(hitTest.HitTest(40.0f, 520.0f) == added);
+
+  // Nouveau viewport : la grille est reconstruite
+  stats = hitTest.GetStats();
+  hitTest.Refresh(1024.0f, 768.0f);
+  CHECK(hitTest.GetStats().rebuilds == stats.rebuilds + 1);
+}
+
+BENCHMARK(UIHitTest_UnchangedFrame)
+{
+  World&           world = Tests::ResetUITestWorld();
+  UILayoutSystem&  layout = world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, nullptr);
+  UIHitTestSystem& hitTest = world.AddSystem<UIHitTestSystem>(SystemPhase::Logic, nullptr);
+
+  // Menu de 1000 boutons en grille
+  std::vector<EntityId> buttons;
+  for (uint32_t i = 0; i < 1000; i++) {
+    buttons.push_back(CreateElement(world, {(i % 40) * 48.0f, (i / 40) * 40.0f}, {44.0f, 36.0f}, true));
+  }
+  RunFrame(hitTest, layout, 1920.0f, 1080.0f);
+
+  const double unchanged = Tests::MeasureMicroseconds(1000, [&] { RunFrame(hitTest, layout, 1920.0f, 1080.0f); });
+
+  size_t       frame = 0;
+  const double oneMoved = Tests::MeasureMicroseconds(1000, [&] {
+    GetRect(world, buttons[frame++ % buttons.size()]).SetSize({44.0f, static_cast<float>(30 + frame % 6)});
+    RunFrame(hitTest, layout, 1920.0f, 1080.0f);
+  });
+
+  printf("  %zu boutons : frame inchangée %.2f us, un bouton modifié %.2f us\n", buttons.size(), unchanged,
+    oneMoved);
+}
@@ -0,0 +1,236 @@
+#include <cstring>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/ECS/components/transform/RectTransformComponent.h"
+#include "Engine/ECS/systems/UILayoutSystem.h"
+#include "TestFramework.h"
+#include "UITestScene.h"
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+namespace
+{
+  constexpr uint32_t FANOUT = 10;  // racines, enfants par racine, petits-enfants par enfant
+
+  struct UIForest {
+    std::vector<EntityId> roots;
+    std::vector<EntityId> children;       // FANOUT par racine, dans l'ordre des racines
+    std::vector<EntityId> grandChildren;  // FANOUT par enfant
+  };
+
+  RectTransformComponent& GetRect(World& world, EntityId id)
+  {
+    return *world.GetEntity(id)->GetComponent<RectTransformComponent>();
+  }
+
+  TransformComponent& GetTransform(World& world, EntityId id)
+  {
+    return *world.GetEntity(id)->GetComponent<TransformComponent>();
+  }
+
+  EntityId CreateElement(World& world, EntityId parent, const XMFLOAT2& offset, const XMFLOAT2& size)
+  {
+    const auto entity = world.CreateEntity();
+    entity->AddComponent<TransformComponent>();
+    auto& rectTransform = entity->AddComponent<RectTransformComponent>(nullptr);
+    rectTransform.SetAnchor(RectAnchorPreset::TopLeft);
+    rectTransform.SetAnchorOffset(offset);
+    rectTransform.SetSize(size);
+    if (parent != INVALID_ENTITY_ID) {
+      GetTransform(world, parent).AddChild(entity->GetId());
+    }
+    return entity->GetId();
+  }
+
+  UIForest CreateForest(World& world)
+  {
+    UIForest forest;
+    for (uint32_t r = 0; r < FANOUT; r++) {
+      const EntityId root = CreateElement(world, INVALID_ENTITY_ID, {r * 120.0f, 10.0f}, {110.0f, 600.0f});
+      forest.roots.push_back(root);
+      for (uint32_t c = 0; c < FANOUT; c++) {
+        const EntityId child = CreateElement(world, root, {5.0f, c * 55.0f}, {100.0f, 50.0f});
+        forest.children.push_back(child);
+        for (uint32_t g = 0; g < FANOUT; g++) {
+          forest.grandChildren.push_back(CreateElement(world, child, {g * 10.0f, 5.0f}, {8.0f, 40.0f}));
+        }
+      }
+    }
+    return forest;
+  }
+
+  using LayoutSnapshot = std::unordered_map<EntityId, RectTransformComponent::RectLayout>;
+
+  LayoutSnapshot TakeSnapshot(World& world, const UIForest& forest)
+  {
+    LayoutSnapshot snapshot;
+    for (const auto* ids : {&forest.roots, &forest.children, &forest.grandChildren}) {
+      for (const EntityId id : *ids) {
+        snapshot[id] = GetRect(world, id).GetLayout();
+      }
+    }
+    return snapshot;
+  }
+
+  bool SameLayouts(const LayoutSnapshot& a, const LayoutSnapshot& b)
+  {
+    if (a.size() != b.size()) return false;
+    for (const auto& [id, layout] : a) {
+      const auto it = b.find(id);
+      if (it == b.end() || memcmp(&layout, &it->second, sizeof(layout)) != 0) return false;
+    }
+    return true;
+  }
+}
+
+TEST_CASE(UILayout_SkipsCleanSubtrees)
+{
+  World&          world = Tests::ResetUITestWorld();
+  UILayoutSystem& layout = world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, nullptr);
+  const UIForest  forest = CreateForest(world);
+  const uint32_t  elementCount = FANOUT + FANOUT * FANOUT + FANOUT * FANOUT * FANOUT;
+
+  // Première passe : tout est calculé
+  layout.Layout(1280.0f, 720.0f);
+  CHECK(layout.GetStats().elements == elementCount);
+  CHECK(layout.GetStats().recomputed == elementCount);
+
+  // Rien n'a changé : aucune hiérarchie parcourue
+  layout.Layout(1280.0f, 720.0f);
+  CHECK(layout.GetStats().elements == 0);
+
+  // Une feuille : seul son chemin depuis la racine est parcouru
+  const EntityId leaf = forest.grandChildren[37];
+  GetRect(world, leaf).SetAnchorOffset({3.0f, 4.0f});
+  layout.Layout(1280.0f, 720.0f);
+  CHECK(layout.GetStats().elements == 3);
+  CHECK(layout.GetStats().recomputed == 1);
+
+  // Un élément intermédiaire : lui et ses enfants, pas ses frères
+  const EntityId child = forest.children[42];
+  GetRect(world, child).SetSize({90.0f, 45.0f});
+  layout.Layout(1280.0f, 720.0f);
+  CHECK(layout.GetStats().elements == 2 + FANOUT);
+  CHECK(layout.GetStats().recomputed == 1 + FANOUT);
+
+  // Rotation, par le TransformComponent
+  GetTransform(world, child).SetRotationEuler({0.0f, 0.0f, 0.3f});
+  layout.Layout(1280.0f, 720.0f);
+  CHECK(layout.GetStats().elements == 2 + FANOUT);
+  CHECK(layout.GetStats().recomputed == 1 + FANOUT);
+
+  // Reparentage : l'élément est recalculé sous son nouveau parent
+  const EntityId newParent = forest.children[75];
+  GetTransform(world, newParent).AddChild(leaf);
+  layout.Layout(1280.0f, 720.0f);
+  CHECK(layout.GetStats().elements == 3);
+  CHECK(layout.GetStats().recomputed == 1);
+  const XMFLOAT4& parentRect = GetRect(world, newParent).GetLayout().screenRect;
+  const XMFLOAT4& leafRect = GetRect(world, leaf).GetLayout().screenRect;
+  CHECK(leafRect.x == parentRect.x + 3.0f && leafRect.y == parentRect.y + 4.0f);
+
+  // Nouveau viewport : tout est recalculé
+  layout.Layout(1920.0f, 1080.0f);
+  CHECK(layout.GetStats().elements == elementCount);
+  CHECK(layout.GetStats().recomputed == elementCount);
+}
+
+TEST_CASE(UILayout_IncrementalMatchesFullLayout)
+{
+  World&          world = Tests::ResetUITestWorld();
+  UILayoutSystem& layout = world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, nullptr);
+  const UIForest  forest = CreateForest(world);
+  layout.Layout(1280.0f, 720.0f);
+
+  std::mt19937                          random(5);
+  std::uniform_int_distribution<size_t> pickChild(0, forest.children.size() - 1);
+  std::uniform_int_distribution<size_t> pickLeaf(0, forest.grandChildren.size() - 1);
+  std::uniform_real_distribution<float> value(-20.0f, 120.0f);
+
+  for (int frame = 0; frame < 200; frame++) {
+    switch (frame % 5) {
+    case 0: GetRect(world, forest.grandChildren[pickLeaf(random)]).SetAnchorOffset({value(random), value(random)});
+      break;
+    case 1: GetRect(world, forest.children[pickChild(random)]).SetSize({value(random) + 30.0f, value(random) + 30.0f});
+      break;
+    case 2: GetRect(world, forest.children[pickChild(random)]).SetAnchor(RectAnchorPreset::MiddleCenter);
+      break;
+    case 3: GetTransform(world, forest.children[pickChild(random)]).SetRotationEuler({0.0f, 0.0f, value(random) * 0.01f});
+      break;
+    default: GetTransform(world, forest.children[pickChild(random)]).AddChild(forest.grandChildren[pickLeaf(random)]);
+      break;
+    }
+    layout.Layout(1280.0f, 720.0f);
+
+    // Le résultat incrémental est identique, au bit près, à un recalcul complet
+    if (frame % 20 == 19) {
+      const LayoutSnapshot incremental = TakeSnapshot(world, forest);
+      for (const EntityId root : forest.roots) {
+        GetRect(world, root).MarkLayoutDirty();
+      }
+      layout.Layout(1280.0f, 720.0f);
+      CHECK(layout.GetStats().recomputed == forest.roots.size() + forest.children.size() + forest.grandChildren.size());
+      CHECK(SameLayouts(incremental, TakeSnapshot(world, forest)));
+    }
+  }
+}
+
+TEST_CASE(UILayout_DisabledRootWaitsForEnable)
+{
+  World&          world = Tests::ResetUITestWorld();
+  UILayoutSystem& layout = world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, nullptr);
+  const EntityId  root = CreateElement(world, INVALID_ENTITY_ID, {10.0f, 20.0f}, {200.0f, 100.0f});
+  const EntityId  child = CreateElement(world, root, {5.0f, 5.0f}, {50.0f, 50.0f});
+
+  layout.Layout(800.0f, 600.0f);
+  const XMFLOAT4 before = GetRect(world, child).GetLayout().screenRect;
+  CHECK(before.x == 15.0f && before.y == 25.0f && before.z == 65.0f && before.w == 75.0f);
+
+  // Racine désactivée : ni la modification ni le redimensionnement ne sont appliqués
+  world.GetEntity(root)->SetEnabled(false);
+  GetRect(world, child).SetAnchorOffset({7.0f, 9.0f});
+  layout.Layout(800.0f, 600.0f);
+  CHECK(layout.GetStats().elements == 0);
+  layout.Layout(1024.0f, 768.0f);
+  CHECK(layout.GetStats().elements == 0);
+  CHECK(GetRect(world, child).GetLayout().screenRect.x == before.x);
+
+  // À la réactivation, la hiérarchie est recalculée pour le viewport courant
+  world.GetEntity(root)->SetEnabled(true);
+  layout.Layout(1024.0f, 768.0f);
+  CHECK(layout.GetStats().elements == 2);
+  CHECK(layout.GetStats().recomputed == 2);
+  const XMFLOAT4 after = GetRect(world, child).GetLayout().screenRect;
+  CHECK(after.x == 17.0f && after.y == 29.0f && after.z == 67.0f && after.w == 79.0f);
+}
+
+BENCHMARK(UILayout_UnchangedFrame)
+{
+  World&          world = Tests::ResetUITestWorld();
+  UILayoutSystem& layout = world.AddSystem<UILayoutSystem>(SystemPhase::Rendering, nullptr);
+  const UIForest  forest = CreateForest(world);
+  layout.Layout(1280.0f, 720.0f);
+
+  const double unchanged = Tests::MeasureMicroseconds(1000, [&] { layout.Layout(1280.0f, 720.0f); });
+
+  // Une feuille modifiée par frame, comme un compteur qui change de texte
+  size_t       frame = 0;
+  const double oneLeaf = Tests::MeasureMicroseconds(1000, [&] {
+    GetRect(world, forest.grandChildren[frame++ % forest.grandChildren.size()]).SetAnchorOffset(
+      {static_cast<float>(frame % 7), 5.0f});
+    layout.Layout(1280.0f, 720.0f);
+  });
+
+  const double full = Tests::MeasureMicroseconds(100, [&] {
+    for (const EntityId root : forest.roots) {
+      GetRect(world, root).MarkLayoutDirty();
+    }
+    layout.Layout(1280.0f, 720.0f);
+  });
+
+  printf("  %zu éléments : frame inchangée %.2f us, une feuille %.2f us, recalcul complet %.1f us\n",
+    forest.roots.size() + forest.children.size() + forest.grandChildren.size(), unchanged, oneLeaf, full);
+}
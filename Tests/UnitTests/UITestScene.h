@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Engine/SceneManager.h"
+
+namespace FrostFireEngine::Tests
+{
+  // Scène sans dispositif : World::GetInstance() vise son World, les systèmes d'interface sont
+  // ajoutés par chaque test et pilotés à la main
+  class UITestScene : public Scene {
+  public:
+    void Initialize(DispositifD3D11* /*pDevice*/) override
+    {
+    }
+  };
+
+  // World vide de la scène de test, créée au premier appel. Les entités sont détruites avec
+  // leurs composants avant Clear, qui ne vide pas les pools.
+  inline World& ResetUITestWorld()
+  {
+    SceneManager& manager = SceneManager::GetInstance();
+    if (!manager.GetActiveScene()) {
+      manager.SetActiveScene<UITestScene>(nullptr);
+    }
+
+    World&                                      world = World::GetInstance();
+    const std::vector<std::shared_ptr<Entity>> entities(world.GetEntities().begin(), world.GetEntities().end());
+    for (const auto& entity : entities) {
+      world.DestroyEntity(entity);
+    }
+    world.Clear();
+    return world;
+  }
+}
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Engine/Shaders/VariantCache.h"
+#include "TestFramework.h"
+
+using namespace FrostFireEngine;
+
+namespace
+{
+  const std::wstring SHADER_PATH = L"Assets/Shaders/Test.fx";
+
+  // Variant sans objets D3D : seule la gestion du cache est testée, sans device
+  VariantHandle Add(VariantCache& cache, int feature)
+  {
+    return cache.AddVariant(SHADER_PATH, {"F" + std::to_string(feature)}, std::make_unique<ShaderVariant>());
+  }
+}
+
+TEST_CASE(VariantCache_NewEntryKeepsLruList)
+{
+  VariantCache cache(4);
+
+  // A libéré : seul dans la liste LRU
+  VariantHandle a = Add(cache, 0);
+  REQUIRE(a);
+  a.Reset();
+
+  // La première référence d'une entrée neuve ne doit pas toucher à la liste
+  VariantHandle b = Add(cache, 1);
+  REQUIRE(b);
+  b.Reset();
+  CHECK(cache.GetSize() == 2);
+
+  // Les deux variants sont retrouvés par Clear : aucun n'a été perdu par la liste
+  cache.Clear();
+  CHECK(cache.GetSize() == 0);
+  CHECK(cache.GetStats().evictions == 2);
+}
+
+TEST_CASE(VariantCache_EvictsLeastRecentlyUsed)
+{
+  VariantCache cache(2);
+  for (int feature = 0; feature < 3; feature++) {
+    Add(cache, feature);
+  }
+
+  // Le plus ancien libéré est évincé, sa recompilation est comptée
+  CHECK(cache.GetSize() == 2);
+  CHECK(cache.GetStats().evictions == 1);
+  CHECK(cache.GetStats().misses == 3);
+  Add(cache, 0);
+  CHECK(cache.GetStats().recompiles == 1);
+
+  // Un variant déjà en cache est renvoyé tel quel
+  const VariantHandle first = Add(cache, 0);
+  CHECK(Add(cache, 0).Get() == first.Get());
+  CHECK(cache.GetStats().misses == 4);
+
+  // Les variants référencés ne sont jamais évincés, même au-delà de la taille maximale
+  std::vector<VariantHandle> held;
+  for (int feature = 10; feature < 15; feature++) {
+    held.push_back(Add(cache, feature));
+  }
+  CHECK(cache.GetSize() == 6);
+  CHECK(cache.GetStats().peakSize == 6);
+
+  held.clear();
+  CHECK(cache.GetSize() == 2);
+}
+
+TEST_CASE(VariantCache_HandleOutlivesCache)
+{
+  auto          cache = std::make_unique<VariantCache>(2);
+  VariantHandle handle = Add(*cache, 0);
+  VariantHandle copy = handle;
+  cache.reset();
+
+  // Le variant appartient aux handles restants
+  REQUIRE(handle);
+  CHECK(handle->GetVariantKey().empty());
+  handle.Reset();
+  CHECK(copy.Get() != nullptr);
+  copy.Reset();
+}
+
+TEST_CASE(VariantCache_RandomHandleOperations)
+{
+  constexpr size_t MAX_SIZE = 6;
+  constexpr int    KEY_COUNT = 16;
+
+  VariantCache                       cache(MAX_SIZE);
+  std::vector<VariantHandle>         handles(32);
+  std::mt19937                       random(99);
+  std::uniform_int_distribution<int> operation(0, 3);
+  std::uniform_int_distribution<int> key(0, KEY_COUNT - 1);
+  std::uniform_int_distribution<int> slot(0, static_cast<int>(handles.size()) - 1);
+
+  for (int i = 0; i < 20000; i++) {
+    VariantHandle& target = handles[slot(random)];
+    switch (operation(random)) {
+    case 0: target = Add(cache, key(random)); break;
+    case 1: target = handles[slot(random)]; break;
+    case 2: target = std::move(handles[slot(random)]); break;
+    default: target.Reset(); break;
+    }
+
+    // Tout handle reste valide, et le cache ne garde au-delà de sa taille que des variants référencés
+    std::set<ShaderVariant*> referenced;
+    for (const VariantHandle& handle : handles) {
+      if (handle) {
+        CHECK(handle->GetVariantKey().empty());
+        referenced.insert(handle.Get());
+      }
+    }
+    CHECK(cache.GetSize() <= std::max(MAX_SIZE, referenced.size()));
+  }
+
+  handles.clear();
+  CHECK(cache.GetSize() <= MAX_SIZE);
+  cache.Clear();
+  CHECK(cache.GetSize() == 0);
+}
@@ -0,0 +1,242 @@
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "Engine/VertexWelder.h"
+#include "TestFramework.h"
+
+using namespace DirectX;
+using namespace FrostFireEngine;
+
+namespace
+{
+  VertexWelder::Epsilons ExactEpsilons()
+  {
+    return {0.0f, 0.0f, 0.0f, 0.0f};
+  }
+
+  // Cube dés-indexé comme à l'import : 6 faces x 2 triangles, un sommet par coin (36)
+  std::vector<Vertex> MakeCubeCorners(float size)
+  {
+    const XMFLOAT3 normals[] = {
+      {1.0f, 0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+      {0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f},
+    };
+    const XMFLOAT2 uvs[] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    const int      quad[] = {0, 1, 2, 0, 2, 3};
+
+    std::vector<Vertex> corners;
+    for (const XMFLOAT3& n : normals) {
+      // Deux axes du plan de la face
+      const XMFLOAT3 u = std::fabs(n.x) > 0.0f ? XMFLOAT3(0.0f, 1.0f, 0.0f) : XMFLOAT3(1.0f, 0.0f, 0.0f);
+      const XMFLOAT3 v(n.y * u.z - n.z * u.y, n.z * u.x - n.x * u.z, n.x * u.y - n.y * u.x);
+      const float    signs[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+      for (const int corner : quad) {
+        const float su = signs[corner][0] * size;
+        const float sv = signs[corner][1] * size;
+        const XMFLOAT3 position(n.x * size + u.x * su + v.x * sv, n.y * size + u.y * su + v.y * sv,
+          n.z * size + u.z * su + v.z * sv);
+        corners.emplace_back(position, n, uvs[corner], u);
+      }
+    }
+    return corners;
+  }
+
+  // Coin de triangle dés-indexé, avec le point de contrôle FBX dont il provient
+  struct ImportCorner {
+    int    controlPoint;
+    Vertex vertex;
+  };
+
+  // Terrain de gridSize x gridSize quads dés-indexé comme à l'import. Normales lisses (une par
+  // point de contrôle) ou à facettes (une par triangle : arêtes vives, comme un modèle low-poly).
+  std::vector<ImportCorner> MakeTerrainCorners(uint32_t gridSize, bool faceted)
+  {
+    const auto height = [](float x, float z) { return std::sin(x * 0.3f) * std::cos(z * 0.2f) * 2.0f; };
+    const auto point = [&](uint32_t x, uint32_t z) {
+      return XMFLOAT3(static_cast<float>(x), height(static_cast<float>(x), static_cast<float>(z)),
+                      static_cast<float>(z));
+    };
+    const auto normalize = [](XMFLOAT3 n) {
+      const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+      return XMFLOAT3(n.x / length, n.y / length, n.z / length);
+    };
+
+    std::vector<ImportCorner> corners;
+    for (uint32_t z = 0; z < gridSize; z++) {
+      for (uint32_t x = 0; x < gridSize; x++) {
+        const uint32_t quad[2][3][2] = {{{x, z}, {x, z + 1}, {x + 1, z}}, {{x + 1, z}, {x, z + 1}, {x + 1, z + 1}}};
+        for (const auto& triangle : quad) {
+          const XMFLOAT3 p0 = point(triangle[0][0], triangle[0][1]);
+          const XMFLOAT3 p1 = point(triangle[1][0], triangle[1][1]);
+          const XMFLOAT3 p2 = point(triangle[2][0], triangle[2][1]);
+          const XMFLOAT3 e1(p1.x - p0.x, p1.y - p0.y, p1.z - p0.z);
+          const XMFLOAT3 e2(p2.x - p0.x, p2.y - p0.y, p2.z - p0.z);
+          const XMFLOAT3 faceNormal = normalize({e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z,
+                                                 e1.x * e2.y - e1.y * e2.x});
+
+          for (const auto& corner : triangle) {
+            const float    cx = static_cast<float>(corner[0]);
+            const float    cz = static_cast<float>(corner[1]);
+            const XMFLOAT3 smoothNormal = normalize({-(height(cx + 0.5f, cz) - height(cx - 0.5f, cz)), 1.0f,
+                                                     -(height(cx, cz + 0.5f) - height(cx, cz - 0.5f))});
+            const XMFLOAT2 uv(cx / static_cast<float>(gridSize), cz / static_cast<float>(gridSize));
+            corners.push_back({static_cast<int>(corner[1] * (gridSize + 1) + corner[0]),
+                               Vertex(point(corner[0], corner[1]), faceted ? faceNormal : smoothNormal, uv)});
+          }
+        }
+      }
+    }
+    return corners;
+  }
+
+  // Ancienne soudure de l'import : clé (point de contrôle, UV x 1000) dans une std::map,
+  // sans tenir compte des normales ni des tangentes
+  size_t WeldByControlPoint(const std::vector<ImportCorner>& corners, std::vector<uint32_t>& indices)
+  {
+    std::map<std::tuple<int, int, int>, uint32_t> uniqueVertices;
+    std::vector<Vertex>                           vertices;
+    indices.clear();
+    for (const ImportCorner& corner : corners) {
+      const XMFLOAT2& uv = corner.vertex.GetTexCoord();
+      const auto      key = std::make_tuple(corner.controlPoint, static_cast<int>(uv.x * 1000),
+                                            static_cast<int>(uv.y * 1000));
+      if (const auto it = uniqueVertices.find(key); it != uniqueVertices.end()) {
+        indices.push_back(it->second);
+        continue;
+      }
+      const uint32_t newIndex = static_cast<uint32_t>(vertices.size());
+      vertices.push_back(corner.vertex);
+      indices.push_back(newIndex);
+      uniqueVertices.emplace(key, newIndex);
+    }
+    return vertices.size();
+  }
+
+  // Soude les coins : un index par coin, comme les groupes de BuildMaterialGroups
+  std::vector<uint32_t> Weld(VertexWelder& welder, const std::vector<Vertex>& corners)
+  {
+    std::vector<uint32_t> indices;
+    for (const Vertex& corner : corners) {
+      indices.push_back(welder.Add(corner));
+    }
+    return indices;
+  }
+}
+
+TEST_CASE(VertexWelder_CubeImportVertexCount)
+{
+  const std::vector<Vertex> corners = MakeCubeCorners(0.5f);
+  REQUIRE(corners.size() == 36);
+
+  // 4 sommets par face : les coins partagés entre faces ont des normales différentes
+  VertexWelder                welder(VertexWelder::Epsilons{}, corners.size());
+  const std::vector<uint32_t> indices = Weld(welder, corners);
+  CHECK(welder.GetVertices().size() == 24);
+
+  for (size_t i = 0; i < corners.size(); i++) {
+    REQUIRE(indices[i] < welder.GetVertices().size());
+    const XMFLOAT3& expected = corners[i].GetPosition();
+    const XMFLOAT3& welded = welder.GetVertices()[indices[i]].GetPosition();
+    CHECK(expected.x == welded.x && expected.y == welded.y && expected.z == welded.z);
+  }
+
+  // Même résultat sans tolérance : les coins dupliqués sont identiques au bit près
+  VertexWelder exact(ExactEpsilons(), corners.size());
+  CHECK(Weld(exact, corners) == indices);
+  CHECK(exact.GetVertices().size() == 24);
+
+  // TakeVertices vide le welder, qui peut resservir
+  CHECK(welder.TakeVertices().size() == 24);
+  CHECK(welder.GetVertices().empty());
+  CHECK(welder.Add(corners[0]) == 0);
+}
+
+TEST_CASE(VertexWelder_ToleranceMergesNearDuplicates)
+{
+  const XMFLOAT3 normal(0.0f, 1.0f, 0.0f);
+  const Vertex   a(XMFLOAT3(1.0f, 2.0f, 3.0f), normal, XMFLOAT2(0.25f, 0.5f));
+  const Vertex   b(XMFLOAT3(1.0f + 1e-7f, 2.0f, 3.0f - 1e-7f), normal, XMFLOAT2(0.25f, 0.5f + 1e-7f));
+  const Vertex   far(XMFLOAT3(1.001f, 2.0f, 3.0f), normal, XMFLOAT2(0.25f, 0.5f));
+
+  VertexWelder welder(VertexWelder::Epsilons{});
+  CHECK(welder.Add(a) == 0);
+  CHECK(welder.Add(b) == 0);
+  CHECK(welder.Add(far) == 1);
+  CHECK(welder.GetVertices().size() == 2);
+}
+
+TEST_CASE(VertexWelder_ZeroEpsilonIsExact)
+{
+  const XMFLOAT3 normal(0.0f, 0.0f, 1.0f);
+  const float    x = 12345.678f;
+  const float    nextX = std::nextafter(x, 1e9f);
+
+  // Un ulp d'écart suffit à séparer deux sommets, sur chaque attribut
+  VertexWelder welder(ExactEpsilons());
+  CHECK(welder.Add(Vertex(XMFLOAT3(x, 0.0f, 0.0f), normal, XMFLOAT2(0.0f, 0.0f))) == 0);
+  CHECK(welder.Add(Vertex(XMFLOAT3(nextX, 0.0f, 0.0f), normal, XMFLOAT2(0.0f, 0.0f))) == 1);
+  CHECK(welder.Add(Vertex(XMFLOAT3(x, 0.0f, 0.0f), normal, XMFLOAT2(std::nextafter(0.0f, 1.0f), 0.0f))) == 2);
+  CHECK(welder.Add(Vertex(XMFLOAT3(x, 0.0f, 0.0f), XMFLOAT3(0.0f, std::nextafter(0.0f, 1.0f), 1.0f),
+    XMFLOAT2(0.0f, 0.0f))) == 3);
+
+  // Les sommets identiques fusionnent toujours, y compris hors de la plage d'un int32 quantifié
+  CHECK(welder.Add(Vertex(XMFLOAT3(x, 0.0f, 0.0f), normal, XMFLOAT2(0.0f, 0.0f))) == 0);
+  const Vertex huge(XMFLOAT3(3e38f, -3e38f, 1e-40f), normal, XMFLOAT2(1e30f, -1e30f));
+  const uint32_t hugeIndex = welder.Add(huge);
+  CHECK(hugeIndex == 4);
+  CHECK(welder.Add(huge) == hugeIndex);
+  CHECK(welder.GetVertices().size() == 5);
+}
+
+TEST_CASE(VertexWelder_GrowKeepsIndices)
+{
+  // Plus de sommets que la table initiale : les agrandissements conservent les index
+  VertexWelder          welder(VertexWelder::Epsilons{});
+  std::vector<uint32_t> first;
+  for (uint32_t i = 0; i < 10000; i++) {
+    const float value = static_cast<float>(i);
+    first.push_back(welder.Add(Vertex(XMFLOAT3(value, -value, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f),
+      XMFLOAT2(0.0f, 0.0f))));
+  }
+  CHECK(welder.GetVertices().size() == 10000);
+
+  for (uint32_t i = 0; i < 10000; i += 7) {
+    const float value = static_cast<float>(i);
+    CHECK(welder.Add(Vertex(XMFLOAT3(value, -value, 0.0f), XMFLOAT3(0.0f, 1.0f, 0.0f),
+      XMFLOAT2(0.0f, 0.0f))) == first[i]);
+  }
+  CHECK(welder.GetVertices().size() == 10000);
+}
+
+BENCHMARK(VertexWelder_ImportWeld)
+{
+  constexpr uint32_t GRID_SIZE = 256;
+
+  for (const bool faceted : {false, true}) {
+    const std::vector<ImportCorner> corners = MakeTerrainCorners(GRID_SIZE, faceted);
+
+    std::vector<uint32_t> indices;
+    size_t                oldCount = 0;
+    const double          oldMicroseconds = Tests::MeasureMicroseconds(5, [&] {
+      oldCount = WeldByControlPoint(corners, indices);
+    });
+
+    size_t       newCount = 0;
+    const double newMicroseconds = Tests::MeasureMicroseconds(5, [&] {
+      VertexWelder welder(VertexWelder::Epsilons{}, corners.size() / 2);
+      indices.clear();
+      for (const ImportCorner& corner : corners) {
+        indices.push_back(welder.Add(corner.vertex));
+      }
+      newCount = welder.GetVertices().size();
+    });
+
+    // Normales à facettes : l'ancienne clé fusionne à tort les coins d'une arête vive
+    printf("  Terrain %s, %zu coins :\n", faceted ? "à facettes" : "lisse", corners.size());
+    printf("    point de contrôle + UV, std::map : %zu sommets, %.2f ms\n", oldCount, oldMicroseconds / 1000.0);
+    printf("    VertexWelder (hachage)           : %zu sommets, %.2f ms\n", newCount, newMicroseconds / 1000.0);
+  }
+}
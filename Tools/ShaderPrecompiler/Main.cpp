@@ -0,0 +1,104 @@
+#include <windows.h>
+#include <d3dcompiler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <execution>
+#include <string>
+#include <vector>
+
+#include "Engine/Shaders/ShaderCache.h"
+#include "Engine/Shaders/techniques/GlobaleTechnique.h"
+#include "Engine/Shaders/techniques/TextTechnique.h"
+
+using namespace FrostFireEngine;
+
+// Compilation hors ligne de tous les variants enregistrés dans ShaderCache/, à lancer depuis
+// le répertoire de travail du jeu (EngineTest) pour que les chemins des techniques correspondent :
+//   ShaderPrecompiler [--debug|--release]
+// Par défaut, les options de compilation sont celles de la configuration de l'outil : les
+// variants précompilés ne servent qu'à un jeu compilé dans la même configuration.
+namespace
+{
+  struct CompileJob {
+    PassShaderInfo    info;
+    std::string       entryPoint;
+    const char*       profile;
+    ShaderCacheResult result = ShaderCacheResult::Failed;
+    std::string       errors;
+  };
+
+  std::string FormatDefines(const std::map<std::string, std::string>& defines)
+  {
+    std::string text;
+    for (const auto& [name, definition] : defines) {
+      if (!text.empty()) text += ' ';
+      text += name + '=' + definition;
+    }
+    return text;
+  }
+
+  int PrintUsage()
+  {
+    fwprintf(stderr, L"Usage : ShaderPrecompiler [--debug|--release]\n");
+    return 2;
+  }
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+  UINT flags = ShaderCache::GetDefaultCompileFlags();
+  for (int i = 1; i < argc; i++) {
+    const std::wstring argument = argv[i];
+    if (argument == L"--debug") {
+      flags = D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+    }
+    else if (argument == L"--release") {
+      flags = D3DCOMPILE_ENABLE_STRICTNESS;
+    }
+    else {
+      return PrintUsage();
+    }
+  }
+
+  // Mêmes combinaisons que le préchauffage du chargement (ShaderTechnique::GetReachableVariants)
+  const GlobaleTechnique                    globale;
+  const TextTechnique                       text;
+  const std::vector<const ShaderTechnique*> techniques = {&globale, &text};
+
+  std::vector<CompileJob> jobs;
+  for (const ShaderTechnique* technique : techniques) {
+    for (const VariantRequest& request : technique->GetReachableVariants()) {
+      PassShaderInfo info;
+      if (!technique->GetVariantShaderInfo(request.pass, request.features, info)) continue;
+      jobs.push_back({info, info.vsEntryPoint, VERTEX_SHADER_PROFILE});
+      jobs.push_back({info, info.psEntryPoint, PIXEL_SHADER_PROFILE});
+    }
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  std::for_each(std::execution::par, jobs.begin(), jobs.end(), [flags](CompileJob& job) {
+    ID3DBlob* blob = nullptr;
+    job.result = ShaderCache::GetInstance().Compile(job.info.shaderFile, job.entryPoint, job.profile,
+                                                    job.info.defines, flags, &blob, &job.errors);
+    if (blob) blob->Release();
+  });
+  const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+  for (const CompileJob& job : jobs) {
+    const char* status = job.result == ShaderCacheResult::Hit ? "EN CACHE" :
+                           job.result == ShaderCacheResult::Compiled ? "COMPILE " : "ECHEC   ";
+    printf("%s %ls %s %s [%s]\n", status, job.info.shaderFile.c_str(), job.entryPoint.c_str(), job.profile,
+           FormatDefines(job.info.defines).c_str());
+    if (job.result == ShaderCacheResult::Failed && !job.errors.empty()) {
+      printf("%s\n", job.errors.c_str());
+    }
+  }
+
+  const ShaderCacheStats stats = ShaderCache::GetInstance().GetStats();
+  printf("\n%u en cache, %u compiles, %u echecs, %u ecritures ratees en %.0f ms (compilation cumulee %.0f ms)\n",
+         stats.hits, stats.misses, stats.failures, stats.writeFailures, elapsedMs, stats.compileMs);
+
+  return stats.failures > 0 || stats.writeFailures > 0 ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+#include <windows.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Engine/Textures/TextureCooker.h"
+
+using namespace FrostFireEngine;
+
+// Cuisson des textures sources en DDS BC, à lancer depuis le répertoire de travail du jeu
+// (EngineTest) pour que les chemins correspondent à ceux passés au TextureManager :
+//   TextureCooker [--format bc1|bc3|bc5|bc7] [--force] <fichier ou dossier>...
+namespace
+{
+  bool IsSourceImage(const std::filesystem::path& path)
+  {
+    static const wchar_t* extensions[] = {L".png", L".jpg", L".jpeg", L".bmp", L".tif", L".tiff", L".tga"};
+    for (const wchar_t* extension : extensions) {
+      if (_wcsicmp(path.extension().c_str(), extension) == 0) return true;
+    }
+    return false;
+  }
+
+  bool ParseFormat(const std::wstring& name, BCFormat& format)
+  {
+    static const std::pair<const wchar_t*, BCFormat> formats[] = {
+      {L"bc1", BCFormat::BC1}, {L"bc3", BCFormat::BC3}, {L"bc5", BCFormat::BC5}, {L"bc7", BCFormat::BC7}
+    };
+    for (const auto& [formatName, value] : formats) {
+      if (_wcsicmp(name.c_str(), formatName) == 0) {
+        format = value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const char* GetFormatName(BCFormat format)
+  {
+    switch (format) {
+    case BCFormat::BC1: return "BC1";
+    case BCFormat::BC3: return "BC3";
+    case BCFormat::BC5: return "BC5";
+    case BCFormat::BC7: return "BC7";
+    }
+    return "?";
+  }
+
+  int PrintUsage()
+  {
+    fwprintf(stderr, L"Usage : TextureCooker [--format bc1|bc3|bc5|bc7] [--force] <fichier ou dossier>...\n");
+    return 2;
+  }
+}
+
+int wmain(int argc, wchar_t* argv[])
+{
+  TextureCookSettings                settings;
+  std::vector<std::filesystem::path> sources;
+
+  for (int i = 1; i < argc; i++) {
+    const std::wstring argument = argv[i];
+    if (argument == L"--force") {
+      settings.force = true;
+    }
+    else if (argument == L"--format") {
+      BCFormat format;
+      if (i + 1 >= argc || !ParseFormat(argv[++i], format)) return PrintUsage();
+      settings.format = format;
+    }
+    else if (std::filesystem::is_directory(argument)) {
+      for (const auto& entry : std::filesystem::recursive_directory_iterator(argument)) {
+        if (entry.is_regular_file() && IsSourceImage(entry.path())) sources.push_back(entry.path());
+      }
+    }
+    else {
+      sources.emplace_back(argument);
+    }
+  }
+  if (sources.empty()) return PrintUsage();
+
+  CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  uint32_t   cooked = 0;
+  uint32_t   upToDate = 0;
+  uint32_t   failed = 0;
+  size_t     uncompressedBytes = 0;
+  size_t     cookedBytes = 0;
+
+  for (const auto& source : sources) {
+    const TextureCookResult result = CookTexture(source.wstring(), settings);
+    if (result.status == TextureCookStatus::Failed) {
+      failed++;
+      printf("ECHEC    %ls : %s\n", source.c_str(), result.error.c_str());
+      continue;
+    }
+
+    (result.status == TextureCookStatus::Cooked ? cooked : upToDate)++;
+    uncompressedBytes += result.uncompressedBytes;
+    cookedBytes += result.cookedBytes;
+    printf("%s %ls : %ux%u, %u mips, %s, %zu -> %zu Ko\n",
+           result.status == TextureCookStatus::Cooked ? "CUIT    " : "A JOUR  ",
+           source.c_str(), result.width, result.height, result.mipCount, GetFormatName(result.format),
+           result.uncompressedBytes / 1024, result.cookedBytes / 1024);
+  }
+
+  const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  printf("\n%u cuites, %u a jour, %u echecs en %.0f ms ; memoire GPU %zu -> %zu Ko\n",
+         cooked, upToDate, failed, elapsedMs, uncompressedBytes / 1024, cookedBytes / 1024);
+
+  CoUninitialize();
+  return failed > 0 ? 1 : 0;
+}